@@ -0,0 +1,319 @@
+#include "AccessLog.h"
+#include "Metrics.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Veľkosť dávky naformátovaných riadkov zapísanej jedným write()
+#define ACCESS_LOG_BATCH_SIZE 65536
+// Najdlhší naformátovaný riadok
+#define ACCESS_LOG_LINE_SIZE 512
+
+// Záznam pevnej veľkosti; vlákna ho len skopírujú, formátuje vlákno logu.
+typedef struct {
+    uint64_t time_ns;            // CLOCK_REALTIME.
+    uint64_t duration_ns;
+    uint64_t parse_ns;
+    uint32_t bytes_in;
+    uint32_t bytes_out;
+    uint32_t request_number;
+    uint16_t status;
+    uint8_t level;
+    char method[8];
+    char path[ACCESS_LOG_PATH_SIZE];
+} AccessLogRecord;
+
+// Miesto v kruhovom bufferi. `sequence` hovorí, či je voľné pre zápis
+// (== pozícia) alebo obsahuje záznam na prečítanie (== pozícia + 1).
+typedef struct {
+    uint64_t sequence;
+    AccessLogRecord record;
+} AccessLogSlot;
+
+static const char *const level_names[] = {"ERROR", "WARN", "INFO", "DEBUG"};
+
+static AccessLogSlot *log_slots;
+static uint64_t log_mask;
+// Pozícia zápisu zdieľaná vláknami servera; na vlastnom riadku cache.
+static struct {
+    uint64_t value;
+    char padding[56];
+} log_tail __attribute__((aligned(64)));
+static uint64_t log_head;        // Pozícia čítania (len vlákno logu).
+static uint64_t log_written;     // Pozícia, po ktorú sú záznamy zapísané.
+static uint64_t log_dropped;
+
+static int log_enabled;
+static AccessLogLevel log_level;
+static unsigned log_sample;
+static __thread unsigned sample_counter;
+
+// Stav vlákna logu.
+static int log_fd = -1;
+static const char *log_path;
+static size_t log_size;
+static size_t log_max_size;
+static int log_max_files;
+
+int access_log_parse_level(const char *name) {
+    static const char *const names[] = {"error", "warn", "info", "debug"};
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) {
+        if (strcasecmp(name, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Skopíruje cestu bez query stringu; netlačiteľné znaky nahradí '_'.
+ *
+ * Query string môže obsahovať heslá alebo tokeny, preto sa zapíše len značka.
+ */
+static void copy_path(char *out, const HttpSlice *path) {
+    static const char redacted[] = "?<redacted>";
+    size_t limit = ACCESS_LOG_PATH_SIZE - 1;
+    size_t length = 0;
+    int query = 0;
+    for (size_t i = 0; i < path->length; i++) {
+        unsigned char c = (unsigned char)path->data[i];
+        if (c == '?') {
+            query = 1;
+            break;
+        }
+        if (length == limit) break;
+        out[length++] = c > 0x20 && c < 0x7f ? (char)c : '_';
+    }
+    if (query) {
+        if (length > limit - (sizeof(redacted) - 1)) length = limit - (sizeof(redacted) - 1);
+        memcpy(out + length, redacted, sizeof(redacted) - 1);
+        length += sizeof(redacted) - 1;
+    }
+    if (length == 0) out[length++] = '-';
+    out[length] = '\0';
+}
+
+void access_log_request(const AccessLogEntry *entry) {
+    if (!log_enabled) return;
+
+    AccessLogLevel level = entry->status >= 500 ? ACCESS_LOG_ERROR
+                         : entry->status >= 400 ? ACCESS_LOG_WARN : ACCESS_LOG_INFO;
+    if (level > log_level) return;
+    // Vzorkujú sa len bežné záznamy, chyby sa zapíšu vždy.
+    if (level == ACCESS_LOG_INFO && log_sample > 1 && sample_counter++ % log_sample != 0) return;
+
+    // Rezervácia miesta: compare-and-swap na pozícii zápisu (Vyukov MPMC).
+    uint64_t position = __atomic_load_n(&log_tail.value, __ATOMIC_RELAXED);
+    AccessLogSlot *slot;
+    while (1) {
+        slot = &log_slots[position & log_mask];
+        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int64_t difference = (int64_t)(sequence - position);
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&log_tail.value, &position, position + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Buffer je plný: záznam sa zahodí, server nečaká na disk.
+            __atomic_fetch_add(&log_dropped, 1, __ATOMIC_RELAXED);
+            metrics_add(METRICS_LOG_DROPPED, 1);
+            return;
+        } else {
+            position = __atomic_load_n(&log_tail.value, __ATOMIC_RELAXED);
+        }
+    }
+
+    AccessLogRecord *record = &slot->record;
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    record->time_ns = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+    record->duration_ns = entry->duration_ns;
+    record->parse_ns = entry->parse_ns;
+    record->bytes_in = entry->bytes_in > UINT32_MAX ? UINT32_MAX : (uint32_t)entry->bytes_in;
+    record->bytes_out = entry->bytes_out > UINT32_MAX ? UINT32_MAX : (uint32_t)entry->bytes_out;
+    record->request_number = (uint32_t)entry->request_number;
+    record->status = (uint16_t)entry->status;
+    record->level = (uint8_t)level;
+    size_t method_length = entry->method.length < sizeof(record->method) - 1
+                               ? entry->method.length : sizeof(record->method) - 1;
+    memcpy(record->method, entry->method.data, method_length);
+    if (method_length == 0) record->method[method_length++] = '-';
+    record->method[method_length] = '\0';
+    copy_path(record->path, &entry->path);
+
+    __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+}
+
+// --- Vlákno logu ---
+
+/**
+ * @brief Vyberie najstarší záznam (len vlákno logu).
+ *
+ * @return 1 ak bol záznam k dispozícii, inak 0.
+ */
+static int log_pop(AccessLogRecord *record) {
+    AccessLogSlot *slot = &log_slots[log_head & log_mask];
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != log_head + 1) return 0;
+    *record = slot->record;
+    __atomic_store_n(&slot->sequence, log_head + log_mask + 1, __ATOMIC_RELEASE);
+    log_head++;
+    return 1;
+}
+
+/**
+ * @brief Naformátuje záznam ako jeden riadok logu.
+ *
+ * Formát: `čas úroveň stav metóda cesta trvanie in=bajty out=bajty`, na úrovni
+ * DEBUG navyše `req=poradie parse=čas`.
+ */
+static size_t log_format(char *out, const AccessLogRecord *record) {
+    static time_t cached_second = -1;
+    static char cached_prefix[32];
+    time_t second = (time_t)(record->time_ns / 1000000000ull);
+    if (second != cached_second) {
+        struct tm tm;
+        gmtime_r(&second, &tm);
+        strftime(cached_prefix, sizeof(cached_prefix), "%Y-%m-%dT%H:%M:%S", &tm);
+        cached_second = second;
+    }
+
+    int written = snprintf(out, ACCESS_LOG_LINE_SIZE, "%s.%06uZ %s %u %s %s %.1fus in=%u out=%u",
+                           cached_prefix, (unsigned)(record->time_ns % 1000000000ull / 1000),
+                           level_names[record->level], record->status, record->method, record->path,
+                           (double)record->duration_ns / 1e3, record->bytes_in, record->bytes_out);
+    if (log_level == ACCESS_LOG_DEBUG && written < ACCESS_LOG_LINE_SIZE) {
+        written += snprintf(out + written, ACCESS_LOG_LINE_SIZE - (size_t)written, " req=%u parse=%.1fus",
+                            record->request_number, (double)record->parse_ns / 1e3);
+    }
+    if (written >= ACCESS_LOG_LINE_SIZE - 1) written = ACCESS_LOG_LINE_SIZE - 2;
+    out[written++] = '\n';
+    return (size_t)written;
+}
+
+static int log_open(int truncate) {
+    if (strcmp(log_path, "-") == 0) {
+        log_fd = STDOUT_FILENO;
+        return 1;
+    }
+    log_fd = open(log_path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+    if (log_fd < 0) {
+        perror(log_path);
+        return 0;
+    }
+    struct stat info;
+    log_size = fstat(log_fd, &info) == 0 ? (size_t)info.st_size : 0;
+    return 1;
+}
+
+/**
+ * @brief Otočí súbory: log.N-1 -> log.N, ..., log -> log.1 a otvorí nový log.
+ */
+static void log_rotate(void) {
+    char from[4096], to[4096];
+    close(log_fd);
+    for (int i = log_max_files - 1; i >= 1; i--) {
+        snprintf(from, sizeof(from), "%s.%d", log_path, i);
+        snprintf(to, sizeof(to), "%s.%d", log_path, i + 1);
+        rename(from, to);
+    }
+    if (log_max_files > 0) {
+        snprintf(to, sizeof(to), "%s.1", log_path);
+        rename(log_path, to);
+    }
+    if (!log_open(1)) log_fd = -1;
+}
+
+static void log_write(const char *data, size_t length) {
+    if (log_fd < 0) return;
+    if (log_fd != STDOUT_FILENO && log_max_size > 0 && log_size > 0 && log_size + length > log_max_size) {
+        log_rotate();
+        if (log_fd < 0) return;
+    }
+    while (length > 0) {
+        ssize_t written = write(log_fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        length -= (size_t)written;
+        log_size += (size_t)written;
+    }
+}
+
+static void *access_log_main(void *arg) {
+    (void)arg;
+    static char batch[ACCESS_LOG_BATCH_SIZE];
+    uint64_t reported_drops = 0;
+    AccessLogRecord record;
+
+    while (1) {
+        size_t used = 0;
+        int popped = 0;
+        while (used + ACCESS_LOG_LINE_SIZE <= sizeof(batch) && log_pop(&record)) {
+            used += log_format(batch + used, &record);
+            popped = 1;
+        }
+        uint64_t drops = __atomic_load_n(&log_dropped, __ATOMIC_RELAXED);
+        if (drops != reported_drops && used + ACCESS_LOG_LINE_SIZE <= sizeof(batch)) {
+            used += (size_t)snprintf(batch + used, ACCESS_LOG_LINE_SIZE,
+                                     "Log nestíha: zahodených %llu záznamov (spolu %llu)\n",
+                                     (unsigned long long)(drops - reported_drops), (unsigned long long)drops);
+            reported_drops = drops;
+        }
+        if (used > 0) log_write(batch, used);
+        __atomic_store_n(&log_written, log_head, __ATOMIC_RELEASE);
+        if (!popped) {
+            struct timespec idle = {0, ACCESS_LOG_IDLE_MS * 1000000L};
+            nanosleep(&idle, NULL);
+        }
+    }
+    return NULL;
+}
+
+int access_log_init(const AccessLogConfig *config) {
+    if (!config->path || !*config->path) return 0;
+
+    uint64_t capacity = 2;
+    while (capacity < config->capacity) capacity <<= 1;
+    log_slots = (AccessLogSlot *)malloc(capacity * sizeof(AccessLogSlot));
+    if (!log_slots) return 0;
+    for (uint64_t i = 0; i < capacity; i++) log_slots[i].sequence = i;
+    log_mask = capacity - 1;
+
+    log_path = config->path;
+    log_max_size = config->max_size;
+    log_max_files = config->max_files;
+    log_level = config->level;
+    log_sample = config->sample > 1 ? (unsigned)config->sample : 1;
+    if (!log_open(0)) {
+        free(log_slots);
+        log_slots = NULL;
+        return 0;
+    }
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, access_log_main, NULL) != 0) {
+        perror("pthread_create");
+        return 0;
+    }
+    pthread_detach(thread);
+    log_enabled = 1;
+    return 1;
+}
+
+void access_log_flush(void) {
+    if (!log_enabled) return;
+    uint64_t target = __atomic_load_n(&log_tail.value, __ATOMIC_ACQUIRE);
+    for (int waited = 0; waited < ACCESS_LOG_FLUSH_MS; waited++) {
+        if (__atomic_load_n(&log_written, __ATOMIC_ACQUIRE) >= target) return;
+        struct timespec pause = {0, 1000000L};
+        nanosleep(&pause, NULL);
+    }
+}
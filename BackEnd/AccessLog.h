@@ -0,0 +1,85 @@
+#ifndef ACCESSLOG_H
+#define ACCESSLOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "HttpParser.h"
+
+// Predvolená kapacita kruhového buffera záznamov (zaokrúhli sa na mocninu 2)
+#define DEFAULT_ACCESS_LOG_BUFFER 65536
+// Predvolená veľkosť súboru logu, po ktorej sa súbor otočí (MB)
+#define DEFAULT_ACCESS_LOG_MAX_MB 64
+// Predvolený počet ponechaných starších súborov (log.1 ... log.N)
+#define DEFAULT_ACCESS_LOG_FILES 5
+// Najdlhšia zaznamenaná cesta (dlhšie sa skrátia)
+#define ACCESS_LOG_PATH_SIZE 96
+// Ako dlho zapisovacie vlákno čaká, keď je buffer prázdny (ms)
+#define ACCESS_LOG_IDLE_MS 10
+// Najdlhšie čakanie na zápis zvyšných záznamov pri ukončení servera (ms)
+#define ACCESS_LOG_FLUSH_MS 1000
+
+// Úroveň záznamu; zapisujú sa záznamy s úrovňou najviac nastavenou.
+typedef enum {
+    ACCESS_LOG_ERROR,            // Odpovede 5xx.
+    ACCESS_LOG_WARN,             // Odpovede 4xx (chybné požiadavky, vypršané limity).
+    ACCESS_LOG_INFO,             // Ostatné odpovede.
+    ACCESS_LOG_DEBUG             // Ako INFO, navyše poradie požiadavky na spojení a čas parsovania.
+} AccessLogLevel;
+
+// Nastavenia logu načítané pri štarte.
+typedef struct {
+    const char *path;            // Súbor logu, "-" pre štandardný výstup.
+    AccessLogLevel level;
+    int sample;                  // Zapíše sa každý N-tý záznam úrovne INFO/DEBUG (1 = všetky).
+    size_t max_size;             // Veľkosť súboru, po ktorej sa otočí (0 = nikdy).
+    int max_files;               // Počet ponechaných otočených súborov.
+    size_t capacity;             // Kapacita kruhového buffera v záznamoch.
+} AccessLogConfig;
+
+// Údaje o vybavenej požiadavke, ktoré volajúci odovzdá logu.
+typedef struct {
+    HttpSlice method;            // Prázdne, ak sa požiadavku nepodarilo naparsovať.
+    HttpSlice path;
+    int status;
+    uint64_t duration_ns;        // Čas spracovania požiadavky.
+    uint64_t parse_ns;
+    size_t bytes_in;             // Hlavičky a telo požiadavky.
+    size_t bytes_out;            // Bajty odpovede zaradené handlerom.
+    int request_number;          // Poradie požiadavky na spojení.
+} AccessLogEntry;
+
+/**
+ * @brief Prevedie názov úrovne ("error", "warn", "info", "debug") na hodnotu.
+ *
+ * @return Úroveň alebo -1 pri neznámom názve.
+ */
+int access_log_parse_level(const char *name);
+
+/**
+ * @brief Otvorí log a spustí vlákno, ktoré do neho zapisuje.
+ *
+ * @param config Nastavenia (reťazec `path` musí existovať počas behu servera).
+ * @return 1 pri úspechu, 0 pri chybe (log ostane vypnutý).
+ */
+int access_log_init(const AccessLogConfig *config);
+
+/**
+ * @brief Zaradí záznam o požiadavke na zápis.
+ *
+ * Záznam pevnej veľkosti sa skopíruje do kruhového buffera bez zámku
+ * a bez systémového volania; formátovanie a zápis robí vlákno logu.
+ * Telo požiadavky sa nezaznamenáva nikdy a query string cesty sa
+ * nahradí značkou, aby sa do logu nedostali heslá. Keď je buffer plný,
+ * záznam sa zahodí a započíta (metrika access_log_dropped), volajúci
+ * nikdy nečaká. Ak log nie je zapnutý, nerobí nič.
+ */
+void access_log_request(const AccessLogEntry *entry);
+
+/**
+ * @brief Počká, kým vlákno logu zapíše všetky zaradené záznamy (najviac ACCESS_LOG_FLUSH_MS).
+ *
+ * Volá sa pred ukončením procesu; ak log nie je zapnutý, nerobí nič.
+ */
+void access_log_flush(void);
+
+#endif // ACCESSLOG_H
@@ -0,0 +1,124 @@
+#include "Admission.h"
+#include "Metrics.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Vedro tokenov jedného klienta.
+typedef struct {
+    uint32_t client;             // IPv4 adresa (0 = voľný záznam).
+    uint32_t reserved;
+    double tokens;               // Zostávajúce tokeny k času `updated_ns`.
+    uint64_t updated_ns;         // Posledné doplnenie (metrics_now_ns()).
+} AdmissionBucket;
+
+// Shard tabuľky: vlastný zámok nad svojimi množinami, zarovnaný na cache line.
+typedef struct {
+    pthread_mutex_t lock;
+    AdmissionBucket *buckets;
+} __attribute__((aligned(64))) AdmissionShard;
+
+#define ADMISSION_SETS (ADMISSION_TABLE_SIZE / ADMISSION_SHARDS / ADMISSION_WAYS)
+
+static AdmissionShard admission_shards[ADMISSION_SHARDS];
+static AdmissionConfig admission_config;
+static int in_flight __attribute__((aligned(64)));
+
+int admission_init(const AdmissionConfig *config) {
+    admission_config = *config;
+    if (admission_config.burst <= 0) admission_config.burst = admission_config.rate;
+    if (admission_config.rate <= 0) return 1;
+
+    for (int i = 0; i < ADMISSION_SHARDS; i++) {
+        AdmissionShard *shard = &admission_shards[i];
+        shard->buckets = (AdmissionBucket *)calloc(ADMISSION_SETS * ADMISSION_WAYS, sizeof(AdmissionBucket));
+        if (!shard->buckets || pthread_mutex_init(&shard->lock, NULL) != 0) {
+            fprintf(stderr, "Nedostatok pamäte pre limity klientov\n");
+            for (int j = 0; j <= i; j++) {
+                free(admission_shards[j].buckets);
+                admission_shards[j].buckets = NULL;
+            }
+            admission_config.rate = 0;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int admission_per_client(void) {
+    return admission_config.rate > 0;
+}
+
+/**
+ * @brief Odoberie klientovi token.
+ *
+ * Záznam sa hľadá len v jednej množine; ak v nej klient nie je a množina je
+ * plná, nahradí sa záznam s najstarším doplnením. Taký klient by mal vedro
+ * pravdepodobne už plné, takže jeho vyradenie limity takmer nezmení.
+ *
+ * @return 1 ak klient token mal, inak 0 a `retry_after` v sekundách.
+ */
+static int admission_take_token(uint32_t client, int *retry_after) {
+    // Fibonacciho hash: najvyššie bity súčinu vyberú shard, stredné množinu.
+    uint32_t hash = client * 2654435761u;
+    AdmissionShard *shard = &admission_shards[(hash >> 26) & (ADMISSION_SHARDS - 1)];
+    AdmissionBucket *set = shard->buckets + (size_t)((hash >> 8) & (ADMISSION_SETS - 1)) * ADMISSION_WAYS;
+    double rate = admission_config.rate;
+    double burst = admission_config.burst;
+    uint64_t now = metrics_now_ns();
+    int allowed;
+
+    pthread_mutex_lock(&shard->lock);
+    AdmissionBucket *bucket = NULL;
+    AdmissionBucket *oldest = set;
+    for (int way = 0; way < ADMISSION_WAYS; way++) {
+        if (set[way].client == client) {
+            bucket = &set[way];
+            break;
+        }
+        if (set[way].updated_ns < oldest->updated_ns) oldest = &set[way];
+    }
+    if (!bucket) {
+        bucket = oldest;
+        bucket->client = client;
+        bucket->tokens = burst;
+        bucket->updated_ns = now;
+    } else if (now > bucket->updated_ns) {
+        bucket->tokens += (double)(now - bucket->updated_ns) * 1e-9 * rate;
+        if (bucket->tokens > burst) bucket->tokens = burst;
+        bucket->updated_ns = now;
+    }
+    allowed = bucket->tokens >= 1.0;
+    if (allowed) {
+        bucket->tokens -= 1.0;
+    } else {
+        *retry_after = (int)((1.0 - bucket->tokens) / rate) + 1;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return allowed;
+}
+
+AdmissionResult admission_acquire(uint32_t client, int *retry_after) {
+    if (admission_config.rate > 0 && client != 0 && !admission_take_token(client, retry_after)) {
+        metrics_error(METRICS_ERROR_RATE_LIMITED);
+        return ADMISSION_RATE_LIMITED;
+    }
+    // Miesto sa obsadí vopred a pri prekročení limitu vráti; súčet tak nikdy
+    // natrvalo neprekročí max_in_flight ani pri súbežných vláknach.
+    int current = __atomic_add_fetch(&in_flight, 1, __ATOMIC_RELAXED);
+    if (admission_config.max_in_flight > 0 && current > admission_config.max_in_flight) {
+        __atomic_sub_fetch(&in_flight, 1, __ATOMIC_RELAXED);
+        metrics_error(METRICS_ERROR_OVERLOADED);
+        *retry_after = ADMISSION_OVERLOAD_RETRY_AFTER;
+        return ADMISSION_OVERLOADED;
+    }
+    return ADMISSION_ACCEPTED;
+}
+
+void admission_release(void) {
+    __atomic_sub_fetch(&in_flight, 1, __ATOMIC_RELAXED);
+}
+
+int admission_in_flight(void) {
+    return __atomic_load_n(&in_flight, __ATOMIC_RELAXED);
+}
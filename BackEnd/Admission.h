@@ -0,0 +1,66 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <stdint.h>
+
+// Počet záznamov tabuľky klientov (mocnina 2); pamäť je pevná, ~1,5 MB
+#define ADMISSION_TABLE_SIZE 65536
+// Počet shardov tabuľky s vlastným zámkom (mocnina 2)
+#define ADMISSION_SHARDS 64
+// Počet záznamov v jednej množine; pri plnej sa nahradí najdlhšie nečinný klient
+#define ADMISSION_WAYS 4
+// Predvolený limit rozpracovaných požiadaviek procesu
+#define DEFAULT_MAX_IN_FLIGHT 4096
+// Retry-After pri preťažení (limit rozpracovaných požiadaviek), v sekundách
+#define ADMISSION_OVERLOAD_RETRY_AFTER 1
+
+// Nastavenie prijímania požiadaviek.
+typedef struct {
+    int rate;             // Požiadavky za sekundu na jednu IP adresu (0 = bez limitu).
+    int burst;            // Kapacita vedra jednej IP adresy (0 = rovnaká ako rate).
+    int max_in_flight;    // Najviac rozpracovaných požiadaviek (0 = bez limitu).
+} AdmissionConfig;
+
+// Výsledok rozhodnutia o požiadavke.
+typedef enum {
+    ADMISSION_ACCEPTED,
+    ADMISSION_RATE_LIMITED,   // Klient prekročil svoj limit.
+    ADMISSION_OVERLOADED      // Server má príliš veľa rozpracovaných požiadaviek.
+} AdmissionResult;
+
+/**
+ * @brief Nastaví limity; volá sa raz pri štarte, pred spustením vlákien.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie tabuľky klientov.
+ */
+int admission_init(const AdmissionConfig *config);
+
+/**
+ * @brief Zistí, či sa požiadavky obmedzujú podľa IP adresy klienta
+ *        (inak nie je potrebné adresu zisťovať).
+ */
+int admission_per_client(void);
+
+/**
+ * @brief Rozhodne o prijatí požiadavky hneď po naparsovaní hlavičiek.
+ *
+ * Najprv sa z vedra klienta odoberie token (doplňuje sa rýchlosťou `rate`
+ * za sekundu až po `burst`), potom sa obsadí miesto v limite rozpracovaných
+ * požiadaviek. Prijatá požiadavka ho musí uvoľniť `admission_release()`.
+ *
+ * @param client IPv4 adresa klienta (0 = neznáma, limit klienta sa nepoužije).
+ * @param retry_after Pri odmietnutí dostane odporúčané čakanie v sekundách.
+ */
+AdmissionResult admission_acquire(uint32_t client, int *retry_after);
+
+/**
+ * @brief Uvoľní miesto prijatej požiadavky po jej dokončení.
+ */
+void admission_release(void);
+
+/**
+ * @brief Aktuálny počet rozpracovaných požiadaviek procesu.
+ */
+int admission_in_flight(void);
+
+#endif // ADMISSION_H
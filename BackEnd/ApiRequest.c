@@ -0,0 +1,59 @@
+#include "ApiRequest.h"
+#include <string.h>
+
+#define FIELD_COUNT(fields) (sizeof(fields) / sizeof((fields)[0]))
+
+static const JsonField generate_fields[] = {
+    {"length",           JSON_FIELD_INT,  offsetof(GenerateRequest, length),            0},
+    {"includeUppercase", JSON_FIELD_FLAG, offsetof(GenerateRequest, include_uppercase), 0},
+    {"includeLowercase", JSON_FIELD_FLAG, offsetof(GenerateRequest, include_lowercase), 0},
+    {"includeNumbers",   JSON_FIELD_FLAG, offsetof(GenerateRequest, include_numbers),   0},
+    {"includeSymbols",   JSON_FIELD_FLAG, offsetof(GenerateRequest, include_symbols),   0},
+    {"policy",           JSON_FIELD_STRING, offsetof(GenerateRequest, policy),          0},
+    {"policyId",         JSON_FIELD_INT,  offsetof(GenerateRequest, policy_id),         0},
+};
+
+static const JsonField generate_batch_fields[] = {
+    {"length",           JSON_FIELD_INT,  offsetof(GenerateRequest, length),            0},
+    {"includeUppercase", JSON_FIELD_FLAG, offsetof(GenerateRequest, include_uppercase), 0},
+    {"includeLowercase", JSON_FIELD_FLAG, offsetof(GenerateRequest, include_lowercase), 0},
+    {"includeNumbers",   JSON_FIELD_FLAG, offsetof(GenerateRequest, include_numbers),   0},
+    {"includeSymbols",   JSON_FIELD_FLAG, offsetof(GenerateRequest, include_symbols),   0},
+    {"policy",           JSON_FIELD_STRING, offsetof(GenerateRequest, policy),          0},
+    {"policyId",         JSON_FIELD_INT,  offsetof(GenerateRequest, policy_id),         0},
+    {"count",            JSON_FIELD_INT,  offsetof(GenerateRequest, count),             1},
+    {"includeScore",     JSON_FIELD_FLAG, offsetof(GenerateRequest, include_score),     0},
+};
+
+static const JsonField password_fields[] = {
+    {"password",         JSON_FIELD_STRING, offsetof(PasswordRequest, password),        1},
+};
+
+static const JsonField passphrase_fields[] = {
+    {"words",            JSON_FIELD_INT,    offsetof(PassphraseRequest, words),         0},
+    {"separator",        JSON_FIELD_STRING, offsetof(PassphraseRequest, separator),     0},
+    {"capitalize",       JSON_FIELD_STRING, offsetof(PassphraseRequest, capitalize),    0},
+    {"digits",           JSON_FIELD_INT,    offsetof(PassphraseRequest, digits),        0},
+    {"wordlist",         JSON_FIELD_STRING, offsetof(PassphraseRequest, wordlist),      0},
+    {"count",            JSON_FIELD_INT,    offsetof(PassphraseRequest, count),         0},
+};
+
+int api_parse_generate_request(char *body, size_t length, GenerateRequest *request) {
+    memset(request, 0, sizeof(*request));
+    return json_parse_object(body, length, generate_fields, FIELD_COUNT(generate_fields), request);
+}
+
+int api_parse_generate_batch_request(char *body, size_t length, GenerateRequest *request) {
+    memset(request, 0, sizeof(*request));
+    return json_parse_object(body, length, generate_batch_fields, FIELD_COUNT(generate_batch_fields), request);
+}
+
+int api_parse_password_request(char *body, size_t length, PasswordRequest *request) {
+    memset(request, 0, sizeof(*request));
+    return json_parse_object(body, length, password_fields, FIELD_COUNT(password_fields), request);
+}
+
+int api_parse_passphrase_request(char *body, size_t length, PassphraseRequest *request) {
+    memset(request, 0, sizeof(*request));
+    return json_parse_object(body, length, passphrase_fields, FIELD_COUNT(passphrase_fields), request);
+}
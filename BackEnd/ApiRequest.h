@@ -0,0 +1,68 @@
+#ifndef APIREQUEST_H
+#define APIREQUEST_H
+
+#include "JsonParser.h"
+
+// Parametre /api/generate a /api/generate/batch.
+typedef struct {
+    int length;                  // Dĺžka hesla (mimo rozsahu použije handler predvolenú).
+    int include_uppercase;
+    int include_lowercase;
+    int include_numbers;
+    int include_symbols;
+    JsonString policy;           // Názov politiky (Policy.h); ak je zadaná, include* sa ignorujú.
+    int policy_id;               // Číslo politiky (0 = nezadané).
+    int count;                   // Len /api/generate/batch: počet hesiel.
+    int include_score;           // Len /api/generate/batch: pridať skóre ku každému heslu.
+} GenerateRequest;
+
+// Telo /api/evaluate a /api/strengthen.
+typedef struct {
+    JsonString password;         // Dekódované heslo v tele požiadavky (ukončené nulou).
+} PasswordRequest;
+
+// Parametre /api/passphrase.
+typedef struct {
+    int words;                   // Počet slov (0 = predvolený).
+    JsonString separator;        // Oddeľovač slov (chýba = "-").
+    JsonString capitalize;       // "none", "first" alebo "random" (chýba = "none").
+    int digits;                  // Počet náhodných číslic.
+    JsonString wordlist;         // Názov slovníka (chýba = predvolený).
+    int count;                   // Počet fráz (0 = jedna, vráti sa bez poľa).
+} PassphraseRequest;
+
+/**
+ * @brief Naparsuje telo /api/generate.
+ *
+ * Chýbajúce voľby sú 0. Telo sa pri parsovaní prepíše.
+ *
+ * @return 1 pri úspechu, 0 pri chybnom JSON (odpoveď 400).
+ */
+int api_parse_generate_request(char *body, size_t length, GenerateRequest *request);
+
+/**
+ * @brief Naparsuje telo /api/generate/batch (`count` je povinný).
+ *
+ * @return 1 pri úspechu, 0 pri chybnom JSON (odpoveď 400).
+ */
+int api_parse_generate_batch_request(char *body, size_t length, GenerateRequest *request);
+
+/**
+ * @brief Naparsuje telo /api/evaluate alebo /api/strengthen (`password` je povinné).
+ *
+ * Heslo ukazuje do tela požiadavky, platí teda len počas jej spracovania.
+ *
+ * @return 1 pri úspechu, 0 pri chybnom JSON (odpoveď 400).
+ */
+int api_parse_password_request(char *body, size_t length, PasswordRequest *request);
+
+/**
+ * @brief Naparsuje telo /api/passphrase (všetky voľby sú nepovinné).
+ *
+ * Reťazce ukazujú do tela požiadavky, platia teda len počas jej spracovania.
+ *
+ * @return 1 pri úspechu, 0 pri chybnom JSON (odpoveď 400).
+ */
+int api_parse_passphrase_request(char *body, size_t length, PassphraseRequest *request);
+
+#endif // APIREQUEST_H
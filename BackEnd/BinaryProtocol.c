@@ -0,0 +1,250 @@
+#include "BinaryProtocol.h"
+#include "ThreadPool.h"
+#include "Metrics.h"
+#include "Admission.h"
+#include "../Client/PasswordProtocol.h"
+#include "../Logic/Password.h"
+#include "../Logic/Policy.h"
+#include <string.h>
+
+// Celý rámec musí zmestiť do vstupu spojenia: connection_read() drží od
+// začiatku požiadavky najviac MAX_HEADER_SIZE + MAX_BODY_SIZE bajtov.
+#if PASSWORD_FRAME_HEADER_SIZE + PASSWORD_FRAME_MAX_PAYLOAD > MAX_HEADER_SIZE + MAX_BODY_SIZE
+#error "Rámec binárneho protokolu sa nezmestí do vstupného buffera spojenia"
+#endif
+
+/**
+ * @brief Prečíta heslo položky EVALUATE alebo STRENGTHEN (uint16_t dĺžka a bajty).
+ *
+ * @return 1 ak je celá položka v payloade, inak 0.
+ */
+static int read_password(const unsigned char **cursor, const unsigned char *end,
+                         const char **password, size_t *length) {
+    uint16_t item_length;
+    if (end - *cursor < (ptrdiff_t)sizeof(item_length)) return 0;
+    memcpy(&item_length, *cursor, sizeof(item_length));
+    *cursor += sizeof(item_length);
+    if ((size_t)(end - *cursor) < item_length) return 0;
+    *password = (const char *)*cursor;
+    *length = item_length;
+    *cursor += item_length;
+    return 1;
+}
+
+/**
+ * @brief GENERATE: vygeneruje `count` hesiel ako /api/generate.
+ *
+ * @return PASSWORD_STATUS_*.
+ */
+static int binary_generate(Buffer *out, const PasswordFrameHeader *request, const unsigned char *payload) {
+    if (request->length != 4) return PASSWORD_STATUS_BAD_REQUEST;
+    int length = payload[0];
+    int policy_id = payload[1];
+    unsigned int classes = payload[2];
+    const PasswordPolicy *policy = policy_id
+        ? policy_by_id(policy_id)
+        : policy_for_classes((classes & PASSWORD_CLASS_SPECIAL) != 0, (classes & PASSWORD_CLASS_DIGIT) != 0,
+                             (classes & PASSWORD_CLASS_UPPER) != 0, (classes & PASSWORD_CLASS_LOWER) != 0);
+    if (!policy) return PASSWORD_STATUS_BAD_REQUEST;
+    if (length < MIN_PASSWORD_LENGTH || length > MAX_PASSWORD_LENGTH) length = policy->default_length;
+    if (length < policy->min_length) return PASSWORD_STATUS_BAD_REQUEST;
+
+    // Položka: dĺžka, heslo a voliteľne skóre; za poslednou ešte miesto
+    // pre nulu, ktorou policy_generate() ukončí heslo.
+    int with_score = (request->flags & PASSWORD_FLAG_SCORE) != 0;
+    if (!buffer_reserve(out, (size_t)request->count * (size_t)(length + 3))) return PASSWORD_STATUS_INTERNAL;
+    for (unsigned int i = 0; i < request->count; i++) {
+        char *item = out->data + out->length;
+        item[0] = (char)length;
+        if (!policy_generate(policy, length, item + 1)) return PASSWORD_STATUS_BAD_REQUEST;
+        out->length += 1 + (size_t)length;
+        if (with_score) {
+            PasswordStrength result;
+            evaluate_password_strength(item + 1, &result);
+            out->data[out->length++] = (char)result.score;
+            out->data[out->length++] = (char)result.is_strong;
+        }
+    }
+    out->data[out->length] = '\0';
+    return PASSWORD_STATUS_OK;
+}
+
+/**
+ * @brief EVALUATE: vyhodnotí heslá všetkými kontrolami ako /api/evaluate.
+ *
+ * @return PASSWORD_STATUS_*.
+ */
+static int binary_evaluate(Buffer *out, const PasswordFrameHeader *request, const unsigned char *payload) {
+    const unsigned char *cursor = payload;
+    const unsigned char *end = payload + request->length;
+    if (!buffer_reserve(out, (size_t)request->count * sizeof(PasswordFrameEvaluation))) {
+        return PASSWORD_STATUS_INTERNAL;
+    }
+    for (unsigned int i = 0; i < request->count; i++) {
+        const char *password;
+        size_t length;
+        if (!read_password(&cursor, end, &password, &length)) return PASSWORD_STATUS_BAD_REQUEST;
+
+        PasswordStrength result;
+        evaluate_password_bytes(password, length, PASSWORD_CHECK_ALL, &result);
+        PasswordFrameEvaluation evaluation;
+        evaluation.reasons = result.reasons;
+        evaluation.guesses_log10 = (float)result.guesses_log10;
+        evaluation.score = (uint8_t)result.score;
+        evaluation.strong = (uint8_t)result.is_strong;
+        evaluation.reserved = 0;
+        memcpy(out->data + out->length, &evaluation, sizeof(evaluation));
+        out->length += sizeof(evaluation);
+    }
+    out->data[out->length] = '\0';
+    return cursor == end ? PASSWORD_STATUS_OK : PASSWORD_STATUS_BAD_REQUEST;
+}
+
+/**
+ * @brief STRENGTHEN: vylepší heslá ako /api/strengthen.
+ *
+ * Dlhší vstup ako MAX_PASSWORD_LENGTH sa oreže rovnako ako v strengthen_password().
+ *
+ * @return PASSWORD_STATUS_*.
+ */
+static int binary_strengthen(Buffer *out, const PasswordFrameHeader *request, const unsigned char *payload) {
+    const unsigned char *cursor = payload;
+    const unsigned char *end = payload + request->length;
+    for (unsigned int i = 0; i < request->count; i++) {
+        const char *password;
+        size_t length;
+        if (!read_password(&cursor, end, &password, &length)) return PASSWORD_STATUS_BAD_REQUEST;
+
+        char weak_password[MAX_PASSWORD_LENGTH + 1];
+        if (length > MAX_PASSWORD_LENGTH) length = MAX_PASSWORD_LENGTH;
+        memcpy(weak_password, password, length);
+        weak_password[length] = '\0';
+        char strong_password[MAX_PASSWORD_LENGTH + 1] = {0};
+        strengthen_password(weak_password, strong_password);
+
+        unsigned char strong_length = (unsigned char)strlen(strong_password);
+        if (!buffer_append(out, &strong_length, 1) || !buffer_append(out, strong_password, strong_length)) {
+            return PASSWORD_STATUS_INTERNAL;
+        }
+    }
+    return cursor == end ? PASSWORD_STATUS_OK : PASSWORD_STATUS_BAD_REQUEST;
+}
+
+/**
+ * @brief Zaradí odpoveď bez payloadu s chybovým stavom.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+static int binary_send_status(Connection *conn, const PasswordFrameHeader *request, int status) {
+    PasswordFrameHeader response = {0, request->request_id, request->opcode, (uint8_t)status, 0};
+    return connection_send(conn, &response, sizeof(response));
+}
+
+/**
+ * @brief Vybaví jeden kompletný rámec a zaradí odpoveď.
+ *
+ * Payload odpovede sa zapisuje priamo do výstupného buffera za miesto
+ * pre hlavičku, ktorá sa doplní, keď je známa dĺžka a stav.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie (spojenie sa zavrie).
+ */
+static int binary_dispatch(Connection *conn, const PasswordFrameHeader *request, const unsigned char *payload) {
+    uint64_t started = metrics_now_ns();
+    MetricsRoute route = METRICS_ROUTE_OTHER;
+    int status;
+    int retry_after;
+
+    Buffer *out = connection_begin_body(conn);
+    size_t header_offset = out->length;
+    PasswordFrameHeader response = {0, request->request_id, request->opcode, PASSWORD_STATUS_OK, request->count};
+    if (!buffer_append(out, &response, sizeof(response))) {
+        connection_cancel_body(conn);
+        return 0;
+    }
+
+    if (request->count > PASSWORD_FRAME_MAX_COUNT) {
+        status = PASSWORD_STATUS_TOO_LARGE;
+    } else if (admission_acquire(0, &retry_after) != ADMISSION_ACCEPTED) {
+        status = PASSWORD_STATUS_OVERLOADED;
+    } else {
+        switch (request->opcode) {
+        case PASSWORD_OP_GENERATE:
+            route = METRICS_ROUTE_UNIX_GENERATE;
+            status = binary_generate(out, request, payload);
+            break;
+        case PASSWORD_OP_EVALUATE:
+            route = METRICS_ROUTE_UNIX_EVALUATE;
+            status = binary_evaluate(out, request, payload);
+            break;
+        case PASSWORD_OP_STRENGTHEN:
+            route = METRICS_ROUTE_UNIX_STRENGTHEN;
+            status = binary_strengthen(out, request, payload);
+            break;
+        default:
+            status = PASSWORD_STATUS_UNKNOWN_OPERATION;
+            break;
+        }
+        admission_release();
+    }
+
+    // Pri chybe sa rozpracované položky zahodia a ostane len hlavička.
+    switch (status) {
+    case PASSWORD_STATUS_OK:
+        break;
+    case PASSWORD_STATUS_TOO_LARGE:
+        metrics_error(METRICS_ERROR_TOO_LARGE);
+        break;
+    case PASSWORD_STATUS_INTERNAL:
+        metrics_error(METRICS_ERROR_INTERNAL);
+        break;
+    case PASSWORD_STATUS_OVERLOADED:
+        // Započítal admission_acquire().
+        break;
+    default:
+        metrics_error(METRICS_ERROR_BAD_REQUEST);
+        break;
+    }
+    if (status != PASSWORD_STATUS_OK) {
+        out->length = header_offset + sizeof(response);
+        out->data[out->length] = '\0';
+        response.count = 0;
+    }
+    response.flags = (uint8_t)status;
+    response.length = (uint32_t)(out->length - header_offset - sizeof(response));
+    memcpy(out->data + header_offset, &response, sizeof(response));
+    connection_end_raw_body(conn);
+
+    uint64_t elapsed = metrics_now_ns() - started;
+    metrics_add(METRICS_FRAMES, 1);
+    metrics_record_route(route, elapsed);
+    metrics_record_phase(METRICS_PHASE_COMPUTE, elapsed);
+    return 1;
+}
+
+int binary_protocol_process(Connection *conn) {
+    while (!conn->close_after_write && conn->out_pending < OUTPUT_HIGH_WATER) {
+        size_t available = conn->in.length - conn->in_start;
+        if (available < sizeof(PasswordFrameHeader)) break;
+
+        const unsigned char *start = (const unsigned char *)conn->in.data + conn->in_start;
+        PasswordFrameHeader request;
+        memcpy(&request, start, sizeof(request));
+        if (request.length > PASSWORD_FRAME_MAX_PAYLOAD) {
+            // Zvyšok rámca sa už nečíta: klient dostane chybu a spojenie sa zavrie.
+            metrics_error(METRICS_ERROR_TOO_LARGE);
+            if (!binary_send_status(conn, &request, PASSWORD_STATUS_TOO_LARGE)) return 0;
+            conn->close_after_write = 1;
+            return 1;
+        }
+        if (available < sizeof(request) + request.length) break;
+
+        if (!binary_dispatch(conn, &request, start + sizeof(request))) return 0;
+        conn->in_start += sizeof(request) + request.length;
+    }
+
+    // Pri ukončovaní servera sa spojenie zavrie po vybavení prijatých rámcov.
+    if (conn->worker->draining && conn->in_start == conn->in.length) {
+        conn->close_after_write = 1;
+    }
+    return 1;
+}
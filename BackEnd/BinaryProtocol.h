@@ -0,0 +1,21 @@
+#ifndef BINARYPROTOCOL_H
+#define BINARYPROTOCOL_H
+
+#include "Connection.h"
+
+/**
+ * @brief Vybaví všetky kompletné rámce binárneho protokolu vo vstupe spojenia.
+ *
+ * Formát rámcov je v Client/PasswordProtocol.h. Každý rámec sa vybaví hneď
+ * v event loope tými istými funkciami Password.c ako zodpovedajúci endpoint
+ * HTTP API a odpoveď sa zaradí do výstupu spojenia bez HTTP hlavičiek.
+ * Spracovanie sa preruší, ak odpovede čakajúce na odoslanie presiahnu
+ * OUTPUT_HIGH_WATER. Na priveľký rámec server odpovie chybou a spojenie
+ * po odoslaní zavrie.
+ *
+ * @param conn Spojenie prijaté na Unix sockete.
+ * @return 1 ak má spojenie pokračovať, 0 ak sa má okamžite zavrieť.
+ */
+int binary_protocol_process(Connection *conn);
+
+#endif // BINARYPROTOCOL_H
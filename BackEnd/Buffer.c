@@ -0,0 +1,83 @@
+#include "Buffer.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void buffer_init(Buffer *buffer) {
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+int buffer_reserve(Buffer *buffer, size_t extra) {
+    if (buffer->length + extra <= buffer->capacity && buffer->data) {
+        return 1;
+    }
+
+    // Kapacita rastie geometricky, aby bol amortizovaný čas pripájania konštantný.
+    size_t new_capacity = buffer->capacity ? buffer->capacity : BUFFER_INITIAL_CAPACITY;
+    while (new_capacity < buffer->length + extra) {
+        new_capacity *= 2;
+    }
+
+    // +1 bajt pre ukončovaciu nulu.
+    char *new_data = (char *)realloc(buffer->data, new_capacity + 1);
+    if (!new_data) return 0;
+
+    buffer->data = new_data;
+    buffer->capacity = new_capacity;
+    buffer->data[buffer->length] = '\0';
+    return 1;
+}
+
+int buffer_append(Buffer *buffer, const void *data, size_t length) {
+    if (!buffer_reserve(buffer, length)) return 0;
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+    return 1;
+}
+
+int buffer_appendf(Buffer *buffer, const char *format, ...) {
+    va_list args;
+
+    // Prvý pokus zapíše priamo do voľného miesta; ak nestačí, buffer sa zväčší.
+    if (!buffer_reserve(buffer, 256)) return 0;
+    size_t available = buffer->capacity - buffer->length + 1;
+
+    va_start(args, format);
+    int needed = vsnprintf(buffer->data + buffer->length, available, format, args);
+    va_end(args);
+    if (needed < 0) return 0;
+
+    if ((size_t)needed >= available) {
+        if (!buffer_reserve(buffer, (size_t)needed)) return 0;
+        va_start(args, format);
+        vsnprintf(buffer->data + buffer->length, (size_t)needed + 1, format, args);
+        va_end(args);
+    }
+
+    buffer->length += (size_t)needed;
+    return 1;
+}
+
+void buffer_consume(Buffer *buffer, size_t count) {
+    if (count >= buffer->length) {
+        buffer_reset(buffer);
+        return;
+    }
+    memmove(buffer->data, buffer->data + count, buffer->length - count);
+    buffer->length -= count;
+    buffer->data[buffer->length] = '\0';
+}
+
+void buffer_reset(Buffer *buffer) {
+    buffer->length = 0;
+    if (buffer->data) buffer->data[0] = '\0';
+}
+
+void buffer_free(Buffer *buffer) {
+    free(buffer->data);
+    buffer_init(buffer);
+}
@@ -0,0 +1,59 @@
+#ifndef BUFFER_H
+#define BUFFER_H
+
+#include <stddef.h>
+
+// Počiatočná kapacita buffera pri prvej alokácii
+#define BUFFER_INITIAL_CAPACITY 4096
+
+// Dynamicky rastúci buffer bajtov. Za platnými dátami vždy ostáva miesto
+// pre ukončovaciu nulu, takže obsah sa dá použiť aj ako C reťazec.
+typedef struct {
+    char *data;       // Alokovaná pamäť (alebo NULL, kým sa nič nezapísalo).
+    size_t length;    // Počet platných bajtov.
+    size_t capacity;  // Veľkosť alokovanej pamäte bez miesta pre nulu.
+} Buffer;
+
+/**
+ * @brief Inicializuje prázdny buffer bez alokácie.
+ */
+void buffer_init(Buffer *buffer);
+
+/**
+ * @brief Zabezpečí miesto pre ďalších `extra` bajtov za aktuálnym obsahom.
+ *
+ * @return 1 pri úspechu, 0 ak sa nepodarilo alokovať pamäť.
+ */
+int buffer_reserve(Buffer *buffer, size_t extra);
+
+/**
+ * @brief Pripojí dáta na koniec buffera.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int buffer_append(Buffer *buffer, const void *data, size_t length);
+
+/**
+ * @brief Pripojí na koniec buffera text naformátovaný ako pri `printf`.
+ *
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int buffer_appendf(Buffer *buffer, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Odstráni prvých `count` bajtov a zvyšok posunie na začiatok.
+ */
+void buffer_consume(Buffer *buffer, size_t count);
+
+/**
+ * @brief Vyprázdni buffer, alokovanú pamäť si ponechá na ďalšie použitie.
+ */
+void buffer_reset(Buffer *buffer);
+
+/**
+ * @brief Uvoľní pamäť buffera.
+ */
+void buffer_free(Buffer *buffer);
+
+#endif // BUFFER_H
@@ -0,0 +1,188 @@
+#include "ComputePool.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Jeden paralelný cyklus. Úloha z `compute_pool_run()` žije na zásobníku
+// volajúceho, ktorý čaká, kým ju neopustia všetky vlákna. Úlohu
+// z `compute_pool_submit()` (`done` != NULL) uvoľní vlákno, ktoré ju dokončí.
+typedef struct ComputeJob {
+    ComputeTask task;
+    void *context;
+    ComputeDone done;           // Oznámenie o dokončení alebo NULL pri čakajúcom volajúcom.
+    size_t count;
+    size_t next_index;          // Ďalší nepridelený index (atomické počítadlo).
+    size_t completed;           // Počet dokončených indexov (pod zámkom poolu).
+    int helpers;                // Vlákna poolu, ktoré práve pracujú na úlohe.
+    pthread_cond_t finished;
+    struct ComputeJob *next;    // Ďalšia úloha vo fronte.
+} ComputeJob;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_work = PTHREAD_COND_INITIALIZER;
+static ComputeJob *pool_jobs = NULL;
+static int pool_threads = 0;
+
+/**
+ * @brief Spracúva indexy úlohy, kým nejaké zostávajú.
+ *
+ * @return Počet spracovaných indexov.
+ */
+static size_t compute_job_work(ComputeJob *job) {
+    size_t processed = 0;
+    size_t index;
+    while ((index = __atomic_fetch_add(&job->next_index, 1, __ATOMIC_RELAXED)) < job->count) {
+        job->task(job->context, index);
+        processed++;
+    }
+    return processed;
+}
+
+/**
+ * @brief Vyradí úlohu z fronty (volá sa pod zámkom poolu).
+ */
+static void compute_job_unlink(ComputeJob *job) {
+    ComputeJob **link = &pool_jobs;
+    while (*link && *link != job) {
+        link = &(*link)->next;
+    }
+    if (*link) *link = job->next;
+}
+
+/**
+ * @brief Zaradí úlohu na koniec fronty a zobudí výpočtové vlákna
+ *        (volá sa pod zámkom poolu).
+ */
+static void compute_job_enqueue(ComputeJob *job) {
+    ComputeJob **tail = &pool_jobs;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = job;
+    pthread_cond_broadcast(&pool_work);
+}
+
+/**
+ * @brief Pripočíta dokončené indexy a zobudí volajúceho, ak je úloha hotová
+ *        (volá sa pod zámkom poolu).
+ *
+ * @return 1 ak bola dokončená úloha bez čakajúceho volajúceho; vlákno potom
+ *         mimo zámku zavolá `done` a úlohu uvoľní.
+ */
+static int compute_job_report(ComputeJob *job, size_t processed) {
+    job->completed += processed;
+    if (job->completed < job->count || job->helpers > 0) return 0;
+
+    if (job->done) {
+        compute_job_unlink(job);
+        return 1;
+    }
+    pthread_cond_signal(&job->finished);
+    return 0;
+}
+
+static void *compute_thread_main(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&pool_lock);
+    while (1) {
+        while (!pool_jobs) {
+            pthread_cond_wait(&pool_work, &pool_lock);
+        }
+
+        ComputeJob *job = pool_jobs;
+        if (__atomic_load_n(&job->next_index, __ATOMIC_RELAXED) >= job->count) {
+            // Všetky indexy sú rozdelené, úloha už pomocníkov nepotrebuje.
+            compute_job_unlink(job);
+            continue;
+        }
+
+        job->helpers++;
+        pthread_mutex_unlock(&pool_lock);
+        size_t processed = compute_job_work(job);
+        pthread_mutex_lock(&pool_lock);
+        job->helpers--;
+        if (compute_job_report(job, processed)) {
+            pthread_mutex_unlock(&pool_lock);
+            job->done(job->context);
+            free(job);
+            pthread_mutex_lock(&pool_lock);
+        }
+    }
+    return NULL;
+}
+
+int compute_pool_init(int thread_count) {
+    if (thread_count < 1 || thread_count > MAX_COMPUTE_THREADS) return 0;
+
+    for (int i = 0; i < thread_count; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, compute_thread_main, NULL) != 0) {
+            perror("pthread_create");
+            break;
+        }
+        pthread_detach(thread);
+        pool_threads++;
+    }
+    return pool_threads > 0;
+}
+
+void compute_pool_run(ComputeTask task, void *context, size_t count) {
+    if (count == 0) return;
+
+    // Bez poolu alebo pri jedinom indexe nemá zmysel nikoho budiť.
+    if (pool_threads == 0 || count == 1) {
+        for (size_t i = 0; i < count; i++) {
+            task(context, i);
+        }
+        return;
+    }
+
+    ComputeJob job;
+    job.task = task;
+    job.context = context;
+    job.done = NULL;
+    job.count = count;
+    job.next_index = 0;
+    job.completed = 0;
+    job.helpers = 0;
+    job.next = NULL;
+    pthread_cond_init(&job.finished, NULL);
+
+    pthread_mutex_lock(&pool_lock);
+    compute_job_enqueue(&job);
+    pthread_mutex_unlock(&pool_lock);
+
+    size_t processed = compute_job_work(&job);
+
+    pthread_mutex_lock(&pool_lock);
+    compute_job_unlink(&job);
+    compute_job_report(&job, processed);
+    while (job.completed < job.count || job.helpers > 0) {
+        pthread_cond_wait(&job.finished, &pool_lock);
+    }
+    pthread_mutex_unlock(&pool_lock);
+    pthread_cond_destroy(&job.finished);
+}
+
+int compute_pool_submit(ComputeTask task, void *context, size_t count, ComputeDone done) {
+    // Bez poolu nemá úlohu kto prevziať, vykoná sa hneď.
+    if (pool_threads == 0 || count == 0) {
+        for (size_t i = 0; i < count; i++) {
+            task(context, i);
+        }
+        done(context);
+        return 1;
+    }
+
+    ComputeJob *job = (ComputeJob *)calloc(1, sizeof(ComputeJob));
+    if (!job) return 0;
+    job->task = task;
+    job->context = context;
+    job->done = done;
+    job->count = count;
+
+    pthread_mutex_lock(&pool_lock);
+    compute_job_enqueue(job);
+    pthread_mutex_unlock(&pool_lock);
+    return 1;
+}
@@ -0,0 +1,51 @@
+#ifndef COMPUTEPOOL_H
+#define COMPUTEPOOL_H
+
+#include <stddef.h>
+
+// Horná hranica počtu výpočtových vlákien
+#define MAX_COMPUTE_THREADS 256
+
+/**
+ * @brief Úloha paralelného cyklu: spracuje jeden index z [0, count).
+ */
+typedef void (*ComputeTask)(void *context, size_t index);
+
+/**
+ * @brief Oznámenie o dokončení úlohy zaradenej cez `compute_pool_submit()`.
+ */
+typedef void (*ComputeDone)(void *context);
+
+/**
+ * @brief Spustí výpočtové vlákna pre CPU náročné časti požiadaviek
+ *        (napr. dávkové vyhodnocovanie hesiel).
+ *
+ * Event loopy pracovných vlákien tak nemusia dlhý výpočet robiť samé.
+ *
+ * @param thread_count Počet vlákien (1 až MAX_COMPUTE_THREADS).
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int compute_pool_init(int thread_count);
+
+/**
+ * @brief Paralelne zavolá `task(context, i)` pre každé i z [0, count).
+ *
+ * Volajúce vlákno sa na práci podieľa tiež, takže funkcia skončí aj vtedy,
+ * keď sú všetky výpočtové vlákna obsadené (alebo pool nebol spustený).
+ * Vráti sa až po dokončení všetkých indexov.
+ */
+void compute_pool_run(ComputeTask task, void *context, size_t count);
+
+/**
+ * @brief Zaradí paralelný cyklus ako `compute_pool_run()`, ale nečaká naň.
+ *
+ * Indexy spracujú len výpočtové vlákna, takže event loop volajúceho medzitým
+ * obsluhuje ostatné spojenia. Po dokončení všetkých indexov zavolá
+ * `done(context)` výpočtové vlákno, ktoré skončilo posledné. Bez poolu sa
+ * cyklus aj `done` vykonajú hneď vo volajúcom vlákne.
+ *
+ * @return 1 ak bola úloha prijatá, 0 pri chybe alokácie (`done` sa nezavolá).
+ */
+int compute_pool_submit(ComputeTask task, void *context, size_t count, ComputeDone done);
+
+#endif // COMPUTEPOOL_H
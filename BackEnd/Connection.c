@@ -0,0 +1,905 @@
+#include "Connection.h"
+#include "HTTPserver.h"
+#include "ThreadPool.h"
+#include "Metrics.h"
+#include "AccessLog.h"
+#include "Admission.h"
+#include "BinaryProtocol.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+
+/**
+ * @brief Uvoľní pripnutý objekt, na ktorý už neukazuje žiadny úsek odpovede.
+ */
+static void connection_unpin(Connection *conn) {
+    if (conn->pinned) {
+        conn->pinned_release(conn->pinned);
+        conn->pinned = NULL;
+        conn->pinned_release = NULL;
+    }
+}
+
+/**
+ * @brief Uvoľní miesto požiadavky v limite rozpracovaných požiadaviek.
+ */
+static void connection_release_admission(Connection *conn) {
+    if (conn->admitted) {
+        admission_release();
+        conn->admitted = 0;
+    }
+}
+
+/**
+ * @brief Ukončí streamovanú odpoveď a uvoľní stav jej producenta.
+ */
+static void connection_end_stream(Connection *conn) {
+    if (conn->producer) {
+        if (conn->producer_destroy) conn->producer_destroy(conn->producer_state);
+        conn->producer = NULL;
+        conn->producer_state = NULL;
+        conn->producer_destroy = NULL;
+    }
+}
+
+/**
+ * @brief Vyradí spojenie zo zoznamu odložených spojení vlákna.
+ */
+static void connection_unready(Connection *conn) {
+    if (!conn->ready_queued) return;
+
+    Worker *worker = conn->worker;
+    if (conn->ready_prev) conn->ready_prev->ready_next = conn->ready_next;
+    else worker->ready_head = conn->ready_next;
+    if (conn->ready_next) conn->ready_next->ready_prev = conn->ready_prev;
+    else worker->ready_tail = conn->ready_prev;
+
+    conn->ready_prev = conn->ready_next = NULL;
+    conn->ready_queued = 0;
+    worker->ready_count--;
+}
+
+/**
+ * @brief Odloží spojenie na ďalšiu iteráciu event loopu.
+ *
+ * Pri edge-triggered epolle nepríde pre socket, ktorý ešte prijíma dáta,
+ * žiadna ďalšia udalosť; spojenie preto pokračuje zo zoznamu vlákna.
+ */
+static void connection_defer(Connection *conn) {
+    if (conn->ready_queued) return;
+
+    Worker *worker = conn->worker;
+    conn->ready_prev = worker->ready_tail;
+    conn->ready_next = NULL;
+    if (worker->ready_tail) worker->ready_tail->ready_next = conn;
+    else worker->ready_head = conn;
+    worker->ready_tail = conn;
+    conn->ready_queued = 1;
+    worker->ready_count++;
+}
+
+/**
+ * @brief Uzavrie socket a uvoľní všetky prostriedky spojenia.
+ *
+ * Zatvorením socketu ho jadro samo odstráni z epollu.
+ */
+static void connection_close(Connection *conn) {
+    timer_wheel_cancel(&conn->timer);
+    connection_unready(conn);
+    if (conn->fd >= 0) close(conn->fd);
+    conn->fd = -1;
+    // Stav producenta ešte používa iné vlákno; zvyšok sa uvoľní v connection_on_resume().
+    if (conn->suspended) {
+        conn->close_pending = 1;
+        return;
+    }
+    connection_end_stream(conn);
+    connection_release_admission(conn);
+    connection_unpin(conn);
+    buffer_free(&conn->in);
+    buffer_free(&conn->out);
+    __atomic_store_n(&conn->worker->open_connections, conn->worker->open_connections - 1, __ATOMIC_RELAXED);
+    metrics_add(METRICS_CONNECTIONS_CLOSED, 1);
+    free(conn);
+}
+
+/**
+ * @brief Nastaví časový limit pre zadanú fázu spojenia.
+ *
+ * @param restart Ak je 0 a fáza sa nezmenila, pôvodný limit ostáva
+ *                (pomalé posielanie hlavičiek po bajtoch ho nepredĺži).
+ */
+static void connection_arm_timer(Connection *conn, TimerPhase phase, int restart) {
+    if (phase == conn->timer_phase && !restart) return;
+
+    uint64_t timeout_ms;
+    switch (phase) {
+    case TIMER_PHASE_HEADERS: timeout_ms = HEADER_TIMEOUT_MS; break;
+    case TIMER_PHASE_BODY:    timeout_ms = BODY_TIMEOUT_MS; break;
+    case TIMER_PHASE_WRITE:   timeout_ms = WRITE_TIMEOUT_MS; break;
+    case TIMER_PHASE_IDLE:
+        timeout_ms = (uint64_t)server_config.keepalive_timeout_ms;
+        if (conn->worker->draining && timeout_ms > DRAIN_IDLE_TIMEOUT_MS) timeout_ms = DRAIN_IDLE_TIMEOUT_MS;
+        break;
+    default:
+        timer_wheel_cancel(&conn->timer);
+        conn->timer_phase = phase;
+        return;
+    }
+
+    conn->timer_phase = phase;
+    timer_wheel_schedule(&conn->worker->timers, &conn->timer, timer_now_ms() + timeout_ms);
+}
+
+/**
+ * @brief Zaradí chybovú odpoveď bez tela, po ktorej sa spojenie zavrie.
+ *
+ * Odpovede na predchádzajúce zreťazené požiadavky sa odošlú pred ňou;
+ * zvyšné neprečítané dáta od klienta sa zahodia.
+ */
+static void connection_fail(Connection *conn, int status, const char *reason) {
+    metrics_error(status == 400 ? METRICS_ERROR_BAD_REQUEST : METRICS_ERROR_TOO_LARGE);
+    AccessLogEntry entry = {0};
+    entry.status = status;
+    entry.parse_ns = conn->parse_ns;
+    entry.bytes_in = conn->in.length - conn->in_start;
+    entry.request_number = conn->requests_served + 1;
+    access_log_request(&entry);
+    connection_sendf(conn,
+                     "HTTP/1.1 %d %s\r\n"
+                     "Content-Length: 0\r\n"
+                     "Connection: close\r\n"
+                     "\r\n",
+                     status, reason);
+    conn->keep_alive = 0;
+    conn->close_after_write = 1;
+}
+
+/**
+ * @brief Odmietne požiadavku hneď po hlavičkách odpoveďou 503 s `Retry-After`.
+ *
+ * Telo sa nečíta ani nespracuje a spojenie sa po odoslaní zavrie, takže
+ * odmietnutie stojí čo najmenej.
+ */
+static void connection_shed(Connection *conn, int retry_after) {
+    AccessLogEntry entry = {0};
+    entry.method = conn->request.method;
+    entry.path = conn->request.path;
+    entry.status = 503;
+    entry.parse_ns = conn->parse_ns;
+    entry.bytes_in = conn->in.length - conn->in_start;
+    entry.request_number = conn->requests_served + 1;
+    access_log_request(&entry);
+    connection_sendf(conn,
+                     "HTTP/1.1 503 Service Unavailable\r\n"
+                     "Retry-After: %d\r\n"
+                     "Content-Length: 0\r\n"
+                     "Connection: close\r\n"
+                     "\r\n",
+                     retry_after);
+    conn->keep_alive = 0;
+    conn->close_after_write = 1;
+}
+
+Connection *connection_open(Worker *worker, int fd, ConnectionProtocol protocol) {
+    Connection *conn = (Connection *)calloc(1, sizeof(Connection));
+    if (!conn) return NULL;
+
+    conn->fd = fd;
+    conn->protocol = protocol;
+    conn->worker = worker;
+    conn->state = CONN_READING_HEADERS;
+    conn->timer_phase = TIMER_PHASE_NONE;
+    timer_node_init(&conn->timer);
+    buffer_init(&conn->in);
+    buffer_init(&conn->out);
+    http_request_init(&conn->request);
+
+    // Adresa klienta sa zisťuje, len ak sa podľa nej obmedzujú požiadavky.
+    if (protocol == CONNECTION_HTTP && admission_per_client()) {
+        struct sockaddr_in peer;
+        socklen_t peer_length = sizeof(peer);
+        if (getpeername(fd, (struct sockaddr *)&peer, &peer_length) == 0 && peer.sin_family == AF_INET) {
+            conn->client_address = ntohl(peer.sin_addr.s_addr);
+        }
+    }
+
+    // Odpovede sa zapisujú naraz, Nagleov algoritmus by ich len zdržal.
+    if (protocol == CONNECTION_HTTP) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    // Edge-triggered režim: udalosť príde len pri zmene stavu, preto sa
+    // pri každej udalosti číta aj zapisuje, kým jadro nevráti EAGAIN.
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = conn;
+    if (epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        perror("epoll_ctl");
+        free(conn);
+        return NULL;
+    }
+
+    __atomic_store_n(&worker->open_connections, worker->open_connections + 1, __ATOMIC_RELAXED);
+    metrics_add(METRICS_CONNECTIONS_OPENED, 1);
+    // Binárny klient sa pripája vopred, kým nemá čo poslať, spojenie je nečinné.
+    connection_arm_timer(conn, protocol == CONNECTION_HTTP ? TIMER_PHASE_HEADERS : TIMER_PHASE_IDLE, 1);
+    return conn;
+}
+
+/**
+ * @brief Koľko bajtov od začiatku aktuálnej požiadavky sa oplatí držať vo vstupe.
+ *
+ * Kým sa číta telo, musí sa doň zmestiť celé (pri chunked tele aj s rámcovaním
+ * chunkov); inak stačí miesto pre hlavičky a telo bežnej veľkosti.
+ */
+static size_t connection_read_limit(const Connection *conn) {
+    size_t limit = MAX_HEADER_SIZE + MAX_BODY_SIZE;
+    if (conn->state == CONN_READING_BODY) {
+        const HttpRequest *request = &conn->request;
+        size_t needed = request->header_length +
+                        (request->chunked ? 2 * conn->body_limit + MAX_HEADER_SIZE : request->content_length);
+        if (needed > limit) limit = needed;
+    }
+    return limit;
+}
+
+/**
+ * @brief Prečíta zo socketu dostupné dáta, najviac po limit vstupného buffera.
+ *
+ * Ak sa čítanie zastaví kvôli limitu, `readable` ostane nastavené a zvyšok
+ * sa dočíta, keď sa spracované požiadavky z buffera odstránia.
+ *
+ * @return 1 ak je spojenie v poriadku, 0 pri chybe čítania.
+ */
+static int connection_read(Connection *conn) {
+    while (conn->in.length - conn->in_start < connection_read_limit(conn)) {
+        const char *old_base = conn->in.data;
+        if (!buffer_reserve(&conn->in, READ_CHUNK_SIZE)) return 0;
+        if (old_base && conn->state == CONN_READING_BODY) {
+            http_request_rebase(&conn->request, old_base, conn->in.data);
+        }
+
+        ssize_t bytes_read = read(conn->fd, conn->in.data + conn->in.length,
+                                  conn->in.capacity - conn->in.length);
+        if (bytes_read > 0) {
+            metrics_add(METRICS_BYTES_RECEIVED, (uint64_t)bytes_read);
+            conn->in.length += (size_t)bytes_read;
+            conn->in.data[conn->in.length] = '\0';
+            if (conn->state == CONN_READING_BODY) {
+                connection_arm_timer(conn, TIMER_PHASE_BODY, 1);
+            }
+            continue;
+        }
+        if (bytes_read == 0) {
+            conn->peer_closed = 1;
+            conn->readable = 0;
+            return 1;
+        }
+        if (errno == EINTR) continue;
+        conn->readable = 0;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 1;
+        metrics_error(METRICS_ERROR_IO);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Rozhodne, či spojenie môže po tejto požiadavke zostať otvorené.
+ *
+ * HTTP/1.1 je predvolene perzistentné, pokiaľ klient nepošle
+ * `Connection: close`; HTTP/1.0 len pri explicitnom `Connection: keep-alive`.
+ */
+static int connection_wants_keep_alive(const Connection *conn) {
+    const HttpRequest *request = &conn->request;
+    if (conn->peer_closed) return 0;
+    if (conn->worker->draining) return 0;
+    if (conn->requests_served >= server_config.keepalive_max_requests) return 0;
+    if (request->version_minor == 0) {
+        return http_slice_has_token(request->connection, "keep-alive");
+    }
+    return !http_slice_has_token(request->connection, "close");
+}
+
+/**
+ * @brief Odovzdá kompletnú požiadavku handleru a odstráni ju zo vstupu.
+ */
+static void connection_dispatch(Connection *conn) {
+    HttpRequest *request = &conn->request;
+    char *start = conn->in.data + conn->in_start;
+    char *body = start + request->header_length;
+    // Chunked telo je už dekódované na mieste a `body_length` nastavil dekodér.
+    size_t body_consumed = request->chunked ? request->body_received : request->content_length;
+    request->body = body;
+    if (!request->chunked) {
+        request->body_length = request->content_length;
+    }
+
+    // Telo sa dočasne ukončí nulou, aby sa s ním dalo pracovať ako s reťazcom;
+    // za ním môže nasledovať ďalšia zreťazená požiadavka.
+    char saved = body[request->body_length];
+    body[request->body_length] = '\0';
+
+    conn->requests_served++;
+    conn->keep_alive = connection_wants_keep_alive(conn);
+    conn->response_status = 0;
+    size_t pending_before = conn->out_pending;
+    uint64_t started = metrics_now_ns();
+    handle_request(conn, request);
+    // Streamovaná odpoveď drží miesto, kým ju producent nedokončí.
+    if (!conn->producer) connection_release_admission(conn);
+    uint64_t elapsed = metrics_now_ns() - started;
+    metrics_add(METRICS_REQUESTS, 1);
+    metrics_record_route(request_route(request), elapsed);
+    metrics_record_phase(METRICS_PHASE_COMPUTE, elapsed);
+    metrics_record_phase(METRICS_PHASE_PARSE, conn->parse_ns);
+
+    // Záznam do access logu: len metóda, cesta a čísla, nikdy telo.
+    AccessLogEntry entry;
+    entry.method = request->method;
+    entry.path = request->path;
+    entry.status = conn->response_status;
+    entry.duration_ns = elapsed;
+    entry.parse_ns = conn->parse_ns;
+    entry.bytes_in = request->header_length + body_consumed;
+    entry.bytes_out = conn->out_pending - pending_before;
+    entry.request_number = conn->requests_served;
+    access_log_request(&entry);
+    conn->parse_ns = 0;
+    body[request->body_length] = saved;
+
+    if (!conn->keep_alive) {
+        conn->close_after_write = 1;
+    }
+
+    conn->in_start += request->header_length + body_consumed;
+    conn->state = CONN_READING_HEADERS;
+    http_request_init(request);
+}
+
+/**
+ * @brief Spracuje všetky kompletné požiadavky vo vstupnom bufferi.
+ *
+ * Zreťazené požiadavky sa vybavujú v poradí, v akom prišli, a ich odpovede
+ * sa skladajú za seba do výstupného buffera. Spracovanie sa preruší, ak
+ * odpovede čakajúce na odoslanie presiahnu OUTPUT_HIGH_WATER alebo kým
+ * sa streamuje odpoveď na predchádzajúcu požiadavku.
+ *
+ * @return 1 ak má spojenie pokračovať, 0 ak sa má okamžite zavrieť.
+ */
+static int connection_process(Connection *conn) {
+    HttpRequest *request = &conn->request;
+
+    if (conn->protocol == CONNECTION_BINARY) {
+        return binary_protocol_process(conn);
+    }
+
+    while (!conn->close_after_write && !conn->producer && conn->out_pending < OUTPUT_HIGH_WATER) {
+        const char *start = conn->in.data + conn->in_start;
+        size_t available = conn->in.length - conn->in_start;
+
+        if (conn->state == CONN_READING_HEADERS) {
+            if (available == 0) break;
+
+            uint64_t parse_started = metrics_now_ns();
+            HttpParseResult parsed = http_parse_request(start, available, request);
+            conn->parse_ns += metrics_now_ns() - parse_started;
+            switch (parsed) {
+            case HTTP_PARSE_INCOMPLETE:
+                return 1;
+            case HTTP_PARSE_ERROR:
+                connection_fail(conn, 400, "Bad Request");
+                return 1;
+            case HTTP_PARSE_TOO_LARGE:
+                connection_fail(conn, 431, "Request Header Fields Too Large");
+                return 1;
+            case HTTP_PARSE_DONE:
+                break;
+            }
+
+            conn->body_limit = request_body_limit(request);
+            if (request->content_length > conn->body_limit) {
+                connection_fail(conn, 413, "Payload Too Large");
+                return 1;
+            }
+
+            // Prijatie požiadavky sa rozhodne pred čítaním tela; metriky
+            // ostávajú dostupné aj pri preťažení.
+            if (request_route(request) != METRICS_ROUTE_METRICS) {
+                int retry_after = 0;
+                if (admission_acquire(conn->client_address, &retry_after) != ADMISSION_ACCEPTED) {
+                    connection_shed(conn, retry_after);
+                    return 1;
+                }
+                conn->admitted = 1;
+            }
+
+            conn->state = CONN_READING_BODY;
+
+            // Klient (napr. curl pri väčšom tele) čaká na povolenie poslať telo.
+            // Medziodpoveď ide do výstupu za odpovede predchádzajúcich zreťazených
+            // požiadaviek a odošle sa bežným connection_flush().
+            int body_missing = request->chunked ? available == request->header_length
+                                                : available < request->header_length + request->content_length;
+            if (request->expect_continue && body_missing) {
+                static const char continue_response[] = "HTTP/1.1 100 Continue\r\n\r\n";
+                if (!connection_send(conn, continue_response, sizeof(continue_response) - 1)) return 0;
+            }
+        }
+
+        if (request->chunked) {
+            char *body = conn->in.data + conn->in_start + request->header_length;
+            uint64_t decode_started = metrics_now_ns();
+            HttpParseResult decoded = http_decode_chunked(body, available - request->header_length,
+                                                          conn->body_limit, request);
+            conn->parse_ns += metrics_now_ns() - decode_started;
+            switch (decoded) {
+            case HTTP_PARSE_INCOMPLETE:
+                return 1;
+            case HTTP_PARSE_ERROR:
+                connection_fail(conn, 400, "Bad Request");
+                return 1;
+            case HTTP_PARSE_TOO_LARGE:
+                connection_fail(conn, 413, "Payload Too Large");
+                return 1;
+            case HTTP_PARSE_DONE:
+                break;
+            }
+        } else if (available < request->header_length + request->content_length) {
+            return 1;
+        }
+        connection_dispatch(conn);
+    }
+    return 1;
+}
+
+/**
+ * @brief Nechá producenta streamovanej odpovede doplniť výstup po OUTPUT_HIGH_WATER.
+ *
+ * @return 1 ak je spojenie v poriadku, 0 pri chybe producenta.
+ */
+static int connection_produce(Connection *conn) {
+    while (conn->producer && !conn->suspended && conn->out_pending < OUTPUT_HIGH_WATER) {
+        int result = conn->producer(conn, conn->producer_state);
+        if (result < 0) return 0;
+        if (result == 0) {
+            // Až dokončený stream uvoľní miesto požiadavky (connection_process()).
+            connection_end_stream(conn);
+            connection_release_admission(conn);
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Odstráni spracované požiadavky zo začiatku vstupného buffera.
+ */
+static void connection_compact_input(Connection *conn) {
+    if (conn->in_start == 0) return;
+
+    const char *old_base = conn->in.data;
+    buffer_consume(&conn->in, conn->in_start);
+    if (conn->state == CONN_READING_BODY) {
+        http_request_rebase(&conn->request, old_base + conn->in_start, conn->in.data);
+    }
+    conn->in_start = 0;
+}
+
+/**
+ * @brief Odošle čo najviac z pripravených odpovedí.
+ *
+ * Všetky čakajúce úseky (hlavičky, telá, dáta zo statickej cache) sa
+ * odovzdajú jadru jedným volaním `sendmsg()` bez predchádzajúceho kopírovania.
+ *
+ * @return 1 ak je spojenie v poriadku, 0 pri chybe zápisu.
+ */
+static int connection_flush(Connection *conn) {
+    if (conn->segment_head < conn->segment_count && conn->write_start_ns == 0) {
+        conn->write_start_ns = metrics_now_ns();
+    }
+    while (conn->segment_head < conn->segment_count) {
+        struct iovec iov[MAX_OUTPUT_SEGMENTS];
+        int iov_count = 0;
+
+        for (int i = conn->segment_head; i < conn->segment_count; i++) {
+            const OutputSegment *segment = &conn->segments[i];
+            const char *base = segment->data ? segment->data : conn->out.data + segment->offset;
+            size_t skip = i == conn->segment_head ? conn->segment_sent : 0;
+            iov[iov_count].iov_base = (void *)(base + skip);
+            iov[iov_count].iov_len = segment->length - skip;
+            iov_count++;
+        }
+
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = iov;
+        message.msg_iovlen = (size_t)iov_count;
+
+        ssize_t sent = sendmsg(conn->fd, &message, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            // Pri EAGAIN sa pokračuje po ďalšej udalosti EPOLLOUT.
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 1;
+            metrics_error(METRICS_ERROR_IO);
+            return 0;
+        }
+        metrics_add(METRICS_BYTES_SENT, (uint64_t)sent);
+
+        // Posun za odoslané bajty, ktoré môžu pokryť viac úsekov.
+        size_t remaining = (size_t)sent;
+        conn->out_pending -= remaining;
+        while (remaining > 0) {
+            const OutputSegment *segment = &conn->segments[conn->segment_head];
+            size_t left = segment->length - conn->segment_sent;
+            if (remaining < left) {
+                conn->segment_sent += remaining;
+                break;
+            }
+            remaining -= left;
+            conn->segment_head++;
+            conn->segment_sent = 0;
+        }
+        connection_arm_timer(conn, TIMER_PHASE_WRITE, 1);
+    }
+
+    if (conn->write_start_ns) {
+        metrics_record_phase(METRICS_PHASE_WRITE, metrics_now_ns() - conn->write_start_ns);
+        conn->write_start_ns = 0;
+    }
+    buffer_reset(&conn->out);
+    conn->segment_count = 0;
+    conn->segment_head = 0;
+    conn->segment_sent = 0;
+    conn->out_pending = 0;
+    connection_unpin(conn);
+    return 1;
+}
+
+/**
+ * @brief Posúva stavový automat spojenia, kým je čo čítať, spracovať a odoslať.
+ *
+ * @return 1 ak má spojenie zostať otvorené, 0 ak sa má zavrieť.
+ */
+static int connection_run(Connection *conn) {
+    int stream_rounds = 0;
+
+    while (1) {
+        size_t consumed_before = conn->in_start;
+        int streamed = conn->producer != NULL;
+
+        if (conn->readable && !conn->close_after_write && !connection_read(conn)) return 0;
+        if (!connection_process(conn)) return 0;
+        if (!connection_produce(conn)) return 0;
+        if (!connection_flush(conn)) return 0;
+
+        int made_progress = conn->in_start != consumed_before || streamed;
+        connection_compact_input(conn);
+
+        if (conn->out_pending > 0) {
+            // Čaká sa na EPOLLOUT; limit zápisu nastavil connection_flush().
+            connection_arm_timer(conn, TIMER_PHASE_WRITE, 0);
+            return 1;
+        }
+        if (conn->suspended) {
+            // Pokračuje sa až po connection_resume(); dovtedy platí limit zápisu.
+            connection_arm_timer(conn, TIMER_PHASE_WRITE, 0);
+            return 1;
+        }
+        if (conn->producer) {
+            // Klient stíha čítať: po niekoľkých kolách sa stream odloží,
+            // aby jeden dlhý stream nezablokoval ostatné spojenia vlákna.
+            if (++stream_rounds < STREAM_ROUNDS_PER_RUN) continue;
+            connection_defer(conn);
+            connection_arm_timer(conn, TIMER_PHASE_WRITE, 0);
+            return 1;
+        }
+        if (conn->close_after_write) return 0;
+
+        // Výstup je prázdny: ak spracovanie stálo kvôli limitom buffera
+        // a medzitým sa pohlo, pokračuje sa ďalšími požiadavkami.
+        if (made_progress && (conn->readable || conn->in.length > 0)) continue;
+        break;
+    }
+
+    if (conn->peer_closed) return 0;
+
+    if (conn->state == CONN_READING_BODY) {
+        connection_arm_timer(conn, TIMER_PHASE_BODY, 0);
+    } else if (conn->in.length > 0) {
+        connection_arm_timer(conn, TIMER_PHASE_HEADERS, 0);
+    } else {
+        connection_arm_timer(conn, TIMER_PHASE_IDLE, 0);
+    }
+    return 1;
+}
+
+void connection_handle_events(Connection *conn, uint32_t events) {
+    if (events & EPOLLERR) {
+        metrics_error(METRICS_ERROR_IO);
+        connection_close(conn);
+        return;
+    }
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+        conn->readable = 1;
+    }
+    if (!connection_run(conn)) {
+        connection_close(conn);
+    }
+}
+
+void connection_run_ready(Worker *worker) {
+    // Spojenia odložené počas tohto prechodu prídu na rad až v ďalšej iterácii.
+    size_t count = worker->ready_count;
+    while (count-- > 0 && worker->ready_head) {
+        Connection *conn = worker->ready_head;
+        connection_unready(conn);
+        if (!connection_run(conn)) {
+            connection_close(conn);
+        }
+    }
+}
+
+void connection_on_resume(Connection *conn) {
+    conn->suspended = 0;
+    if (conn->close_pending) {
+        connection_close(conn);
+        return;
+    }
+    connection_defer(conn);
+}
+
+/**
+ * @brief Skráti limit nečinnosti keep-alive spojenia pri ukončovaní vlákna.
+ *
+ * Spojenie sa nezavrie hneď: klient mohol ďalšiu požiadavku práve odoslať.
+ * Ak príde do DRAIN_IDLE_TIMEOUT_MS, vybaví sa s `Connection: close`.
+ */
+static void connection_shorten_idle(TimerNode *node) {
+    Connection *conn = (Connection *)((char *)node - offsetof(Connection, timer));
+    if (conn->timer_phase == TIMER_PHASE_IDLE) {
+        connection_arm_timer(conn, TIMER_PHASE_IDLE, 1);
+    }
+}
+
+void connection_drain(Worker *worker) {
+    timer_wheel_visit(&worker->timers, connection_shorten_idle);
+}
+
+void connection_on_timeout(TimerNode *node) {
+    Connection *conn = (Connection *)((char *)node - offsetof(Connection, timer));
+
+    // Klientovi, ktorý začal posielať požiadavku, dáme vedieť, prečo končíme.
+    if (conn->protocol == CONNECTION_HTTP &&
+        (conn->timer_phase == TIMER_PHASE_HEADERS || conn->timer_phase == TIMER_PHASE_BODY)) {
+        static const char timeout_response[] =
+            "HTTP/1.1 408 Request Timeout\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        send(conn->fd, timeout_response, sizeof(timeout_response) - 1, MSG_NOSIGNAL);
+        metrics_error(METRICS_ERROR_TIMEOUT);
+        AccessLogEntry entry = {0};
+        entry.status = 408;
+        entry.bytes_in = conn->in.length - conn->in_start;
+        entry.bytes_out = sizeof(timeout_response) - 1;
+        entry.request_number = conn->requests_served + 1;
+        access_log_request(&entry);
+    }
+    connection_close(conn);
+}
+
+const char *connection_header(const Connection *conn) {
+    return conn->keep_alive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+}
+
+/**
+ * @brief Zapamätá si stavový kód, ak `data` sú začiatkom prvej odpovede handlera.
+ */
+static void connection_note_status(Connection *conn, const char *data, size_t length) {
+    if (conn->response_status != 0 || length < 12 || memcmp(data, "HTTP/1.", 7) != 0) return;
+    conn->response_status = (data[9] - '0') * 100 + (data[10] - '0') * 10 + (data[11] - '0');
+}
+
+/**
+ * @brief Zaregistruje bajty pridané do buffera `out` od pozície `old_length`.
+ *
+ * Ak posledný úsek z buffera `out` končí na `old_length`, len sa predĺži;
+ * inak vznikne nový.
+ * Posledný voľný úsek je vždy rezervovaný pre dáta z buffera, preto sa
+ * sem vždy zmestia.
+ */
+static void connection_commit(Connection *conn, size_t old_length) {
+    size_t length = conn->out.length - old_length;
+    if (length == 0) return;
+    connection_note_status(conn, conn->out.data + old_length, length);
+
+    OutputSegment *last = conn->segment_count > conn->segment_head
+                              ? &conn->segments[conn->segment_count - 1] : NULL;
+    if (last && !last->data && last->offset + last->length == old_length) {
+        last->length += length;
+    } else {
+        OutputSegment *segment = &conn->segments[conn->segment_count++];
+        segment->data = NULL;
+        segment->offset = old_length;
+        segment->length = length;
+    }
+    conn->out_pending += length;
+}
+
+int connection_send(Connection *conn, const void *data, size_t length) {
+    size_t old_length = conn->out.length;
+    if (!buffer_append(&conn->out, data, length)) return 0;
+    connection_commit(conn, old_length);
+    return 1;
+}
+
+int connection_sendf(Connection *conn, const char *format, ...) {
+    size_t old_length = conn->out.length;
+    va_list args;
+
+    if (!buffer_reserve(&conn->out, 256)) return 0;
+    size_t available = conn->out.capacity - conn->out.length + 1;
+    va_start(args, format);
+    int needed = vsnprintf(conn->out.data + conn->out.length, available, format, args);
+    va_end(args);
+    if (needed < 0) return 0;
+
+    if ((size_t)needed >= available) {
+        if (!buffer_reserve(&conn->out, (size_t)needed)) return 0;
+        va_start(args, format);
+        vsnprintf(conn->out.data + conn->out.length, (size_t)needed + 1, format, args);
+        va_end(args);
+    }
+    conn->out.length += (size_t)needed;
+    connection_commit(conn, old_length);
+    return 1;
+}
+
+int connection_send_static(Connection *conn, const void *data, size_t length) {
+    if (length == 0) return 1;
+    if (conn->segment_count >= MAX_OUTPUT_SEGMENTS - 1) {
+        return connection_send(conn, data, length);
+    }
+
+    connection_note_status(conn, (const char *)data, length);
+    OutputSegment *segment = &conn->segments[conn->segment_count++];
+    segment->data = (const char *)data;
+    segment->offset = 0;
+    segment->length = length;
+    conn->out_pending += length;
+    return 1;
+}
+
+Buffer *connection_begin_body(Connection *conn) {
+    conn->body_start = conn->out.length;
+    return &conn->out;
+}
+
+/**
+ * @brief Zapíše desiatkové číslo bez printf.
+ *
+ * @return Počet zapísaných znakov (najviac 20).
+ */
+static size_t format_size(char *out, size_t value) {
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+int connection_end_body(Connection *conn, const char *head, size_t head_length) {
+    size_t body_start = conn->body_start;
+    size_t body_length = conn->out.length - body_start;
+
+    // Doplnok hlavičiek: hodnota Content-Length, hlavička Connection a prázdny riadok.
+    const char *connection = connection_header(conn);
+    size_t connection_length = strlen(connection);
+    char tail[64];
+    size_t tail_length = format_size(tail, body_length);
+    memcpy(tail + tail_length, "\r\n", 2);
+    tail_length += 2;
+    memcpy(tail + tail_length, connection, connection_length);
+    tail_length += connection_length;
+    memcpy(tail + tail_length, "\r\n", 2);
+    tail_length += 2;
+
+    // Tri úseky a jeden voľný, ktorý zostáva rezervovaný pre dáta z buffera.
+    if (conn->segment_count + 4 <= MAX_OUTPUT_SEGMENTS) {
+        // Telo ostáva tam, kde ho handler zapísal; doplnok sa pridá za neho
+        // a úseky sa zaradia v poradí hlavička, doplnok, telo.
+        size_t tail_offset = conn->out.length;
+        if (!buffer_append(&conn->out, tail, tail_length)) {
+            connection_cancel_body(conn);
+            return 0;
+        }
+        connection_note_status(conn, head, head_length);
+        OutputSegment *segment = &conn->segments[conn->segment_count++];
+        segment->data = head;
+        segment->offset = 0;
+        segment->length = head_length;
+        segment = &conn->segments[conn->segment_count++];
+        segment->data = NULL;
+        segment->offset = tail_offset;
+        segment->length = tail_length;
+        if (body_length > 0) {
+            segment = &conn->segments[conn->segment_count++];
+            segment->data = NULL;
+            segment->offset = body_start;
+            segment->length = body_length;
+        }
+        conn->out_pending += head_length + tail_length + body_length;
+        return 1;
+    }
+
+    // Málo voľných úsekov (veľa zreťazených odpovedí čaká): hlavičky sa
+    // vložia do buffera pred telo.
+    size_t prefix = head_length + tail_length;
+    if (!buffer_reserve(&conn->out, prefix)) {
+        connection_cancel_body(conn);
+        return 0;
+    }
+    char *body = conn->out.data + body_start;
+    memmove(body + prefix, body, body_length);
+    memcpy(body, head, head_length);
+    memcpy(body + head_length, tail, tail_length);
+    conn->out.length += prefix;
+    conn->out.data[conn->out.length] = '\0';
+    connection_commit(conn, body_start);
+    return 1;
+}
+
+void connection_end_raw_body(Connection *conn) {
+    connection_commit(conn, conn->body_start);
+}
+
+void connection_cancel_body(Connection *conn) {
+    conn->out.length = conn->body_start;
+    if (conn->out.data) conn->out.data[conn->out.length] = '\0';
+}
+
+void connection_stream(Connection *conn, ConnectionProducer producer, void *state,
+                       void (*destroy)(void *state)) {
+    connection_end_stream(conn);
+    conn->producer = producer;
+    conn->producer_state = state;
+    conn->producer_destroy = destroy;
+}
+
+void connection_suspend(Connection *conn) {
+    conn->suspended = 1;
+}
+
+void connection_resume(Connection *conn) {
+    thread_pool_resume(conn->worker, conn);
+}
+
+int connection_send_chunk(Connection *conn, const void *data, size_t length) {
+    if (length == 0) {
+        return connection_send(conn, "0\r\n\r\n", 5);
+    }
+    return connection_sendf(conn, "%zx\r\n", length) &&
+           connection_send(conn, data, length) &&
+           connection_send(conn, "\r\n", 2);
+}
+
+int connection_pin(Connection *conn, void *object, void (*release)(void *object)) {
+    if (conn->pinned == object) {
+        // Spojenie už referenciu drží, druhá nie je potrebná.
+        release(object);
+        return 1;
+    }
+    if (conn->pinned) return 0;
+
+    conn->pinned = object;
+    conn->pinned_release = release;
+    return 1;
+}
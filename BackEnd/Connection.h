@@ -0,0 +1,289 @@
+#ifndef CONNECTION_H
+#define CONNECTION_H
+
+#include <stdint.h>
+#include "Buffer.h"
+#include "HttpParser.h"
+#include "TimerWheel.h"
+
+// Časový limit na prijatie kompletných hlavičiek od otvorenia spojenia
+#define HEADER_TIMEOUT_MS 10000
+// Časový limit nečinnosti počas prijímania tela požiadavky
+#define BODY_TIMEOUT_MS 10000
+// Časový limit nečinnosti počas odosielania odpovede
+#define WRITE_TIMEOUT_MS 30000
+// Predvolený čas, počas ktorého môže nečinné keep-alive spojenie zostať otvorené
+#define DEFAULT_KEEPALIVE_TIMEOUT_MS 5000
+// Predvolený maximálny počet požiadaviek na jednom spojení
+#define DEFAULT_KEEPALIVE_MAX_REQUESTS 1000
+// Limit nečinnosti keep-alive spojenia, keď proces končí (connection_drain())
+#define DRAIN_IDLE_TIMEOUT_MS 1000
+// Ak čaká na odoslanie viac bajtov, ďalšie zreťazené požiadavky sa
+// nespracúvajú, kým klient odpovede neprečíta
+#define OUTPUT_HIGH_WATER (256 * 1024)
+// Predvolená maximálna veľkosť tela jednej požiadavky (pozri request_body_limit())
+#define MAX_BODY_SIZE (1024 * 1024)
+// Minimálne voľné miesto vo vstupnom bufferi pred každým čítaním
+#define READ_CHUNK_SIZE 4096
+// Maximálny počet úsekov odpovedí odoslaných jedným volaním writev()/sendmsg()
+#define MAX_OUTPUT_SEGMENTS 64
+// Koľkokrát za sebou môže streamovaná odpoveď naplniť a odoslať výstup,
+// kým event loop obslúži ostatné spojenia
+#define STREAM_ROUNDS_PER_RUN 2
+
+struct Worker;
+struct Connection;
+
+/**
+ * @brief Producent streamovanej odpovede.
+ *
+ * Volá sa opakovane, kým je vo výstupe spojenia miesto (menej ako
+ * OUTPUT_HIGH_WATER čakajúcich bajtov). Pri každom volaní pripojí ďalšiu
+ * časť odpovede, napr. cez `connection_send_chunk()`.
+ *
+ * @return 1 ak bude produkovať ďalej, 0 ak je odpoveď kompletná, -1 pri chybe
+ *         (spojenie sa zavrie).
+ */
+typedef int (*ConnectionProducer)(struct Connection *conn, void *state);
+
+// Protokol spojenia podľa počúvajúceho socketu, ktorý ho prijal.
+typedef enum {
+    CONNECTION_HTTP,        // HTTP/1.x na TCP porte.
+    CONNECTION_BINARY       // Binárne rámce na Unix sockete (BinaryProtocol.h).
+} ConnectionProtocol;
+
+// Stav parsovania aktuálnej požiadavky.
+typedef enum {
+    CONN_READING_HEADERS,   // Čaká sa na kompletné hlavičky.
+    CONN_READING_BODY       // Hlavičky sú naparsované, čaká sa na telo.
+} ConnectionState;
+
+// Fáza spojenia, podľa ktorej sa vyberá časový limit.
+typedef enum {
+    TIMER_PHASE_NONE,
+    TIMER_PHASE_HEADERS,    // Prijímajú sa hlavičky (limit od prvého bajtu).
+    TIMER_PHASE_BODY,       // Prijíma sa telo (limit od posledného pokroku).
+    TIMER_PHASE_WRITE,      // Odosiela sa odpoveď (limit od posledného pokroku).
+    TIMER_PHASE_IDLE        // Keep-alive spojenie čaká na ďalšiu požiadavku.
+} TimerPhase;
+
+// Úsek odpovede čakajúci na odoslanie. Buď ukazuje do buffera `out`
+// spojenia, alebo na externé nemenné dáta (konštanty, statická cache),
+// ktoré sa nekopírujú.
+typedef struct {
+    const char *data;        // Externé dáta alebo NULL pre úsek buffera `out`.
+    size_t offset;           // Začiatok úseku v `out` (ak `data` je NULL).
+    size_t length;
+} OutputSegment;
+
+// Jedno klientske spojenie obsluhované event loopom pracovného vlákna.
+typedef struct Connection {
+    TimerNode timer;         // Časovač aktuálnej fázy (hlavičky/telo/zápis/nečinnosť).
+    TimerPhase timer_phase;
+    int fd;                  // Neblokujúci socket klienta.
+    ConnectionProtocol protocol;
+    uint32_t client_address; // IPv4 adresa klienta pre limity (0 = nezistená).
+    ConnectionState state;
+    Buffer in;               // Prijaté dáta; môžu obsahovať viac zreťazených požiadaviek.
+    size_t in_start;         // Začiatok aktuálnej požiadavky v `in`.
+    size_t body_limit;       // Maximálna veľkosť tela aktuálnej požiadavky.
+    Buffer out;              // Dáta odpovedí skopírované handlerom.
+    size_t body_start;       // Začiatok tela rozpracovanej odpovede v `out` (connection_begin_body()).
+    OutputSegment segments[MAX_OUTPUT_SEGMENTS]; // Odpovede v poradí požiadaviek.
+    int segment_count;       // Počet platných úsekov.
+    int segment_head;        // Prvý ešte neodoslaný úsek.
+    size_t segment_sent;     // Koľko bajtov z prvého úseku už bolo odoslaných.
+    size_t out_pending;      // Celkový počet bajtov čakajúcich na odoslanie.
+    void *pinned;            // Objekt, do ktorého ukazujú externé úseky.
+    void (*pinned_release)(void *pinned); // Uvoľnenie `pinned` po odoslaní.
+    ConnectionProducer producer;          // Aktívny producent streamovanej odpovede.
+    void *producer_state;
+    void (*producer_destroy)(void *state);
+    struct Connection *ready_prev;        // Zoznam spojení, ktoré chcú pokračovať
+    struct Connection *ready_next;        // v ďalšej iterácii event loopu.
+    int ready_queued;
+    int suspended;           // Producent čaká na prácu iného vlákna (connection_suspend()).
+    int close_pending;       // Spojenie sa zavrelo počas pozastavenia, uvoľní sa po obnovení.
+    struct Connection *resume_next;       // Zoznam obnovených spojení vlákna (Worker.resumed).
+    HttpRequest request;     // Práve spracovávaná požiadavka.
+    int readable;            // Socket môže mať ďalšie dáta (edge-triggered epoll).
+    int peer_closed;         // Klient zavrel svoju stranu spojenia.
+    int keep_alive;          // Spojenie zostane otvorené po aktuálnej odpovedi.
+    int close_after_write;   // Po odoslaní odpovedí sa spojenie zavrie.
+    int requests_served;     // Počet požiadaviek spracovaných na tomto spojení.
+    int admitted;            // Požiadavka drží miesto v limite rozpracovaných (admission_acquire()).
+    int response_status;     // Stavový kód odpovede aktuálnej požiadavky (pre access log).
+    uint64_t parse_ns;       // Čas parsovania aktuálnej požiadavky (pre metriky).
+    uint64_t write_start_ns; // Začiatok odosielania čakajúcich odpovedí (0 = nič nečaká).
+    struct Worker *worker;   // Vlákno, ktoré spojenie vlastní.
+} Connection;
+
+/**
+ * @brief Vytvorí spojenie pre prijatý socket a zaregistruje ho v epolle vlákna.
+ *
+ * @param worker Pracovné vlákno, ktoré bude spojenie obsluhovať.
+ * @param fd Neblokujúci socket klienta.
+ * @param protocol Protokol podľa socketu, na ktorom bolo spojenie prijaté.
+ * @return Nové spojenie alebo NULL pri chybe (socket ostáva otvorený).
+ */
+Connection *connection_open(struct Worker *worker, int fd, ConnectionProtocol protocol);
+
+/**
+ * @brief Spracuje udalosti z epollu: číta, parsuje, volá `handle_request()`
+ *        pre každú kompletnú (aj zreťazenú) požiadavku a odosiela odpovede.
+ *        Po návrate môže byť spojenie už uvoľnené.
+ *
+ * @param conn Spojenie.
+ * @param events Maska udalostí z `epoll_wait()`.
+ */
+void connection_handle_events(Connection *conn, uint32_t events);
+
+/**
+ * @brief Obslúži spojenia odložené v predchádzajúcej iterácii event loopu
+ *        (napr. dlhé streamované odpovede, ktoré uvoľnili vlákno iným).
+ */
+void connection_run_ready(struct Worker *worker);
+
+/**
+ * @brief Pokračuje v spojení, ktoré iné vlákno vrátilo cez `connection_resume()`.
+ *
+ * Volá ho event loop vlákna, ktoré spojenie vlastní. Ak sa spojenie medzitým
+ * zavrelo, až teraz sa uvoľní.
+ */
+void connection_on_resume(Connection *conn);
+
+/**
+ * @brief Callback časového kolesa: spojenie prekročilo časový limit a zavrie sa.
+ */
+void connection_on_timeout(TimerNode *node);
+
+/**
+ * @brief Začne ukončovanie spojení vlákna.
+ *
+ * Ďalšia odpoveď na každom spojení už nesie `Connection: close`; nečinné
+ * keep-alive spojenia sa zavrú po DRAIN_IDLE_TIMEOUT_MS.
+ */
+void connection_drain(struct Worker *worker);
+
+/**
+ * @brief Vráti hlavičku `Connection` (vrátane CRLF) pre aktuálnu odpoveď.
+ *
+ * Handler ju vkladá do každej odpovede, aby klient vedel, či spojenie
+ * zostane otvorené.
+ */
+const char *connection_header(const Connection *conn);
+
+/**
+ * @brief Pripojí kópiu dát na koniec odpovede; odošlú sa, keď handler skončí.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int connection_send(Connection *conn, const void *data, size_t length);
+
+/**
+ * @brief Pripojí na koniec odpovede text naformátovaný ako pri `printf`.
+ *
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int connection_sendf(Connection *conn, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Pripojí na koniec odpovede externé dáta bez kopírovania.
+ *
+ * Dáta musia zostať platné, kým sa neodošlú: buď sú to konštanty,
+ * alebo patria objektu pripnutému cez `connection_pin()`. Ak už nie je
+ * voľný úsek, dáta sa skopírujú.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int connection_send_static(Connection *conn, const void *data, size_t length);
+
+/**
+ * @brief Začne odpoveď, ktorej telo handler zapíše priamo do výstupného buffera.
+ *
+ * Telo sa nekopíruje: handler ho pripája do vráteného buffera (napr. cez
+ * `json_append_string()`) a `connection_end_body()` pred neho zaradí hlavičky.
+ * Medzi týmito volaniami sa nesmú volať iné funkcie `connection_send*()`.
+ *
+ * @return Buffer, na ktorého koniec sa zapisuje telo.
+ */
+Buffer *connection_begin_body(Connection *conn);
+
+/**
+ * @brief Dokončí odpoveď začatú `connection_begin_body()`.
+ *
+ * `head` je konštantný začiatok hlavičiek končiaci textom "Content-Length: ";
+ * neskopíruje sa. Spojenie doplní dĺžku tela a hlavičku `Connection`, takže
+ * hlavička, jej doplnok a telo sa odošlú ako tri úseky jedným `sendmsg()`.
+ *
+ * @param head Konštantný začiatok hlavičiek (musí zostať platný).
+ * @param head_length Dĺžka `head`.
+ * @return 1 pri úspechu, 0 pri chybe alokácie (odpoveď sa zahodí).
+ */
+int connection_end_body(Connection *conn, const char *head, size_t head_length);
+
+/**
+ * @brief Dokončí odpoveď začatú `connection_begin_body()` bez HTTP hlavičiek.
+ *
+ * Odošle sa presne to, čo handler zapísal (napr. rámec binárneho protokolu).
+ */
+void connection_end_raw_body(Connection *conn);
+
+/**
+ * @brief Zahodí telo rozpracované od `connection_begin_body()`.
+ */
+void connection_cancel_body(Connection *conn);
+
+/**
+ * @brief Začne streamovať odpoveď po častiach.
+ *
+ * Hlavičky odpovede musí handler odoslať sám ešte pred týmto volaním.
+ * Spojenie potom volá `producer`, vždy keď klient prečíta dosť dát, takže
+ * celá odpoveď nikdy nemusí byť v pamäti naraz. Kým stream beží, ďalšie
+ * zreťazené požiadavky čakajú. Po skončení (alebo zatvorení spojenia) sa
+ * zavolá `destroy(state)`.
+ */
+void connection_stream(Connection *conn, ConnectionProducer producer, void *state,
+                       void (*destroy)(void *state));
+
+/**
+ * @brief Pozastaví streamovanú odpoveď, kým na nej pracuje iné vlákno.
+ *
+ * Volá sa po `connection_stream()`, keď handler odovzdal výpočet napr.
+ * výpočtovému poolu. Producent sa dovtedy nevolá a vlákno obsluhuje ostatné
+ * spojenia. Spojenie ani stav producenta sa neuvoľnia, kým práca neskončí
+ * a niekto nezavolá `connection_resume()`, ani keď sa klient medzitým odpojí.
+ */
+void connection_suspend(Connection *conn);
+
+/**
+ * @brief Ukončí pozastavenie zo `connection_suspend()`.
+ *
+ * Dá sa volať z ľubovoľného vlákna; producent pokračuje v ďalšej iterácii
+ * event loopu vlákna, ktoré spojenie vlastní.
+ */
+void connection_resume(Connection *conn);
+
+/**
+ * @brief Pripojí jeden chunk odpovede v kódovaní `Transfer-Encoding: chunked`.
+ *
+ * Prázdne dáta (`length` 0) znamenajú záverečný chunk.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int connection_send_chunk(Connection *conn, const void *data, size_t length);
+
+/**
+ * @brief Pripne objekt, na ktorého dáta budú ukazovať externé úseky odpovede.
+ *
+ * Spojenie prevezme jednu referenciu na objekt a uvoľní ju funkciou
+ * `release`, keď sa odošle všetko čakajúce. Naraz môže byť pripnutý len
+ * jeden objekt; ak je pripnutý iný, funkcia vráti 0 a volajúci má dáta
+ * kopírovať a referenciu uvoľniť sám.
+ *
+ * @return 1 ak spojenie referenciu prevzalo, inak 0.
+ */
+int connection_pin(Connection *conn, void *object, void (*release)(void *object));
+
+#endif // CONNECTION_H
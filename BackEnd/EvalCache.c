@@ -0,0 +1,204 @@
+#include "EvalCache.h"
+#include "Metrics.h"
+#include "../Logic/Random.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Záznam má 40 bajtov: kľúč, platnosť a výsledok vyhodnotenia (bez textu
+// spätnej väzby, ten sa zostaví z dôvodov), takže množina zaberie päť cache line.
+typedef struct {
+    uint64_t high;               // Kľúč (SipHash); heslo sa neukladá.
+    uint64_t low;
+    uint64_t expires_ns;         // 0 = voľný záznam.
+    double guesses_log10;
+    uint32_t reasons;            // PASSWORD_REASON_*.
+    uint8_t score;
+    uint8_t is_strong;
+    uint8_t referenced;          // Bit CLOCK: použitý od posledného obehu ručičky.
+    uint8_t reserved;
+} EvalCacheEntry;
+
+// Shard: vlastný zámok nad svojimi množinami, zarovnaný na cache line,
+// aby sa zámky susedných shardov neprebíjali.
+typedef struct {
+    pthread_mutex_t lock;
+    EvalCacheEntry *entries;     // sets * EVAL_CACHE_WAYS záznamov.
+    uint8_t *hands;              // Ručička CLOCK pre každú množinu.
+} __attribute__((aligned(64))) EvalCacheShard;
+
+static EvalCacheShard eval_shards[EVAL_CACHE_SHARDS];
+static uint64_t eval_secret[2];
+static uint64_t eval_set_mask;   // Počet množín v sharde - 1 (mocnina 2).
+static uint64_t eval_ttl_ns;
+static int eval_enabled;
+
+// --- SipHash-2-4 so 128-bitovým výstupom ---
+
+#define ROTL64(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+#define SIPROUND                                                          \
+    do {                                                                  \
+        v0 += v1; v1 = ROTL64(v1, 13); v1 ^= v0; v0 = ROTL64(v0, 32);     \
+        v2 += v3; v3 = ROTL64(v3, 16); v3 ^= v2;                          \
+        v0 += v3; v3 = ROTL64(v3, 21); v3 ^= v0;                          \
+        v2 += v1; v1 = ROTL64(v1, 17); v1 ^= v2; v2 = ROTL64(v2, 32);     \
+    } while (0)
+
+static inline uint64_t load_le64(const unsigned char *p) {
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+           (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+void eval_cache_key(const char *password, size_t length, EvalCacheKey *key) {
+    const unsigned char *in = (const unsigned char *)password;
+    uint64_t v0 = 0x736f6d6570736575ull ^ eval_secret[0];
+    uint64_t v1 = 0x646f72616e646f6dull ^ eval_secret[1] ^ 0xee;
+    uint64_t v2 = 0x6c7967656e657261ull ^ eval_secret[0];
+    uint64_t v3 = 0x7465646279746573ull ^ eval_secret[1];
+
+    const unsigned char *end = in + (length & ~(size_t)7);
+    for (; in != end; in += 8) {
+        uint64_t m = load_le64(in);
+        v3 ^= m;
+        SIPROUND;
+        SIPROUND;
+        v0 ^= m;
+    }
+    uint64_t b = (uint64_t)length << 56;
+    for (size_t i = 0; i < (length & 7); i++) b |= (uint64_t)in[i] << (8 * i);
+    v3 ^= b;
+    SIPROUND;
+    SIPROUND;
+    v0 ^= b;
+
+    v2 ^= 0xee;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    key->low = v0 ^ v1 ^ v2 ^ v3;
+    v1 ^= 0xdd;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    key->high = v0 ^ v1 ^ v2 ^ v3;
+}
+
+// --- Cache ---
+
+int eval_cache_init(size_t max_bytes, int ttl_ms) {
+    // Počet množín v sharde sa zaokrúhli nadol na mocninu 2, takže
+    // alokovaná pamäť nikdy neprekročí max_bytes.
+    size_t sets = max_bytes / (sizeof(EvalCacheEntry) * EVAL_CACHE_WAYS * EVAL_CACHE_SHARDS);
+    if (sets == 0 || ttl_ms <= 0) return 1;
+    while (sets & (sets - 1)) sets &= sets - 1;
+
+    random_bytes(eval_secret, sizeof(eval_secret));
+    for (int i = 0; i < EVAL_CACHE_SHARDS; i++) {
+        EvalCacheShard *shard = &eval_shards[i];
+        shard->entries = (EvalCacheEntry *)calloc(sets * EVAL_CACHE_WAYS, sizeof(EvalCacheEntry));
+        shard->hands = (uint8_t *)calloc(sets, 1);
+        if (!shard->entries || !shard->hands || pthread_mutex_init(&shard->lock, NULL) != 0) {
+            fprintf(stderr, "Nedostatok pamäte pre cache vyhodnotení\n");
+            for (int j = 0; j <= i; j++) {
+                free(eval_shards[j].entries);
+                free(eval_shards[j].hands);
+                eval_shards[j].entries = NULL;
+                eval_shards[j].hands = NULL;
+            }
+            return 0;
+        }
+    }
+    eval_set_mask = sets - 1;
+    eval_ttl_ns = (uint64_t)ttl_ms * 1000000ull;
+    eval_enabled = 1;
+    return 1;
+}
+
+int eval_cache_enabled(void) {
+    return eval_enabled;
+}
+
+/**
+ * @brief Shard a prvý záznam množiny pre kľúč (nízke bity vyberú shard, ďalšie množinu).
+ */
+static inline EvalCacheShard *eval_locate(const EvalCacheKey *key, size_t *set) {
+    *set = (size_t)((key->low >> 6) & eval_set_mask);
+    return &eval_shards[key->low & (EVAL_CACHE_SHARDS - 1)];
+}
+
+int eval_cache_lookup(const EvalCacheKey *key, PasswordStrength *result) {
+    if (!eval_enabled) return 0;
+
+    size_t set;
+    EvalCacheShard *shard = eval_locate(key, &set);
+    uint64_t now = metrics_now_ns();
+    int hit = 0;
+    pthread_mutex_lock(&shard->lock);
+    EvalCacheEntry *entry = shard->entries + set * EVAL_CACHE_WAYS;
+    for (int way = 0; way < EVAL_CACHE_WAYS; way++, entry++) {
+        if (entry->expires_ns == 0 || entry->high != key->high || entry->low != key->low) continue;
+        if (entry->expires_ns <= now) {
+            entry->expires_ns = 0; // Vypršaný záznam sa uvoľní hneď.
+            break;
+        }
+        entry->referenced = 1;
+        result->is_strong = entry->is_strong;
+        result->score = entry->score;
+        result->reasons = entry->reasons;
+        result->guesses_log10 = entry->guesses_log10;
+        hit = 1;
+        break;
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    metrics_add(hit ? METRICS_EVAL_CACHE_HITS : METRICS_EVAL_CACHE_MISSES, 1);
+    return hit;
+}
+
+void eval_cache_store(const EvalCacheKey *key, const PasswordStrength *result) {
+    if (!eval_enabled) return;
+
+    size_t set;
+    EvalCacheShard *shard = eval_locate(key, &set);
+    uint64_t now = metrics_now_ns();
+    int evicted = 0;
+    pthread_mutex_lock(&shard->lock);
+    EvalCacheEntry *entries = shard->entries + set * EVAL_CACHE_WAYS;
+    EvalCacheEntry *victim = NULL;
+    // Prednostne rovnaký kľúč (dve súbežné vyhodnotenia), potom voľné
+    // alebo vypršané miesto.
+    for (int way = 0; way < EVAL_CACHE_WAYS; way++) {
+        EvalCacheEntry *entry = &entries[way];
+        if (entry->expires_ns != 0 && entry->high == key->high && entry->low == key->low) {
+            victim = entry;
+            break;
+        }
+        if (!victim && entry->expires_ns <= now) victim = entry;
+    }
+    // Plná množina: ručička preskakuje použité záznamy (a maže im bit),
+    // kým nenájde nepoužitý; najviac jeden obeh + 1.
+    if (!victim) {
+        uint8_t hand = shard->hands[set];
+        while (entries[hand].referenced) {
+            entries[hand].referenced = 0;
+            hand = (uint8_t)((hand + 1) % EVAL_CACHE_WAYS);
+        }
+        victim = &entries[hand];
+        shard->hands[set] = (uint8_t)((hand + 1) % EVAL_CACHE_WAYS);
+        evicted = 1;
+    }
+    victim->high = key->high;
+    victim->low = key->low;
+    victim->expires_ns = now + eval_ttl_ns;
+    victim->guesses_log10 = result->guesses_log10;
+    victim->reasons = result->reasons;
+    victim->score = (uint8_t)result->score;
+    victim->is_strong = (uint8_t)result->is_strong;
+    victim->referenced = 0;
+    pthread_mutex_unlock(&shard->lock);
+
+    if (evicted) metrics_add(METRICS_EVAL_CACHE_EVICTIONS, 1);
+}
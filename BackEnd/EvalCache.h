@@ -0,0 +1,65 @@
+#ifndef EVALCACHE_H
+#define EVALCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../Logic/Password.h"
+
+// Počet shardov (mocnina 2); každý má vlastný zámok
+#define EVAL_CACHE_SHARDS 64
+// Počet záznamov v jednej množine (CLOCK vyberá obeť v rámci množiny)
+#define EVAL_CACHE_WAYS 8
+// Predvolená veľkosť cache a doba platnosti záznamu
+#define DEFAULT_EVAL_CACHE_MB 16
+#define DEFAULT_EVAL_CACHE_TTL_MS 60000
+
+// Kľúč záznamu: 128-bitový SipHash hesla s tajným kľúčom procesu.
+// Heslo samotné sa do cache nikdy neukladá.
+typedef struct {
+    uint64_t high;
+    uint64_t low;
+} EvalCacheKey;
+
+/**
+ * @brief Vytvorí cache a vygeneruje tajný kľúč SipHash.
+ *
+ * Pamäť záznamov sa alokuje naraz a počas behu sa nemení. Volá sa raz
+ * pri štarte, pred spustením vlákien.
+ *
+ * @param max_bytes Horná hranica pamäte záznamov (0 = cache vypnutá).
+ * @param ttl_ms Doba platnosti záznamu.
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int eval_cache_init(size_t max_bytes, int ttl_ms);
+
+/**
+ * @brief Zistí, či je cache zapnutá.
+ */
+int eval_cache_enabled(void);
+
+/**
+ * @brief Vypočíta kľúč hesla (SipHash-2-4 so 128-bitovým výstupom).
+ */
+void eval_cache_key(const char *password, size_t length, EvalCacheKey *key);
+
+/**
+ * @brief Ak je pre kľúč platný záznam, skopíruje uložený výsledok do `result`.
+ *
+ * Započíta zásah alebo výpadok do metrík.
+ *
+ * @return 1 pri zásahu, 0 inak.
+ */
+int eval_cache_lookup(const EvalCacheKey *key, PasswordStrength *result);
+
+/**
+ * @brief Uloží výsledok vyhodnotenia hesla pre kľúč.
+ *
+ * Ukladá sa výsledok, nie telo odpovede: záznam má stálu veľkosť bez
+ * ohľadu na dĺžku spätnej väzby a odpoveď sa pri zásahu len naformátuje.
+ *
+ * Ak je množina plná, algoritmus CLOCK vyhodí záznam, ktorý od posledného
+ * obehu ručičky nebol použitý.
+ */
+void eval_cache_store(const EvalCacheKey *key, const PasswordStrength *result);
+
+#endif // EVALCACHE_H
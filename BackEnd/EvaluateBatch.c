@@ -0,0 +1,320 @@
+#include "EvaluateBatch.h"
+#include "ComputePool.h"
+#include "JsonParser.h"
+#include "JsonWriter.h"
+#include "Metrics.h"
+#include "../Logic/LibPassword.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Rozpracovaná dávka: vstup, výsledky po úsekoch a stav odosielania.
+// Heslá sú dekódované na mieste v kópii tela požiadavky; smerníky a dĺžky
+// sú v samostatných poliach, ako ich prijíma password_evaluate_batch().
+typedef struct {
+    Connection *conn;           // Spojenie, ktoré čaká na výsledky.
+    char *body;                 // Kópia tela; vstupný buffer spojenia sa medzitým mení.
+    const char **passwords;
+    size_t *lengths;
+    size_t count;
+    int ndjson;                 // 1 pre NDJSON, 0 pre JSON pole.
+    Buffer *slices;             // Serializované výsledky, EVALUATE_BATCH_SLICE hesiel na úsek.
+    size_t slice_count;
+    size_t next_slice;          // Ďalší úsek na odoslanie.
+    int started;                // Hlavičky odpovede sú odoslané.
+    int failed;                 // Niektorej úlohe zlyhala alokácia.
+} EvaluateBatch;
+
+static void evaluate_batch_free(void *state) {
+    EvaluateBatch *batch = (EvaluateBatch *)state;
+    if (!batch) return;
+    for (size_t i = 0; batch->slices && i < batch->slice_count; i++) {
+        buffer_free(&batch->slices[i]);
+    }
+    free(batch->slices);
+    free(batch->body);
+    free(batch->passwords);
+    free(batch->lengths);
+    free(batch);
+}
+
+// Spoločný kontext libpassword pre všetky dávky; po vytvorení sa nemení.
+// Dávky sa hodnotia všetkými kontrolami ako /api/evaluate.
+static PasswordContext *batch_context;
+static pthread_once_t batch_context_once = PTHREAD_ONCE_INIT;
+
+static void batch_context_create(void) {
+    batch_context = password_context_create(LIBPASSWORD_VERSION);
+    if (batch_context) password_context_set_checks(batch_context, PASSWORD_CHECK_ALL);
+}
+
+// --- Parsovanie tela ---
+
+static const char *skip_whitespace(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    return p;
+}
+
+/**
+ * @brief Naparsuje jednu položku dávky: reťazec alebo objekt s kľúčom "password".
+ *
+ * Heslo sa dekóduje na mieste v tele požiadavky, ostatné členy objektu
+ * (aj vnorené) sa preskočia.
+ *
+ * @param first Prvý token položky.
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+static int parse_entry(JsonTokenizer *tokenizer, const JsonToken *first, char *body, EvaluateBatch *batch) {
+    size_t index = batch->count;
+    JsonToken token;
+
+    if (first->type == JSON_TOKEN_STRING) {
+        char *out = body + (first->data - body);
+        batch->passwords[index] = out;
+        batch->lengths[index] = json_decode_string(first, out);
+    } else if (first->type == JSON_TOKEN_OBJECT_START) {
+        int found = 0;
+        while (json_next(tokenizer, &token) == JSON_TOKEN_KEY) {
+            char *key = body + (token.data - body);
+            size_t key_length = json_decode_string(&token, key);
+            int is_password = key_length == 8 && memcmp(key, "password", 8) == 0;
+
+            JsonTokenType type = json_next(tokenizer, &token);
+            if (is_password) {
+                if (type != JSON_TOKEN_STRING) return 0;
+                char *out = body + (token.data - body);
+                batch->passwords[index] = out;
+                batch->lengths[index] = json_decode_string(&token, out);
+                found = 1;
+            } else if (!json_skip_value(tokenizer, &token)) {
+                return 0;
+            }
+        }
+        if (token.type != JSON_TOKEN_OBJECT_END || !found) return 0;
+    } else {
+        return 0;
+    }
+
+    batch->count++;
+    return 1;
+}
+
+/**
+ * @brief Naparsuje celé telo (JSON pole alebo NDJSON) do zoznamu položiek.
+ *
+ * @return 1 pri úspechu, 0 pri chybnom tele, -1 pri priveľkom počte položiek.
+ */
+static int evaluate_batch_parse(EvaluateBatch *batch, char *body, size_t length) {
+    const char *end = body + length;
+    const char *p = skip_whitespace(body, end);
+    JsonTokenizer tokenizer;
+    JsonToken token;
+
+    batch->ndjson = p >= end || *p != '[';
+
+    if (!batch->ndjson) {
+        json_tokenizer_init(&tokenizer, body, length);
+        json_next(&tokenizer, &token);
+        while (json_next(&tokenizer, &token) != JSON_TOKEN_ARRAY_END) {
+            if (token.type == JSON_TOKEN_ERROR) return 0;
+            if (batch->count >= MAX_EVALUATE_BATCH_ENTRIES) return -1;
+            if (!parse_entry(&tokenizer, &token, body, batch)) return 0;
+        }
+        return json_next(&tokenizer, &token) == JSON_TOKEN_END;
+    }
+
+    // NDJSON: jedna položka na riadok (JSON reťazec nemôže obsahovať znak
+    // nového riadku), prázdne riadky sa preskočia.
+    while ((p = skip_whitespace(p, end)) < end) {
+        const char *line_end = memchr(p, '\n', (size_t)(end - p));
+        if (!line_end) line_end = end;
+        if (batch->count >= MAX_EVALUATE_BATCH_ENTRIES) return -1;
+
+        json_tokenizer_init(&tokenizer, p, (size_t)(line_end - p));
+        json_next(&tokenizer, &token);
+        if (!parse_entry(&tokenizer, &token, body, batch)) return 0;
+        if (json_next(&tokenizer, &token) != JSON_TOKEN_END) return 0;
+        p = line_end;
+    }
+    return 1;
+}
+
+// --- Vyhodnotenie a odpoveď ---
+
+/**
+ * @brief Úloha výpočtového poolu: vyhodnotí a serializuje jeden úsek dávky.
+ */
+static void evaluate_batch_slice(void *context, size_t slice) {
+    EvaluateBatch *batch = (EvaluateBatch *)context;
+    Buffer *out = &batch->slices[slice];
+    size_t first = slice * EVALUATE_BATCH_SLICE;
+    size_t last = first + EVALUATE_BATCH_SLICE;
+    if (last > batch->count) last = batch->count;
+
+    uint8_t scores[EVALUATE_BATCH_SLICE];
+    uint8_t strong[EVALUATE_BATCH_SLICE];
+    uint32_t reasons[EVALUATE_BATCH_SLICE];
+    PasswordEvaluations results = {scores, strong, reasons, NULL};
+    password_evaluate_batch(batch_context, last - first, batch->passwords + first, batch->lengths + first, &results);
+
+    for (size_t i = first; i < last; i++) {
+        char feedback[PASSWORD_FEEDBACK_SIZE];
+        size_t feedback_length = password_feedback(reasons[i - first], strong[i - first], feedback, sizeof(feedback));
+        int written = (batch->ndjson || i == 0 || JSON_APPEND_LITERAL(out, ",\n")) &&
+                      JSON_APPEND_LITERAL(out, "{\"score\":") &&
+                      json_append_int(out, scores[i - first]) &&
+                      JSON_APPEND_LITERAL(out, ",\"strong\":") &&
+                      json_append_bool(out, strong[i - first]) &&
+                      JSON_APPEND_LITERAL(out, ",\"feedback\":") &&
+                      json_append_string(out, feedback, feedback_length) &&
+                      JSON_APPEND_LITERAL(out, "}") &&
+                      (!batch->ndjson || JSON_APPEND_LITERAL(out, "\n"));
+        if (!written) {
+            __atomic_store_n(&batch->failed, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Odošle chybovú JSON odpoveď a započíta chybu.
+ */
+static void evaluate_batch_error(Connection *conn, int status, const char *reason, const char *message) {
+    metrics_error(status == 400 ? METRICS_ERROR_BAD_REQUEST
+                  : status == 413 ? METRICS_ERROR_TOO_LARGE : METRICS_ERROR_INTERNAL);
+    connection_sendf(conn,
+        "HTTP/1.1 %d %s\r\n"
+        "Content-Type: application/json\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "Content-Length: %zu\r\n"
+        "%s"
+        "\r\n"
+        "{ \"error\": \"%s\" }",
+        status, reason, strlen(message) + 15, connection_header(conn), message);
+}
+
+/**
+ * @brief Odošle hlavičky odpovede, keď sú známe všetky výsledky.
+ *
+ * @return 1 ak nasledujú úseky výsledkov, 0 ak sa namiesto nich odoslala chyba.
+ */
+static int evaluate_batch_start(Connection *conn, EvaluateBatch *batch) {
+    if (__atomic_load_n(&batch->failed, __ATOMIC_RELAXED)) {
+        evaluate_batch_error(conn, 500, "Internal Server Error", "Out of memory");
+        return 0;
+    }
+
+    // Celková dĺžka je známa vopred, odpoveď preto nepotrebuje chunked kódovanie.
+    size_t content_length = batch->ndjson ? 0 : 5;   // "[\n" a "\n]\n"
+    for (size_t i = 0; i < batch->slice_count; i++) {
+        content_length += batch->slices[i].length;
+    }
+
+    connection_sendf(conn,
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: %s\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "Access-Control-Allow-Methods: POST, GET, OPTIONS\r\n"
+        "Access-Control-Allow-Headers: Content-Type\r\n"
+        "Content-Length: %zu\r\n"
+        "%s"
+        "\r\n"
+        "%s",
+        batch->ndjson ? "application/x-ndjson" : "application/json",
+        content_length, connection_header(conn), batch->ndjson ? "" : "[\n");
+
+    // Heslá už nie sú potrebné, výsledky sa posielajú podľa tempa klienta.
+    free(batch->body);
+    free(batch->passwords);
+    free(batch->lengths);
+    batch->body = NULL;
+    batch->passwords = NULL;
+    batch->lengths = NULL;
+    return 1;
+}
+
+/**
+ * @brief Producent odpovede: po výpočte pošle hlavičky, potom ďalší úsek
+ *        výsledkov, ktorý hneď uvoľní.
+ */
+static int evaluate_batch_produce(Connection *conn, void *state) {
+    EvaluateBatch *batch = (EvaluateBatch *)state;
+
+    if (!batch->started) {
+        batch->started = 1;
+        return evaluate_batch_start(conn, batch);
+    }
+    if (batch->next_slice < batch->slice_count) {
+        Buffer *slice = &batch->slices[batch->next_slice++];
+        if (!connection_send(conn, slice->data, slice->length)) return -1;
+        buffer_free(slice);
+        return 1;
+    }
+    if (!batch->ndjson && !connection_send(conn, "\n]\n", 3)) return -1;
+    return 0;
+}
+
+/**
+ * @brief Volá ho výpočtový pool po vyhodnotení všetkých úsekov.
+ */
+static void evaluate_batch_done(void *context) {
+    EvaluateBatch *batch = (EvaluateBatch *)context;
+    connection_resume(batch->conn);
+}
+
+void evaluate_batch_handle(Connection *conn, const HttpRequest *request) {
+    pthread_once(&batch_context_once, batch_context_create);
+    EvaluateBatch *batch = batch_context ? (EvaluateBatch *)calloc(1, sizeof(EvaluateBatch)) : NULL;
+    if (!batch) {
+        evaluate_batch_error(conn, 500, "Internal Server Error", "Out of memory");
+        return;
+    }
+
+    // Položka zaberá v tele aspoň 2 bajty ("" alebo {}).
+    size_t max_entries = request->body_length / 2 + 1;
+    if (max_entries > MAX_EVALUATE_BATCH_ENTRIES) max_entries = MAX_EVALUATE_BATCH_ENTRIES;
+    batch->body = (char *)malloc(request->body_length + 1);
+    batch->passwords = (const char **)malloc(max_entries * sizeof(const char *));
+    batch->lengths = (size_t *)malloc(max_entries * sizeof(size_t));
+    if (!batch->body || !batch->passwords || !batch->lengths) {
+        evaluate_batch_free(batch);
+        evaluate_batch_error(conn, 500, "Internal Server Error", "Out of memory");
+        return;
+    }
+    memcpy(batch->body, request->body, request->body_length + 1);
+
+    int parsed = evaluate_batch_parse(batch, batch->body, request->body_length);
+    if (parsed <= 0) {
+        evaluate_batch_free(batch);
+        if (parsed < 0) {
+            evaluate_batch_error(conn, 413, "Payload Too Large", "Too many passwords in batch");
+        } else {
+            evaluate_batch_error(conn, 400, "Bad Request", "Invalid batch");
+        }
+        return;
+    }
+
+    batch->slice_count = (batch->count + EVALUATE_BATCH_SLICE - 1) / EVALUATE_BATCH_SLICE;
+    batch->slices = (Buffer *)calloc(batch->slice_count + 1, sizeof(Buffer));
+    if (!batch->slices) {
+        evaluate_batch_free(batch);
+        evaluate_batch_error(conn, 500, "Internal Server Error", "Out of memory");
+        return;
+    }
+    for (size_t i = 0; i < batch->slice_count; i++) {
+        buffer_init(&batch->slices[i]);
+    }
+
+    // Dávku hodnotí výpočtový pool a event loop medzitým obsluhuje ostatné
+    // spojenia; odpoveď začne producent až po evaluate_batch_done().
+    batch->conn = conn;
+    connection_stream(conn, evaluate_batch_produce, batch, evaluate_batch_free);
+    connection_suspend(conn);
+    // Access log zapisuje požiadavku hneď po návrate handlera, keď hlavičky
+    // ešte nie sú odoslané; dávka okrem zlyhania alokácie končí 200.
+    conn->response_status = 200;
+    if (!compute_pool_submit(evaluate_batch_slice, batch, batch->slice_count, evaluate_batch_done)) {
+        batch->failed = 1;
+        connection_resume(conn);
+    }
+}
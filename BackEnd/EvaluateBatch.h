@@ -0,0 +1,30 @@
+#ifndef EVALUATEBATCH_H
+#define EVALUATEBATCH_H
+
+#include "Connection.h"
+
+// Maximálny počet hesiel v jednej požiadavke na /api/evaluate/batch
+#define MAX_EVALUATE_BATCH_ENTRIES 100000
+// Maximálna veľkosť tela požiadavky na /api/evaluate/batch
+#define MAX_EVALUATE_BATCH_BODY_SIZE (16 * 1024 * 1024)
+// Počet hesiel, ktoré vyhodnotí a serializuje jedna úloha výpočtového poolu
+#define EVALUATE_BATCH_SLICE 1024
+
+/**
+ * @brief Vyhodnotí dávku hesiel a zaradí odpoveď do výstupu spojenia.
+ *
+ * Telo je buď JSON pole (`["heslo1", "heslo2"]`), alebo NDJSON (jedna
+ * položka na riadok). Položka je reťazec alebo objekt s kľúčom "password".
+ * Heslá sa vyhodnotia paralelne vo výpočtovom poole, kým event loop
+ * obsluhuje ostatné spojenia (`connection_suspend()`). Výsledky sa vrátia
+ * v rovnakom poradí a formáte (pole alebo NDJSON) ako vstup. Odpoveď sa
+ * odosiela postupne podľa toho, ako ju klient číta.
+ *
+ * Pri chybnom tele odpovie 400, pri priveľkej dávke 413.
+ *
+ * @param conn Spojenie klienta.
+ * @param request Požiadavka s kompletným telom.
+ */
+void evaluate_batch_handle(Connection *conn, const HttpRequest *request);
+
+#endif // EVALUATEBATCH_H
@@ -1,66 +1,166 @@
 #include "HTTPserver.h"
+#include "ThreadPool.h"
+#include "StaticCache.h"
+#include "ComputePool.h"
+#include "EvaluateBatch.h"
+#include "ApiRequest.h"
+#include "JsonWriter.h"
+#include "Metrics.h"
+#include "AccessLog.h"
+#include "Supervisor.h"
+#include "EvalCache.h"
+#include "Admission.h"
 #include "../Logic/Password.h"
-#include <ctype.h>
-#include <sys/select.h> // Pre select() a fd_set
-#include <fcntl.h>      // Pre fcntl()
+#include "../Logic/Breach.h"
+#include "../Logic/Passphrase.h"
+#include "../Logic/Policy.h"
+#include "../Logic/Markov.h"
+#include <math.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>     // Pre signal() a SIGPIPE
+#include <sys/signalfd.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+ServerConfig server_config = {
+    DEFAULT_KEEPALIVE_TIMEOUT_MS,
+    DEFAULT_KEEPALIVE_MAX_REQUESTS,
+    0,
+    0,
+    0,
+    NULL
+};
 
 /**
- * @brief Extrahuje hodnotu reťazca z jednoduchého JSON objektu.
- * 
- * Funkcia hľadá zadaný kľúč v JSON reťazci a vracia jeho hodnotu.
- * Je navrhnutá pre veľmi jednoduchý formát, napr. `{"kľúč":"hodnota"}`.
- * 
- * @param json Vstupný JSON reťazec.
- * @param key Kľúč, ktorého hodnotu treba nájsť.
- * @return Novonalokovaný reťazec s hodnotou alebo NULL pri neúspechu.
- *         Volajúci je zodpovedný za uvoľnenie pamäte.
+ * @brief Načíta kladné celé číslo z premennej prostredia.
+ *
+ * @param name Názov premennej prostredia.
+ * @param fallback Hodnota, ktorá sa použije, ak premenná chýba alebo je neplatná.
+ * @return Načítaná hodnota alebo `fallback`.
  */
-char* get_json_string_value(const char* json, const char* key) {
-    char key_pattern[100];
-    sprintf(key_pattern, "\"%s\":\"", key);
-    
-    const char* key_ptr = strstr(json, key_pattern);
-    if (!key_ptr) return NULL;
-
-    const char* value_start = key_ptr + strlen(key_pattern);
-    const char* value_end = strchr(value_start, '"');
-    if (!value_end) return NULL;
-
-    int value_len = value_end - value_start;
-    char* value = (char*)malloc(value_len + 1);
-    if (!value) return NULL;
-
-    strncpy(value, value_start, value_len);
-    value[value_len] = '\0';
-    return value;
+static int get_env_int(const char* name, int fallback) {
+    const char* value = getenv(name);
+    if (!value || !*value) return fallback;
+
+    char* end = NULL;
+    long parsed = strtol(value, &end, 10);
+    if (*end != '\0' || parsed <= 0 || parsed > 1000000) {
+        fprintf(stderr, "Neplatná hodnota %s=%s, používam %d\n", name, value, fallback);
+        return fallback;
+    }
+    return (int)parsed;
 }
 
+// Konštantné začiatky hlavičiek odpovedí API; hodnotu Content-Length a hlavičku
+// Connection doplní connection_end_body(), takže sa nič neformátuje.
+static const char api_ok_head[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/json\r\n"
+    "Access-Control-Allow-Origin: *\r\n"           // Povoľuje prístup z akejkoľvek domény
+    "Access-Control-Allow-Methods: POST, GET, OPTIONS\r\n"
+    "Access-Control-Allow-Headers: Content-Type\r\n"
+    "Content-Length: ";
+static const char api_bad_request_head[] =
+    "HTTP/1.1 400 Bad Request\r\n"
+    "Content-Type: application/json\r\n"
+    "Access-Control-Allow-Origin: *\r\n"
+    "Content-Length: ";
+static const char api_internal_error_head[] =
+    "HTTP/1.1 500 Internal Server Error\r\n"
+    "Content-Type: application/json\r\n"
+    "Access-Control-Allow-Origin: *\r\n"
+    "Content-Length: ";
+static const char metrics_head[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+    "Content-Length: ";
+static const char api_preflight_head[] =
+    "HTTP/1.1 204 No Content\r\n"
+    "Access-Control-Allow-Origin: *\r\n"
+    "Access-Control-Allow-Methods: POST, GET, OPTIONS\r\n"
+    "Access-Control-Allow-Headers: Content-Type\r\n";
+
 /**
- * @brief Extrahuje číselnú hodnotu z jednoduchého JSON objektu.
- * 
- * Hľadá zadaný kľúč a parsuje nasledujúce číslo.
- * Ignoruje medzery medzi dvojbodkou a hodnotou.
- * 
- * @param json Vstupný JSON reťazec.
- * @param key Kľúč, ktorého číselnú hodnotu treba nájsť.
- * @return Extrahovaná číselná hodnota alebo 0, ak kľúč nebol nájdený.
+ * @brief Odošle JSON odpoveď `{ "error": "..." }` s danou hlavičkou.
  */
-int get_json_int_value(const char* json, const char* key) {
-    char key_pattern[100];
-    sprintf(key_pattern, "\"%s\":", key); // Hľadá "kľúč":
+static void send_json_error(Connection *conn, const char *head, size_t head_length, const char *message) {
+    Buffer *body = connection_begin_body(conn);
+    if (JSON_APPEND_LITERAL(body, "{ \"error\": ") &&
+        json_append_string(body, message, strlen(message)) &&
+        JSON_APPEND_LITERAL(body, " }")) {
+        connection_end_body(conn, head, head_length);
+    } else {
+        connection_cancel_body(conn);
+    }
+}
 
-    const char* key_ptr = strstr(json, key_pattern);
-    if (!key_ptr) return 0;
+/**
+ * @brief Odošle 400 `{ "error": "Invalid JSON" }` a započíta chybu.
+ */
+static void send_bad_request(Connection *conn) {
+    metrics_error(METRICS_ERROR_BAD_REQUEST);
+    send_json_error(conn, api_bad_request_head, sizeof(api_bad_request_head) - 1, "Invalid JSON");
+}
+
+/**
+ * @brief Odošle 500 `{ "error": "Out of memory" }` a započíta chybu.
+ */
+static void send_out_of_memory(Connection *conn) {
+    metrics_error(METRICS_ERROR_INTERNAL);
+    send_json_error(conn, api_internal_error_head, sizeof(api_internal_error_head) - 1, "Out of memory");
+}
 
-    const char* value_start = key_ptr + strlen(key_pattern);
-    
-    // Preskočíme medzery
-    while (*value_start && isspace(*value_start)) {
-        value_start++;
+/**
+ * @brief Odošle metriky servera v textovom formáte Prometheus.
+ */
+static void send_metrics(Connection *conn) {
+    Buffer *body = connection_begin_body(conn);
+    if (metrics_write_prometheus(body) &&
+        buffer_appendf(body,
+                       "# HELP password_server_requests_in_flight Prijaté, ešte nedokončené požiadavky procesu.\n"
+                       "# TYPE password_server_requests_in_flight gauge\n"
+                       "password_server_requests_in_flight %d\n",
+                       admission_in_flight())) {
+        connection_end_body(conn, metrics_head, sizeof(metrics_head) - 1);
+    } else {
+        connection_cancel_body(conn);
+        metrics_error(METRICS_ERROR_INTERNAL);
+        connection_sendf(conn, "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\n%s\r\n",
+                         connection_header(conn));
     }
+}
 
-    // Konvertujeme číslo na integer
-    return atoi(value_start);
+/**
+ * @brief Odošle zoznam pomenovaných politík generovania (GET /api/policies).
+ */
+static void send_policies(Connection *conn) {
+    Buffer *body = connection_begin_body(conn);
+    int ok = JSON_APPEND_LITERAL(body, "{ \"policies\": [");
+    for (int id = 1; ok && id <= policy_count(); id++) {
+        const PasswordPolicy *policy = policy_by_id(id);
+        ok = (id == 1 || JSON_APPEND_LITERAL(body, ", ")) &&
+             JSON_APPEND_LITERAL(body, "{ \"id\": ") &&
+             json_append_int(body, policy->id) &&
+             JSON_APPEND_LITERAL(body, ", \"name\": ") &&
+             json_append_string(body, policy->name, strlen(policy->name)) &&
+             JSON_APPEND_LITERAL(body, ", \"length\": ") &&
+             json_append_int(body, policy->default_length) &&
+             JSON_APPEND_LITERAL(body, ", \"minLength\": ") &&
+             json_append_int(body, policy->min_length) &&
+             JSON_APPEND_LITERAL(body, ", \"alphabetSize\": ") &&
+             json_append_int(body, (long)policy->all.size) &&
+             JSON_APPEND_LITERAL(body, ", \"maxRun\": ") &&
+             json_append_int(body, policy->max_run) &&
+             JSON_APPEND_LITERAL(body, ", \"prefix\": ") &&
+             json_append_string(body, policy->prefix, (size_t)policy->prefix_length) &&
+             JSON_APPEND_LITERAL(body, " }");
+    }
+    if (ok && JSON_APPEND_LITERAL(body, "] }")) {
+        connection_end_body(conn, api_ok_head, sizeof(api_ok_head) - 1);
+    } else {
+        connection_cancel_body(conn);
+    }
 }
 
 /**
@@ -74,85 +174,227 @@ const char* get_mime_type(const char* path) {
     if (strstr(path, ".html")) return "text/html";
     if (strstr(path, ".css")) return "text/css";
     if (strstr(path, ".js")) return "application/javascript";
+    if (strstr(path, ".json")) return "application/json";
+    if (strstr(path, ".svg")) return "image/svg+xml";
+    if (strstr(path, ".png")) return "image/png";
+    if (strstr(path, ".ico")) return "image/x-icon";
     return "application/octet-stream"; // Fallback pre neznáme typy
 }
 
 /**
- * @brief Načíta a odošle statický súbor klientovi.
+ * @brief Odošle statický súbor klientovi z pamäťovej cache.
  * 
- * Funkcia vytvorí cestu k súboru v rámci adresára 'Frontend',
- * načíta ho a odošle ako HTTP odpoveď s príslušnými hlavičkami.
+ * Súbory z adresára 'Frontend' sú pri štarte načítané do pamäte spolu
+ * s hotovými hlavičkami, takže obsluha je len vyhľadanie v tabuľke.
+ * Ak klient pošle zhodný ETag v If-None-Match, dostane 304 bez tela;
+ * ak podporuje gzip, dostane predkomprimovanú verziu. Hlavičky aj telo
+ * sa odosielajú bez kopírovania priamo z cache.
  * 
- * @param client_socket Socket klienta.
+ * @param conn Spojenie klienta.
+ * @param request Požiadavka (kvôli Accept-Encoding a If-None-Match).
  * @param file_path Relatívna cesta k súboru (napr. "/index.html").
  */
-void serve_static_file(int client_socket, const char* file_path) {
-    char full_path[256];
-    // Vytvoríme cestu k súboru v zložke Frontend
-    snprintf(full_path, sizeof(full_path), "Frontend%s", file_path);
+void serve_static_file(Connection *conn, const HttpRequest *request, const char* file_path) {
+    StaticTable *table = static_cache_acquire();
+    const StaticAsset *asset = table ? static_cache_find(table, file_path, strlen(file_path)) : NULL;
 
-    FILE* file = fopen(full_path, "rb");
-    if (!file) {
+    if (!asset) {
         // Súbor sa nenašiel, pošleme odpoveď 404 Not Found.
-        char response[] = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
-        write(client_socket, response, strlen(response));
+        if (table) static_cache_release(table);
+        connection_sendf(conn, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n%s\r\n",
+                         connection_header(conn));
         return;
     }
 
-    // Zistíme veľkosť súboru
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    const StaticVariant *variant = static_asset_select(asset, request->accept_encoding);
+    int not_modified = request->if_none_match.length > 0 &&
+                       static_variant_etag_matches(variant, request->if_none_match);
 
-    // Alokujeme pamäť a načítame obsah súboru
-    char* buffer = (char*)malloc(file_size);
-    if (!buffer) {
-        fclose(file);
-        // Chyba alokácie pamäte, pošleme odpoveď 500 Internal Server Error.
-        char response[] = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\n\r\n";
-        write(client_socket, response, strlen(response));
-        return;
+    // Spojenie si podrží referenciu na tabuľku, kým sa dáta neodošlú. Ak už drží
+    // inú (tabuľka sa medzitým znovu načítala), dáta sa radšej skopírujú.
+    int zero_copy = connection_pin(conn, table, static_cache_release);
+    int (*send_part)(Connection *, const void *, size_t) = zero_copy ? connection_send_static : connection_send;
+
+    if (not_modified) {
+        send_part(conn, variant->not_modified_header, variant->not_modified_length);
+    } else {
+        send_part(conn, variant->header, variant->header_length);
     }
+    const char *connection = connection_header(conn);
+    connection_send_static(conn, connection, strlen(connection));
+    connection_send_static(conn, "\r\n", 2);
+    if (!not_modified) {
+        send_part(conn, variant->body, variant->body_length);
+    }
+
+    if (!zero_copy) static_cache_release(table);
+}
 
-    fread(buffer, 1, file_size, file);
-    fclose(file);
+/**
+ * @brief Prevezme všetky spojenia čakajúce v jadre a odovzdá ich vláknam.
+ *
+ * Počúvajúci socket je neblokujúci, takže jedno prebudenie vyprázdni celú frontu.
+ *
+ * @param protocol Protokol, ktorým hovoria spojenia z tohto socketu.
+ */
+static void accept_pending(int server_fd, ThreadPool *pool, ConnectionProtocol protocol) {
+    while (1) {
+        int client_socket = accept4(server_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client_socket < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept");
+            return;
+        }
+
+        // Spojenie prevezme event loop niektorého pracovného vlákna
+        if (!thread_pool_submit(pool, client_socket, protocol)) {
+            metrics_error(METRICS_ERROR_REJECTED);
+            close(client_socket); // Všetky vlákna sú preťažené
+        }
+    }
+}
+
+/**
+ * @brief Otvorí Unix socket pre binárny protokol (Client/PasswordProtocol.h).
+ *
+ * Súbor socketu, ktorý zostal po predchádzajúcom behu, sa nahradí; iný
+ * súbor na tej istej ceste sa neprepíše.
+ *
+ * @param bound Dostane identitu vytvoreného súboru socketu (pre close_unix_listener()).
+ * @return Neblokujúci počúvajúci socket alebo -1 pri chybe.
+ */
+static int open_unix_listener(const char *path, int backlog, struct stat *bound) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Cesta Unix socketu je pridlhá: %s\n", path);
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+
+    struct stat existing;
+    if (lstat(path, &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+        unlink(path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("socket (unix)");
+        return -1;
+    }
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0 || lstat(path, bound) < 0 ||
+        listen(fd, backlog) < 0) {
+        fprintf(stderr, "Nepodarilo sa počúvať na %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
 
-    // Pripravíme a odošleme HTTP hlavičky
-    char header[512];
-    snprintf(header, sizeof(header),
-             "HTTP/1.1 200 OK\r\n"
-             "Content-Type: %s\r\n"
-             "Content-Length: %ld\r\n"
-             "\r\n",
-             get_mime_type(full_path), file_size);
+/**
+ * @brief Zavrie Unix socket a odstráni jeho súbor.
+ *
+ * Pri reštarte cez supervisora už mohla nová generácia na tej istej ceste
+ * vytvoriť vlastný socket; ten sa neodstráni.
+ */
+static void close_unix_listener(int fd, const char *path, const struct stat *bound) {
+    struct stat current;
+    close(fd);
+    if (lstat(path, &current) == 0 && current.st_dev == bound->st_dev && current.st_ino == bound->st_ino) {
+        unlink(path);
+    }
+}
 
-    write(client_socket, header, strlen(header));
-    // Odošleme samotný obsah súboru
-    write(client_socket, buffer, file_size);
+/**
+ * @brief Počká, kým vlákna dobehnú otvorené spojenia, najviac SERVER_DRAIN_TIMEOUT_MS.
+ *
+ * Ďalší signál na `signal_fd` čakanie preruší.
+ */
+static void drain_connections(ThreadPool *pool, int signal_fd) {
+    int timeout_ms = get_env_int("SERVER_DRAIN_TIMEOUT_MS", DEFAULT_DRAIN_TIMEOUT_MS);
+    uint64_t deadline = timer_now_ms() + (uint64_t)timeout_ms;
+    thread_pool_drain(pool);
 
-    free(buffer);
+    size_t open;
+    while ((open = thread_pool_connections(pool)) > 0 && timer_now_ms() < deadline) {
+        struct pollfd fd = {signal_fd, POLLIN, 0};
+        if (poll(&fd, 1, DRAIN_POLL_MS) > 0) break;
+    }
+    if (open > 0) {
+        fprintf(stderr, "Ukončujem, %zu spojení sa nestihlo dokončiť\n", open);
+    }
 }
 
 /**
  * @brief Inicializuje a spustí HTTP server.
  * 
- * Vytvorí socket, nastaví jeho parametre, naviaže ho na port
- * a vstúpi do nekonečnej slučky, kde prijíma nové spojenia a obsluhuje ich.
+ * Vytvorí socket, nastaví jeho parametre, naviaže ho na port, spustí pool
+ * pracovných vlákien a prijíma nové spojenia, ktoré odovzdáva event loopom
+ * vlákien. Port, dĺžku fronty listen() a počet pracovných procesov určujú
+ * argumenty programu alebo premenné `SERVER_PORT`, `SERVER_BACKLOG` a
+ * `SERVER_WORKERS`; pri viac ako jednom procese sa tento proces stane
+ * supervisorom. Počet vlákien, veľkosť fronty a správanie
+ * keep-alive spojení sa dajú nastaviť premennými prostredia `SERVER_THREADS`,
+ * `SERVER_QUEUE_SIZE`, `KEEPALIVE_TIMEOUT_MS`, `KEEPALIVE_MAX_REQUESTS` a
+ * `COMPUTE_THREADS` (vlákna pre dávkové vyhodnocovanie); `STATIC_RELOAD=1`
+ * zapne opätovné načítanie statických súborov pri zmene a `BREACH_INDEX`
+ * určuje súbor s indexom uniknutých hesiel, `MARKOV_MODEL` Markovov model. `PASSPHRASE_WORDLISTS` sú slovníky
+ * pre `/api/passphrase` (súbory oddelené dvojbodkou) a `PASSWORD_POLICIES`
+ * súbor s ďalšími politikami generovania hesiel. `ACCESS_LOG` zapne access log
+ * (súbor alebo "-" pre štandardný výstup), `ACCESS_LOG_LEVEL`, `ACCESS_LOG_SAMPLE`,
+ * `ACCESS_LOG_MAX_MB`, `ACCESS_LOG_FILES` a `ACCESS_LOG_BUFFER` ho dolaďujú.
+ * `EVAL_CACHE_MB` a `EVAL_CACHE_TTL_MS` určujú veľkosť a platnosť cache
+ * odpovedí `/api/evaluate`. `ADMISSION_RATE` a `ADMISSION_BURST` obmedzia
+ * požiadavky jednej IP adresy a `MAX_IN_FLIGHT` počet rozpracovaných požiadaviek.
+ * `UNIX_SOCKET` zapne druhý počúvajúci socket s binárnym protokolom
+ * (Client/PasswordProtocol.h) pre klientov na tom istom stroji.
+ *
+ * Po SIGTERM alebo SIGINT server prestane prijímať spojenia, dobehne otvorené
+ * (najviac `SERVER_DRAIN_TIMEOUT_MS`) a funkcia sa vráti.
  */
 void start_server() {
-    int server_fd, client_socket;
+    int server_fd;
     struct sockaddr_in address;
-    int addrlen = sizeof(address);
 
-    // Vytvorenie socketu
-    if ((server_fd = socket(AF_INET, SOCK_STREAM, 0)) == 0) {
+    if (!server_config.port) server_config.port = get_env_int("SERVER_PORT", PORT);
+    if (!server_config.listen_backlog) {
+        server_config.listen_backlog = get_env_int("SERVER_BACKLOG", DEFAULT_LISTEN_BACKLOG);
+    }
+    if (!server_config.worker_processes) server_config.worker_processes = get_env_int("SERVER_WORKERS", 1);
+    if (server_config.worker_processes > MAX_WORKER_PROCESSES) server_config.worker_processes = MAX_WORKER_PROCESSES;
+
+    // Viac procesov: tento proces ich len spúšťa a stráži, sám nepočúva.
+    int ready_fd;
+    int worker_index = supervisor_worker_index(&ready_fd);
+    if (worker_index < 0 && server_config.worker_processes > 1) {
+        exit(supervisor_run(server_config.argv, server_config.worker_processes) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    // SIGTERM a SIGINT sa prevezmú cez signalfd v akceptore; blokujú sa skôr,
+    // ako vzniknú ďalšie vlákna, aby masku zdedili a signál nedostali ony.
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGTERM);
+    sigaddset(&stop_signals, SIGINT);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, NULL);
+    int signal_fd = signalfd(-1, &stop_signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signal_fd < 0) {
+        perror("signalfd");
+        exit(EXIT_FAILURE);
+    }
+
+    // Vytvorenie neblokujúceho socketu
+    if ((server_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0) {
         perror("socket failed");
         exit(EXIT_FAILURE);
     }
 
-    // Nastavenie možnosti opätovného použitia adresy a portu
+    // Nastavenie možnosti opätovného použitia adresy a portu; so SO_REUSEPORT
+    // môže na porte počúvať viac procesov naraz a jadro medzi ne delí spojenia.
     int opt = 1;
-    if (setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt))) {
+    if (setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) ||
+        setsockopt(server_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt))) {
         perror("setsockopt");
         exit(EXIT_FAILURE);
     }
@@ -160,7 +402,7 @@ void start_server() {
     // Konfigurácia adresy servera
     address.sin_family = AF_INET;
     address.sin_addr.s_addr = INADDR_ANY;
-    address.sin_port = htons(PORT);
+    address.sin_port = htons((uint16_t)server_config.port);
 
     // Naviazanie socketu na adresu a port
     if (bind(server_fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
@@ -169,195 +411,614 @@ void start_server() {
     }
 
     // Začatie počúvania na prichádzajúce spojenia
-    if (listen(server_fd, 10) < 0) {
+    if (listen(server_fd, server_config.listen_backlog) < 0) {
         perror("listen");
         exit(EXIT_FAILURE);
     }
 
-    printf("Server počúva na http://localhost:%d\n", PORT);
+    // Binárny protokol na Unix sockete (voliteľný); pracovné procesy počúvajú
+    // každý na vlastnej ceste (socket.0, socket.1, ...).
+    int unix_fd = -1;
+    struct stat unix_file;
+    const char *unix_path = getenv("UNIX_SOCKET");
+    if (unix_path && *unix_path) {
+        static char worker_unix_path[sizeof(((struct sockaddr_un *)0)->sun_path) + 16];
+        if (worker_index >= 0) {
+            snprintf(worker_unix_path, sizeof(worker_unix_path), "%s.%d", unix_path, worker_index);
+            unix_path = worker_unix_path;
+        }
+        unix_fd = open_unix_listener(unix_path, server_config.listen_backlog, &unix_file);
+        if (unix_fd < 0) {
+            exit(EXIT_FAILURE);
+        }
+    }
 
-    // Nekonečná slučka na prijímanie spojení
-    while (1) {
-        if ((client_socket = accept(server_fd, (struct sockaddr *)&address, (socklen_t*)&addrlen)) < 0) {
-            perror("accept");
-            continue; // Pri chybe pokračujeme na ďalšie spojenie
+    // Zápis do socketu, ktorý klient medzičasom zavrel, nesmie ukončiť celý proces.
+    signal(SIGPIPE, SIG_IGN);
+
+    // Načítanie statických súborov do pamäte (voliteľne so sledovaním zmien).
+    if (!static_cache_init(STATIC_ROOT)) {
+        fprintf(stderr, "Nepodarilo sa načítať statické súbory z %s\n", STATIC_ROOT);
+    } else if (get_env_int("STATIC_RELOAD", 0)) {
+        static_cache_watch();
+    }
+
+    // Slovníky pre /api/passphrase (zoznam súborov oddelených dvojbodkou);
+    // vstavaný slovník slabík je k dispozícii vždy.
+    const char *wordlists = getenv("PASSPHRASE_WORDLISTS");
+    if (!passphrase_init(wordlists)) {
+        exit(EXIT_FAILURE);
+    }
+    if (wordlists && *wordlists) {
+        for (int i = 0; passphrase_list_name(i); i++) {
+            printf("Slovník fráz: %s (%u slov)\n", passphrase_list_name(i), passphrase_list_size(i));
+        }
+    }
+
+    // Pomenované politiky generovania hesiel (okrem vstavaných voliteľne zo súboru).
+    const char *policy_path = getenv("PASSWORD_POLICIES");
+    if (!policy_load(policy_path)) {
+        exit(EXIT_FAILURE);
+    }
+    if (policy_path && *policy_path) {
+        printf("Politiky hesiel: %s (%d politík)\n", policy_path, policy_count());
+    }
+
+    // Markovov model odhadu pokusov (voliteľný); bez neho sa pokusy odhadujú len podľa vzorov.
+    const char *markov_path = getenv("MARKOV_MODEL");
+    if (markov_path && *markov_path) {
+        if (!markov_open(markov_path)) {
+            exit(EXIT_FAILURE);
         }
+        printf("Markovov model: %s (%llu hesiel)\n", markov_path, (unsigned long long)markov_passwords());
+    }
 
-        // Spracovanie spojenia
-        handle_connection(client_socket);
+    // Index uniknutých hesiel (voliteľný); bez neho sa heslá hodnotia len podľa znakov.
+    const char *breach_path = getenv("BREACH_INDEX");
+    if (breach_path && *breach_path) {
+        if (!breach_index_open(breach_path)) {
+            exit(EXIT_FAILURE);
+        }
+        printf("Index uniknutých hesiel: %s (%llu hesiel)\n", breach_path,
+               (unsigned long long)breach_index_count());
     }
 
-    // Uvoľnenie zdrojov
+    // Cache odpovedí /api/evaluate (EVAL_CACHE_MB=0 ju vypne); každý proces má vlastnú
+    // pamäť aj tajný kľúč, takže kľúče záznamov sa nedajú predpovedať zvonku.
+    const char *cache_mb = getenv("EVAL_CACHE_MB");
+    if (!cache_mb || strcmp(cache_mb, "0") != 0) {
+        size_t cache_bytes = (size_t)get_env_int("EVAL_CACHE_MB", DEFAULT_EVAL_CACHE_MB) << 20;
+        if (!eval_cache_init(cache_bytes, get_env_int("EVAL_CACHE_TTL_MS", DEFAULT_EVAL_CACHE_TTL_MS))) {
+            fprintf(stderr, "Cache vyhodnotení je vypnutá\n");
+        }
+    }
+
+    // Prijímanie požiadaviek: limit na IP adresu (voliteľný) a na počet rozpracovaných.
+    AdmissionConfig admission;
+    admission.rate = get_env_int("ADMISSION_RATE", 0);
+    admission.burst = get_env_int("ADMISSION_BURST", 0);
+    admission.max_in_flight = get_env_int("MAX_IN_FLIGHT", DEFAULT_MAX_IN_FLIGHT);
+    if (!admission_init(&admission)) {
+        fprintf(stderr, "Limity klientov sú vypnuté\n");
+    }
+
+    // Access log (voliteľný); zapisuje ho samostatné vlákno, nie event loopy.
+    const char *access_log_path = getenv("ACCESS_LOG");
+    if (access_log_path && *access_log_path) {
+        // Každý pracovný proces píše a otáča vlastný súbor (log.0, log.1, ...).
+        static char worker_log_path[4096];
+        if (worker_index >= 0 && strcmp(access_log_path, "-") != 0) {
+            snprintf(worker_log_path, sizeof(worker_log_path), "%s.%d", access_log_path, worker_index);
+            access_log_path = worker_log_path;
+        }
+        const char *level_name = getenv("ACCESS_LOG_LEVEL");
+        int level = level_name ? access_log_parse_level(level_name) : ACCESS_LOG_INFO;
+        if (level < 0) {
+            fprintf(stderr, "Neznáma úroveň ACCESS_LOG_LEVEL: %s\n", level_name);
+            level = ACCESS_LOG_INFO;
+        }
+        AccessLogConfig log_config;
+        log_config.path = access_log_path;
+        log_config.level = (AccessLogLevel)level;
+        log_config.sample = get_env_int("ACCESS_LOG_SAMPLE", 1);
+        log_config.max_size = (size_t)get_env_int("ACCESS_LOG_MAX_MB", DEFAULT_ACCESS_LOG_MAX_MB) << 20;
+        log_config.max_files = get_env_int("ACCESS_LOG_FILES", DEFAULT_ACCESS_LOG_FILES);
+        log_config.capacity = (size_t)get_env_int("ACCESS_LOG_BUFFER", DEFAULT_ACCESS_LOG_BUFFER);
+        if (!access_log_init(&log_config)) {
+            fprintf(stderr, "Nepodarilo sa otvoriť access log %s\n", access_log_path);
+        }
+    }
+
+    // Spustenie pracovných vlákien, ktoré obsluhujú spojenia paralelne.
+    // Pracovný proces je pripnutý na jedno CPU, preto mu predvolene stačí jedno vlákno.
+    int default_threads = worker_index >= 0 ? 1 : thread_pool_default_size();
+    int thread_count = get_env_int("SERVER_THREADS", default_threads);
+    if (thread_count > MAX_WORKER_THREADS) thread_count = MAX_WORKER_THREADS;
+    int queue_capacity = get_env_int("SERVER_QUEUE_SIZE", DEFAULT_QUEUE_CAPACITY);
+    server_config.keepalive_timeout_ms = get_env_int("KEEPALIVE_TIMEOUT_MS", DEFAULT_KEEPALIVE_TIMEOUT_MS);
+    server_config.keepalive_max_requests = get_env_int("KEEPALIVE_MAX_REQUESTS", DEFAULT_KEEPALIVE_MAX_REQUESTS);
+
+    // Výpočtové vlákna pre CPU náročné dávkové požiadavky.
+    int compute_threads = get_env_int("COMPUTE_THREADS", default_threads);
+    if (compute_threads > MAX_COMPUTE_THREADS) compute_threads = MAX_COMPUTE_THREADS;
+    if (!compute_pool_init(compute_threads)) {
+        fprintf(stderr, "Nepodarilo sa spustiť výpočtové vlákna, dávky sa spracujú v event loope\n");
+    }
+
+    static ThreadPool pool;
+    if (!thread_pool_init(&pool, thread_count, (size_t)queue_capacity)) {
+        fprintf(stderr, "Nepodarilo sa spustiť pracovné vlákna\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (worker_index >= 0) {
+        printf("Pracovný proces %d (PID %d) počúva na porte %d (%d vlákien)\n",
+               worker_index, (int)getpid(), server_config.port, pool.thread_count);
+    } else {
+        printf("Server počúva na http://localhost:%d (%d vlákien)\n", server_config.port, pool.thread_count);
+    }
+    if (unix_fd >= 0) {
+        printf("Binárny protokol na Unix sockete %s\n", unix_path);
+    }
+    fflush(stdout);
+    supervisor_notify_ready(ready_fd);
+
+    // Prijímanie spojení, kým nepríde signál na ukončenie (poll() záporný
+    // deskriptor vypnutého Unix socketu ignoruje).
+    struct pollfd fds[3] = {{server_fd, POLLIN, 0}, {signal_fd, POLLIN, 0}, {unix_fd, POLLIN, 0}};
+    while (1) {
+        if (poll(fds, 3, -1) < 0) {
+            if (errno != EINTR) perror("poll");
+            continue;
+        }
+        if (fds[1].revents & POLLIN) break;
+        if (fds[0].revents & POLLIN) accept_pending(server_fd, &pool, CONNECTION_HTTP);
+        if (fds[2].revents & POLLIN) accept_pending(unix_fd, &pool, CONNECTION_BINARY);
+    }
+    struct signalfd_siginfo info;
+    if (read(signal_fd, &info, sizeof(info)) < 0) perror("signalfd");
+
+    // Spojenia, ktoré jadro už nadviazalo, sa ešte obslúžia; potom sa socket
+    // zavrie a nové spojenia dostanú ostatné procesy na porte.
+    accept_pending(server_fd, &pool, CONNECTION_HTTP);
     close(server_fd);
+    if (unix_fd >= 0) {
+        accept_pending(unix_fd, &pool, CONNECTION_BINARY);
+        close_unix_listener(unix_fd, unix_path, &unix_file);
+    }
+    printf("Ukončujem: čakám na %zu otvorených spojení\n", thread_pool_connections(&pool));
+    fflush(stdout);
+    drain_connections(&pool, signal_fd);
+    access_log_flush();
+    close(signal_fd);
 }
 
 /**
- * @brief Spracuje jedno prichádzajúce klientske HTTP spojenie.
- * 
- * Prečíta HTTP požiadavku, odovzdá ju na spracovanie
- * a nakoniec uzavrie socket.
- * 
- * @param client_socket Socket pripojeného klienta.
+ * @brief Vyberie politiku a dĺžku hesla pre /api/generate a /api/generate/batch.
+ *
+ * Politika sa určí podľa `policy` alebo `policyId`, inak podľa volieb
+ * include* (predpočítané kombinácie tried). Dĺžka mimo rozsahu
+ * MIN_PASSWORD_LENGTH až MAX_PASSWORD_LENGTH sa nahradí predvolenou dĺžkou politiky.
+ *
+ * @return Politika alebo NULL, ak zadaná politika neexistuje.
+ */
+static const PasswordPolicy *request_policy(const GenerateRequest *params, int *length) {
+    const PasswordPolicy *policy;
+    if (params->policy.data) {
+        policy = policy_find(params->policy.data, params->policy.length);
+    } else if (params->policy_id) {
+        policy = policy_by_id(params->policy_id);
+    } else {
+        policy = policy_for_classes(params->include_symbols, params->include_numbers,
+                                    params->include_uppercase, params->include_lowercase);
+    }
+    if (!policy) return NULL;
+    *length = params->length;
+    if (*length < MIN_PASSWORD_LENGTH || *length > MAX_PASSWORD_LENGTH) {
+        *length = policy->default_length;
+    }
+    return policy;
+}
+
+// Stav streamovaného dávkového generovania hesiel.
+typedef struct {
+    long remaining;          // Počet hesiel, ktoré ešte treba vygenerovať.
+    PasswordContext *context; // Politika a dĺžka hesiel dávky.
+    int include_score;       // Pridať ku každému heslu skóre (všetky kontroly ako /api/evaluate).
+    int chunked;             // 0 pre klientov HTTP/1.0 (telo končí zatvorením spojenia).
+    char passwords[BATCH_GENERATE_GROUP][MAX_PASSWORD_LENGTH + 1];
+    char chunk[BATCH_CHUNK_SIZE];
+} BatchGenerateStream;
+
+static void batch_generate_free(void *state) {
+    BatchGenerateStream *stream = (BatchGenerateStream *)state;
+    password_context_destroy(stream->context);
+    free(stream);
+}
+
+/**
+ * @brief Vygeneruje ďalší chunk NDJSON riadkov dávkového generovania.
+ *
+ * Heslá sa generujú a vyhodnocujú po skupinách dávkovými funkciami libpassword.
+ * Jedno volanie vyrobí najviac BATCH_CHUNK_SIZE bajtov, takže v pamäti je
+ * naraz len malá časť dávky; ďalšie volanie príde, až keď klient výstup prečíta.
  */
-void handle_connection(int client_socket) {
-    char buffer[BUFFER_SIZE] = {0};
-    int bytes_read = 0;
-    int total_bytes_read = 0;
-
-    // Nastavenie neblokujúceho režimu pre socket
-    int flags = fcntl(client_socket, F_GETFL, 0);
-    fcntl(client_socket, F_SETFL, flags | O_NONBLOCK);
-
-    // Čítanie s časovým limitom, aby sme počkali na prichádzajúce dáta
-    fd_set readfds;
-    struct timeval tv;
-    int retval;
-
-    // Čakáme maximálne 1 sekundu na dáta
-    tv.tv_sec = 1;
-    tv.tv_usec = 0;
-
-    FD_ZERO(&readfds);
-    FD_SET(client_socket, &readfds);
-
-    retval = select(client_socket + 1, &readfds, NULL, NULL, &tv);
-
-    if (retval == -1) {
-        perror("select()");
-    } else if (retval) {
-        // Dáta sú k dispozícii, čítame ich v cykle
-        do {
-            bytes_read = read(client_socket, buffer + total_bytes_read, BUFFER_SIZE - 1 - total_bytes_read);
-            if (bytes_read > 0) {
-                total_bytes_read += bytes_read;
-            }
-        } while (bytes_read > 0 && total_bytes_read < BUFFER_SIZE - 1);
-    }
-    // Ak po časovom limite neprišli žiadne dáta, total_bytes_read bude 0
-
-    // Diagnostický výpis prijatej požiadavky na konzolu
-    printf("--- Prijatá požiadavka (%d bytes) ---\n%s\n--------------------------\n", total_bytes_read, buffer);
-    
-    // Ak sme nič neprečítali, nemá zmysel pokračovať
-    if (total_bytes_read > 0) {
-        // Všetku logiku spracovania presunieme do funkcie handle_request
-        handle_request(client_socket, buffer);
-    }
-
-    // Uzavretie spojenia
-    close(client_socket);
+static int batch_generate_produce(Connection *conn, void *state) {
+    BatchGenerateStream *stream = (BatchGenerateStream *)state;
+    size_t used = 0;
+
+    // Riadok má najviac MAX_PASSWORD_LENGTH znakov hesla a pár desiatok bajtov okolo.
+    size_t count = sizeof(stream->chunk) / (MAX_PASSWORD_LENGTH + 64);
+    if (count > BATCH_GENERATE_GROUP) count = BATCH_GENERATE_GROUP;
+    if ((long)count > stream->remaining) count = (size_t)stream->remaining;
+    if (!password_generate_batch(stream->context, count, stream->passwords[0], sizeof(stream->passwords[0]))) {
+        return -1;
+    }
+    uint8_t scores[BATCH_GENERATE_GROUP];
+    uint8_t strong[BATCH_GENERATE_GROUP];
+    if (stream->include_score) {
+        const char *passwords[BATCH_GENERATE_GROUP];
+        for (size_t i = 0; i < count; i++) passwords[i] = stream->passwords[i];
+        PasswordEvaluations results = {scores, strong, NULL, NULL};
+        password_evaluate_batch(stream->context, count, passwords, NULL, &results);
+    }
+
+    // Vygenerované heslá neobsahujú úvodzovky ani spätné lomky, escapovanie netreba.
+    for (size_t i = 0; i < count; i++) {
+        int written;
+        if (stream->include_score) {
+            written = snprintf(stream->chunk + used, sizeof(stream->chunk) - used,
+                               "{\"password\":\"%s\",\"score\":%d,\"strong\":%s}\n",
+                               stream->passwords[i], scores[i], strong[i] ? "true" : "false");
+        } else {
+            written = snprintf(stream->chunk + used, sizeof(stream->chunk) - used,
+                               "{\"password\":\"%s\"}\n", stream->passwords[i]);
+        }
+        used += (size_t)written;
+    }
+    stream->remaining -= (long)count;
+
+    if (!stream->chunked) {
+        if (!connection_send(conn, stream->chunk, used)) return -1;
+        return stream->remaining > 0;
+    }
+    if (used > 0 && !connection_send_chunk(conn, stream->chunk, used)) return -1;
+    if (stream->remaining > 0) return 1;
+    return connection_send_chunk(conn, NULL, 0) ? 0 : -1;
+}
+
+/**
+ * @brief Spustí dávkové generovanie hesiel streamované ako NDJSON.
+ *
+ * Telo požiadavky obsahuje `count` a rovnaké parametre ako `/api/generate`,
+ * voliteľne `includeScore`. Každé heslo je jeden riadok JSON; odpoveď sa
+ * posiela po chunkoch (`Transfer-Encoding: chunked`) tempom, akým ju klient číta.
+ *
+ * @return 1 ak bol stream spustený, 0 pri neplatných parametroch, -1 pri
+ *         chybe alokácie.
+ */
+static int start_batch_generate(Connection *conn, const HttpRequest *request, const GenerateRequest *params) {
+    if (params->count < 1 || params->count > MAX_BATCH_COUNT) return 0;
+    int length;
+    const PasswordPolicy *policy = request_policy(params, &length);
+    // Overenie parametrov skôr, než sa odošlú hlavičky 200.
+    if (!policy || length < policy->min_length) return 0;
+
+    BatchGenerateStream *stream = (BatchGenerateStream *)malloc(sizeof(BatchGenerateStream));
+    if (!stream) return -1;
+    stream->context = password_context_create(LIBPASSWORD_VERSION);
+    if (!stream->context) {
+        free(stream);
+        return -1;
+    }
+    if (policy->name[0]) {
+        password_context_set_policy(stream->context, policy->name);
+    } else {
+        password_context_set_classes(stream->context, params->include_symbols, params->include_numbers,
+                                     params->include_uppercase, params->include_lowercase);
+    }
+    password_context_set_length(stream->context, length);
+    stream->remaining = params->count;
+    stream->include_score = params->include_score;
+
+    // HTTP/1.0 nepozná chunked kódovanie: telo sa ukončí zatvorením spojenia.
+    stream->chunked = request->version_minor > 0;
+    if (!stream->chunked) {
+        conn->keep_alive = 0;
+    }
+
+    connection_sendf(conn,
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/x-ndjson\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "Access-Control-Allow-Methods: POST, GET, OPTIONS\r\n"
+        "Access-Control-Allow-Headers: Content-Type\r\n"
+        "%s"
+        "%s"
+        "\r\n",
+        stream->chunked ? "Transfer-Encoding: chunked\r\n" : "",
+        connection_header(conn));
+    connection_stream(conn, batch_generate_produce, stream, batch_generate_free);
+    return 1;
+}
+
+size_t request_body_limit(const HttpRequest *request) {
+    if (http_slice_equals(request->method, "POST") &&
+        http_slice_equals(request->path, "/api/evaluate/batch")) {
+        return MAX_EVALUATE_BATCH_BODY_SIZE;
+    }
+    return MAX_BODY_SIZE;
+}
+
+MetricsRoute request_route(const HttpRequest *request) {
+    if (http_slice_equals(request->method, "GET")) {
+        if (http_slice_equals(request->path, "/metrics")) return METRICS_ROUTE_METRICS;
+        return http_slice_equals(request->path, "/api/policies") ? METRICS_ROUTE_POLICIES : METRICS_ROUTE_STATIC;
+    }
+    if (http_slice_equals(request->method, "OPTIONS")) return METRICS_ROUTE_OPTIONS;
+    if (!http_slice_equals(request->method, "POST")) return METRICS_ROUTE_OTHER;
+    if (http_slice_equals(request->path, "/api/generate")) return METRICS_ROUTE_GENERATE;
+    if (http_slice_equals(request->path, "/api/generate/batch")) return METRICS_ROUTE_GENERATE_BATCH;
+    if (http_slice_equals(request->path, "/api/evaluate")) return METRICS_ROUTE_EVALUATE;
+    if (http_slice_equals(request->path, "/api/evaluate/batch")) return METRICS_ROUTE_EVALUATE_BATCH;
+    if (http_slice_equals(request->path, "/api/strengthen")) return METRICS_ROUTE_STRENGTHEN;
+    if (http_slice_equals(request->path, "/api/passphrase")) return METRICS_ROUTE_PASSPHRASE;
+    return METRICS_ROUTE_OTHER;
+}
+
+/**
+ * @brief Prevedie parametre /api/passphrase na voľby generátora.
+ *
+ * Chýbajúce voľby dostanú predvolené hodnoty (PASSPHRASE_DEFAULT_WORDS slov,
+ * oddeľovač "-", predvolený slovník).
+ *
+ * @param error Pri neplatných voľbách dostane chybovú správu pre klienta.
+ * @return 1 ak sú voľby platné, inak 0.
+ */
+static int passphrase_options_from_request(const PassphraseRequest *params, PassphraseOptions *options,
+                                           const char **error) {
+    options->list = passphrase_find_list(params->wordlist.data, params->wordlist.length);
+    if (options->list < 0) {
+        *error = "Unknown wordlist";
+        return 0;
+    }
+    options->words = params->words ? params->words : PASSPHRASE_DEFAULT_WORDS;
+    options->separator = params->separator.data ? params->separator.data : "-";
+    options->separator_length = params->separator.data ? params->separator.length : 1;
+    options->digits = params->digits;
+    const JsonString *caps = &params->capitalize;
+    if (!caps->data || (caps->length == 4 && memcmp(caps->data, "none", 4) == 0)) {
+        options->caps = PASSPHRASE_CAPS_NONE;
+    } else if (caps->length == 5 && memcmp(caps->data, "first", 5) == 0) {
+        options->caps = PASSPHRASE_CAPS_FIRST;
+    } else if (caps->length == 6 && memcmp(caps->data, "random", 6) == 0) {
+        options->caps = PASSPHRASE_CAPS_RANDOM;
+    } else {
+        *error = "Invalid capitalize (none, first, random)";
+        return 0;
+    }
+    if (!passphrase_options_valid(options)) {
+        *error = "Invalid passphrase options";
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Zapíše odpoveď /api/evaluate: skóre, spätnú väzbu a odhad času
+ *        prelomenia pri rôznych rýchlostiach útoku.
+ */
+static int write_evaluation(Buffer *body, const PasswordStrength *result) {
+    double guesses = pow(10.0, result->guesses_log10);
+    char feedback[PASSWORD_FEEDBACK_SIZE];
+    size_t feedback_length = format_password_feedback(result->reasons, result->is_strong, feedback, sizeof(feedback));
+    return JSON_APPEND_LITERAL(body, "{ \"score\": ") &&
+           json_append_int(body, result->score) &&
+           JSON_APPEND_LITERAL(body, ", \"feedback\": ") &&
+           json_append_string(body, feedback, feedback_length) &&
+           buffer_appendf(body, ", \"guessesLog10\": %.2f, \"crackSeconds\": { "
+                          "\"onlineThrottled\": %.3g, \"online\": %.3g, "
+                          "\"offlineSlowHash\": %.3g, \"offlineFastHash\": %.3g } }",
+                          result->guesses_log10, guesses / CRACK_RATE_ONLINE_THROTTLED,
+                          guesses / CRACK_RATE_ONLINE, guesses / CRACK_RATE_OFFLINE_SLOW,
+                          guesses / CRACK_RATE_OFFLINE_FAST);
+}
+
+/**
+ * @brief Zapíše odpoveď /api/passphrase: jednu frázu alebo pole `count` fráz
+ *        spolu s entropiou jednej frázy a použitým slovníkom.
+ */
+static int write_passphrases(Buffer *body, const PassphraseOptions *options, int count) {
+    char passphrase[PASSPHRASE_MAX_LENGTH];
+    int ok = count > 0 ? JSON_APPEND_LITERAL(body, "{ \"passphrases\": [") :
+                         JSON_APPEND_LITERAL(body, "{ \"passphrase\": ");
+    for (int i = 0; ok && i < (count > 0 ? count : 1); i++) {
+        size_t length = passphrase_generate(options, passphrase);
+        ok = (i == 0 || JSON_APPEND_LITERAL(body, ", ")) &&
+             json_append_string(body, passphrase, length);
+    }
+    const char *name = passphrase_list_name(options->list);
+    return ok && (count == 0 || JSON_APPEND_LITERAL(body, "]")) &&
+           buffer_appendf(body, ", \"entropy\": %.2f, \"wordlist\": ", passphrase_entropy(options)) &&
+           json_append_string(body, name, strlen(name)) &&
+           JSON_APPEND_LITERAL(body, ", \"wordlistSize\": ") &&
+           json_append_int(body, (long)passphrase_list_size(options->list)) &&
+           JSON_APPEND_LITERAL(body, " }");
 }
 
 /**
  * @brief Parzuje a spracováva HTTP požiadavku.
  * 
  * Táto funkcia je hlavným smerovačom aplikácie. Rozlišuje medzi požiadavkami
- * na statické súbory (GET) a API volaniami (POST, OPTIONS) a posiela odpovede.
+ * na statické súbory (GET) a API volaniami (POST, OPTIONS) a odpovede
+ * zapisuje do výstupného buffera spojenia.
  * 
- * @param client_socket Socket pripojeného klienta pre odosielanie odpovedí.
- * @param request Reťazec obsahujúci celú HTTP požiadavku.
+ * @param conn Spojenie klienta pre odosielanie odpovedí.
+ * @param request Naparsovaná požiadavka; telo je ukončené nulou.
  */
-void handle_request(int client_socket, const char *request) {
+void handle_request(Connection *conn, const HttpRequest *request) {
     // --- Spracovanie GET požiadaviek na statické súbory ---
-    if (strncmp(request, "GET ", 4) == 0) {
+    if (http_slice_equals(request->method, "GET")) {
+        if (http_slice_equals(request->path, "/metrics")) {
+            send_metrics(conn);
+            return;
+        }
+        if (http_slice_equals(request->path, "/api/policies")) {
+            send_policies(conn);
+            return;
+        }
         char path[256];
-        sscanf(request, "GET %255s", path);
+        // Query string (napr. "?v=2") nie je súčasťou cesty k súboru.
+        const char *query = memchr(request->path.data, '?', request->path.length);
+        size_t path_length = query ? (size_t)(query - request->path.data) : request->path.length;
+        if (path_length > sizeof(path) - 1) path_length = sizeof(path) - 1;
+        memcpy(path, request->path.data, path_length);
+        path[path_length] = '\0';
         // Ak je cesta "/", servírujeme index.html
         if (strcmp(path, "/") == 0) {
-            serve_static_file(client_socket, "/index.html");
+            serve_static_file(conn, request, "/index.html");
         } else {
-            serve_static_file(client_socket, path);
+            serve_static_file(conn, request, path);
         }
         return;
     }
 
-    // --- Spracovanie API požiadaviek (POST, OPTIONS) ---
-    char response[BUFFER_SIZE] = {0};
-    char json_response[1024] = "{ \"error\": \"Invalid request\" }"; // Predvolená chybová správa
-
     // --- Obsluha pre OPTIONS (CORS preflight) ---
     // Potrebné pre moderné prehliadače na povolenie Cross-Origin požiadaviek.
-    if (strncmp(request, "OPTIONS /api/", 13) == 0) {
-        sprintf(response, 
-            "HTTP/1.1 204 No Content\r\n"
-            "Access-Control-Allow-Origin: *\r\n"
-            "Access-Control-Allow-Methods: POST, GET, OPTIONS\r\n"
-            "Access-Control-Allow-Headers: Content-Type\r\n"
-            "Connection: keep-alive\r\n"
-            "\r\n");
-        write(client_socket, response, strlen(response));
+    if (http_slice_equals(request->method, "OPTIONS") &&
+        request->path.length >= 5 && memcmp(request->path.data, "/api/", 5) == 0) {
+        const char *connection = connection_header(conn);
+        connection_send_static(conn, api_preflight_head, sizeof(api_preflight_head) - 1);
+        connection_send_static(conn, connection, strlen(connection));
+        connection_send_static(conn, "\r\n", 2);
         return;
     }
 
     // --- Spracovanie POST požiadaviek na API endpointy ---
+    int is_post = http_slice_equals(request->method, "POST");
+
+    // Endpoint na dávkové vyhodnotenie hesiel (výpočet vo výpočtovom poole)
+    if (is_post && http_slice_equals(request->path, "/api/evaluate/batch")) {
+        evaluate_batch_handle(conn, request);
+        return;
+    }
+
+    // Telo sa parsuje jedným prechodom do štruktúry daného endpointu; reťazce
+    // sa dekódujú na mieste v tele, takže nič sa nealokuje ani nekopíruje.
+    // Odpoveď sa zapisuje priamo do výstupného buffera spojenia.
+    Buffer *body = NULL;
+    int written = 0;
+
+    // Endpoint na dávkové generovanie hesiel (streamovaná odpoveď)
+    if (is_post && http_slice_equals(request->path, "/api/generate/batch")) {
+        GenerateRequest params;
+        if (!api_parse_generate_batch_request(request->body, request->body_length, &params)) {
+            send_bad_request(conn);
+            return;
+        }
+        int started = start_batch_generate(conn, request, &params);
+        if (started < 0) {
+            send_out_of_memory(conn);
+            return;
+        }
+        if (started) return;
 
     // Endpoint na generovanie hesla
-    if (strncmp(request, "POST /api/generate", 18) == 0) {
-        const char* body = strstr(request, "\r\n\r\n"); // Nájdenie tela požiadavky
-        if (body) {
-            // Parsovanie parametrov z JSON tela
-            int length = get_json_int_value(body, "length");
-            int upper = get_json_int_value(body, "includeUppercase");
-            int lower = get_json_int_value(body, "includeLowercase");
-            int nums = get_json_int_value(body, "includeNumbers");
-            int syms = get_json_int_value(body, "includeSymbols");
-
-            // Validácia dĺžky, aby sa predišlo chybám
-            if (length < MIN_PASSWORD_LENGTH || length > MAX_PASSWORD_LENGTH) {
-                length = 12; // Predvolená hodnota
-            }
-
-            char password[MAX_PASSWORD_LENGTH + 1] = {0};
-            if (generate_password(password, length, syms, nums, upper, lower)) {
-                PasswordStrength result;
-                evaluate_password_strength(password, &result); // Vyhodnotenie sily vygenerovaného hesla
-                // Vytvorenie JSON odpovede s heslom a jeho skóre
-                sprintf(json_response, "{ \"password\": \"%s\", \"score\": %d, \"feedback\": \"%s\" }", 
-                        password, result.score, result.feedback);
-            }
+    } else if (is_post && http_slice_equals(request->path, "/api/generate")) {
+        GenerateRequest params;
+        if (!api_parse_generate_request(request->body, request->body_length, &params)) {
+            send_bad_request(conn);
+            return;
+        }
+        int length;
+        const PasswordPolicy *policy = request_policy(&params, &length);
+        if (!policy) {
+            metrics_error(METRICS_ERROR_BAD_REQUEST);
+            send_json_error(conn, api_bad_request_head, sizeof(api_bad_request_head) - 1, "Unknown policy");
+            return;
+        }
+
+        char password[MAX_PASSWORD_LENGTH + 1] = {0};
+        if (policy_generate(policy, length, password)) {
+            PasswordStrength result;
+            evaluate_password_strength(password, &result); // Vyhodnotenie sily vygenerovaného hesla
+            char feedback[PASSWORD_FEEDBACK_SIZE];
+            size_t feedback_length = format_password_feedback(result.reasons, result.is_strong,
+                                                              feedback, sizeof(feedback));
+            // JSON odpoveď s heslom a jeho skóre
+            body = connection_begin_body(conn);
+            written = JSON_APPEND_LITERAL(body, "{ \"password\": ") &&
+                      json_append_string(body, password, strlen(password)) &&
+                      JSON_APPEND_LITERAL(body, ", \"score\": ") &&
+                      json_append_int(body, result.score) &&
+                      JSON_APPEND_LITERAL(body, ", \"feedback\": ") &&
+                      json_append_string(body, feedback, feedback_length) &&
+                      JSON_APPEND_LITERAL(body, " }");
         }
 
     // Endpoint na vyhodnotenie hesla
-    } else if (strncmp(request, "POST /api/evaluate", 18) == 0) {
-        const char* body = strstr(request, "\r\n\r\n");
-        if (body) {
-            char* password = get_json_string_value(body, "password");
-            if (password) {
-                PasswordStrength result;
-                evaluate_password_strength(password, &result);
-                // Vytvorenie JSON odpovede so skóre a spätnou väzbou
-                sprintf(json_response, "{ \"score\": %d, \"feedback\": \"%s\" }", result.score, result.feedback);
-                free(password); // Uvoľnenie pamäte alokovanej v get_json_string_value
-            }
+    } else if (is_post && http_slice_equals(request->path, "/api/evaluate")) {
+        PasswordRequest params;
+        if (!api_parse_password_request(request->body, request->body_length, &params)) {
+            send_bad_request(conn);
+            return;
         }
+        // Opakované heslo sa neprepočítava: z cache sa vezme hotový výsledok
+        // a odpoveď sa z neho len naformátuje.
+        EvalCacheKey key;
+        PasswordStrength result;
+        int cached = eval_cache_enabled();
+        if (cached) eval_cache_key(params.password.data, params.password.length, &key);
+        if (!cached || !eval_cache_lookup(&key, &result)) {
+            evaluate_password_strength(params.password.data, &result);
+            if (cached) eval_cache_store(&key, &result);
+        }
+        body = connection_begin_body(conn);
+        written = write_evaluation(body, &result);
 
     // Endpoint na vylepšenie hesla
-    } else if (strncmp(request, "POST /api/strengthen", 20) == 0) {
-        const char* body = strstr(request, "\r\n\r\n");
-        if (body) {
-            char* password = get_json_string_value(body, "password");
-            if (password) {
-                char strong_password[MAX_PASSWORD_LENGTH + 1] = {0};
-                strengthen_password(password, strong_password);
-                // Vytvorenie JSON odpovede s vylepšeným heslom
-                sprintf(json_response, "{ \"strong_password\": \"%s\" }", strong_password);
-                free(password); // Uvoľnenie pamäte
-            }
+    } else if (is_post && http_slice_equals(request->path, "/api/strengthen")) {
+        PasswordRequest params;
+        if (!api_parse_password_request(request->body, request->body_length, &params)) {
+            send_bad_request(conn);
+            return;
+        }
+        char strong_password[MAX_PASSWORD_LENGTH + 1] = {0};
+        strengthen_password(params.password.data, strong_password);
+        // JSON odpoveď s vylepšeným heslom
+        body = connection_begin_body(conn);
+        written = JSON_APPEND_LITERAL(body, "{ \"strong_password\": ") &&
+                  json_append_string(body, strong_password, strlen(strong_password)) &&
+                  JSON_APPEND_LITERAL(body, " }");
+
+    // Endpoint na generovanie prístupovej frázy zo slovníka
+    } else if (is_post && http_slice_equals(request->path, "/api/passphrase")) {
+        PassphraseRequest params;
+        if (!api_parse_passphrase_request(request->body, request->body_length, &params)) {
+            send_bad_request(conn);
+            return;
+        }
+        PassphraseOptions options;
+        const char *error = NULL;
+        if (params.count < 0 || params.count > MAX_PASSPHRASE_COUNT) {
+            error = "Invalid count";
+        } else {
+            passphrase_options_from_request(&params, &options, &error);
+        }
+        if (error) {
+            metrics_error(METRICS_ERROR_BAD_REQUEST);
+            send_json_error(conn, api_bad_request_head, sizeof(api_bad_request_head) - 1, error);
+            return;
         }
+        body = connection_begin_body(conn);
+        written = write_passphrases(body, &options, params.count);
     }
 
-    // Vytvorenie finálnej HTTP odpovede s JSON obsahom a CORS hlavičkami
-    sprintf(response, 
-        "HTTP/1.1 200 OK\r\n"
-        "Content-Type: application/json\r\n"
-        "Access-Control-Allow-Origin: *\r\n" // Povoľuje prístup z akejkoľvek domény
-        "Access-Control-Allow-Methods: POST, GET, OPTIONS\r\n"
-        "Access-Control-Allow-Headers: Content-Type\r\n"
-        "Content-Length: %zu\r\n"
-        "\r\n"
-        "%s",
-        strlen(json_response), json_response);
-    
-    // Odoslanie odpovede klientovi
-    write(client_socket, response, strlen(response));
+    if (written) {
+        connection_end_body(conn, api_ok_head, sizeof(api_ok_head) - 1);
+        return;
+    }
+    // Neznámy endpoint alebo neplatné parametre (predvolená chybová správa).
+    if (body) connection_cancel_body(conn);
+    send_json_error(conn, api_ok_head, sizeof(api_ok_head) - 1, "Invalid request");
 }
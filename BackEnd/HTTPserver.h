@@ -8,50 +8,90 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include "Connection.h"
+#include "Metrics.h"
 
-// Definícia portu, na ktorom bude server počúvať
+// Predvolený port, na ktorom bude server počúvať
 #define PORT 8080
-// Maximálna veľkosť buffera pre požiadavky
-#define BUFFER_SIZE 4096
+// Predvolená dĺžka fronty nadviazaných spojení v jadre, ktoré ešte neprevzal accept()
+#define DEFAULT_LISTEN_BACKLOG SOMAXCONN
+// Ako dlho končiaci proces čaká na dobehnutie otvorených spojení (ms)
+#define DEFAULT_DRAIN_TIMEOUT_MS 30000
+// Ako často sa pri ukončovaní kontroluje počet otvorených spojení (ms)
+#define DRAIN_POLL_MS 50
+// Maximálny počet hesiel v jednej požiadavke na /api/generate/batch
+#define MAX_BATCH_COUNT 1000000
+// Maximálny počet fráz v jednej odpovedi /api/passphrase
+#define MAX_PASSPHRASE_COUNT 1000
+// Veľkosť jedného chunku streamovanej NDJSON odpovede
+#define BATCH_CHUNK_SIZE 16384
+// Počet hesiel generovaných (a vyhodnotených) naraz jedným volaním libpassword
+#define BATCH_GENERATE_GROUP 64
+
+// Nastavenia servera načítané pri štarte z argumentov a premenných prostredia.
+typedef struct {
+    int keepalive_timeout_ms;     // Čas nečinnosti, po ktorom sa keep-alive spojenie zavrie.
+    int keepalive_max_requests;   // Maximálny počet požiadaviek na jednom spojení.
+    int port;                     // Port (0 = z SERVER_PORT alebo PORT).
+    int listen_backlog;           // Dĺžka fronty listen() (0 = z SERVER_BACKLOG alebo predvolená).
+    int worker_processes;         // Počet pracovných procesov (0 = z SERVER_WORKERS alebo 1).
+    char **argv;                  // Argumenty programu na spustenie pracovných procesov.
+} ServerConfig;
+
+// Aktuálne nastavenia servera (po štarte sa už nemenia).
+extern ServerConfig server_config;
 
 /**
  * @brief Spustí HTTP server a začne počúvať na definovanom porte.
  * 
- * Táto funkcia inicializuje socket, naviaže ho na port a začne prijímať
- * prichádzajúce spojenia v nekonečnej slučke.
+ * Táto funkcia inicializuje socket, naviaže ho na port a prijíma prichádzajúce
+ * spojenia, kým nepríde SIGTERM alebo SIGINT. Spojenia obsluhujú pracovné
+ * vlákna, každé s vlastným epoll event loopom. Pri viacerých pracovných
+ * procesoch sa z procesu stane supervisor (Supervisor.h).
  */
 void start_server();
 
 /**
- * @brief Spracuje prichádzajúce HTTP spojenie.
+ * @brief Spracuje HTTP požiadavku a vygeneruje odpoveď.
  * 
- * Prečíta požiadavku od klienta, zavolá funkciu na spracovanie požiadavky
- * a odošle odpoveď späť klientovi.
+ * Táto funkcia je "srdcom" API. Podľa metódy a cesty požiadavky
+ * volá príslušné funkcie z Password.c a generuje JSON odpoveď,
+ * ktorú zapíše do výstupného buffera spojenia.
  * 
- * @param client_socket Socket klienta.
+ * @param conn Spojenie, ktorému patrí požiadavka.
+ * @param request Naparsovaná požiadavka s kompletným telom.
  */
-void handle_connection(int client_socket);
+void handle_request(Connection *conn, const HttpRequest *request);
 
 /**
- * @brief Spracuje HTTP požiadavku a vygeneruje odpoveď.
- * 
- * Táto funkcia je "srdcom" API. Parzuje URL a telo požiadavky,
- * volá príslušné funkcie z Password.c a generuje JSON odpoveď.
- * 
- * @param client_socket Socket klienta.
- * @param request Buffer obsahujúci HTTP požiadavku.
+ * @brief Určí maximálnu veľkosť tela požiadavky podľa jej cesty.
+ *
+ * Volá sa hneď po naparsovaní hlavičiek, ešte pred čítaním tela.
+ *
+ * @param request Požiadavka s naparsovanými hlavičkami.
+ * @return Limit v bajtoch (MAX_BODY_SIZE pre bežné požiadavky).
+ */
+size_t request_body_limit(const HttpRequest *request);
+
+/**
+ * @brief Určí endpoint požiadavky pre metriky času spracovania.
+ *
+ * @param request Naparsovaná požiadavka.
+ * @return Endpoint (METRICS_ROUTE_OTHER pre neznáme cesty).
  */
-void handle_request(int client_socket, const char *request);
+MetricsRoute request_route(const HttpRequest *request);
 
 /**
  * @brief Servíruje statický súbor klientovi.
  * 
- * Táto funkcia načíta obsah súboru a odošle ho ako HTTP odpoveď.
+ * Táto funkcia nájde súbor v pamäťovej cache a odošle ho ako HTTP
+ * odpoveď (prípadne 304 alebo gzip verziu podľa hlavičiek požiadavky).
  * 
- * @param client_socket Socket klienta.
+ * @param conn Spojenie klienta.
+ * @param request Požiadavka klienta.
  * @param path Cesta k súboru.
  */
-void serve_static_file(int client_socket, const char* path);
+void serve_static_file(Connection *conn, const HttpRequest *request, const char* path);
 
 /**
  * @brief Získa MIME typ súboru na základe jeho cesty.
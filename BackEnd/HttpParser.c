@@ -0,0 +1,278 @@
+#include "HttpParser.h"
+#include <string.h>
+#include <strings.h>
+
+void http_request_init(HttpRequest *request) {
+    memset(request, 0, sizeof(*request));
+}
+
+/**
+ * @brief Porovná názov hlavičky bez ohľadu na veľkosť písmen.
+ */
+static int header_name_is(const char *name, size_t name_length, const char *expected) {
+    return strlen(expected) == name_length && strncasecmp(name, expected, name_length) == 0;
+}
+
+/**
+ * @brief Naparsuje hodnotu Content-Length (len číslice, bez pretečenia).
+ *
+ * @return 1 pri úspechu, 0 ak hodnota nie je platné číslo.
+ */
+static int parse_content_length(const char *value, size_t length, size_t *out) {
+    if (length == 0 || length > 18) return 0;
+    size_t result = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (value[i] < '0' || value[i] > '9') return 0;
+        result = result * 10 + (size_t)(value[i] - '0');
+    }
+    *out = result;
+    return 1;
+}
+
+/**
+ * @brief Naparsuje prvý riadok požiadavky: `METÓDA cesta HTTP/1.x`.
+ *
+ * @return Ukazovateľ za koncom riadku alebo NULL pri chybe.
+ */
+static const char *parse_request_line(const char *p, const char *end, HttpRequest *request) {
+    const char *start = p;
+    while (p < end && *p >= 'A' && *p <= 'Z') p++;
+    if (p == start || p >= end || *p != ' ') return NULL;
+    request->method.data = start;
+    request->method.length = (size_t)(p - start);
+    p++;
+
+    start = p;
+    while (p < end && *p != ' ' && *p != '\r' && (unsigned char)*p > 0x20) p++;
+    if (p == start || p >= end || *p != ' ') return NULL;
+    if (*start != '/' && *start != '*') return NULL;
+    request->path.data = start;
+    request->path.length = (size_t)(p - start);
+    p++;
+
+    if (end - p < 10 || memcmp(p, "HTTP/1.", 7) != 0) return NULL;
+    if (p[7] != '0' && p[7] != '1') return NULL;
+    request->version_minor = p[7] - '0';
+    p += 8;
+    if (p[0] != '\r' || p[1] != '\n') return NULL;
+    return p + 2;
+}
+
+HttpParseResult http_parse_request(const char *data, size_t length, HttpRequest *request) {
+    // Hľadanie konca hlavičiek pokračuje tam, kde skončilo predchádzajúce volanie
+    // (s presahom 3 bajty, ak by "\r\n\r\n" prišlo rozdelené).
+    size_t start = request->scan_offset > 3 ? request->scan_offset - 3 : 0;
+    const char *header_end = NULL;
+
+    for (size_t i = start; i + 3 < length; i++) {
+        if (data[i] == '\r' && data[i + 1] == '\n' && data[i + 2] == '\r' && data[i + 3] == '\n') {
+            header_end = data + i;
+            break;
+        }
+    }
+
+    if (!header_end) {
+        request->scan_offset = length;
+        return length > MAX_HEADER_SIZE ? HTTP_PARSE_TOO_LARGE : HTTP_PARSE_INCOMPLETE;
+    }
+
+    size_t header_length = (size_t)(header_end - data) + 4;
+    if (header_length > MAX_HEADER_SIZE) return HTTP_PARSE_TOO_LARGE;
+
+    const char *p = data;
+    const char *end = header_end + 2; // Za posledným CRLF poslednej hlavičky.
+
+    // Prázdne riadky pred požiadavkou sa podľa RFC 9112 tolerujú.
+    while (p + 1 < end && p[0] == '\r' && p[1] == '\n') p += 2;
+
+    p = parse_request_line(p, end, request);
+    if (!p) return HTTP_PARSE_ERROR;
+
+    int has_content_length = 0;
+    while (p < end) {
+        const char *line_end = memchr(p, '\r', (size_t)(end - p));
+        if (!line_end || line_end + 1 >= end || line_end[1] != '\n') return HTTP_PARSE_ERROR;
+
+        const char *colon = memchr(p, ':', (size_t)(line_end - p));
+        if (!colon || colon == p) return HTTP_PARSE_ERROR;
+
+        // Medzera pred dvojbodkou nie je v názve hlavičky povolená.
+        for (const char *c = p; c < colon; c++) {
+            if (*c == ' ' || *c == '\t') return HTTP_PARSE_ERROR;
+        }
+
+        const char *value = colon + 1;
+        const char *value_end = line_end;
+        while (value < value_end && (*value == ' ' || *value == '\t')) value++;
+        while (value_end > value && (value_end[-1] == ' ' || value_end[-1] == '\t')) value_end--;
+
+        size_t name_length = (size_t)(colon - p);
+        HttpSlice slice = { value, (size_t)(value_end - value) };
+
+        if (header_name_is(p, name_length, "Content-Length")) {
+            size_t parsed;
+            if (!parse_content_length(value, slice.length, &parsed)) return HTTP_PARSE_ERROR;
+            // Viac rozdielnych Content-Length hlavičiek je znak pašovania požiadaviek.
+            if (has_content_length && parsed != request->content_length) return HTTP_PARSE_ERROR;
+            request->content_length = parsed;
+            has_content_length = 1;
+        } else if (header_name_is(p, name_length, "Transfer-Encoding")) {
+            request->chunked = http_slice_has_token(slice, "chunked");
+            if (!request->chunked) return HTTP_PARSE_ERROR;
+        } else if (header_name_is(p, name_length, "Connection")) {
+            request->connection = slice;
+        } else if (header_name_is(p, name_length, "Content-Type")) {
+            request->content_type = slice;
+        } else if (header_name_is(p, name_length, "Accept-Encoding")) {
+            request->accept_encoding = slice;
+        } else if (header_name_is(p, name_length, "If-None-Match")) {
+            request->if_none_match = slice;
+        } else if (header_name_is(p, name_length, "Expect")) {
+            request->expect_continue = http_slice_has_token(slice, "100-continue");
+        }
+
+        p = line_end + 2;
+    }
+
+    // Telo so súčasne uvedeným Content-Length aj chunked kódovaním odmietame.
+    if (request->chunked && has_content_length) return HTTP_PARSE_ERROR;
+
+    request->header_length = header_length;
+    return HTTP_PARSE_DONE;
+}
+
+/**
+ * @brief Nájde koniec riadku (CRLF) v rámci chunked tela.
+ *
+ * @return Dĺžka riadku bez CRLF, -1 ak riadok ešte nie je celý,
+ *         -2 pri chybe (osamotené LF alebo príliš dlhý riadok).
+ */
+static long chunk_line_length(const char *line, size_t available) {
+    const char *newline = memchr(line, '\n', available);
+    if (!newline) {
+        return available > MAX_CHUNK_LINE_SIZE ? -2 : -1;
+    }
+    size_t length = (size_t)(newline - line);
+    if (length == 0 || line[length - 1] != '\r' || length > MAX_CHUNK_LINE_SIZE) return -2;
+    return (long)(length - 1);
+}
+
+/**
+ * @brief Naparsuje veľkosť chunku (hexadecimálne, rozšírenia za ';' sa ignorujú).
+ *
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+static int parse_chunk_size(const char *line, size_t length, size_t *out) {
+    size_t result = 0;
+    size_t digits = 0;
+    while (digits < length && line[digits] != ';' && line[digits] != ' ' && line[digits] != '\t') {
+        char c = line[digits];
+        int value;
+        if (c >= '0' && c <= '9') value = c - '0';
+        else if (c >= 'a' && c <= 'f') value = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') value = c - 'A' + 10;
+        else return 0;
+        if (++digits > 15) return 0;
+        result = result * 16 + (size_t)value;
+    }
+    if (digits == 0) return 0;
+    *out = result;
+    return 1;
+}
+
+HttpParseResult http_decode_chunked(char *body, size_t available, size_t max_length, HttpRequest *request) {
+    while (1) {
+        char *p = body + request->body_received;
+        size_t left = available - request->body_received;
+        long line_length;
+
+        switch (request->chunk_state) {
+        case CHUNK_SIZE_LINE:
+            line_length = chunk_line_length(p, left);
+            if (line_length == -1) return HTTP_PARSE_INCOMPLETE;
+            if (line_length < 0) return HTTP_PARSE_ERROR;
+            if (!parse_chunk_size(p, (size_t)line_length, &request->chunk_remaining)) {
+                return HTTP_PARSE_ERROR;
+            }
+            if (request->chunk_remaining > max_length - request->body_length) {
+                return HTTP_PARSE_TOO_LARGE;
+            }
+            request->body_received += (size_t)line_length + 2;
+            request->chunk_state = request->chunk_remaining > 0 ? CHUNK_DATA : CHUNK_TRAILER;
+            break;
+
+        case CHUNK_DATA: {
+            if (left == 0) return HTTP_PARSE_INCOMPLETE;
+            size_t count = left < request->chunk_remaining ? left : request->chunk_remaining;
+            // Dekódované telo je vždy kratšie ako prečítané, presun ide len dozadu.
+            memmove(body + request->body_length, p, count);
+            request->body_length += count;
+            request->body_received += count;
+            request->chunk_remaining -= count;
+            if (request->chunk_remaining == 0) request->chunk_state = CHUNK_DATA_END;
+            break;
+        }
+
+        case CHUNK_DATA_END:
+            if (left < 2) return HTTP_PARSE_INCOMPLETE;
+            if (p[0] != '\r' || p[1] != '\n') return HTTP_PARSE_ERROR;
+            request->body_received += 2;
+            request->chunk_state = CHUNK_SIZE_LINE;
+            break;
+
+        case CHUNK_TRAILER:
+            // Trailer hlavičky sa preskočia; prázdny riadok ukončuje telo.
+            line_length = chunk_line_length(p, left);
+            if (line_length == -1) return HTTP_PARSE_INCOMPLETE;
+            if (line_length < 0) return HTTP_PARSE_ERROR;
+            request->body_received += (size_t)line_length + 2;
+            if (line_length == 0) return HTTP_PARSE_DONE;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Posunie jeden slice, ak ukazuje do starého buffera.
+ */
+static void rebase_slice(HttpSlice *slice, const char *old_base, const char *new_base) {
+    if (slice->data) {
+        slice->data = new_base + (slice->data - old_base);
+    }
+}
+
+void http_request_rebase(HttpRequest *request, const char *old_base, char *new_base) {
+    if (old_base == new_base) return;
+    rebase_slice(&request->method, old_base, new_base);
+    rebase_slice(&request->path, old_base, new_base);
+    rebase_slice(&request->connection, old_base, new_base);
+    rebase_slice(&request->content_type, old_base, new_base);
+    rebase_slice(&request->accept_encoding, old_base, new_base);
+    rebase_slice(&request->if_none_match, old_base, new_base);
+    if (request->body) {
+        request->body = new_base + (request->body - old_base);
+    }
+}
+
+int http_slice_equals(HttpSlice slice, const char *text) {
+    size_t length = strlen(text);
+    return slice.length == length && memcmp(slice.data, text, length) == 0;
+}
+
+int http_slice_has_token(HttpSlice slice, const char *token) {
+    size_t token_length = strlen(token);
+    const char *p = slice.data;
+    const char *end = slice.data + slice.length;
+
+    // Hodnota je zoznam oddelený čiarkami; parametre za ';' sa ignorujú.
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) p++;
+        const char *item = p;
+        while (p < end && *p != ',' && *p != ';' && *p != ' ' && *p != '\t') p++;
+        if ((size_t)(p - item) == token_length && strncasecmp(item, token, token_length) == 0) {
+            return 1;
+        }
+        while (p < end && *p != ',') p++;
+    }
+    return 0;
+}
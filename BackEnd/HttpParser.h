@@ -0,0 +1,112 @@
+#ifndef HTTPPARSER_H
+#define HTTPPARSER_H
+
+#include <stddef.h>
+
+// Maximálna veľkosť hlavičiek jednej požiadavky
+#define MAX_HEADER_SIZE 8192
+// Maximálna dĺžka riadku s veľkosťou chunku alebo trailer hlavičky
+#define MAX_CHUNK_LINE_SIZE 1024
+
+// Pohľad na časť vstupného buffera (nie je ukončený nulou, nič sa nekopíruje).
+typedef struct {
+    const char *data;
+    size_t length;
+} HttpSlice;
+
+// Výsledok parsovania hlavičiek.
+typedef enum {
+    HTTP_PARSE_ERROR = -1,       // Požiadavka je syntakticky chybná (400).
+    HTTP_PARSE_INCOMPLETE = 0,   // Hlavičky ešte neprišli celé.
+    HTTP_PARSE_DONE = 1,         // Hlavičky sú kompletné a naparsované.
+    HTTP_PARSE_TOO_LARGE = 2     // Hlavičky presiahli MAX_HEADER_SIZE (431) alebo telo limit (413).
+} HttpParseResult;
+
+// Stav dekódovania tela v kódovaní chunked.
+typedef enum {
+    CHUNK_SIZE_LINE,             // Čaká sa na riadok s veľkosťou chunku.
+    CHUNK_DATA,                  // Čítajú sa dáta chunku.
+    CHUNK_DATA_END,              // Čaká sa na CRLF za dátami chunku.
+    CHUNK_TRAILER                // Za posledným chunkom: trailer hlavičky po prázdny riadok.
+} ChunkState;
+
+// Naparsovaná HTTP požiadavka. Všetky reťazce ukazujú do vstupného buffera.
+typedef struct {
+    HttpSlice method;            // Napr. "GET", "POST".
+    HttpSlice path;              // Cieľ požiadavky, napr. "/api/generate".
+    int version_minor;           // 0 pre HTTP/1.0, 1 pre HTTP/1.1.
+
+    // Hlavičky, ktoré server potrebuje (ostatné sa preskočia).
+    HttpSlice connection;
+    HttpSlice content_type;
+    HttpSlice accept_encoding;
+    HttpSlice if_none_match;
+    size_t content_length;       // 0, ak hlavička chýba.
+    int chunked;                 // 1, ak klient poslal Transfer-Encoding: chunked.
+    int expect_continue;         // 1, ak klient čaká na "100 Continue" pred odoslaním tela.
+
+    size_t header_length;        // Dĺžka hlavičiek vrátane záverečného CRLFCRLF.
+    char *body;                  // Telo požiadavky (nastaví spojenie, keď je kompletné);
+                                 // handler ho smie prepísať (napr. dekódovanie JSON na mieste).
+    size_t body_length;          // Pri chunked tele počet už dekódovaných bajtov.
+
+    ChunkState chunk_state;      // Interné: stav dekódovania chunked tela.
+    size_t chunk_remaining;      // Interné: zostávajúce bajty aktuálneho chunku.
+    size_t body_received;        // Interné: spracované bajty chunked tela na vstupe.
+
+    size_t scan_offset;          // Interné: odkiaľ pokračovať v hľadaní konca hlavičiek.
+} HttpRequest;
+
+/**
+ * @brief Pripraví štruktúru požiadavky na nové parsovanie.
+ */
+void http_request_init(HttpRequest *request);
+
+/**
+ * @brief Inkrementálne parsuje hlavičky HTTP požiadavky.
+ *
+ * Funkcia sa volá opakovane vždy, keď do buffera pribudnú dáta. Koniec
+ * hlavičiek sa hľadá len v novo pridanej časti, takže celkový čas je
+ * lineárny bez ohľadu na to, v koľkých TCP segmentoch požiadavka prišla.
+ *
+ * @param data Začiatok požiadavky vo vstupnom bufferi.
+ * @param length Počet dostupných bajtov.
+ * @param request Stav parsovania; pri úspechu obsahuje naparsované polia.
+ * @return Jedna z hodnôt HttpParseResult.
+ */
+HttpParseResult http_parse_request(const char *data, size_t length, HttpRequest *request);
+
+/**
+ * @brief Inkrementálne dekóduje telo v kódovaní `Transfer-Encoding: chunked`.
+ *
+ * Dáta chunkov sa presúvajú priamo vo vstupnom bufferi tak, aby dekódované
+ * telo ležalo súvisle od `body`; pokračuje sa tam, kde predchádzajúce volanie
+ * skončilo. Po úspechu je `body_length` dĺžka tela a `body_received` počet
+ * bajtov vstupu, ktoré telo zaberalo (vrátane rámcovania chunkov).
+ *
+ * @param body Začiatok tela (hneď za hlavičkami).
+ * @param available Počet dostupných bajtov od `body`.
+ * @param max_length Najväčšia povolená dĺžka dekódovaného tela.
+ * @param request Stav dekódovania.
+ * @return HTTP_PARSE_DONE, HTTP_PARSE_INCOMPLETE, HTTP_PARSE_ERROR pri chybnom
+ *         rámcovaní alebo HTTP_PARSE_TOO_LARGE pri prekročení `max_length`.
+ */
+HttpParseResult http_decode_chunked(char *body, size_t available, size_t max_length, HttpRequest *request);
+
+/**
+ * @brief Posunie všetky ukazovatele požiadavky po realokácii vstupného buffera.
+ */
+void http_request_rebase(HttpRequest *request, const char *old_base, char *new_base);
+
+/**
+ * @brief Porovná slice s C reťazcom (rozlišuje veľkosť písmen).
+ */
+int http_slice_equals(HttpSlice slice, const char *text);
+
+/**
+ * @brief Zistí, či slice obsahuje token `token` (bez ohľadu na veľkosť písmen),
+ *        napr. "close" v hlavičke `Connection: keep-alive, close`.
+ */
+int http_slice_has_token(HttpSlice slice, const char *token);
+
+#endif // HTTPPARSER_H
@@ -0,0 +1,445 @@
+#include "JsonParser.h"
+#include <limits.h>
+#include <string.h>
+
+// Čo tokenizér očakáva na ďalšej pozícii.
+enum {
+    JSON_STATE_VALUE = 0,        // Hodnota (začiatok vstupu, za dvojbodkou alebo čiarkou v poli).
+    JSON_STATE_VALUE_OR_CLOSE,   // Za '[': hodnota alebo ']'.
+    JSON_STATE_KEY_OR_CLOSE,     // Za '{': kľúč alebo '}'.
+    JSON_STATE_KEY,              // Za čiarkou v objekte.
+    JSON_STATE_COLON,            // Za kľúčom.
+    JSON_STATE_AFTER_VALUE,      // Za hodnotou v kontajneri: čiarka alebo zátvorka.
+    JSON_STATE_DONE,             // Najvyššia hodnota je kompletná.
+    JSON_STATE_ERROR
+};
+
+static const char *skip_whitespace(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    return p;
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Načíta 4 hexadecimálne číslice z escape sekvencie \\uXXXX.
+ */
+static long parse_hex4(const char *p, const char *end) {
+    if (end - p < 4) return -1;
+    long value = 0;
+    for (int i = 0; i < 4; i++) {
+        int digit = hex_value(p[i]);
+        if (digit < 0) return -1;
+        value = value * 16 + digit;
+    }
+    return value;
+}
+
+/**
+ * @brief Nájde koniec reťazca a overí jeho escape sekvencie.
+ *
+ * Bežné znaky sa len preskakujú; escape sekvencie sa tu iba kontrolujú
+ * (vrátane párov UTF-16), aby `json_decode_string()` už nemohol zlyhať.
+ *
+ * @param p Ukazovateľ za úvodnou úvodzovkou.
+ * @return Ukazovateľ za záverečnou úvodzovkou alebo NULL pri chybe.
+ */
+static const char *scan_string(const char *p, const char *end, JsonToken *token) {
+    const char *start = p;
+    int escaped = 0;
+
+    while (p < end) {
+        unsigned char c = (unsigned char)*p;
+        if (c == '"') {
+            token->data = start;
+            token->length = (size_t)(p - start);
+            token->escaped = escaped;
+            return p + 1;
+        }
+        if (c < 0x20) return NULL;
+        if (c != '\\') {
+            p++;
+            continue;
+        }
+
+        escaped = 1;
+        if (end - p < 2) return NULL;
+        char escape = p[1];
+        if (escape != 'u') {
+            if (!memchr("\"\\/bfnrt", escape, 8)) return NULL;
+            p += 2;
+            continue;
+        }
+        long code = parse_hex4(p + 2, end);
+        if (code < 0) return NULL;
+        p += 6;
+        // Náhradný pár UTF-16 (znaky mimo BMP) musí byť kompletný.
+        if (code >= 0xD800 && code <= 0xDBFF) {
+            if (end - p < 6 || p[0] != '\\' || p[1] != 'u') return NULL;
+            long low = parse_hex4(p + 2, end);
+            if (low < 0xDC00 || low > 0xDFFF) return NULL;
+            p += 6;
+        } else if (code >= 0xDC00 && code <= 0xDFFF) {
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Preskočí číslo v tvare -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+ *
+ * @return Ukazovateľ za číslom alebo NULL, ak na `p` nie je platné číslo.
+ */
+static const char *scan_number(const char *p, const char *end) {
+    if (p < end && *p == '-') p++;
+    if (p >= end) return NULL;
+    if (*p == '0') {
+        p++;
+    } else if (*p >= '1' && *p <= '9') {
+        while (p < end && *p >= '0' && *p <= '9') p++;
+    } else {
+        return NULL;
+    }
+
+    if (p < end && *p == '.') {
+        const char *digits = ++p;
+        while (p < end && *p >= '0' && *p <= '9') p++;
+        if (p == digits) return NULL;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p < end && (*p == '+' || *p == '-')) p++;
+        const char *digits = p;
+        while (p < end && *p >= '0' && *p <= '9') p++;
+        if (p == digits) return NULL;
+    }
+    return p;
+}
+
+static JsonTokenType json_fail(JsonTokenizer *tokenizer, JsonToken *token) {
+    tokenizer->state = JSON_STATE_ERROR;
+    token->type = JSON_TOKEN_ERROR;
+    return JSON_TOKEN_ERROR;
+}
+
+/**
+ * @brief Prečíta hodnotu začínajúcu na `p` (stav JSON_STATE_VALUE).
+ */
+static JsonTokenType json_value(JsonTokenizer *tokenizer, const char *p, JsonToken *token) {
+    const char *start = p;
+    const char *end = tokenizer->end;
+    JsonTokenType type;
+
+    switch (*p) {
+    case '{':
+    case '[':
+        if (tokenizer->depth >= JSON_MAX_DEPTH) return json_fail(tokenizer, token);
+        if (*p == '{') {
+            tokenizer->objects |= (uint64_t)1 << tokenizer->depth;
+            tokenizer->state = JSON_STATE_KEY_OR_CLOSE;
+            type = JSON_TOKEN_OBJECT_START;
+        } else {
+            tokenizer->objects &= ~((uint64_t)1 << tokenizer->depth);
+            tokenizer->state = JSON_STATE_VALUE_OR_CLOSE;
+            type = JSON_TOKEN_ARRAY_START;
+        }
+        tokenizer->depth++;
+        tokenizer->p = p + 1;
+        token->type = type;
+        token->data = p;
+        token->length = 1;
+        return type;
+    case '"':
+        p = scan_string(p + 1, end, token);
+        type = JSON_TOKEN_STRING;
+        break;
+    case 't':
+        p = end - p >= 4 && memcmp(p, "true", 4) == 0 ? p + 4 : NULL;
+        type = JSON_TOKEN_TRUE;
+        break;
+    case 'f':
+        p = end - p >= 5 && memcmp(p, "false", 5) == 0 ? p + 5 : NULL;
+        type = JSON_TOKEN_FALSE;
+        break;
+    case 'n':
+        p = end - p >= 4 && memcmp(p, "null", 4) == 0 ? p + 4 : NULL;
+        type = JSON_TOKEN_NULL;
+        break;
+    default:
+        p = scan_number(p, end);
+        type = JSON_TOKEN_NUMBER;
+        break;
+    }
+    if (!p) return json_fail(tokenizer, token);
+
+    if (type != JSON_TOKEN_STRING) {
+        token->data = start;
+        token->length = (size_t)(p - start);
+    }
+    tokenizer->p = p;
+    tokenizer->state = tokenizer->depth == 0 ? JSON_STATE_DONE : JSON_STATE_AFTER_VALUE;
+    token->type = type;
+    return type;
+}
+
+void json_tokenizer_init(JsonTokenizer *tokenizer, const char *data, size_t length) {
+    tokenizer->p = data;
+    tokenizer->end = data + length;
+    tokenizer->objects = 0;
+    tokenizer->depth = 0;
+    tokenizer->state = JSON_STATE_VALUE;
+}
+
+JsonTokenType json_next(JsonTokenizer *tokenizer, JsonToken *token) {
+    const char *p = tokenizer->p;
+    const char *end = tokenizer->end;
+    token->data = NULL;
+    token->length = 0;
+    token->escaped = 0;
+
+    while (1) {
+        if (tokenizer->state == JSON_STATE_ERROR) return json_fail(tokenizer, token);
+        p = skip_whitespace(p, end);
+        if (p >= end) {
+            if (tokenizer->state != JSON_STATE_DONE) return json_fail(tokenizer, token);
+            tokenizer->p = p;
+            token->type = JSON_TOKEN_END;
+            return JSON_TOKEN_END;
+        }
+
+        char c = *p;
+        int in_object = tokenizer->depth > 0 && ((tokenizer->objects >> (tokenizer->depth - 1)) & 1);
+
+        switch (tokenizer->state) {
+        case JSON_STATE_DONE:
+            // Za najvyššou hodnotou nasledujú ďalšie dáta.
+            return json_fail(tokenizer, token);
+        case JSON_STATE_COLON:
+            if (c != ':') return json_fail(tokenizer, token);
+            p++;
+            tokenizer->state = JSON_STATE_VALUE;
+            continue;
+        case JSON_STATE_AFTER_VALUE:
+            if (c == ',') {
+                p++;
+                tokenizer->state = in_object ? JSON_STATE_KEY : JSON_STATE_VALUE;
+                continue;
+            }
+            if (c != (in_object ? '}' : ']')) return json_fail(tokenizer, token);
+            break;
+        case JSON_STATE_KEY_OR_CLOSE:
+            if (c == '}') break;
+            /* fall through */
+        case JSON_STATE_KEY:
+            if (c != '"') return json_fail(tokenizer, token);
+            p = scan_string(p + 1, end, token);
+            if (!p) return json_fail(tokenizer, token);
+            tokenizer->p = p;
+            tokenizer->state = JSON_STATE_COLON;
+            token->type = JSON_TOKEN_KEY;
+            return JSON_TOKEN_KEY;
+        case JSON_STATE_VALUE_OR_CLOSE:
+            if (c == ']') break;
+            /* fall through */
+        default:
+            return json_value(tokenizer, p, token);
+        }
+
+        // Zatvárajúca zátvorka kontajnera.
+        tokenizer->depth--;
+        tokenizer->p = p + 1;
+        tokenizer->state = tokenizer->depth == 0 ? JSON_STATE_DONE : JSON_STATE_AFTER_VALUE;
+        token->type = c == '}' ? JSON_TOKEN_OBJECT_END : JSON_TOKEN_ARRAY_END;
+        token->data = p;
+        token->length = 1;
+        return token->type;
+    }
+}
+
+int json_skip_value(JsonTokenizer *tokenizer, const JsonToken *first) {
+    switch (first->type) {
+    case JSON_TOKEN_OBJECT_START:
+    case JSON_TOKEN_ARRAY_START: {
+        // Kontajner sa končí, keď hĺbka klesne pod úroveň jeho obsahu.
+        int depth = tokenizer->depth;
+        JsonToken token;
+        while (tokenizer->depth >= depth) {
+            JsonTokenType type = json_next(tokenizer, &token);
+            if (type == JSON_TOKEN_ERROR || type == JSON_TOKEN_END) return 0;
+        }
+        return 1;
+    }
+    case JSON_TOKEN_STRING:
+    case JSON_TOKEN_NUMBER:
+    case JSON_TOKEN_TRUE:
+    case JSON_TOKEN_FALSE:
+    case JSON_TOKEN_NULL:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+size_t json_decode_string(const JsonToken *token, char *out) {
+    const char *p = token->data;
+    const char *end = p + token->length;
+    if (!token->escaped) {
+        if (out != p) memmove(out, p, token->length);
+        return token->length;
+    }
+
+    // Zápis nikdy nepredbehne čítanie: každá escape sekvencia sa skráti.
+    size_t length = 0;
+    while (p < end) {
+        char c = *p++;
+        if (c != '\\') {
+            out[length++] = c;
+            continue;
+        }
+
+        char escape = *p++;
+        switch (escape) {
+        case 'b': out[length++] = '\b'; break;
+        case 'f': out[length++] = '\f'; break;
+        case 'n': out[length++] = '\n'; break;
+        case 'r': out[length++] = '\r'; break;
+        case 't': out[length++] = '\t'; break;
+        case 'u': {
+            long code = parse_hex4(p, end);
+            p += 4;
+            if (code >= 0xD800 && code <= 0xDBFF) {
+                long low = parse_hex4(p + 2, end);
+                p += 6;
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            // Zápis v UTF-8 (najviac 4 bajty, escape sekvencia ich mala 6 alebo 12).
+            if (code < 0x80) {
+                out[length++] = (char)code;
+            } else if (code < 0x800) {
+                out[length++] = (char)(0xC0 | (code >> 6));
+                out[length++] = (char)(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                out[length++] = (char)(0xE0 | (code >> 12));
+                out[length++] = (char)(0x80 | ((code >> 6) & 0x3F));
+                out[length++] = (char)(0x80 | (code & 0x3F));
+            } else {
+                out[length++] = (char)(0xF0 | (code >> 18));
+                out[length++] = (char)(0x80 | ((code >> 12) & 0x3F));
+                out[length++] = (char)(0x80 | ((code >> 6) & 0x3F));
+                out[length++] = (char)(0x80 | (code & 0x3F));
+            }
+            break;
+        }
+        default:
+            // '"', '\\' a '/' sa zapíšu tak, ako sú.
+            out[length++] = escape;
+            break;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Prevedie číselný token na int (len celé čísla, mimo rozsahu sa nasýti).
+ *
+ * @return 1 pri úspechu, 0 ak číslo má desatinnú časť alebo exponent.
+ */
+static int token_to_int(const JsonToken *token, int *value) {
+    const char *p = token->data;
+    const char *end = p + token->length;
+    int negative = *p == '-';
+    if (negative) p++;
+
+    long long parsed = 0;
+    for (; p < end; p++) {
+        if (*p < '0' || *p > '9') return 0;
+        if (parsed <= INT_MAX) parsed = parsed * 10 + (*p - '0');
+    }
+    if (negative) parsed = -parsed;
+    if (parsed > INT_MAX) parsed = INT_MAX;
+    if (parsed < INT_MIN) parsed = INT_MIN;
+    *value = (int)parsed;
+    return 1;
+}
+
+/**
+ * @brief Zistí, či je číselný token nenulový (0, -0, 0.0 aj 0e5 sú nula).
+ */
+static int token_is_nonzero(const JsonToken *token) {
+    for (size_t i = 0; i < token->length; i++) {
+        char c = token->data[i];
+        if (c == 'e' || c == 'E') break;
+        if (c >= '1' && c <= '9') return 1;
+    }
+    return 0;
+}
+
+int json_parse_object(char *body, size_t length, const JsonField *fields, size_t count, void *out) {
+    JsonTokenizer tokenizer;
+    JsonToken token;
+    uint32_t seen = 0;
+
+    if (count > 32) return 0;
+    json_tokenizer_init(&tokenizer, body, length);
+    if (json_next(&tokenizer, &token) != JSON_TOKEN_OBJECT_START) return 0;
+
+    while (json_next(&tokenizer, &token) == JSON_TOKEN_KEY) {
+        // Tokeny ukazujú do `body`, ktoré patrí volajúcemu a smie sa prepísať.
+        char *key = body + (token.data - body);
+        size_t key_length = token.escaped ? json_decode_string(&token, key) : token.length;
+
+        const JsonField *field = NULL;
+        size_t index = 0;
+        for (; index < count; index++) {
+            if (strlen(fields[index].name) == key_length && memcmp(fields[index].name, key, key_length) == 0) {
+                field = &fields[index];
+                break;
+            }
+        }
+
+        JsonTokenType type = json_next(&tokenizer, &token);
+        if (!field) {
+            if (!json_skip_value(&tokenizer, &token)) return 0;
+            continue;
+        }
+        if (type == JSON_TOKEN_NULL) continue;
+
+        void *target = (char *)out + field->offset;
+        switch (field->type) {
+        case JSON_FIELD_STRING: {
+            if (type != JSON_TOKEN_STRING) return 0;
+            JsonString *string = (JsonString *)target;
+            string->data = body + (token.data - body);
+            string->length = json_decode_string(&token, string->data);
+            // Miesto za dekódovaným reťazcom (aspoň záverečná úvodzovka) už tokenizér prešiel.
+            string->data[string->length] = '\0';
+            break;
+        }
+        case JSON_FIELD_INT:
+            if (type != JSON_TOKEN_NUMBER || !token_to_int(&token, (int *)target)) return 0;
+            break;
+        case JSON_FIELD_FLAG:
+            if (type == JSON_TOKEN_TRUE || type == JSON_TOKEN_FALSE) {
+                *(int *)target = type == JSON_TOKEN_TRUE;
+            } else if (type == JSON_TOKEN_NUMBER) {
+                *(int *)target = token_is_nonzero(&token);
+            } else {
+                return 0;
+            }
+            break;
+        }
+        seen |= (uint32_t)1 << index;
+    }
+    if (token.type != JSON_TOKEN_OBJECT_END || json_next(&tokenizer, &token) != JSON_TOKEN_END) return 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (fields[i].required && !(seen & ((uint32_t)1 << i))) return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,126 @@
+#ifndef JSONPARSER_H
+#define JSONPARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Maximálna hĺbka vnorenia objektov a polí
+#define JSON_MAX_DEPTH 64
+
+// Druh tokenu, ktorý vrátil `json_next()`.
+typedef enum {
+    JSON_TOKEN_ERROR = -1,       // Syntaktická chyba (ďalšie volania vracajú tiež chybu).
+    JSON_TOKEN_END = 0,          // Koniec vstupu za kompletnou hodnotou.
+    JSON_TOKEN_OBJECT_START,     // {
+    JSON_TOKEN_OBJECT_END,       // }
+    JSON_TOKEN_ARRAY_START,      // [
+    JSON_TOKEN_ARRAY_END,        // ]
+    JSON_TOKEN_KEY,              // Kľúč člena objektu (reťazec pred dvojbodkou).
+    JSON_TOKEN_STRING,
+    JSON_TOKEN_NUMBER,
+    JSON_TOKEN_TRUE,
+    JSON_TOKEN_FALSE,
+    JSON_TOKEN_NULL
+} JsonTokenType;
+
+// Token: pohľad do vstupu, nič sa nekopíruje.
+typedef struct {
+    JsonTokenType type;
+    const char *data;            // Text tokenu; pri reťazci a kľúči bez úvodzoviek.
+    size_t length;
+    int escaped;                 // Reťazec obsahuje escape sekvencie (treba ho dekódovať).
+} JsonToken;
+
+// Stav tokenizéra. Vstup sa prejde raz, zľava doprava.
+typedef struct {
+    const char *p;               // Interné: aktuálna pozícia.
+    const char *end;
+    uint64_t objects;            // Interné: bit i = kontajner v hĺbke i je objekt.
+    int depth;                   // Aktuálna hĺbka vnorenia (0 = mimo kontajnera).
+    int state;                   // Interné: čo sa očakáva ďalej.
+} JsonTokenizer;
+
+// Reťazec dekódovaný na mieste vo vstupe, ukončený nulou.
+typedef struct {
+    char *data;                  // NULL, ak hodnota v JSON chýbala.
+    size_t length;
+} JsonString;
+
+// Typ poľa štruktúry, do ktorého `json_parse_object()` uloží hodnotu člena.
+typedef enum {
+    JSON_FIELD_STRING,           // JsonString; hodnota musí byť reťazec.
+    JSON_FIELD_INT,              // int; celé číslo (mimo rozsahu sa nasýti na INT_MIN/INT_MAX).
+    JSON_FIELD_FLAG              // int 0/1; true/false alebo číslo (nenulové = 1).
+} JsonFieldType;
+
+// Popis jedného člena objektu: kľúč, typ a kam v štruktúre patrí.
+typedef struct {
+    const char *name;
+    JsonFieldType type;
+    size_t offset;               // offsetof() poľa v cieľovej štruktúre.
+    int required;                // Chýbajúci povinný člen je chyba.
+} JsonField;
+
+/**
+ * @brief Pripraví tokenizér na prechod vstupom.
+ *
+ * @param tokenizer Stav tokenizéra.
+ * @param data Vstup (nemusí byť ukončený nulou).
+ * @param length Dĺžka vstupu v bajtoch.
+ */
+void json_tokenizer_init(JsonTokenizer *tokenizer, const char *data, size_t length);
+
+/**
+ * @brief Vráti ďalší token vstupu.
+ *
+ * Tokenizér kontroluje celú gramatiku (čiarky, dvojbodky, párovanie
+ * zátvoriek, tvar čísel a escape sekvencie), takže volajúci už nemusí.
+ * Za najvyššou hodnotou smú nasledovať len medzery.
+ *
+ * @param tokenizer Stav tokenizéra.
+ * @param token Výsledný token (platný, kým existuje vstup).
+ * @return Typ tokenu; JSON_TOKEN_END na konci, JSON_TOKEN_ERROR pri chybe.
+ */
+JsonTokenType json_next(JsonTokenizer *tokenizer, JsonToken *token);
+
+/**
+ * @brief Preskočí hodnotu, ktorej prvý token už volajúci prečítal.
+ *
+ * Pri objekte alebo poli prečíta tokeny až po zodpovedajúcu zátvorku.
+ *
+ * @return 1 pri úspechu, 0 pri syntaktickej chybe.
+ */
+int json_skip_value(JsonTokenizer *tokenizer, const JsonToken *first);
+
+/**
+ * @brief Dekóduje escape sekvencie reťazca (\\uXXXX do UTF-8).
+ *
+ * Dekódovaný text nie je nikdy dlhší ako zdrojový, `out` preto môže byť
+ * aj `token->data` (dekódovanie na mieste). Bez escape sekvencií sa len
+ * skopíruje (alebo nič, ak `out == token->data`).
+ *
+ * @param token Reťazec alebo kľúč vrátený `json_next()`.
+ * @param out Cieľ s miestom aspoň pre `token->length` bajtov.
+ * @return Dĺžka dekódovaného reťazca.
+ */
+size_t json_decode_string(const JsonToken *token, char *out);
+
+/**
+ * @brief Naparsuje JSON objekt do štruktúry podľa tabuľky členov.
+ *
+ * Telo sa prejde raz. Reťazce sa dekódujú na mieste v `body` a ukončia
+ * nulou, takže `JsonString` ukazuje priamo do tela; nič sa nealokuje.
+ * Neznáme kľúče sa preskočia, pri opakovanom kľúči platí posledná hodnota
+ * a `null` ponechá predvolenú hodnotu, ktorú volajúci nastavil vopred.
+ *
+ * @param body Telo požiadavky (prepíše sa).
+ * @param length Dĺžka tela.
+ * @param fields Tabuľka členov.
+ * @param count Počet členov v tabuľke (najviac 32).
+ * @param out Cieľová štruktúra.
+ * @return 1 pri úspechu, 0 ak telo nie je platný JSON objekt, hodnota má
+ *         nesprávny typ alebo chýba povinný člen.
+ */
+int json_parse_object(char *body, size_t length, const JsonField *fields, size_t count, void *out);
+
+#endif // JSONPARSER_H
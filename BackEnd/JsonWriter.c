@@ -0,0 +1,101 @@
+#include "JsonWriter.h"
+
+// Bajty, pri ktorých sa rýchly prechod reťazcom zastaví: znak za spätnou
+// lomkou, 'u' pre \u00XX, 'x' pre začiatok viacbajtového UTF-8 znaku.
+#define ESCAPE_U 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u'
+#define ESCAPE_X 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x'
+static const char json_escape[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+    ESCAPE_U, ESCAPE_U,
+    0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    ESCAPE_X, ESCAPE_X, ESCAPE_X, ESCAPE_X, ESCAPE_X, ESCAPE_X, ESCAPE_X, ESCAPE_X,
+};
+
+/**
+ * @brief Dĺžka platného UTF-8 znaku na `p` (bez prekrývajúcich sa zápisov,
+ *        náhradných znakov UTF-16 a kódov nad U+10FFFF).
+ *
+ * @return 2 až 4, alebo 0 ak znak nie je platný.
+ */
+static size_t utf8_length(const unsigned char *p, const unsigned char *end) {
+    unsigned char c = p[0];
+    size_t length;
+    unsigned char min = 0x80, max = 0xBF;     // Povolený rozsah druhého bajtu.
+
+    if (c >= 0xC2 && c <= 0xDF) {
+        length = 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        length = 3;
+        if (c == 0xE0) min = 0xA0;
+        if (c == 0xED) max = 0x9F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        length = 4;
+        if (c == 0xF0) min = 0x90;
+        if (c == 0xF4) max = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if ((size_t)(end - p) < length) return 0;
+    if (p[1] < min || p[1] > max) return 0;
+    for (size_t i = 2; i < length; i++) {
+        if (p[i] < 0x80 || p[i] > 0xBF) return 0;
+    }
+    return length;
+}
+
+int json_append_string(Buffer *out, const char *text, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char *p = (const unsigned char *)text;
+    const unsigned char *end = p + length;
+    const unsigned char *run = p;     // Začiatok úseku, ktorý sa skopíruje bez zmeny.
+
+    if (!buffer_append(out, "\"", 1)) return 0;
+    while (p < end) {
+        char escape = json_escape[*p];
+        if (!escape) {
+            p++;
+            continue;
+        }
+        size_t sequence = escape == 'x' ? utf8_length(p, end) : 0;
+        if (sequence) {
+            p += sequence;
+            continue;
+        }
+
+        if (!buffer_append(out, run, (size_t)(p - run))) return 0;
+        if (escape == 'x') {
+            if (!JSON_APPEND_LITERAL(out, "\\ufffd")) return 0;
+        } else if (escape == 'u') {
+            char code[6] = {'\\', 'u', '0', '0', hex[*p >> 4], hex[*p & 0x0F]};
+            if (!buffer_append(out, code, sizeof(code))) return 0;
+        } else {
+            char code[2] = {'\\', escape};
+            if (!buffer_append(out, code, sizeof(code))) return 0;
+        }
+        run = ++p;
+    }
+    return buffer_append(out, run, (size_t)(p - run)) && buffer_append(out, "\"", 1);
+}
+
+int json_append_int(Buffer *out, long value) {
+    char digits[24];
+    size_t count = 0;
+    unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+
+    do {
+        digits[sizeof(digits) - 1 - count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) digits[sizeof(digits) - 1 - count++] = '-';
+    return buffer_append(out, digits + sizeof(digits) - count, count);
+}
+
+int json_append_bool(Buffer *out, int value) {
+    return value ? JSON_APPEND_LITERAL(out, "true") : JSON_APPEND_LITERAL(out, "false");
+}
@@ -0,0 +1,39 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <stddef.h>
+#include "Buffer.h"
+
+// Pripojí reťazcový literál (bez escapovania, dĺžka sa zistí pri preklade).
+#define JSON_APPEND_LITERAL(out, text) buffer_append((out), (text), sizeof(text) - 1)
+
+/**
+ * @brief Pripojí reťazec ako JSON reťazec (v úvodzovkách, s escapovaním).
+ *
+ * Úseky, ktoré netreba escapovať (vrátane platného UTF-8), sa kopírujú
+ * naraz; čistý vstup je teda jedno `memcpy`. Riadiace znaky, úvodzovky
+ * a spätné lomky sa escapujú, neplatné UTF-8 bajty sa nahradia \\ufffd,
+ * takže výsledok je vždy platný JSON.
+ *
+ * @param out Cieľový buffer.
+ * @param text Reťazec (nemusí byť ukončený nulou).
+ * @param length Dĺžka reťazca v bajtoch.
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int json_append_string(Buffer *out, const char *text, size_t length);
+
+/**
+ * @brief Pripojí celé číslo v desiatkovom zápise.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int json_append_int(Buffer *out, long value);
+
+/**
+ * @brief Pripojí true alebo false.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int json_append_bool(Buffer *out, int value);
+
+#endif // JSONWRITER_H
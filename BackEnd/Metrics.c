@@ -0,0 +1,303 @@
+#include "Metrics.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Najmenšia a najväčšia hranica `le` exportovaných histogramov (mocniny 2 v ns)
+#define EXPORT_MIN_EXPONENT 10
+#define EXPORT_MAX_EXPONENT 35
+
+#define SUB_BUCKET_COUNT (1u << METRICS_SUB_BUCKET_BITS)
+
+// Histogram s logaritmickými vedierkami (v štýle HdrHistogram).
+typedef struct {
+    uint64_t count;
+    uint64_t sum;                // Súčet hodnôt v ns.
+    uint64_t buckets[METRICS_HISTOGRAM_BUCKETS];
+} MetricsHistogram;
+
+// Údaje jedného vlákna. Zapisuje do nich len vlastník, ostatní len čítajú.
+typedef struct MetricsShard {
+    uint64_t counters[METRICS_COUNTER_COUNT];
+    uint64_t errors[METRICS_ERROR_COUNT];
+    MetricsHistogram routes[METRICS_ROUTE_COUNT];
+    MetricsHistogram phases[METRICS_PHASE_COUNT];
+    struct MetricsShard *next;   // Zoznam všetkých vlákien (len pribúda).
+} MetricsShard;
+
+static const char *const route_names[METRICS_ROUTE_COUNT] = {
+    "static", "options", "generate", "generate_batch", "evaluate",
+    "evaluate_batch", "strengthen", "passphrase", "policies", "metrics",
+    "unix_generate", "unix_evaluate", "unix_strengthen", "other",
+};
+static const char *const phase_names[METRICS_PHASE_COUNT] = {
+    "accept_wait", "parse", "compute", "write",
+};
+static const char *const error_names[METRICS_ERROR_COUNT] = {
+    "bad_request", "too_large", "timeout", "io", "rejected", "internal", "rate_limited", "overloaded",
+};
+
+static MetricsShard *shard_list;
+static __thread MetricsShard *local_shard;
+
+// Zápis jediným vlastníkom: obyčajné sčítanie a atomický store (bez lock
+// prefixu), aby čitateľ nikdy nevidel roztrhnutú hodnotu.
+#define SHARD_ADD(field, value) __atomic_store_n(&(field), (field) + (value), __ATOMIC_RELAXED)
+#define SHARD_READ(field) __atomic_load_n(&(field), __ATOMIC_RELAXED)
+
+/**
+ * @brief Vráti údaje volajúceho vlákna; pri prvom volaní ich vytvorí.
+ *
+ * Nové vlákno sa do zoznamu pridá cez compare-and-swap, takže ani
+ * registrácia nepotrebuje zámok. Údaje sa nikdy neuvoľňujú.
+ */
+static MetricsShard *metrics_shard(void) {
+    MetricsShard *shard = local_shard;
+    if (shard) return shard;
+
+    void *memory = NULL;
+    if (posix_memalign(&memory, 64, sizeof(MetricsShard)) != 0) return NULL;
+    shard = (MetricsShard *)memory;
+    memset(shard, 0, sizeof(*shard));
+
+    shard->next = __atomic_load_n(&shard_list, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&shard_list, &shard->next, shard, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+    local_shard = shard;
+    return shard;
+}
+
+/**
+ * @brief Index vedierka: hodnoty pod 2^B presne, vyššie podľa najvyššieho
+ *        bitu a B nasledujúcich bitov.
+ */
+static unsigned bucket_index(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) return (unsigned)value;
+    unsigned exponent = 63u - (unsigned)__builtin_clzll(value);
+    if (exponent > METRICS_MAX_EXPONENT) return METRICS_HISTOGRAM_BUCKETS - 1;
+    unsigned sub = (unsigned)(value >> (exponent - METRICS_SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    return ((exponent - METRICS_SUB_BUCKET_BITS + 1) << METRICS_SUB_BUCKET_BITS) | sub;
+}
+
+/**
+ * @brief Najväčšia hodnota, ktorá patrí do vedierka (v ns).
+ */
+static uint64_t bucket_upper(unsigned index) {
+    if (index < SUB_BUCKET_COUNT) return index;
+    unsigned block = index >> METRICS_SUB_BUCKET_BITS;
+    uint64_t sub = index & (SUB_BUCKET_COUNT - 1);
+    return ((SUB_BUCKET_COUNT + sub + 1) << (block - 1)) - 1;
+}
+
+static void histogram_record(MetricsHistogram *histogram, uint64_t value) {
+    SHARD_ADD(histogram->buckets[bucket_index(value)], 1);
+    SHARD_ADD(histogram->count, 1);
+    SHARD_ADD(histogram->sum, value);
+}
+
+uint64_t metrics_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+void metrics_add(MetricsCounter counter, uint64_t value) {
+    MetricsShard *shard = metrics_shard();
+    if (shard) SHARD_ADD(shard->counters[counter], value);
+}
+
+void metrics_error(MetricsError error) {
+    MetricsShard *shard = metrics_shard();
+    if (shard) SHARD_ADD(shard->errors[error], 1);
+}
+
+void metrics_record_route(MetricsRoute route, uint64_t duration_ns) {
+    MetricsShard *shard = metrics_shard();
+    if (shard) histogram_record(&shard->routes[route], duration_ns);
+}
+
+void metrics_record_phase(MetricsPhase phase, uint64_t duration_ns) {
+    MetricsShard *shard = metrics_shard();
+    if (shard) histogram_record(&shard->phases[phase], duration_ns);
+}
+
+// --- Export ---
+
+/**
+ * @brief Sčíta histogram `offset` (v bajtoch od začiatku MetricsShard) zo všetkých vlákien.
+ */
+static void histogram_collect(size_t offset, MetricsHistogram *total) {
+    memset(total, 0, sizeof(*total));
+    for (MetricsShard *shard = __atomic_load_n(&shard_list, __ATOMIC_ACQUIRE); shard; shard = shard->next) {
+        MetricsHistogram *histogram = (MetricsHistogram *)((char *)shard + offset);
+        total->sum += SHARD_READ(histogram->sum);
+        for (unsigned i = 0; i < METRICS_HISTOGRAM_BUCKETS; i++) {
+            total->buckets[i] += SHARD_READ(histogram->buckets[i]);
+        }
+    }
+    // Počet sa odvodí z vedierok, aby bol konzistentný s nimi aj počas zápisov.
+    for (unsigned i = 0; i < METRICS_HISTOGRAM_BUCKETS; i++) {
+        total->count += total->buckets[i];
+    }
+}
+
+/**
+ * @brief Najmenšia hodnota, pod ktorou (vrátane) je aspoň podiel `quantile` meraní.
+ */
+static uint64_t histogram_quantile(const MetricsHistogram *histogram, double quantile) {
+    if (histogram->count == 0) return 0;
+    uint64_t rank = (uint64_t)(quantile * (double)histogram->count + 0.5);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < METRICS_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) return bucket_upper(i);
+    }
+    return bucket_upper(METRICS_HISTOGRAM_BUCKETS - 1);
+}
+
+static int write_histogram(Buffer *out, const char *name, const char *label, const char *value,
+                           const MetricsHistogram *histogram) {
+    uint64_t cumulative = 0;
+    unsigned index = 0;
+
+    for (unsigned exponent = EXPORT_MIN_EXPONENT; exponent <= EXPORT_MAX_EXPONENT; exponent++) {
+        // Hodnoty menšie ako 2^exponent sú vo vedierkach pred jej indexom.
+        unsigned limit = bucket_index((uint64_t)1 << exponent);
+        while (index < limit) cumulative += histogram->buckets[index++];
+        if (!buffer_appendf(out, "%s_bucket{%s=\"%s\",le=\"%.6g\"} %llu\n", name, label, value,
+                            (double)((uint64_t)1 << exponent) / 1e9, (unsigned long long)cumulative)) {
+            return 0;
+        }
+    }
+    return buffer_appendf(out, "%s_bucket{%s=\"%s\",le=\"+Inf\"} %llu\n"
+                               "%s_sum{%s=\"%s\"} %.9f\n"
+                               "%s_count{%s=\"%s\"} %llu\n",
+                          name, label, value, (unsigned long long)histogram->count,
+                          name, label, value, (double)histogram->sum / 1e9,
+                          name, label, value, (unsigned long long)histogram->count);
+}
+
+static int write_quantiles(Buffer *out, const char *name, const char *label, const char *value,
+                           const MetricsHistogram *histogram) {
+    static const char *const quantile_names[] = {"0.5", "0.9", "0.99", "0.999"};
+    static const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+    for (size_t i = 0; i < sizeof(quantiles) / sizeof(quantiles[0]); i++) {
+        if (!buffer_appendf(out, "%s_quantile{%s=\"%s\",quantile=\"%s\"} %.9f\n", name, label, value,
+                            quantile_names[i], (double)histogram_quantile(histogram, quantiles[i]) / 1e9)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Zapíše rodinu histogramov `name` a za ňu samostatnú rodinu
+ *        `name_quantile` (gauge) s kvantilmi z tých istých súčtov.
+ *
+ * @param offset Poloha prvého histogramu rodiny v MetricsShard.
+ * @param histograms Pracovné miesto pre `count` histogramov.
+ */
+static int write_histogram_family(Buffer *out, const char *name, const char *help, const char *label,
+                                  const char *const *values, int count, size_t offset,
+                                  MetricsHistogram *histograms) {
+    for (int i = 0; i < count; i++) {
+        histogram_collect(offset + (size_t)i * sizeof(MetricsHistogram), &histograms[i]);
+    }
+
+    if (!buffer_appendf(out, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name)) return 0;
+    for (int i = 0; i < count; i++) {
+        if (!write_histogram(out, name, label, values[i], &histograms[i])) return 0;
+    }
+    if (!buffer_appendf(out, "# HELP %s_quantile Kvantily p50, p90, p99 a p99.9 z histogramu %s.\n"
+                             "# TYPE %s_quantile gauge\n", name, name, name)) {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!write_quantiles(out, name, label, values[i], &histograms[i])) return 0;
+    }
+    return 1;
+}
+
+int metrics_write_prometheus(Buffer *out) {
+    uint64_t counters[METRICS_COUNTER_COUNT] = {0};
+    uint64_t errors[METRICS_ERROR_COUNT] = {0};
+    for (MetricsShard *shard = __atomic_load_n(&shard_list, __ATOMIC_ACQUIRE); shard; shard = shard->next) {
+        for (int i = 0; i < METRICS_COUNTER_COUNT; i++) counters[i] += SHARD_READ(shard->counters[i]);
+        for (int i = 0; i < METRICS_ERROR_COUNT; i++) errors[i] += SHARD_READ(shard->errors[i]);
+    }
+    uint64_t open = counters[METRICS_CONNECTIONS_OPENED] >= counters[METRICS_CONNECTIONS_CLOSED]
+                        ? counters[METRICS_CONNECTIONS_OPENED] - counters[METRICS_CONNECTIONS_CLOSED] : 0;
+
+    if (!buffer_appendf(out,
+            "# HELP password_server_requests_total Počet spracovaných HTTP požiadaviek.\n"
+            "# TYPE password_server_requests_total counter\n"
+            "password_server_requests_total %llu\n"
+            "# HELP password_server_frames_total Počet spracovaných rámcov binárneho protokolu (Unix socket).\n"
+            "# TYPE password_server_frames_total counter\n"
+            "password_server_frames_total %llu\n"
+            "# HELP password_server_received_bytes_total Bajty prijaté od klientov.\n"
+            "# TYPE password_server_received_bytes_total counter\n"
+            "password_server_received_bytes_total %llu\n"
+            "# HELP password_server_sent_bytes_total Bajty odoslané klientom.\n"
+            "# TYPE password_server_sent_bytes_total counter\n"
+            "password_server_sent_bytes_total %llu\n"
+            "# HELP password_server_connections_accepted_total Prevzaté spojenia.\n"
+            "# TYPE password_server_connections_accepted_total counter\n"
+            "password_server_connections_accepted_total %llu\n"
+            "# HELP password_server_connections_open Aktuálne otvorené spojenia.\n"
+            "# TYPE password_server_connections_open gauge\n"
+            "password_server_connections_open %llu\n"
+            "# HELP password_server_access_log_dropped_total Záznamy access logu zahodené pri plnom bufferi.\n"
+            "# TYPE password_server_access_log_dropped_total counter\n"
+            "password_server_access_log_dropped_total %llu\n"
+            "# HELP password_server_eval_cache_hits_total Vyhodnotenia hesiel obslúžené z cache.\n"
+            "# TYPE password_server_eval_cache_hits_total counter\n"
+            "password_server_eval_cache_hits_total %llu\n"
+            "# HELP password_server_eval_cache_misses_total Vyhodnotenia hesiel, ktoré v cache neboli.\n"
+            "# TYPE password_server_eval_cache_misses_total counter\n"
+            "password_server_eval_cache_misses_total %llu\n"
+            "# HELP password_server_eval_cache_evictions_total Platné záznamy cache vytlačené novými.\n"
+            "# TYPE password_server_eval_cache_evictions_total counter\n"
+            "password_server_eval_cache_evictions_total %llu\n"
+            "# HELP password_server_errors_total Chyby podľa druhu.\n"
+            "# TYPE password_server_errors_total counter\n",
+            (unsigned long long)counters[METRICS_REQUESTS],
+            (unsigned long long)counters[METRICS_FRAMES],
+            (unsigned long long)counters[METRICS_BYTES_RECEIVED],
+            (unsigned long long)counters[METRICS_BYTES_SENT],
+            (unsigned long long)counters[METRICS_CONNECTIONS_OPENED],
+            (unsigned long long)open,
+            (unsigned long long)counters[METRICS_LOG_DROPPED],
+            (unsigned long long)counters[METRICS_EVAL_CACHE_HITS],
+            (unsigned long long)counters[METRICS_EVAL_CACHE_MISSES],
+            (unsigned long long)counters[METRICS_EVAL_CACHE_EVICTIONS])) {
+        return 0;
+    }
+    for (int i = 0; i < METRICS_ERROR_COUNT; i++) {
+        if (!buffer_appendf(out, "password_server_errors_total{kind=\"%s\"} %llu\n",
+                            error_names[i], (unsigned long long)errors[i])) {
+            return 0;
+        }
+    }
+
+    // Histogramy sú veľké, na zásobník sa nedávajú.
+    int family_size = (int)METRICS_ROUTE_COUNT > (int)METRICS_PHASE_COUNT ? (int)METRICS_ROUTE_COUNT
+                                                                          : (int)METRICS_PHASE_COUNT;
+    MetricsHistogram *histograms = (MetricsHistogram *)malloc((size_t)family_size * sizeof(MetricsHistogram));
+    if (!histograms) return 0;
+    int ok = write_histogram_family(out, "password_server_request_duration_seconds",
+                                    "Čas spracovania požiadavky handlerom podľa endpointu.",
+                                    "route", route_names, METRICS_ROUTE_COUNT,
+                                    offsetof(MetricsShard, routes), histograms) &&
+             write_histogram_family(out, "password_server_phase_duration_seconds",
+                                    "Trvanie fáz požiadavky (čakanie vo fronte, parsovanie, výpočet, zápis).",
+                                    "phase", phase_names, METRICS_PHASE_COUNT,
+                                    offsetof(MetricsShard, phases), histograms);
+    free(histograms);
+    return ok;
+}
@@ -0,0 +1,111 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include "Buffer.h"
+
+// Počet bitov za najvyšším bitom hodnoty, ktoré určujú podvedierko histogramu
+// (2^3 = 8 vedierok na každú mocninu 2, relatívna chyba najviac 12,5 %)
+#define METRICS_SUB_BUCKET_BITS 3
+// Najväčšia rozlíšená hodnota je 2^METRICS_MAX_EXPONENT ns (~69 s), väčšie
+// padnú do posledného vedierka
+#define METRICS_MAX_EXPONENT 36
+// Počet vedierok histogramu
+#define METRICS_HISTOGRAM_BUCKETS ((METRICS_MAX_EXPONENT - METRICS_SUB_BUCKET_BITS + 2) << METRICS_SUB_BUCKET_BITS)
+
+// Endpointy, pre ktoré sa meria čas spracovania (pozri request_route()).
+typedef enum {
+    METRICS_ROUTE_STATIC,
+    METRICS_ROUTE_OPTIONS,
+    METRICS_ROUTE_GENERATE,
+    METRICS_ROUTE_GENERATE_BATCH,
+    METRICS_ROUTE_EVALUATE,
+    METRICS_ROUTE_EVALUATE_BATCH,
+    METRICS_ROUTE_STRENGTHEN,
+    METRICS_ROUTE_PASSPHRASE,
+    METRICS_ROUTE_POLICIES,
+    METRICS_ROUTE_METRICS,
+    METRICS_ROUTE_UNIX_GENERATE,     // Rámce binárneho protokolu na Unix sockete.
+    METRICS_ROUTE_UNIX_EVALUATE,
+    METRICS_ROUTE_UNIX_STRENGTHEN,
+    METRICS_ROUTE_OTHER,
+    METRICS_ROUTE_COUNT
+} MetricsRoute;
+
+// Fázy životného cyklu požiadavky.
+typedef enum {
+    METRICS_PHASE_ACCEPT_WAIT,   // Od accept() po prevzatie spojenia vláknom.
+    METRICS_PHASE_PARSE,         // Parsovanie hlavičiek a dekódovanie chunked tela.
+    METRICS_PHASE_COMPUTE,       // Handler (všetky endpointy spolu).
+    METRICS_PHASE_WRITE,         // Od prvého pokusu o zápis po odovzdanie celej odpovede jadru.
+    METRICS_PHASE_COUNT
+} MetricsPhase;
+
+// Jednoduché počítadlá.
+typedef enum {
+    METRICS_BYTES_RECEIVED,
+    METRICS_BYTES_SENT,
+    METRICS_CONNECTIONS_OPENED,
+    METRICS_CONNECTIONS_CLOSED,
+    METRICS_REQUESTS,
+    METRICS_FRAMES,              // Rámce binárneho protokolu (Unix socket).
+    METRICS_LOG_DROPPED,         // Záznamy access logu zahodené pri plnom bufferi.
+    METRICS_EVAL_CACHE_HITS,     // /api/evaluate obslúžené z cache.
+    METRICS_EVAL_CACHE_MISSES,   // /api/evaluate, ktoré sa museli vyhodnotiť.
+    METRICS_EVAL_CACHE_EVICTIONS, // Platné záznamy cache vytlačené novými.
+    METRICS_COUNTER_COUNT
+} MetricsCounter;
+
+// Druhy chýb.
+typedef enum {
+    METRICS_ERROR_BAD_REQUEST,   // 400: chybná HTTP požiadavka alebo JSON.
+    METRICS_ERROR_TOO_LARGE,     // 413/431: priveľké telo alebo hlavičky.
+    METRICS_ERROR_TIMEOUT,       // 408: klient neposlal požiadavku včas.
+    METRICS_ERROR_IO,            // Chyba čítania alebo zápisu na socket.
+    METRICS_ERROR_REJECTED,      // Spojenie odmietnuté, fronty vlákien sú plné.
+    METRICS_ERROR_INTERNAL,      // 500: napr. chyba alokácie.
+    METRICS_ERROR_RATE_LIMITED,  // 503: klient prekročil limit požiadaviek.
+    METRICS_ERROR_OVERLOADED,    // 503: priveľa rozpracovaných požiadaviek.
+    METRICS_ERROR_COUNT
+} MetricsError;
+
+/**
+ * @brief Aktuálny monotónny čas v nanosekundách (pre merania trvania).
+ */
+uint64_t metrics_now_ns(void);
+
+/**
+ * @brief Pripočíta hodnotu k počítadlu.
+ *
+ * Každé vlákno zapisuje do vlastnej kópie bez zámkov a atomických
+ * inštrukcií s prefixom lock; súčet sa robí až pri čítaní.
+ */
+void metrics_add(MetricsCounter counter, uint64_t value);
+
+/**
+ * @brief Započíta jednu chybu daného druhu.
+ */
+void metrics_error(MetricsError error);
+
+/**
+ * @brief Zapíše trvanie spracovania požiadavky endpointom (v ns).
+ */
+void metrics_record_route(MetricsRoute route, uint64_t duration_ns);
+
+/**
+ * @brief Zapíše trvanie fázy požiadavky (v ns).
+ */
+void metrics_record_phase(MetricsPhase phase, uint64_t duration_ns);
+
+/**
+ * @brief Sčíta údaje všetkých vlákien a zapíše ich v textovom formáte Prometheus.
+ *
+ * Histogramy sa exportujú s hranicami na mocninách 2 (od ~1 µs) a navyše
+ * ako kvantily (p50, p90, p99, p99.9) vypočítané z plného rozlíšenia.
+ *
+ * @param out Buffer, na ktorého koniec sa výstup pripojí.
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+int metrics_write_prometheus(Buffer *out);
+
+#endif // METRICS_H
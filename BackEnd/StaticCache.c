@@ -0,0 +1,414 @@
+#include "StaticCache.h"
+#include "HTTPserver.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+// Aktuálna tabuľka; výmenu chráni rwlock, čítanie drží zámok len na
+// dobu zvýšenia počítadla referencií.
+static StaticTable *current_table = NULL;
+static pthread_rwlock_t table_lock = PTHREAD_RWLOCK_INITIALIZER;
+static char static_root[256];
+
+// Dynamické pole súborov počas načítavania adresára.
+typedef struct {
+    StaticAsset *items;
+    size_t count;
+    size_t capacity;
+} AssetList;
+
+/**
+ * @brief 64-bitový FNV-1a haš (pre ETag aj index tabuľky).
+ */
+static uint64_t fnv1a_hash(const char *data, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Určí hodnotu Cache-Control podľa typu súboru.
+ *
+ * HTML sa vždy overuje (ETag/304), aby sa nová verzia prejavila hneď;
+ * ostatné súbory si prehliadač môže chvíľu ponechať bez overovania.
+ */
+static const char *cache_control_for(const char *path) {
+    if (strstr(path, ".html")) return "no-cache";
+    return "public, max-age=300";
+}
+
+/**
+ * @brief Skomprimuje dáta do formátu gzip.
+ *
+ * @return Novonalokovaný buffer alebo NULL, ak kompresia zlyhala.
+ */
+static char *gzip_compress(const char *data, size_t length, size_t *out_length) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // windowBits 15 + 16 = gzip hlavička namiesto zlib.
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return NULL;
+    }
+
+    size_t capacity = deflateBound(&stream, (uLong)length);
+    char *output = (char *)malloc(capacity);
+    if (!output) {
+        deflateEnd(&stream);
+        return NULL;
+    }
+
+    stream.next_in = (Bytef *)data;
+    stream.avail_in = (uInt)length;
+    stream.next_out = (Bytef *)output;
+    stream.avail_out = (uInt)capacity;
+    int status = deflate(&stream, Z_FINISH);
+    *out_length = stream.total_out;
+    deflateEnd(&stream);
+
+    if (status != Z_STREAM_END) {
+        free(output);
+        return NULL;
+    }
+    return output;
+}
+
+/**
+ * @brief Zostaví hlavičky 200 a 304 pre jednu reprezentáciu súboru.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+static int build_variant_headers(StaticVariant *variant, const char *path, const char *encoding) {
+    const char *cache_control = cache_control_for(path);
+    char header[512];
+
+    int length = snprintf(header, sizeof(header),
+                          "HTTP/1.1 200 OK\r\n"
+                          "Content-Type: %s\r\n"
+                          "Content-Length: %zu\r\n"
+                          "%s%s%s"
+                          "ETag: %s\r\n"
+                          "Cache-Control: %s\r\n"
+                          "Vary: Accept-Encoding\r\n",
+                          get_mime_type(path), variant->body_length,
+                          encoding ? "Content-Encoding: " : "", encoding ? encoding : "", encoding ? "\r\n" : "",
+                          variant->etag, cache_control);
+    variant->header = strndup(header, (size_t)length);
+    variant->header_length = (size_t)length;
+
+    length = snprintf(header, sizeof(header),
+                      "HTTP/1.1 304 Not Modified\r\n"
+                      "ETag: %s\r\n"
+                      "Cache-Control: %s\r\n"
+                      "Vary: Accept-Encoding\r\n",
+                      variant->etag, cache_control);
+    variant->not_modified_header = strndup(header, (size_t)length);
+    variant->not_modified_length = (size_t)length;
+
+    return variant->header && variant->not_modified_header;
+}
+
+/**
+ * @brief Uvoľní pamäť jednej reprezentácie.
+ */
+static void free_variant(StaticVariant *variant) {
+    free(variant->body);
+    free(variant->header);
+    free(variant->not_modified_header);
+}
+
+/**
+ * @brief Načíta jeden súbor a pripraví jeho reprezentácie.
+ *
+ * @param file_path Cesta k súboru na disku.
+ * @param url_path URL cesta, pod ktorou sa bude servírovať.
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+static int load_asset(StaticAsset *asset, const char *file_path, const char *url_path) {
+    memset(asset, 0, sizeof(*asset));
+
+    FILE *file = fopen(file_path, "rb");
+    if (!file) return 0;
+
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_size < 0 || file_size > STATIC_MAX_FILE_SIZE) {
+        fclose(file);
+        return 0;
+    }
+
+    // +1, aby malloc(0) pri prázdnom súbore nevrátil NULL.
+    asset->identity.body = (char *)malloc((size_t)file_size + 1);
+    if (!asset->identity.body) {
+        fclose(file);
+        return 0;
+    }
+    asset->identity.body_length = fread(asset->identity.body, 1, (size_t)file_size, file);
+    fclose(file);
+
+    asset->path = strdup(url_path);
+    asset->path_length = strlen(url_path);
+
+    uint64_t hash = fnv1a_hash(asset->identity.body, asset->identity.body_length);
+    snprintf(asset->identity.etag, sizeof(asset->identity.etag), "\"%016llx-%zx\"",
+             (unsigned long long)hash, asset->identity.body_length);
+
+    // Gzip verzia sa ponechá, len ak ušetrí dostatok miesta.
+    size_t gzip_length = 0;
+    char *gzip_body = gzip_compress(asset->identity.body, asset->identity.body_length, &gzip_length);
+    if (gzip_body && gzip_length * 100 <= asset->identity.body_length * (100 - STATIC_GZIP_MIN_SAVING)) {
+        asset->has_gzip = 1;
+        asset->gzip.body = gzip_body;
+        asset->gzip.body_length = gzip_length;
+        snprintf(asset->gzip.etag, sizeof(asset->gzip.etag), "\"%016llx-%zx-gz\"",
+                 (unsigned long long)hash, asset->identity.body_length);
+    } else {
+        free(gzip_body);
+    }
+
+    int ok = asset->path && build_variant_headers(&asset->identity, url_path, NULL);
+    if (ok && asset->has_gzip) {
+        ok = build_variant_headers(&asset->gzip, url_path, "gzip");
+    }
+    return ok;
+}
+
+/**
+ * @brief Rekurzívne načíta všetky súbory z adresára.
+ *
+ * @param dir_path Cesta k adresáru na disku.
+ * @param url_prefix URL prefix súborov v tomto adresári (napr. "" alebo "/img").
+ */
+static int load_directory(AssetList *list, const char *dir_path, const char *url_prefix) {
+    DIR *dir = opendir(dir_path);
+    if (!dir) return 0;
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        // Skryté súbory (aj "." a "..") sa nezverejňujú.
+        if (entry->d_name[0] == '.') continue;
+
+        char file_path[512];
+        char url_path[512];
+        snprintf(file_path, sizeof(file_path), "%s/%s", dir_path, entry->d_name);
+        snprintf(url_path, sizeof(url_path), "%s/%s", url_prefix, entry->d_name);
+
+        struct stat info;
+        if (stat(file_path, &info) != 0) continue;
+
+        if (S_ISDIR(info.st_mode)) {
+            load_directory(list, file_path, url_path);
+            continue;
+        }
+        if (!S_ISREG(info.st_mode)) continue;
+
+        if (list->count == list->capacity) {
+            size_t new_capacity = list->capacity ? list->capacity * 2 : 16;
+            StaticAsset *items = (StaticAsset *)realloc(list->items, new_capacity * sizeof(StaticAsset));
+            if (!items) break;
+            list->items = items;
+            list->capacity = new_capacity;
+        }
+
+        if (load_asset(&list->items[list->count], file_path, url_path)) {
+            list->count++;
+        } else {
+            fprintf(stderr, "Nepodarilo sa načítať %s\n", file_path);
+            StaticAsset *failed = &list->items[list->count];
+            free(failed->path);
+            free_variant(&failed->identity);
+            free_variant(&failed->gzip);
+        }
+    }
+
+    closedir(dir);
+    return 1;
+}
+
+/**
+ * @brief Uvoľní tabuľku so všetkými súbormi.
+ */
+static void free_table(StaticTable *table) {
+    for (size_t i = 0; i < table->count; i++) {
+        free(table->assets[i].path);
+        free_variant(&table->assets[i].identity);
+        free_variant(&table->assets[i].gzip);
+    }
+    free(table->assets);
+    free(table->index);
+    free(table);
+}
+
+/**
+ * @brief Načíta adresár a zostaví novú nemennú tabuľku s hašovacím indexom.
+ */
+static StaticTable *build_table(const char *root) {
+    AssetList list = { NULL, 0, 0 };
+    if (!load_directory(&list, root, "")) {
+        free(list.items);
+        return NULL;
+    }
+
+    StaticTable *table = (StaticTable *)calloc(1, sizeof(StaticTable));
+    if (!table) {
+        free(list.items);
+        return NULL;
+    }
+    table->assets = list.items;
+    table->count = list.count;
+    table->references = 1;
+
+    // Index má aspoň dvojnásobok miest oproti počtu súborov.
+    size_t slots = 8;
+    while (slots < list.count * 2) slots <<= 1;
+    table->index = (StaticAsset **)calloc(slots, sizeof(StaticAsset *));
+    if (!table->index) {
+        free_table(table);
+        return NULL;
+    }
+    table->index_mask = slots - 1;
+
+    for (size_t i = 0; i < table->count; i++) {
+        StaticAsset *asset = &table->assets[i];
+        size_t slot = fnv1a_hash(asset->path, asset->path_length) & table->index_mask;
+        while (table->index[slot]) slot = (slot + 1) & table->index_mask;
+        table->index[slot] = asset;
+    }
+    return table;
+}
+
+/**
+ * @brief Atomicky nahradí aktuálnu tabuľku novou.
+ */
+static void swap_table(StaticTable *table) {
+    pthread_rwlock_wrlock(&table_lock);
+    StaticTable *old_table = current_table;
+    current_table = table;
+    pthread_rwlock_unlock(&table_lock);
+
+    if (old_table) static_cache_release(old_table);
+}
+
+int static_cache_init(const char *root) {
+    snprintf(static_root, sizeof(static_root), "%s", root);
+
+    StaticTable *table = build_table(static_root);
+    if (!table) return 0;
+    swap_table(table);
+
+    printf("Statická cache: %zu súborov z adresára %s\n", table->count, static_root);
+    return 1;
+}
+
+/**
+ * @brief Vlákno, ktoré pri zmene súborov zostaví a vymení novú tabuľku.
+ */
+static void *watch_main(void *arg) {
+    int inotify_fd = (int)(intptr_t)arg;
+    char events[4096];
+
+    while (read(inotify_fd, events, sizeof(events)) > 0) {
+        // Editory často zapisujú súbor vo viacerých krokoch; chvíľu počkáme
+        // a zvyšné udalosti zahodíme, aby sa tabuľka zostavila len raz.
+        usleep(100 * 1000);
+        int flags = fcntl(inotify_fd, F_GETFL, 0);
+        fcntl(inotify_fd, F_SETFL, flags | O_NONBLOCK);
+        while (read(inotify_fd, events, sizeof(events)) > 0) {
+        }
+        fcntl(inotify_fd, F_SETFL, flags);
+
+        StaticTable *table = build_table(static_root);
+        if (table) {
+            swap_table(table);
+            printf("Statická cache znovu načítaná (%zu súborov)\n", table->count);
+        }
+    }
+    return NULL;
+}
+
+int static_cache_watch(void) {
+    int inotify_fd = inotify_init1(IN_CLOEXEC);
+    if (inotify_fd < 0) {
+        perror("inotify_init1");
+        return 0;
+    }
+    if (inotify_add_watch(inotify_fd, static_root,
+                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE) < 0) {
+        perror("inotify_add_watch");
+        close(inotify_fd);
+        return 0;
+    }
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, watch_main, (void *)(intptr_t)inotify_fd) != 0) {
+        close(inotify_fd);
+        return 0;
+    }
+    pthread_detach(thread);
+    return 1;
+}
+
+StaticTable *static_cache_acquire(void) {
+    pthread_rwlock_rdlock(&table_lock);
+    StaticTable *table = current_table;
+    if (table) __atomic_add_fetch(&table->references, 1, __ATOMIC_RELAXED);
+    pthread_rwlock_unlock(&table_lock);
+    return table;
+}
+
+void static_cache_release(void *table) {
+    StaticTable *static_table = (StaticTable *)table;
+    if (__atomic_sub_fetch(&static_table->references, 1, __ATOMIC_ACQ_REL) == 0) {
+        free_table(static_table);
+    }
+}
+
+const StaticAsset *static_cache_find(const StaticTable *table, const char *path, size_t path_length) {
+    size_t slot = fnv1a_hash(path, path_length) & table->index_mask;
+    while (table->index[slot]) {
+        const StaticAsset *asset = table->index[slot];
+        if (asset->path_length == path_length && memcmp(asset->path, path, path_length) == 0) {
+            return asset;
+        }
+        slot = (slot + 1) & table->index_mask;
+    }
+    return NULL;
+}
+
+const StaticVariant *static_asset_select(const StaticAsset *asset, HttpSlice accept_encoding) {
+    if (asset->has_gzip && accept_encoding.length && http_slice_has_token(accept_encoding, "gzip")) {
+        return &asset->gzip;
+    }
+    return &asset->identity;
+}
+
+int static_variant_etag_matches(const StaticVariant *variant, HttpSlice if_none_match) {
+    const char *p = if_none_match.data;
+    const char *end = p + if_none_match.length;
+    size_t etag_length = strlen(variant->etag);
+
+    // Hodnota je "*" alebo zoznam ETagov oddelených čiarkami; pri If-None-Match
+    // sa porovnáva slabo, takže prefix "W/" sa ignoruje.
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) p++;
+        if (p < end && *p == '*') return 1;
+        if (end - p >= 2 && p[0] == 'W' && p[1] == '/') p += 2;
+
+        const char *tag = p;
+        while (p < end && *p != ',') p++;
+        const char *tag_end = p;
+        while (tag_end > tag && (tag_end[-1] == ' ' || tag_end[-1] == '\t')) tag_end--;
+
+        if ((size_t)(tag_end - tag) == etag_length && memcmp(tag, variant->etag, etag_length) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
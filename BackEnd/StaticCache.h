@@ -0,0 +1,93 @@
+#ifndef STATICCACHE_H
+#define STATICCACHE_H
+
+#include <stddef.h>
+#include "HttpParser.h"
+
+// Adresár so statickými súbormi frontendu
+#define STATIC_ROOT "Frontend"
+// Súbory väčšie ako tento limit sa do pamäte nenačítajú
+#define STATIC_MAX_FILE_SIZE (16 * 1024 * 1024)
+// Komprimovaná verzia sa použije, len ak ušetrí aspoň 10 % veľkosti
+#define STATIC_GZIP_MIN_SAVING 10
+
+// Jedna reprezentácia súboru (nekomprimovaná alebo gzip) s predpripravenými
+// hlavičkami. Hlavičky neobsahujú `Connection` ani záverečný prázdny riadok,
+// tie závisia od konkrétneho spojenia.
+typedef struct {
+    char *body;                  // Telo odpovede.
+    size_t body_length;
+    char etag[48];               // Silný ETag tejto reprezentácie vrátane úvodzoviek.
+    char *header;                // Hlavičky odpovede 200.
+    size_t header_length;
+    char *not_modified_header;   // Hlavičky odpovede 304.
+    size_t not_modified_length;
+} StaticVariant;
+
+// Jeden súbor načítaný do pamäte.
+typedef struct {
+    char *path;                  // URL cesta, napr. "/index.html".
+    size_t path_length;
+    StaticVariant identity;      // Nekomprimovaný obsah.
+    StaticVariant gzip;          // Obsah skomprimovaný gzipom (ak `has_gzip`).
+    int has_gzip;
+} StaticAsset;
+
+// Nemenná tabuľka všetkých súborov. Po zostavení sa už nemení; pri zmene
+// súborov sa zostaví nová a atomicky vymení. Stará sa uvoľní, keď ju
+// prestane používať posledné spojenie.
+typedef struct {
+    StaticAsset *assets;
+    size_t count;
+    StaticAsset **index;         // Hašovací index podľa cesty (otvorené adresovanie).
+    size_t index_mask;
+    int references;              // Počet držiteľov (atomické počítadlo).
+} StaticTable;
+
+/**
+ * @brief Načíta všetky súbory z adresára `root` do pamäte.
+ *
+ * @param root Koreňový adresár (napr. STATIC_ROOT).
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int static_cache_init(const char *root);
+
+/**
+ * @brief Spustí vlákno, ktoré sleduje zmeny v adresári a tabuľku znovu načíta.
+ *
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int static_cache_watch(void);
+
+/**
+ * @brief Vráti aktuálnu tabuľku a zvýši počet jej referencií.
+ *
+ * @return Tabuľka alebo NULL, ak sa nepodarilo nič načítať.
+ */
+StaticTable *static_cache_acquire(void);
+
+/**
+ * @brief Uvoľní referenciu získanú cez `static_cache_acquire()`.
+ *
+ * @param table Ukazovateľ na StaticTable (typ void* kvôli `connection_pin()`).
+ */
+void static_cache_release(void *table);
+
+/**
+ * @brief Nájde súbor podľa URL cesty.
+ *
+ * @return Súbor alebo NULL, ak v tabuľke nie je.
+ */
+const StaticAsset *static_cache_find(const StaticTable *table, const char *path, size_t path_length);
+
+/**
+ * @brief Vyberie reprezentáciu súboru podľa hlavičky Accept-Encoding.
+ */
+const StaticVariant *static_asset_select(const StaticAsset *asset, HttpSlice accept_encoding);
+
+/**
+ * @brief Zistí, či hodnota hlavičky If-None-Match zodpovedá ETagu reprezentácie.
+ */
+int static_variant_etag_matches(const StaticVariant *variant, HttpSlice if_none_match);
+
+#endif // STATICCACHE_H
@@ -0,0 +1,276 @@
+#include "Supervisor.h"
+#include "TimerWheel.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/signalfd.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// Najviac sledovaných procesov: bežiaca generácia aj staré, ktoré ešte dobiehajú.
+#define MAX_SUPERVISED (4 * MAX_WORKER_PROCESSES)
+
+// Pracovný proces sledovaný supervisorom.
+typedef struct {
+    pid_t pid;
+    int index;               // Poradie v generácii (určuje CPU).
+    int generation;
+    uint64_t started_ms;
+} SupervisedWorker;
+
+static SupervisedWorker supervised[MAX_SUPERVISED];
+static int supervised_count;
+static char exe_path[PATH_MAX];
+static char *const *worker_argv;
+static int cpus[CPU_SETSIZE];    // CPU, na ktorých smie supervisor bežať.
+static int cpu_count;
+
+int supervisor_worker_index(int *ready_fd) {
+    *ready_fd = -1;
+    const char *value = getenv(WORKER_ENV);
+    int index, fd;
+    if (!value || sscanf(value, "%d,%d", &index, &fd) != 2 || index < 0) return -1;
+    *ready_fd = fd;
+    // Procesy, ktoré spustí tento proces (napr. audit), už pracovníkmi nie sú.
+    unsetenv(WORKER_ENV);
+    return index;
+}
+
+void supervisor_notify_ready(int ready_fd) {
+    if (ready_fd < 0) return;
+    char ready = 1;
+    if (write(ready_fd, &ready, 1) < 0) perror("write");
+    close(ready_fd);
+}
+
+/**
+ * @brief Spustí jeden pracovný proces pripnutý na CPU podľa jeho poradia.
+ *
+ * @param ready_fd Deskriptor, ktorý proces zdedí na ohlásenie pripravenosti, alebo -1.
+ * @return PID procesu alebo -1 pri chybe.
+ */
+static pid_t spawn_worker(int index, int generation, int ready_fd) {
+    if (supervised_count == MAX_SUPERVISED) {
+        fprintf(stderr, "Supervisor: príliš veľa procesov\n");
+        return -1;
+    }
+
+    pid_t parent = getpid();
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0) {
+        // Signály blokované pre signalfd by zdedil aj nový program.
+        sigset_t none;
+        sigemptyset(&none);
+        sigprocmask(SIG_SETMASK, &none, NULL);
+        // Ak supervisor zanikne, pracovník skončí tiež.
+        prctl(PR_SET_PDEATHSIG, SIGTERM);
+        if (getppid() != parent) _exit(1);
+
+        if (cpu_count > 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpus[index % cpu_count], &set);
+            if (sched_setaffinity(0, sizeof(set), &set) < 0) perror("sched_setaffinity");
+        }
+        char value[32];
+        snprintf(value, sizeof(value), "%d,%d", index, ready_fd);
+        if (ready_fd >= 0) fcntl(ready_fd, F_SETFD, 0);
+        setenv(WORKER_ENV, value, 1);
+        execv(exe_path, worker_argv);
+        perror("execv");
+        _exit(127);
+    }
+
+    SupervisedWorker *worker = &supervised[supervised_count++];
+    worker->pid = pid;
+    worker->index = index;
+    worker->generation = generation;
+    worker->started_ms = timer_now_ms();
+    return pid;
+}
+
+/**
+ * @brief Spustí celú generáciu procesov a počká, kým všetky začnú počúvať.
+ *
+ * @return 1 ak sa ohlásili všetky procesy, inak 0.
+ */
+static int start_generation(int generation, int worker_count) {
+    int ready_pipe[2];
+    if (pipe2(ready_pipe, O_CLOEXEC) < 0) {
+        perror("pipe2");
+        return 0;
+    }
+
+    int spawned = 0;
+    for (int i = 0; i < worker_count; i++) {
+        if (spawn_worker(i, generation, ready_pipe[1]) > 0) spawned++;
+    }
+    close(ready_pipe[1]);
+
+    // Každý proces pošle jeden bajt; koniec súboru znamená, že zvyšné spadli.
+    int ready = 0;
+    uint64_t deadline = timer_now_ms() + WORKER_READY_TIMEOUT_MS;
+    while (ready < spawned) {
+        uint64_t now = timer_now_ms();
+        if (now >= deadline) break;
+        struct pollfd fd = {ready_pipe[0], POLLIN, 0};
+        int polled = poll(&fd, 1, (int)(deadline - now));
+        if (polled < 0 && errno == EINTR) continue;
+        if (polled <= 0) break;
+        char buffer[MAX_WORKER_PROCESSES];
+        ssize_t bytes = read(ready_pipe[0], buffer, sizeof(buffer));
+        if (bytes <= 0) break;
+        ready += (int)bytes;
+    }
+    close(ready_pipe[0]);
+    return ready == worker_count;
+}
+
+/**
+ * @brief Pošle signál procesom jednej generácie (alebo všetkým pri generation < 0).
+ */
+static void signal_generation(int generation, int signal_number) {
+    for (int i = 0; i < supervised_count; i++) {
+        if (generation < 0 || supervised[i].generation == generation) {
+            kill(supervised[i].pid, signal_number);
+        }
+    }
+}
+
+/**
+ * @brief Pozbiera skončené procesy; spadnutých pracovníkov bežiacej generácie nahradí.
+ */
+static void reap_workers(int current_generation, int stopping) {
+    int status;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        int found = -1;
+        for (int i = 0; i < supervised_count; i++) {
+            if (supervised[i].pid == pid) {
+                found = i;
+                break;
+            }
+        }
+        if (found < 0) continue;
+        SupervisedWorker worker = supervised[found];
+        supervised[found] = supervised[--supervised_count];
+
+        if (stopping || worker.generation != current_generation) continue;
+
+        // Proces bežiacej generácie nemal skončiť.
+        if (WIFSIGNALED(status)) {
+            fprintf(stderr, "Supervisor: proces %d (PID %d) ukončil signál %d, spúšťam nový\n",
+                    worker.index, (int)pid, WTERMSIG(status));
+        } else {
+            fprintf(stderr, "Supervisor: proces %d (PID %d) skončil s kódom %d, spúšťam nový\n",
+                    worker.index, (int)pid, WEXITSTATUS(status));
+        }
+        uint64_t lived = timer_now_ms() - worker.started_ms;
+        if (lived < WORKER_RESPAWN_DELAY_MS) {
+            // Proces padá hneď po štarte: nový sa spustí s odstupom, nie v slučke.
+            uint64_t wait_ms = WORKER_RESPAWN_DELAY_MS - lived;
+            struct timespec delay = {(time_t)(wait_ms / 1000), (long)(wait_ms % 1000) * 1000000L};
+            nanosleep(&delay, NULL);
+        }
+        spawn_worker(worker.index, worker.generation, -1);
+    }
+}
+
+int supervisor_run(char *const argv[], int worker_count) {
+    // Nová generácia sa spúšťa z cesty binárky, aby reštart načítal jej novú verziu.
+    ssize_t length = readlink("/proc/self/exe", exe_path, sizeof(exe_path) - 1);
+    if (length <= 0) {
+        perror("readlink");
+        return 0;
+    }
+    exe_path[length] = '\0';
+    worker_argv = argv;
+
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) cpus[cpu_count++] = cpu;
+        }
+    }
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGCHLD);
+    sigaddset(&signals, SIGHUP);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGINT);
+    sigprocmask(SIG_BLOCK, &signals, NULL);
+    int signal_fd = signalfd(-1, &signals, SFD_CLOEXEC);
+    if (signal_fd < 0) {
+        perror("signalfd");
+        return 0;
+    }
+
+    int generation = 1;
+    int last_generation = 1;
+    if (!start_generation(generation, worker_count)) {
+        fprintf(stderr, "Supervisor: pracovné procesy sa nepodarilo spustiť\n");
+        signal_generation(-1, SIGKILL);
+        while (wait(NULL) > 0) {
+        }
+        return 0;
+    }
+    printf("Supervisor (PID %d): %d pracovných procesov na %d CPU; SIGHUP = reštart\n",
+           (int)getpid(), worker_count, cpu_count);
+    fflush(stdout);
+
+    int stopping = 0;
+    while (1) {
+        struct signalfd_siginfo info;
+        ssize_t bytes = read(signal_fd, &info, sizeof(info));
+        if (bytes != (ssize_t)sizeof(info)) {
+            if (bytes < 0 && errno == EINTR) continue;
+            perror("signalfd");
+            return 0;
+        }
+
+        switch (info.ssi_signo) {
+        case SIGCHLD:
+            reap_workers(generation, stopping);
+            if (stopping && supervised_count == 0) return 1;
+            break;
+        case SIGHUP:
+            if (stopping) break;
+            // Nová generácia počúva súbežne so starou; stará dostane SIGTERM,
+            // až keď nová prijíma spojenia.
+            last_generation++;
+            printf("Supervisor: reštart, spúšťam generáciu %d\n", last_generation);
+            fflush(stdout);
+            if (start_generation(last_generation, worker_count)) {
+                signal_generation(generation, SIGTERM);
+                generation = last_generation;
+            } else {
+                fprintf(stderr, "Supervisor: nová generácia sa nespustila, ostáva generácia %d\n", generation);
+                signal_generation(last_generation, SIGTERM);
+            }
+            break;
+        default:
+            if (stopping) {
+                signal_generation(-1, SIGKILL);
+                break;
+            }
+            stopping = 1;
+            signal_generation(-1, SIGTERM);
+            if (supervised_count == 0) return 1;
+            break;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+// Premenná prostredia, ktorou supervisor odovzdá pracovnému procesu jeho
+// číslo a deskriptor na ohlásenie pripravenosti ("číslo,fd")
+#define WORKER_ENV "SERVER_WORKER"
+// Horná hranica počtu pracovných procesov
+#define MAX_WORKER_PROCESSES 256
+// Ako dlho sa čaká, kým nová generácia procesov začne počúvať (ms)
+#define WORKER_READY_TIMEOUT_MS 10000
+// Proces, ktorý spadne skôr ako po tomto čase, sa znovu spustí až po ňom (ms)
+#define WORKER_RESPAWN_DELAY_MS 1000
+
+/**
+ * @brief Spustí supervisor, ktorý drží `worker_count` pracovných procesov.
+ *
+ * Každý proces je nová inštancia programu (rovnaké argumenty, premenná
+ * WORKER_ENV), pripnutá na jedno CPU, s vlastným socketom na rovnakom
+ * porte (SO_REUSEPORT), takže spojenia medzi procesy rozdeľuje jadro.
+ * Spadnutý proces sa znovu spustí. SIGHUP spustí novú generáciu procesov
+ * (aj z novej binárky na disku) a až keď všetky počúvajú, pošle starým
+ * SIGTERM, aby dobehli rozpracované spojenia. SIGTERM/SIGINT ukončí všetky
+ * procesy, druhý signál ich zabije okamžite.
+ *
+ * @param argv Argumenty programu, s ktorými sa procesy spúšťajú.
+ * @param worker_count Počet pracovných procesov.
+ * @return 1 po riadnom ukončení, 0 ak sa procesy nepodarilo spustiť.
+ */
+int supervisor_run(char *const argv[], int worker_count);
+
+/**
+ * @brief Zistí, či tento proces spustil supervisor ako pracovný proces.
+ *
+ * @param ready_fd Sem sa uloží deskriptor na ohlásenie pripravenosti (-1 ak nie je).
+ * @return Číslo pracovného procesu alebo -1, ak proces beží samostatne.
+ */
+int supervisor_worker_index(int *ready_fd);
+
+/**
+ * @brief Oznámi supervisoru, že pracovný proces počúva; deskriptor zavrie.
+ */
+void supervisor_notify_ready(int ready_fd);
+
+#endif // SUPERVISOR_H
@@ -0,0 +1,269 @@
+#include "ThreadPool.h"
+#include "Connection.h"
+#include "HTTPserver.h"
+#include "Metrics.h"
+#include <errno.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+/**
+ * @brief Zaokrúhli hodnotu nahor na najbližšiu mocninu 2.
+ */
+static size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Inicializuje prázdnu frontu so zadanou kapacitou.
+ */
+static int queue_init(ConnectionQueue *queue, size_t capacity) {
+    queue->capacity = round_up_pow2(capacity);
+    queue->items = (QueuedConnection *)malloc(queue->capacity * sizeof(QueuedConnection));
+    if (!queue->items) return 0;
+    queue->head = queue->tail = queue->count = 0;
+    pthread_mutex_init(&queue->lock, NULL);
+    return 1;
+}
+
+/**
+ * @brief Vloží socket do fronty bez čakania.
+ *
+ * @return -1 ak je fronta plná, 1 ak bola predtým prázdna (vlákno treba
+ *         zobudiť), inak 0.
+ */
+static int queue_try_push(ConnectionQueue *queue, QueuedConnection item) {
+    pthread_mutex_lock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        pthread_mutex_unlock(&queue->lock);
+        return -1;
+    }
+    queue->items[queue->tail] = item;
+    queue->tail = (queue->tail + 1) & (queue->capacity - 1);
+    int was_empty = queue->count++ == 0;
+    pthread_mutex_unlock(&queue->lock);
+    return was_empty;
+}
+
+/**
+ * @brief Vyberie naraz všetky sockety z fronty (najviac `max_items`).
+ *
+ * Jedno zamknutie na celú dávku drží súperenie o zámok na minime.
+ */
+static size_t queue_pop_all(ConnectionQueue *queue, QueuedConnection *items, size_t max_items) {
+    pthread_mutex_lock(&queue->lock);
+    size_t taken = 0;
+    while (queue->count > 0 && taken < max_items) {
+        items[taken++] = queue->items[queue->head];
+        queue->head = (queue->head + 1) & (queue->capacity - 1);
+        queue->count--;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return taken;
+}
+
+/**
+ * @brief Prevezme nové spojenia z fronty a zaregistruje ich v epolle vlákna.
+ */
+static void worker_accept_new(Worker *worker) {
+    uint64_t counter;
+    while (read(worker->wake_fd, &counter, sizeof(counter)) > 0) {
+    }
+
+    QueuedConnection items[MAX_EPOLL_EVENTS];
+    size_t count;
+    while ((count = queue_pop_all(&worker->inbox, items, MAX_EPOLL_EVENTS)) > 0) {
+        uint64_t now = metrics_now_ns();
+        for (size_t i = 0; i < count; i++) {
+            metrics_record_phase(METRICS_PHASE_ACCEPT_WAIT, now - items[i].accepted_ns);
+            if (!connection_open(worker, items[i].fd, items[i].protocol)) {
+                close(items[i].fd);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Prevezme spojenia, ktorým iné vlákna dokončili prácu, a pokračuje v nich.
+ */
+static void worker_resume_connections(Worker *worker) {
+    pthread_mutex_lock(&worker->resume_lock);
+    Connection *conn = worker->resumed;
+    worker->resumed = NULL;
+    pthread_mutex_unlock(&worker->resume_lock);
+
+    while (conn) {
+        Connection *next = conn->resume_next;
+        conn->resume_next = NULL;
+        connection_on_resume(conn);
+        conn = next;
+    }
+}
+
+/**
+ * @brief Event loop pracovného vlákna.
+ *
+ * Čaká na udalosti zo socketov svojich spojení a z `wake_fd`, spracuje ich,
+ * dá slovo odloženým spojeniam a posunie časové koleso. Čakanie je obmedzené
+ * na jedno tiknutie kolesa, aby časové limity vypršali včas aj bez iných
+ * udalostí.
+ */
+static void *worker_main(void *arg) {
+    Worker *worker = (Worker *)arg;
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+
+    while (1) {
+        // Ak čakajú odložené spojenia, epoll sa len skontroluje bez čakania.
+        int timeout = worker->ready_count > 0 ? 0 : TIMER_TICK_MS;
+        int ready = epoll_wait(worker->epoll_fd, events, MAX_EPOLL_EVENTS, timeout);
+        if (ready < 0 && errno != EINTR) {
+            perror("epoll_wait");
+        }
+
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.ptr == NULL) {
+                worker_accept_new(worker);
+                worker_resume_connections(worker);
+            } else {
+                connection_handle_events((Connection *)events[i].data.ptr, events[i].events);
+            }
+        }
+
+        connection_run_ready(worker);
+        if (!worker->draining && __atomic_load_n(&worker->drain_requested, __ATOMIC_ACQUIRE)) {
+            worker->draining = 1;
+            connection_drain(worker);
+        }
+        timer_wheel_advance(&worker->timers, timer_now_ms(), connection_on_timeout);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Pripraví epoll, eventfd a frontu jedného vlákna.
+ */
+static int worker_init(Worker *worker, int id, size_t queue_capacity) {
+    worker->id = id;
+    worker->open_connections = 0;
+    worker->drain_requested = 0;
+    worker->draining = 0;
+    timer_wheel_init(&worker->timers, timer_now_ms());
+
+    if (!queue_init(&worker->inbox, queue_capacity)) return 0;
+    pthread_mutex_init(&worker->resume_lock, NULL);
+    worker->resumed = NULL;
+
+    worker->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    worker->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (worker->epoll_fd < 0 || worker->wake_fd < 0) {
+        perror("epoll/eventfd");
+        return 0;
+    }
+
+    // Udalosť s ukazovateľom NULL označuje wake_fd (spojenia majú vždy nenulový).
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, worker->wake_fd, &event) < 0) {
+        perror("epoll_ctl");
+        return 0;
+    }
+    return 1;
+}
+
+int thread_pool_default_size(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    if (cores > MAX_WORKER_THREADS) return MAX_WORKER_THREADS;
+    return (int)cores;
+}
+
+int thread_pool_init(ThreadPool *pool, int thread_count, size_t queue_capacity) {
+    if (!pool || thread_count < 1 || thread_count > MAX_WORKER_THREADS || queue_capacity == 0) {
+        return 0;
+    }
+
+    pool->workers = (Worker *)calloc((size_t)thread_count, sizeof(Worker));
+    if (!pool->workers) return 0;
+    pool->next_worker = 0;
+    pool->thread_count = 0;
+
+    for (int i = 0; i < thread_count; i++) {
+        Worker *worker = &pool->workers[i];
+        if (!worker_init(worker, i, queue_capacity)) break;
+        if (pthread_create(&worker->thread, NULL, worker_main, worker) != 0) {
+            perror("pthread_create");
+            break;
+        }
+        pthread_detach(worker->thread);
+        pool->thread_count++;
+    }
+
+    // Stačí, ak sa podarilo spustiť aspoň jedno vlákno.
+    return pool->thread_count > 0;
+}
+
+/**
+ * @brief Zobudí vlákno zápisom do jeho eventfd.
+ */
+static void worker_wake(Worker *worker) {
+    uint64_t one = 1;
+    if (write(worker->wake_fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        perror("eventfd write");
+    }
+}
+
+int thread_pool_submit(ThreadPool *pool, int client_socket, ConnectionProtocol protocol) {
+    if (!pool || client_socket < 0) return 0;
+
+    QueuedConnection item = {client_socket, protocol, metrics_now_ns()};
+    for (int attempt = 0; attempt < pool->thread_count; attempt++) {
+        Worker *worker = &pool->workers[pool->next_worker++ % (unsigned int)pool->thread_count];
+        int pushed = queue_try_push(&worker->inbox, item);
+        if (pushed < 0) continue;
+
+        // Zobudiť treba len vlákno, ktorého fronta bola prázdna; inak ju
+        // vlákno ešte len ide vyprázdniť a nové spojenie si vezme tiež.
+        if (pushed == 1) {
+            worker_wake(worker);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+void thread_pool_resume(Worker *worker, Connection *conn) {
+    pthread_mutex_lock(&worker->resume_lock);
+    int was_empty = worker->resumed == NULL;
+    conn->resume_next = worker->resumed;
+    worker->resumed = conn;
+    pthread_mutex_unlock(&worker->resume_lock);
+
+    // Neprázdny zoznam vlákno ešte len ide prevziať, zobudiť ho netreba.
+    if (was_empty) {
+        worker_wake(worker);
+    }
+}
+
+void thread_pool_drain(ThreadPool *pool) {
+    for (int i = 0; i < pool->thread_count; i++) {
+        __atomic_store_n(&pool->workers[i].drain_requested, 1, __ATOMIC_RELEASE);
+        worker_wake(&pool->workers[i]);
+    }
+}
+
+size_t thread_pool_connections(ThreadPool *pool) {
+    size_t total = 0;
+    for (int i = 0; i < pool->thread_count; i++) {
+        Worker *worker = &pool->workers[i];
+        total += __atomic_load_n(&worker->open_connections, __ATOMIC_RELAXED);
+        pthread_mutex_lock(&worker->inbox.lock);
+        total += worker->inbox.count;
+        pthread_mutex_unlock(&worker->inbox.lock);
+    }
+    return total;
+}
@@ -0,0 +1,120 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "TimerWheel.h"
+#include "Connection.h"
+
+// Predvolená kapacita fronty nových spojení jedného vlákna (zaokrúhli sa na mocninu 2)
+#define DEFAULT_QUEUE_CAPACITY 1024
+// Horná hranica počtu pracovných vlákien
+#define MAX_WORKER_THREADS 256
+// Maximálny počet udalostí spracovaných jedným volaním epoll_wait()
+#define MAX_EPOLL_EVENTS 256
+
+// Prijatý socket vo fronte spolu s časom prijatia (na meranie čakania).
+typedef struct {
+    int fd;
+    ConnectionProtocol protocol;
+    uint64_t accepted_ns;    // metrics_now_ns() v čase odovzdania vláknu.
+} QueuedConnection;
+
+// Ohraničená kruhová fronta prijatých socketov čakajúcich na prevzatie vláknom.
+typedef struct {
+    QueuedConnection *items; // Kruhový buffer socketov.
+    size_t capacity;         // Kapacita (vždy mocnina 2, aby stačilo maskovanie).
+    size_t head;             // Index nasledujúceho prvku na vybratie.
+    size_t tail;             // Index nasledujúceho voľného miesta.
+    size_t count;            // Aktuálny počet prvkov vo fronte.
+    pthread_mutex_t lock;
+} ConnectionQueue;
+
+// Pracovné vlákno s vlastným epoll event loopom. Spojenie patrí počas celej
+// svojej existencie jedinému vláknu, takže jeho stav netreba zamykať.
+typedef struct Worker {
+    pthread_t thread;
+    int id;
+    int epoll_fd;               // Epoll inštancia vlákna.
+    int wake_fd;                // eventfd, ktorým akceptor hlási nové spojenia
+                                // a výpočtové vlákna dokončenú prácu.
+    ConnectionQueue inbox;      // Nové spojenia od akceptora.
+    TimerWheel timers;          // Časové limity spojení tohto vlákna.
+    size_t open_connections;    // Počet otvorených spojení (číta ho aj akceptor).
+    int drain_requested;        // Akceptor žiada ukončiť spojenia (thread_pool_drain()).
+    int draining;               // Vlákno už spojenia ukončuje: nové keep-alive nedovolí.
+    struct Connection *ready_head;  // Spojenia odložené na ďalšiu iteráciu.
+    struct Connection *ready_tail;
+    size_t ready_count;
+    pthread_mutex_t resume_lock;
+    struct Connection *resumed; // Spojenia, ktorých práca mimo event loopu skončila.
+} Worker;
+
+// Skupina pracovných vlákien, medzi ktoré akceptor rozdeľuje spojenia.
+typedef struct {
+    Worker *workers;
+    int thread_count;
+    unsigned int next_worker;   // Index vlákna pre ďalšie spojenie (round-robin).
+} ThreadPool;
+
+/**
+ * @brief Vráti predvolený počet pracovných vlákien (počet dostupných jadier).
+ *
+ * @return Počet vlákien, vždy aspoň 1.
+ */
+int thread_pool_default_size(void);
+
+/**
+ * @brief Vytvorí pracovné vlákna, každé s vlastným epollom a frontou.
+ *
+ * @param pool Štruktúra poolu na inicializáciu.
+ * @param thread_count Počet pracovných vlákien.
+ * @param queue_capacity Kapacita fronty nových spojení jedného vlákna.
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int thread_pool_init(ThreadPool *pool, int thread_count, size_t queue_capacity);
+
+/**
+ * @brief Odovzdá prijatý socket niektorému pracovnému vláknu.
+ *
+ * Vlákna sa striedajú round-robin; ak má vybrané vlákno plnú frontu,
+ * skúsi sa ďalšie. Volajúci nikdy neblokuje.
+ *
+ * @param pool Inicializovaný pool.
+ * @param client_socket Neblokujúci socket klienta.
+ * @param protocol Protokol počúvajúceho socketu, ktorý spojenie prijal.
+ * @return 1 pri úspechu, 0 ak sú všetky fronty plné (socket treba zavrieť).
+ */
+int thread_pool_submit(ThreadPool *pool, int client_socket, ConnectionProtocol protocol);
+
+/**
+ * @brief Vráti spojenie jeho vláknu po dokončení práce mimo event loopu.
+ *
+ * Dá sa volať z ľubovoľného vlákna. Vlákno spojenie prevezme v ďalšej
+ * iterácii svojho event loopu (`connection_on_resume()`).
+ *
+ * @param worker Vlákno, ktoré spojenie vlastní.
+ * @param conn Spojenie pozastavené cez `connection_suspend()`.
+ */
+void thread_pool_resume(Worker *worker, struct Connection *conn);
+
+/**
+ * @brief Požiada vlákna, aby ukončili spojenia pred koncom procesu.
+ *
+ * Nečinné keep-alive spojenia sa zavrú hneď, rozpracované dostanú odpoveď
+ * s `Connection: close`. Spojenia, ktoré sú ešte vo frontách, sa obslúžia.
+ *
+ * @param pool Inicializovaný pool.
+ */
+void thread_pool_drain(ThreadPool *pool);
+
+/**
+ * @brief Vráti počet spojení, ktoré vlákna ešte obsluhujú alebo majú vo fronte.
+ *
+ * @param pool Inicializovaný pool.
+ * @return Počet spojení.
+ */
+size_t thread_pool_connections(ThreadPool *pool);
+
+#endif // THREADPOOL_H
@@ -0,0 +1,87 @@
+#include "TimerWheel.h"
+#include <time.h>
+
+uint64_t timer_now_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000u + (uint64_t)now.tv_nsec / 1000000u;
+}
+
+void timer_wheel_init(TimerWheel *wheel, uint64_t now_ms) {
+    for (int i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        wheel->slots[i].prev = &wheel->slots[i];
+        wheel->slots[i].next = &wheel->slots[i];
+    }
+    wheel->current_tick = now_ms / TIMER_TICK_MS;
+}
+
+void timer_node_init(TimerNode *node) {
+    node->prev = NULL;
+    node->next = NULL;
+    node->expires_ms = 0;
+}
+
+void timer_wheel_cancel(TimerNode *node) {
+    if (!node->next) return;
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+void timer_wheel_schedule(TimerWheel *wheel, TimerNode *node, uint64_t expires_ms) {
+    timer_wheel_cancel(node);
+
+    // Časovač v minulosti sa zaradí do nasledujúceho tiknutia.
+    uint64_t tick = expires_ms / TIMER_TICK_MS;
+    if (tick <= wheel->current_tick) {
+        tick = wheel->current_tick + 1;
+    }
+
+    TimerNode *head = &wheel->slots[tick & (TIMER_WHEEL_SLOTS - 1)];
+    node->expires_ms = expires_ms;
+    node->next = head->next;
+    node->prev = head;
+    head->next->prev = node;
+    head->next = node;
+}
+
+size_t timer_wheel_advance(TimerWheel *wheel, uint64_t now_ms, void (*on_expire)(TimerNode *node)) {
+    uint64_t target_tick = now_ms / TIMER_TICK_MS;
+    size_t expired = 0;
+
+    // Ak sa koleso dlho neposúvalo, stačí prejsť každý slot najviac raz.
+    if (target_tick - wheel->current_tick > TIMER_WHEEL_SLOTS) {
+        wheel->current_tick = target_tick - TIMER_WHEEL_SLOTS;
+    }
+
+    while (wheel->current_tick < target_tick) {
+        wheel->current_tick++;
+        TimerNode *head = &wheel->slots[wheel->current_tick & (TIMER_WHEEL_SLOTS - 1)];
+        TimerNode *node = head->next;
+
+        while (node != head) {
+            TimerNode *next = node->next;
+            // Časovače z neskorších otáčok kolesa v slote zostávajú.
+            if (node->expires_ms / TIMER_TICK_MS <= wheel->current_tick) {
+                timer_wheel_cancel(node);
+                on_expire(node);
+                expired++;
+            }
+            node = next;
+        }
+    }
+    return expired;
+}
+
+void timer_wheel_visit(TimerWheel *wheel, void (*visit)(TimerNode *node)) {
+    for (int i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        TimerNode *head = &wheel->slots[i];
+        TimerNode *node = head->next;
+        while (node != head) {
+            TimerNode *next = node->next;
+            visit(node);
+            node = next;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Dĺžka jedného tiknutia kolesa v milisekundách
+#define TIMER_TICK_MS 100
+// Počet slotov kolesa (mocnina 2); koleso pokryje 512 * 100 ms = 51,2 s,
+// dlhšie časovače jednoducho prejdú kolesom viackrát.
+#define TIMER_WHEEL_SLOTS 512
+
+// Uzol časovača vložený priamo do štruktúry, ktorej časovač patrí.
+typedef struct TimerNode {
+    struct TimerNode *prev;
+    struct TimerNode *next;
+    uint64_t expires_ms;   // Absolútny čas vypršania (CLOCK_MONOTONIC).
+} TimerNode;
+
+// Hašované časové koleso: každý slot je obojsmerne zreťazený zoznam časovačov.
+// Vloženie aj zrušenie časovača je O(1), posun kolesa prejde len sloty,
+// ktorých čas už nastal.
+typedef struct {
+    TimerNode slots[TIMER_WHEEL_SLOTS];  // Hlavy zoznamov (sentinely).
+    uint64_t current_tick;               // Posledné spracované tiknutie.
+} TimerWheel;
+
+/**
+ * @brief Vráti aktuálny monotónny čas v milisekundách.
+ */
+uint64_t timer_now_ms(void);
+
+/**
+ * @brief Inicializuje prázdne koleso začínajúce v čase `now_ms`.
+ */
+void timer_wheel_init(TimerWheel *wheel, uint64_t now_ms);
+
+/**
+ * @brief Inicializuje uzol časovača ako neaktívny.
+ */
+void timer_node_init(TimerNode *node);
+
+/**
+ * @brief Naplánuje (alebo preplánuje) časovač na absolútny čas `expires_ms`.
+ */
+void timer_wheel_schedule(TimerWheel *wheel, TimerNode *node, uint64_t expires_ms);
+
+/**
+ * @brief Zruší časovač; nad neaktívnym uzlom nerobí nič.
+ */
+void timer_wheel_cancel(TimerNode *node);
+
+/**
+ * @brief Posunie koleso do času `now_ms` a zavolá `on_expire` pre každý
+ *        časovač, ktorý medzičasom vypršal.
+ *
+ * Callback smie uvoľniť pamäť, v ktorej je uzol uložený.
+ *
+ * @return Počet vypršaných časovačov.
+ */
+size_t timer_wheel_advance(TimerWheel *wheel, uint64_t now_ms, void (*on_expire)(TimerNode *node));
+
+/**
+ * @brief Zavolá `visit` pre každý naplánovaný časovač bez ohľadu na čas vypršania.
+ *
+ * Callback smie časovač zrušiť aj uvoľniť pamäť, v ktorej je uzol uložený.
+ */
+void timer_wheel_visit(TimerWheel *wheel, void (*visit)(TimerNode *node));
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,217 @@
+/**
+ * @file classify_bench.c
+ * @brief Benchmark vyhodnotenia sily hesla: pôvodné viacnásobné prechody
+ *        (has_* + calculate_entropy) oproti jednoprechodovej klasifikácii.
+ *
+ * Pred meraním overí, že obe verzie dávajú pre všetky vstupy rovnaký
+ * výsledok. Potom pre rôzne dĺžky hesiel vypíše ns na jedno vyhodnotenie.
+ * Meria sa len hodnotenie podľa tried znakov (bez vzorov a indexu
+ * uniknutých hesiel, ktoré pôvodná verzia nemala).
+ *
+ * Použitie: ./Benchmarks/classify_bench
+ */
+#include "../Logic/Password.h"
+#include "../Logic/Classify.h"
+#include "../Logic/Random.h"
+#include <stdint.h>
+
+// Počet rôznych hesiel v jednej sade
+#define BENCH_INPUTS 1024
+// Ako dlho beží jedno meranie
+#define BENCH_DURATION_SEC 0.5
+
+static volatile int bench_sink;
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// --- Pôvodná implementácia (každá funkcia prechádza heslo znova) ---
+
+static const char legacy_special_chars[] = "!@#$%^&*()_+-=[]{}|;:,.<>?";
+
+static int legacy_has_lowercase(const char *p) {
+    for (int i = 0; p[i]; i++) if (islower((unsigned char)p[i])) return 1;
+    return 0;
+}
+
+static int legacy_has_uppercase(const char *p) {
+    for (int i = 0; p[i]; i++) if (isupper((unsigned char)p[i])) return 1;
+    return 0;
+}
+
+static int legacy_has_numbers(const char *p) {
+    for (int i = 0; p[i]; i++) if (isdigit((unsigned char)p[i])) return 1;
+    return 0;
+}
+
+static int legacy_has_special_chars(const char *p) {
+    for (int i = 0; p[i]; i++) if (strchr(legacy_special_chars, p[i])) return 1;
+    return 0;
+}
+
+static int legacy_calculate_entropy(const char *password) {
+    int charset_size = 0;
+    if (legacy_has_lowercase(password)) charset_size += 26;
+    if (legacy_has_uppercase(password)) charset_size += 26;
+    if (legacy_has_numbers(password)) charset_size += 10;
+    if (legacy_has_special_chars(password)) charset_size += strlen(legacy_special_chars);
+
+    int length = strlen(password);
+    double entropy_per_char = 0;
+    if (charset_size > 0) {
+        if (charset_size >= 95) entropy_per_char = 6.6;
+        else if (charset_size >= 62) entropy_per_char = 5.9;
+        else if (charset_size >= 36) entropy_per_char = 5.2;
+        else if (charset_size >= 26) entropy_per_char = 4.7;
+        else entropy_per_char = 3.3;
+    }
+    return (int)(entropy_per_char * length);
+}
+
+// Výsledok pôvodnej verzie, ktorá spätnú väzbu skladala priamo do textu.
+typedef struct {
+    int score;
+    int is_strong;
+    char feedback[256];
+} LegacyStrength;
+
+static void legacy_evaluate(const char *password, LegacyStrength *result) {
+    result->is_strong = 0;
+    strcpy(result->feedback, "");
+
+    int length = strlen(password);
+    int has_lower = legacy_has_lowercase(password);
+    int has_upper = legacy_has_uppercase(password);
+    int has_nums = legacy_has_numbers(password);
+    int has_special = legacy_has_special_chars(password);
+
+    int score = 0;
+    if (length >= 12) score += 40;
+    else if (length >= 8) score += 25;
+    else if (length >= 6) score += 15;
+    else score += 5;
+    if (has_lower) score += 10;
+    if (has_upper) score += 10;
+    if (has_nums) score += 10;
+    if (has_special) score += 10;
+
+    int entropy = legacy_calculate_entropy(password);
+    if (entropy >= 60) score += 20;
+    else if (entropy >= 40) score += 15;
+    else if (entropy >= 30) score += 10;
+    else score += 5;
+
+    result->score = score;
+    result->is_strong = (score >= 80 && length >= MIN_PASSWORD_LENGTH &&
+                         has_lower && has_upper && has_nums && has_special);
+
+    char feedback[256] = "";
+    if (result->is_strong) {
+        strcat(feedback, "Heslo je silné!");
+    } else {
+        char recommendations[200] = "";
+        if (length < MIN_PASSWORD_LENGTH) strcat(recommendations, "Použite aspoň 8 znakov. ");
+        if (!has_lower) strcat(recommendations, "Pridajte malé písmená. ");
+        if (!has_upper) strcat(recommendations, "Pridajte veľké písmená. ");
+        if (!has_nums) strcat(recommendations, "Pridajte čísla. ");
+        if (!has_special) strcat(recommendations, "Pridajte špeciálne znaky. ");
+        if (strlen(recommendations) > 0) sprintf(feedback, "Odporúčania: %s", recommendations);
+    }
+    strcpy(result->feedback, feedback);
+}
+
+// --- Meranie ---
+
+/**
+ * @brief Naplní sadu hesiel danej dĺžky náhodnými tlačiteľnými znakmi
+ *        (vrátane medzier a znakov mimo ASCII, aby sa otestovali všetky triedy).
+ */
+static void make_inputs(char **inputs, size_t length) {
+    static const char extra[] = " ~\"'\\/`\xc3\xa1";
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        char *p = inputs[i];
+        // Časť hesiel len z malých písmen (typické slabé heslá).
+        int only_lower = i % 4 == 0;
+        for (size_t j = 0; j < length; j++) {
+            uint32_t r = random_uniform(100);
+            if (only_lower || r < 40) p[j] = (char)('a' + random_uniform(26));
+            else if (r < 60) p[j] = (char)('A' + random_uniform(26));
+            else if (r < 80) p[j] = (char)('0' + random_uniform(10));
+            else if (r < 95) p[j] = "!@#$%^&*()_+-=[]{}|;:,.<>?"[random_uniform(26)];
+            else p[j] = extra[random_uniform(sizeof(extra) - 1)];
+        }
+        p[length] = '\0';
+    }
+}
+
+/**
+ * @brief Nové hodnotenie podľa tried znakov (to, čo robila pôvodná verzia).
+ */
+static void classes_evaluate(const char *password, PasswordStrength *result) {
+    CharClassStats stats;
+    classify_password(password, &stats);
+    evaluate_password_classes(&stats, result);
+}
+
+static double bench_evaluate(char **inputs, int legacy) {
+    LegacyStrength legacy_result;
+    PasswordStrength result;
+    uint64_t operations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        for (int i = 0; i < BENCH_INPUTS; i++) {
+            if (legacy) {
+                legacy_evaluate(inputs[i], &legacy_result);
+                bench_sink ^= legacy_result.score;
+            } else {
+                classes_evaluate(inputs[i], &result);
+                bench_sink ^= result.score;
+            }
+        }
+        operations += BENCH_INPUTS;
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_DURATION_SEC);
+    return elapsed * 1e9 / (double)operations;
+}
+
+int main(void) {
+    static const size_t lengths[] = {8, 12, 16, 24, 64, 256, 1024};
+    char *inputs[BENCH_INPUTS];
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        inputs[i] = (char *)malloc(1024 + 1);
+    }
+
+    printf("SIMD implementácia: %s\n", classify_implementation());
+    printf("%8s %14s %14s %9s\n", "dĺžka", "pôvodné ns/op", "nové ns/op", "zrýchlenie");
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        make_inputs(inputs, lengths[l]);
+
+        for (int i = 0; i < BENCH_INPUTS; i++) {
+            LegacyStrength expected;
+            PasswordStrength actual;
+            char feedback[PASSWORD_FEEDBACK_SIZE];
+            legacy_evaluate(inputs[i], &expected);
+            classes_evaluate(inputs[i], &actual);
+            format_password_feedback(actual.reasons, actual.is_strong, feedback, sizeof(feedback));
+            if (expected.score != actual.score || expected.is_strong != actual.is_strong ||
+                strcmp(expected.feedback, feedback) != 0) {
+                fprintf(stderr, "Rozdielny výsledok pre \"%s\"\n", inputs[i]);
+                return EXIT_FAILURE;
+            }
+        }
+
+        double legacy_ns = bench_evaluate(inputs, 1);
+        double new_ns = bench_evaluate(inputs, 0);
+        printf("%7zu %14.1f %14.1f %9.2fx\n", lengths[l], legacy_ns, new_ns, legacy_ns / new_ns);
+    }
+
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        free(inputs[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file json_bench.c
+ * @brief Benchmark parsovania tela API požiadaviek: pôvodné hľadanie kľúčov
+ *        cez strstr (jedno na kľúč, malloc pre reťazce) oproti jednoprechodovému
+ *        tokenizéru, ktorý plní štruktúru požiadavky (ApiRequest.c).
+ *
+ * Pred meraním overí, že obe verzie z kompaktného tela vyčítajú rovnaké
+ * hodnoty, a vypíše, ako dopadnú telá, na ktorých pôvodná verzia zlyhávala
+ * (medzery, escape sekvencie). Nový parser dekóduje reťazce na mieste, preto
+ * sa telo pred každým parsovaním skopíruje; kópia je započítaná v meraní.
+ *
+ * Použitie: ./Benchmarks/json_bench
+ */
+#include "../BackEnd/ApiRequest.h"
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Ako dlho beží jedno meranie
+#define BENCH_DURATION_SEC 0.5
+// Miesto na kópiu tela
+#define BENCH_BODY_SIZE 1024
+
+static volatile int bench_sink;
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// --- Pôvodná implementácia (HTTPserver.c) ---
+
+static char *legacy_get_json_string_value(const char *json, const char *key) {
+    char key_pattern[100];
+    sprintf(key_pattern, "\"%s\":\"", key);
+
+    const char *key_ptr = strstr(json, key_pattern);
+    if (!key_ptr) return NULL;
+
+    const char *value_start = key_ptr + strlen(key_pattern);
+    const char *value_end = strchr(value_start, '"');
+    if (!value_end) return NULL;
+
+    int value_len = value_end - value_start;
+    char *value = (char *)malloc(value_len + 1);
+    if (!value) return NULL;
+
+    strncpy(value, value_start, value_len);
+    value[value_len] = '\0';
+    return value;
+}
+
+static int legacy_get_json_int_value(const char *json, const char *key) {
+    char key_pattern[100];
+    sprintf(key_pattern, "\"%s\":", key);
+
+    const char *key_ptr = strstr(json, key_pattern);
+    if (!key_ptr) return 0;
+
+    const char *value_start = key_ptr + strlen(key_pattern);
+    while (*value_start && isspace(*value_start)) {
+        value_start++;
+    }
+    return atoi(value_start);
+}
+
+static void legacy_parse_generate(const char *body, GenerateRequest *request) {
+    request->length = legacy_get_json_int_value(body, "length");
+    request->include_uppercase = legacy_get_json_int_value(body, "includeUppercase");
+    request->include_lowercase = legacy_get_json_int_value(body, "includeLowercase");
+    request->include_numbers = legacy_get_json_int_value(body, "includeNumbers");
+    request->include_symbols = legacy_get_json_int_value(body, "includeSymbols");
+}
+
+// --- Meranie ---
+
+static const char generate_body[] =
+    "{\"length\":16,\"includeUppercase\":1,\"includeLowercase\":1,\"includeNumbers\":1,\"includeSymbols\":0}";
+static const char evaluate_body[] = "{\"password\":\"Tr0ub4dor&3-correct-horse\"}";
+static const char evaluate_escaped_body[] = "{ \"password\" : \"p\\u00e1ss\\\"w0rd\\\\\" }";
+
+static double bench_legacy_generate(void) {
+    GenerateRequest request;
+    uint64_t operations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        for (int i = 0; i < 1000; i++) {
+            legacy_parse_generate(generate_body, &request);
+            bench_sink += request.length;
+        }
+        operations += 1000;
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_DURATION_SEC);
+    return elapsed * 1e9 / (double)operations;
+}
+
+static double bench_generate(void) {
+    char body[BENCH_BODY_SIZE];
+    GenerateRequest request;
+    uint64_t operations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        for (int i = 0; i < 1000; i++) {
+            memcpy(body, generate_body, sizeof(generate_body));
+            bench_sink += api_parse_generate_request(body, sizeof(generate_body) - 1, &request);
+            bench_sink += request.length;
+        }
+        operations += 1000;
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_DURATION_SEC);
+    return elapsed * 1e9 / (double)operations;
+}
+
+static double bench_legacy_password(const char *source) {
+    uint64_t operations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        for (int i = 0; i < 1000; i++) {
+            char *password = legacy_get_json_string_value(source, "password");
+            if (password) {
+                bench_sink += password[0];
+                free(password);
+            }
+        }
+        operations += 1000;
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_DURATION_SEC);
+    return elapsed * 1e9 / (double)operations;
+}
+
+static double bench_password(const char *source) {
+    char body[BENCH_BODY_SIZE];
+    size_t length = strlen(source);
+    PasswordRequest request;
+    uint64_t operations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        for (int i = 0; i < 1000; i++) {
+            memcpy(body, source, length + 1);
+            if (api_parse_password_request(body, length, &request)) {
+                bench_sink += request.password.data[0];
+            }
+        }
+        operations += 1000;
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_DURATION_SEC);
+    return elapsed * 1e9 / (double)operations;
+}
+
+int main(void) {
+    // Overenie zhody na telách, ktoré zvládne aj pôvodná verzia.
+    char body[BENCH_BODY_SIZE];
+    GenerateRequest legacy, parsed;
+    legacy_parse_generate(generate_body, &legacy);
+    memcpy(body, generate_body, sizeof(generate_body));
+    if (!api_parse_generate_request(body, sizeof(generate_body) - 1, &parsed) ||
+        legacy.length != parsed.length || legacy.include_uppercase != parsed.include_uppercase ||
+        legacy.include_lowercase != parsed.include_lowercase ||
+        legacy.include_numbers != parsed.include_numbers ||
+        legacy.include_symbols != parsed.include_symbols) {
+        fprintf(stderr, "Rozdielny výsledok pre %s\n", generate_body);
+        return 1;
+    }
+    PasswordRequest password;
+    char *legacy_password = legacy_get_json_string_value(evaluate_body, "password");
+    memcpy(body, evaluate_body, sizeof(evaluate_body));
+    if (!legacy_password || !api_parse_password_request(body, sizeof(evaluate_body) - 1, &password) ||
+        strcmp(legacy_password, password.password.data) != 0) {
+        fprintf(stderr, "Rozdielny výsledok pre %s\n", evaluate_body);
+        return 1;
+    }
+    free(legacy_password);
+
+    // Telá, na ktorých sa pôvodná verzia mýli.
+    legacy_password = legacy_get_json_string_value(evaluate_escaped_body, "password");
+    memcpy(body, evaluate_escaped_body, sizeof(evaluate_escaped_body));
+    int ok = api_parse_password_request(body, sizeof(evaluate_escaped_body) - 1, &password);
+    printf("%s\n  pôvodne: %s\n  teraz:   %s\n\n", evaluate_escaped_body,
+           legacy_password ? legacy_password : "(nenájdené)", ok ? password.password.data : "(chyba)");
+    free(legacy_password);
+
+    printf("%-32s %13s %12s\n", "telo", "pôvodne ns", "teraz ns");
+    printf("%-35s %12.1f %12.1f\n", "/api/generate (5 kľúčov)", bench_legacy_generate(), bench_generate());
+    printf("%-32s %12.1f %12.1f\n", "/api/evaluate", bench_legacy_password(evaluate_body),
+           bench_password(evaluate_body));
+    printf("%-32s %12s %12.1f\n", "/api/evaluate (escape, medzery)", "-",
+           bench_password(evaluate_escaped_body));
+    return 0;
+}
@@ -0,0 +1,827 @@
+/**
+ * @file load_generator.c
+ * @brief Generátor záťaže pre bežiaci password_server (náhrada za ab/wrk).
+ *
+ * Posiela zmes požiadaviek (API endpointy a statické súbory) v dvoch režimoch:
+ *
+ * - otvorená slučka (`--rate`): požiadavky prichádzajú pevným tempom bez ohľadu
+ *   na to, ako rýchlo server odpovedá. Latencia sa meria od plánovaného času
+ *   odoslania, takže čakanie na voľné spojenie sa započíta (korekcia
+ *   „coordinated omission“ ako vo wrk2),
+ * - uzavretá slučka (bez `--rate`): každé spojenie pošle ďalšiu požiadavku hneď
+ *   po odpovedi. Korigovaná latencia sa dopočíta z histogramu: meranie dlhšie
+ *   ako očakávaný interval sa doplní o chýbajúce merania, ktoré by počas
+ *   zdržania prišli (ako HdrHistogram `recordValueWithExpectedInterval`).
+ *
+ * Každé vlákno má vlastné spojenia a epoll. Na konci sa vypíše priepustnosť,
+ * chyby a percentily p50/p90/p99/p99.9/max korigovanej latencie aj samotného
+ * času obsluhy (od odoslania po prijatie odpovede).
+ *
+ * Zmes požiadaviek sa dá načítať zo súboru (`--mix`), jeden riadok na druh:
+ *
+ *     # váha metóda cesta [telo]
+ *     40 POST /api/evaluate {"password":"Tr0ub4dor&3"}
+ *     20 GET /index.html
+ *
+ * Použitie: ./Benchmarks/load_generator [--host H] [--port P] [--connections N]
+ *           [--threads T] [--duration S] [--warmup S] [--rate R] [--no-keepalive]
+ *           [--mix SÚBOR] [--expected-interval-us U]
+ */
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+// Bity podvedierka histogramu (16 vedierok na mocninu 2, chyba najviac 6,25 %)
+#define LOAD_SUB_BUCKET_BITS 4
+#define LOAD_SUB_BUCKETS (1u << LOAD_SUB_BUCKET_BITS)
+// Najväčšia rozlíšená latencia 2^40 ns (~18 minút)
+#define LOAD_MAX_EXPONENT 40
+#define LOAD_HISTOGRAM_BUCKETS ((LOAD_MAX_EXPONENT - LOAD_SUB_BUCKET_BITS + 2) << LOAD_SUB_BUCKET_BITS)
+// Najviac spojení a vlákien
+#define LOAD_MAX_CONNECTIONS 10000
+#define LOAD_MAX_THREADS 64
+// Najviac druhov požiadaviek v zmesi a najdlhší riadok súboru so zmesou
+#define LOAD_MAX_MIX 64
+#define LOAD_MAX_LINE 8192
+// Počiatočná veľkosť buffera odpovede
+#define LOAD_READ_CHUNK 16384
+
+// Histogram latencií v ns (logaritmické vedierka).
+typedef struct {
+    uint64_t counts[LOAD_HISTOGRAM_BUCKETS];
+    uint64_t total;
+    uint64_t max;
+} Histogram;
+
+// Jeden druh požiadavky zmesi s hotovými bajtmi požiadavky.
+typedef struct {
+    unsigned weight;
+    char label[80];              // Napr. "POST /api/evaluate".
+    char *request[2];            // [0] keep-alive, [1] Connection: close.
+    size_t length[2];
+} MixEntry;
+
+typedef enum {
+    LOAD_IDLE,                   // Bez požiadavky (socket môže byť otvorený).
+    LOAD_CONNECTING,
+    LOAD_WRITING,
+    LOAD_READING
+} LoadState;
+
+typedef struct {
+    int fd;
+    LoadState state;
+    uint32_t events;             // Udalosti aktuálne registrované v epolle.
+    const MixEntry *entry;
+    size_t sent;                 // Odoslané bajty požiadavky.
+    uint64_t intended_ns;        // Plánovaný čas odoslania (otvorená slučka) alebo skutočný.
+    uint64_t start_ns;           // Skutočný začiatok (pred connect/write).
+    char *in;
+    size_t in_length;
+    size_t in_capacity;
+} LoadConnection;
+
+typedef struct {
+    pthread_t thread;
+    int id;
+    int epoll_fd;
+    int timer_fd;                // Otvorená slučka: budík na čas ďalšej požiadavky.
+    LoadConnection *connections;
+    int connection_count;
+    int *idle;                   // Zásobník indexov voľných spojení.
+    int idle_count;
+    uint64_t rng;
+    uint64_t interval_ns;        // Otvorená slučka: rozostup požiadaviek vlákna (0 = uzavretá).
+    uint64_t first_ns;           // Plánovaný čas prvej požiadavky vlákna.
+    uint64_t scheduled;          // Otvorená slučka: počet už odoslaných plánovaných požiadaviek.
+    Histogram latency;           // Od plánovaného času (korigovaná pri otvorenej slučke).
+    Histogram service;           // Od skutočného odoslania.
+    uint64_t completed;
+    uint64_t bytes_received;
+    uint64_t errors_connect;
+    uint64_t errors_io;
+    uint64_t status_errors;      // Odpovede mimo 2xx/3xx.
+    uint64_t unfinished;         // Požiadavky nevybavené do konca merania.
+    uint64_t backlog_max;        // Najviac požiadaviek čakajúcich na voľné spojenie.
+    uint64_t entry_completed[LOAD_MAX_MIX];
+} LoadThread;
+
+// Nastavenia behu.
+static struct {
+    struct sockaddr_storage address;
+    socklen_t address_length;
+    int connections;
+    int threads;
+    double duration;
+    double warmup;
+    double rate;
+    int keep_alive;
+    uint64_t expected_interval_ns;
+    MixEntry mix[LOAD_MAX_MIX];
+    int mix_count;
+    unsigned mix_total;
+    uint64_t measure_ns;         // Začiatok merania (po zahriatí).
+    uint64_t end_ns;
+} load;
+
+static uint64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+// --- Histogram ---
+
+static unsigned bucket_index(uint64_t value) {
+    if (value < LOAD_SUB_BUCKETS) return (unsigned)value;
+    unsigned exponent = 63u - (unsigned)__builtin_clzll(value);
+    if (exponent > LOAD_MAX_EXPONENT) return LOAD_HISTOGRAM_BUCKETS - 1;
+    unsigned sub = (unsigned)(value >> (exponent - LOAD_SUB_BUCKET_BITS)) & (LOAD_SUB_BUCKETS - 1);
+    return ((exponent - LOAD_SUB_BUCKET_BITS + 1) << LOAD_SUB_BUCKET_BITS) | sub;
+}
+
+static uint64_t bucket_upper(unsigned index) {
+    if (index < LOAD_SUB_BUCKETS) return index;
+    unsigned block = index >> LOAD_SUB_BUCKET_BITS;
+    uint64_t sub = index & (LOAD_SUB_BUCKETS - 1);
+    return ((LOAD_SUB_BUCKETS + sub + 1) << (block - 1)) - 1;
+}
+
+static void histogram_record(Histogram *histogram, uint64_t value, uint64_t count) {
+    histogram->counts[bucket_index(value)] += count;
+    histogram->total += count;
+    if (value > histogram->max) histogram->max = value;
+}
+
+static void histogram_merge(Histogram *into, const Histogram *from) {
+    for (unsigned i = 0; i < LOAD_HISTOGRAM_BUCKETS; i++) into->counts[i] += from->counts[i];
+    into->total += from->total;
+    if (from->max > into->max) into->max = from->max;
+}
+
+static uint64_t histogram_percentile(const Histogram *histogram, double percentile) {
+    if (histogram->total == 0) return 0;
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)histogram->total + 0.5);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < LOAD_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->counts[i];
+        if (seen >= rank) {
+            uint64_t upper = bucket_upper(i);
+            return upper < histogram->max ? upper : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+/**
+ * @brief Doplní merania, ktoré uzavretá slučka počas zdržania neposlala.
+ *
+ * Meranie s hodnotou v > interval znamená, že počas neho mali prísť ďalšie
+ * požiadavky s latenciou v - interval, v - 2*interval, ... (ako v HdrHistogram).
+ */
+static void histogram_correct(const Histogram *raw, uint64_t interval, Histogram *corrected) {
+    *corrected = *raw;
+    if (interval == 0) return;
+    for (unsigned i = 0; i < LOAD_HISTOGRAM_BUCKETS; i++) {
+        uint64_t count = raw->counts[i];
+        if (count == 0) continue;
+        uint64_t value = i == bucket_index(raw->max) ? raw->max : bucket_upper(i);
+        for (uint64_t missing = value > interval ? value - interval : 0; missing >= interval;
+             missing -= interval) {
+            histogram_record(corrected, missing, count);
+        }
+    }
+}
+
+// --- Zmes požiadaviek ---
+
+static int mix_add(unsigned weight, const char *method, const char *path, const char *body) {
+    if (load.mix_count == LOAD_MAX_MIX) {
+        fprintf(stderr, "Priveľa druhov požiadaviek (najviac %d)\n", LOAD_MAX_MIX);
+        return 0;
+    }
+    MixEntry *entry = &load.mix[load.mix_count];
+    size_t body_length = body ? strlen(body) : 0;
+    snprintf(entry->label, sizeof(entry->label), "%s %s", method, path);
+    for (int close = 0; close < 2; close++) {
+        size_t capacity = strlen(method) + strlen(path) + body_length + 256;
+        entry->request[close] = (char *)malloc(capacity);
+        if (!entry->request[close]) return 0;
+        int written;
+        if (body) {
+            written = snprintf(entry->request[close], capacity,
+                               "%s %s HTTP/1.1\r\nHost: localhost\r\n%s"
+                               "Content-Type: application/json\r\nContent-Length: %zu\r\n\r\n%s",
+                               method, path, close ? "Connection: close\r\n" : "", body_length, body);
+        } else {
+            written = snprintf(entry->request[close], capacity, "%s %s HTTP/1.1\r\nHost: localhost\r\n%s\r\n",
+                               method, path, close ? "Connection: close\r\n" : "");
+        }
+        entry->length[close] = (size_t)written;
+    }
+    entry->weight = weight;
+    load.mix_total += weight;
+    load.mix_count++;
+    return 1;
+}
+
+static int mix_default(void) {
+    return mix_add(30, "POST", "/api/evaluate", "{\"password\":\"Tr0ub4dor&3\"}") &&
+           mix_add(30, "POST", "/api/generate",
+                   "{\"length\":16,\"includeUppercase\":true,\"includeLowercase\":true,"
+                   "\"includeNumbers\":true,\"includeSymbols\":true}") &&
+           mix_add(10, "POST", "/api/strengthen", "{\"password\":\"heslo123\"}") &&
+           mix_add(30, "GET", "/", NULL);
+}
+
+/**
+ * @brief Načíta zmes zo súboru: "váha metóda cesta [telo]" na riadok.
+ */
+static int mix_load(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return 0;
+    }
+    char line[LOAD_MAX_LINE];
+    int number = 0, ok = 1;
+    while (ok && fgets(line, sizeof(line), file)) {
+        number++;
+        line[strcspn(line, "\r\n")] = '\0';
+        char *p = line + strspn(line, " \t");
+        if (*p == '\0' || *p == '#') continue;
+
+        char method[16], target[1024];
+        unsigned weight;
+        int consumed = 0;
+        if (sscanf(p, "%u %15s %1023s %n", &weight, method, target, &consumed) < 3 || weight == 0) {
+            fprintf(stderr, "%s:%d: očakáva sa \"váha metóda cesta [telo]\"\n", path, number);
+            ok = 0;
+            break;
+        }
+        const char *body = p + consumed;
+        ok = mix_add(weight, method, target, *body ? body : NULL);
+    }
+    fclose(file);
+    if (ok && load.mix_count == 0) {
+        fprintf(stderr, "%s: zmes je prázdna\n", path);
+        ok = 0;
+    }
+    return ok;
+}
+
+static uint32_t thread_random(LoadThread *thread) {
+    thread->rng ^= thread->rng >> 12;
+    thread->rng ^= thread->rng << 25;
+    thread->rng ^= thread->rng >> 27;
+    return (uint32_t)((thread->rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static const MixEntry *mix_pick(LoadThread *thread) {
+    unsigned ticket = thread_random(thread) % load.mix_total;
+    for (int i = 0; i < load.mix_count; i++) {
+        if (ticket < load.mix[i].weight) return &load.mix[i];
+        ticket -= load.mix[i].weight;
+    }
+    return &load.mix[load.mix_count - 1];
+}
+
+// --- Spojenia ---
+
+static void connection_watch(LoadThread *thread, LoadConnection *conn, uint32_t events) {
+    if (conn->events == events) return;
+    struct epoll_event event;
+    event.events = events;
+    event.data.ptr = conn;
+    epoll_ctl(thread->epoll_fd, conn->events ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, conn->fd, &event);
+    conn->events = events;
+}
+
+static void connection_drop(LoadConnection *conn) {
+    if (conn->fd >= 0) close(conn->fd);
+    conn->fd = -1;
+    conn->events = 0;
+}
+
+static void connection_release(LoadThread *thread, LoadConnection *conn) {
+    conn->state = LOAD_IDLE;
+    conn->entry = NULL;
+    if (conn->fd >= 0) connection_watch(thread, conn, EPOLLIN | EPOLLRDHUP);
+    thread->idle[thread->idle_count++] = (int)(conn - thread->connections);
+}
+
+static void connection_fail(LoadThread *thread, LoadConnection *conn, uint64_t *counter) {
+    if (conn->intended_ns >= load.measure_ns) (*counter)++;
+    connection_drop(conn);
+    connection_release(thread, conn);
+}
+
+/**
+ * @brief Pošle zvyšok požiadavky; po odoslaní čaká na odpoveď.
+ */
+static void connection_write(LoadThread *thread, LoadConnection *conn) {
+    int close_mode = !load.keep_alive;
+    while (conn->sent < conn->entry->length[close_mode]) {
+        ssize_t sent = send(conn->fd, conn->entry->request[close_mode] + conn->sent,
+                            conn->entry->length[close_mode] - conn->sent, MSG_NOSIGNAL);
+        if (sent > 0) {
+            conn->sent += (size_t)sent;
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            connection_watch(thread, conn, EPOLLOUT);
+            return;
+        }
+        connection_fail(thread, conn, &thread->errors_io);
+        return;
+    }
+    conn->state = LOAD_READING;
+    conn->in_length = 0;
+    connection_watch(thread, conn, EPOLLIN | EPOLLRDHUP);
+}
+
+/**
+ * @brief Začne požiadavku na voľnom spojení (pri potrebe ho najprv otvorí).
+ */
+static void connection_start(LoadThread *thread, LoadConnection *conn, uint64_t intended) {
+    conn->entry = mix_pick(thread);
+    conn->sent = 0;
+    conn->intended_ns = intended;
+    conn->start_ns = now_ns();
+
+    if (conn->fd >= 0) {
+        conn->state = LOAD_WRITING;
+        connection_write(thread, conn);
+        return;
+    }
+
+    conn->fd = socket(load.address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (conn->fd < 0) {
+        connection_fail(thread, conn, &thread->errors_connect);
+        return;
+    }
+    int one = 1;
+    setsockopt(conn->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(conn->fd, (struct sockaddr *)&load.address, load.address_length) == 0) {
+        conn->state = LOAD_WRITING;
+        connection_write(thread, conn);
+    } else if (errno == EINPROGRESS) {
+        conn->state = LOAD_CONNECTING;
+        connection_watch(thread, conn, EPOLLOUT);
+    } else {
+        connection_fail(thread, conn, &thread->errors_connect);
+    }
+}
+
+/**
+ * @brief Zistí, či je odpoveď v bufferi kompletná.
+ *
+ * @return 1 kompletná, 0 treba ďalšie dáta, -1 chybná odpoveď.
+ */
+static int response_complete(LoadConnection *conn, int peer_closed, int *status, int *server_close) {
+    char *headers_end = memmem(conn->in, conn->in_length, "\r\n\r\n", 4);
+    if (!headers_end) return peer_closed ? -1 : 0;
+    if (conn->in_length < 12 || memcmp(conn->in, "HTTP/1.", 7) != 0) return -1;
+    *status = atoi(conn->in + 9);
+
+    size_t body_start = (size_t)(headers_end - conn->in) + 4;
+    long content_length = -1;
+    int chunked = 0;
+    *server_close = 0;
+    *headers_end = '\0';
+    for (char *line = strstr(conn->in, "\r\n"); line; line = strstr(line + 2, "\r\n")) {
+        const char *name = line + 2;
+        if (strncasecmp(name, "Content-Length:", 15) == 0) {
+            content_length = strtol(name + 15, NULL, 10);
+        } else if (strncasecmp(name, "Transfer-Encoding:", 18) == 0) {
+            chunked = strstr(name, "chunked") != NULL;
+        } else if (strncasecmp(name, "Connection:", 11) == 0) {
+            *server_close = strstr(name, "close") != NULL;
+        }
+    }
+    *headers_end = '\r';
+
+    // 1xx (100 Continue) predchádza skutočnej odpovedi.
+    if (*status >= 100 && *status < 200) {
+        memmove(conn->in, conn->in + body_start, conn->in_length - body_start);
+        conn->in_length -= body_start;
+        return response_complete(conn, peer_closed, status, server_close);
+    }
+    if (*status == 204 || *status == 304) return 1;
+    if (content_length >= 0) return conn->in_length - body_start >= (size_t)content_length ? 1 : (peer_closed ? -1 : 0);
+    if (chunked) {
+        size_t position = body_start;
+        while (1) {
+            char *line_end = memmem(conn->in + position, conn->in_length - position, "\r\n", 2);
+            if (!line_end) return peer_closed ? -1 : 0;
+            size_t size = strtoul(conn->in + position, NULL, 16);
+            position = (size_t)(line_end - conn->in) + 2;
+            if (size == 0) return conn->in_length - position >= 2 ? 1 : (peer_closed ? -1 : 0);
+            position += size + 2;
+            if (position > conn->in_length) return peer_closed ? -1 : 0;
+        }
+    }
+    // Telo bez dĺžky končí zatvorením spojenia.
+    *server_close = 1;
+    return peer_closed ? 1 : 0;
+}
+
+static void connection_finish(LoadThread *thread, LoadConnection *conn, int status, int server_close);
+
+static void connection_read(LoadThread *thread, LoadConnection *conn) {
+    int peer_closed = 0;
+    while (1) {
+        if (conn->in_capacity - conn->in_length < LOAD_READ_CHUNK / 2) {
+            size_t capacity = conn->in_capacity ? conn->in_capacity * 2 : LOAD_READ_CHUNK;
+            char *grown = (char *)realloc(conn->in, capacity);
+            if (!grown) {
+                connection_fail(thread, conn, &thread->errors_io);
+                return;
+            }
+            conn->in = grown;
+            conn->in_capacity = capacity;
+        }
+        ssize_t received = recv(conn->fd, conn->in + conn->in_length, conn->in_capacity - conn->in_length, 0);
+        if (received > 0) {
+            conn->in_length += (size_t)received;
+            if (conn->intended_ns >= load.measure_ns) thread->bytes_received += (uint64_t)received;
+            continue;
+        }
+        if (received == 0) {
+            peer_closed = 1;
+            break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        connection_fail(thread, conn, &thread->errors_io);
+        return;
+    }
+
+    int status = 0, server_close = 0;
+    int complete = response_complete(conn, peer_closed, &status, &server_close);
+    if (complete < 0) {
+        connection_fail(thread, conn, &thread->errors_io);
+    } else if (complete > 0) {
+        connection_finish(thread, conn, status, server_close || peer_closed);
+    }
+}
+
+static void connection_finish(LoadThread *thread, LoadConnection *conn, int status, int server_close) {
+    uint64_t done = now_ns();
+    if (conn->intended_ns >= load.measure_ns && done <= load.end_ns) {
+        histogram_record(&thread->latency, done - conn->intended_ns, 1);
+        histogram_record(&thread->service, done - conn->start_ns, 1);
+        thread->completed++;
+        thread->entry_completed[conn->entry - load.mix]++;
+        if (status < 200 || status >= 400) thread->status_errors++;
+    }
+    if (server_close || !load.keep_alive) connection_drop(conn);
+    connection_release(thread, conn);
+}
+
+static void connection_event(LoadThread *thread, LoadConnection *conn, uint32_t events) {
+    switch (conn->state) {
+    case LOAD_IDLE:
+        // Server zavrel nečinné keep-alive spojenie; pri ďalšej požiadavke sa otvorí nové.
+        connection_drop(conn);
+        break;
+    case LOAD_CONNECTING: {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        getsockopt(conn->fd, SOL_SOCKET, SO_ERROR, &error, &length);
+        if (error) {
+            connection_fail(thread, conn, &thread->errors_connect);
+            return;
+        }
+        conn->state = LOAD_WRITING;
+        connection_write(thread, conn);
+        break;
+    }
+    case LOAD_WRITING:
+        if (events & EPOLLERR) connection_fail(thread, conn, &thread->errors_io);
+        else connection_write(thread, conn);
+        break;
+    case LOAD_READING:
+        connection_read(thread, conn);
+        break;
+    }
+}
+
+// --- Vlákno ---
+
+static void *load_thread_main(void *arg) {
+    LoadThread *thread = (LoadThread *)arg;
+    struct epoll_event events[256];
+
+    // Uzavretá slučka: všetky spojenia začnú hneď.
+    if (thread->interval_ns == 0) {
+        uint64_t now = now_ns();
+        while (thread->idle_count > 0) {
+            connection_start(thread, &thread->connections[thread->idle[--thread->idle_count]], now);
+        }
+    }
+
+    while (1) {
+        uint64_t now = now_ns();
+        if (now >= load.end_ns) break;
+
+        if (thread->interval_ns) {
+            // Požiadavky, ktorých čas nastal, dostanú voľné spojenia; ostatné čakajú
+            // a ich latencia rastie od plánovaného času.
+            uint64_t due = now >= thread->first_ns ? (now - thread->first_ns) / thread->interval_ns + 1 : 0;
+            while (thread->scheduled < due && thread->idle_count > 0) {
+                uint64_t intended = thread->first_ns + thread->scheduled * thread->interval_ns;
+                thread->scheduled++;
+                connection_start(thread, &thread->connections[thread->idle[--thread->idle_count]], intended);
+            }
+            if (due - thread->scheduled > thread->backlog_max && now >= load.measure_ns) {
+                thread->backlog_max = due - thread->scheduled;
+            }
+            // Budík s presnosťou na ns; timeout epoll_wait() má len milisekundy.
+            uint64_t next = thread->first_ns + due * thread->interval_ns;
+            struct itimerspec alarm;
+            memset(&alarm, 0, sizeof(alarm));
+            alarm.it_value.tv_sec = (time_t)(next / 1000000000ull);
+            alarm.it_value.tv_nsec = (long)(next % 1000000000ull);
+            timerfd_settime(thread->timer_fd, TFD_TIMER_ABSTIME, &alarm, NULL);
+        } else {
+            // Spojenia uvoľnené chybou alebo zatvorením pokračujú hneď.
+            while (thread->idle_count > 0) {
+                connection_start(thread, &thread->connections[thread->idle[--thread->idle_count]], now);
+            }
+        }
+        uint64_t until_end = (load.end_ns - now) / 1000000 + 1;
+        int timeout = until_end < 100 ? (int)until_end : 100;
+
+        int ready = epoll_wait(thread->epoll_fd, events, 256, timeout);
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.ptr == NULL) {
+                uint64_t expirations;
+                if (read(thread->timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+                    perror("timerfd");
+                }
+                continue;
+            }
+            connection_event(thread, (LoadConnection *)events[i].data.ptr, events[i].events);
+        }
+    }
+
+    // Nevybavené požiadavky trvali aspoň do konca merania (dolný odhad latencie).
+    uint64_t end = load.end_ns;
+    for (int i = 0; i < thread->connection_count; i++) {
+        LoadConnection *conn = &thread->connections[i];
+        if (conn->state != LOAD_IDLE && conn->intended_ns >= load.measure_ns) {
+            histogram_record(&thread->latency, end - conn->intended_ns, 1);
+            thread->unfinished++;
+        }
+        connection_drop(conn);
+        free(conn->in);
+    }
+    if (thread->interval_ns && end >= thread->first_ns) {
+        uint64_t due = (end - thread->first_ns) / thread->interval_ns + 1;
+        for (uint64_t k = thread->scheduled; k < due; k++) {
+            uint64_t intended = thread->first_ns + k * thread->interval_ns;
+            if (intended < load.measure_ns || intended >= end) continue;
+            histogram_record(&thread->latency, end - intended, 1);
+            thread->unfinished++;
+        }
+    }
+    close(thread->epoll_fd);
+    if (thread->timer_fd >= 0) close(thread->timer_fd);
+    return NULL;
+}
+
+// --- Výstup ---
+
+static void format_duration(char *out, size_t size, uint64_t ns) {
+    if (ns < 1000) snprintf(out, size, "%lluns", (unsigned long long)ns);
+    else if (ns < 1000000) snprintf(out, size, "%.1fµs", (double)ns / 1e3);
+    else if (ns < 1000000000) snprintf(out, size, "%.2fms", (double)ns / 1e6);
+    else snprintf(out, size, "%.3fs", (double)ns / 1e9);
+}
+
+/**
+ * @brief Vypíše text doplnený medzerami na `width` znakov (nie bajtov, text je v UTF-8).
+ */
+static void print_padded(const char *text, int width) {
+    int characters = 0;
+    for (const char *p = text; *p; p++) characters += ((unsigned char)*p & 0xC0) != 0x80;
+    printf("%s%*s", text, width > characters ? width - characters : 0, "");
+}
+
+static void print_latency_row(const char *label, const Histogram *histogram) {
+    static const double percentiles[] = {50, 90, 99, 99.9};
+    char cell[32];
+    print_padded(label, 24);
+    for (size_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++) {
+        format_duration(cell, sizeof(cell), histogram_percentile(histogram, percentiles[i]));
+        printf(" ");
+        print_padded("", 10 - (int)strlen(cell) + (strstr(cell, "µ") ? 1 : 0));
+        printf("%s", cell);
+    }
+    format_duration(cell, sizeof(cell), histogram->max);
+    printf(" ");
+    print_padded("", 10 - (int)strlen(cell) + (strstr(cell, "µ") ? 1 : 0));
+    printf("%s\n", cell);
+}
+
+static void print_usage(const char *program) {
+    fprintf(stderr,
+            "Použitie: %s [voľby]\n"
+            "  --host H                 adresa servera (predvolene 127.0.0.1)\n"
+            "  --port P                 port (predvolene 8080)\n"
+            "  --connections N          počet spojení (predvolene 16)\n"
+            "  --threads T              počet vlákien (predvolene počet jadier)\n"
+            "  --duration S             trvanie merania v sekundách (predvolene 10)\n"
+            "  --warmup S               zahriatie pred meraním (predvolene 1)\n"
+            "  --rate R                 otvorená slučka: R požiadaviek za sekundu spolu\n"
+            "                           (bez voľby uzavretá slučka)\n"
+            "  --no-keepalive           nové spojenie pre každú požiadavku\n"
+            "  --mix SÚBOR              zmes požiadaviek: \"váha metóda cesta [telo]\" na riadok\n"
+            "  --expected-interval-us U uzavretá slučka: očakávaný interval pre korekciu\n"
+            "                           (predvolene medián času obsluhy)\n",
+            program);
+}
+
+static int resolve(const char *host, const char *port) {
+    struct addrinfo hints, *result;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    int error = getaddrinfo(host, port, &hints, &result);
+    if (error != 0) {
+        fprintf(stderr, "%s:%s: %s\n", host, port, gai_strerror(error));
+        return 0;
+    }
+    memcpy(&load.address, result->ai_addr, result->ai_addrlen);
+    load.address_length = result->ai_addrlen;
+    freeaddrinfo(result);
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    const char *host = "127.0.0.1", *port = "8080", *mix_path = NULL;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    load.connections = 16;
+    load.threads = cores > 0 ? (int)cores : 1;
+    load.duration = 10;
+    load.warmup = 1;
+    load.keep_alive = 1;
+
+    for (int i = 1; i < argc; i++) {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--host") == 0 && has_value) {
+            host = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && has_value) {
+            port = argv[++i];
+        } else if (strcmp(argv[i], "--connections") == 0 && has_value) {
+            load.connections = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+            load.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--duration") == 0 && has_value) {
+            load.duration = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && has_value) {
+            load.warmup = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--rate") == 0 && has_value) {
+            load.rate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--no-keepalive") == 0) {
+            load.keep_alive = 0;
+        } else if (strcmp(argv[i], "--mix") == 0 && has_value) {
+            mix_path = argv[++i];
+        } else if (strcmp(argv[i], "--expected-interval-us") == 0 && has_value) {
+            load.expected_interval_ns = (uint64_t)(atof(argv[++i]) * 1000.0);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (load.connections < 1 || load.connections > LOAD_MAX_CONNECTIONS || load.threads < 1 ||
+        load.duration <= 0 || load.warmup < 0 || load.rate < 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (load.threads > LOAD_MAX_THREADS) load.threads = LOAD_MAX_THREADS;
+    if (load.threads > load.connections) load.threads = load.connections;
+    if (!resolve(host, port)) return 1;
+    if (mix_path ? !mix_load(mix_path) : !mix_default()) return 1;
+
+    LoadThread *threads = (LoadThread *)calloc((size_t)load.threads, sizeof(LoadThread));
+    LoadConnection *connections = (LoadConnection *)calloc((size_t)load.connections, sizeof(LoadConnection));
+    int *idle = (int *)calloc((size_t)load.connections, sizeof(int));
+    if (!threads || !connections || !idle) {
+        perror("calloc");
+        return 1;
+    }
+
+    uint64_t start = now_ns();
+    load.measure_ns = start + (uint64_t)(load.warmup * 1e9);
+    load.end_ns = load.measure_ns + (uint64_t)(load.duration * 1e9);
+
+    int assigned = 0;
+    for (int t = 0; t < load.threads; t++) {
+        LoadThread *thread = &threads[t];
+        thread->id = t;
+        thread->rng = 0x9e3779b97f4a7c15ull * (uint64_t)(t + 1);
+        thread->connections = connections + assigned;
+        thread->connection_count = load.connections / load.threads + (t < load.connections % load.threads);
+        thread->idle = idle + assigned;
+        for (int i = 0; i < thread->connection_count; i++) {
+            thread->connections[i].fd = -1;
+            thread->idle[thread->idle_count++] = thread->connection_count - 1 - i;
+        }
+        assigned += thread->connection_count;
+        if (load.rate > 0) {
+            // Vlákna sa striedajú, aby spolu dali rovnomerný prúd požiadaviek.
+            thread->interval_ns = (uint64_t)(1e9 * load.threads / load.rate);
+            if (thread->interval_ns == 0) thread->interval_ns = 1;
+            thread->first_ns = start + thread->interval_ns * (uint64_t)t / (uint64_t)load.threads;
+        }
+        thread->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        thread->timer_fd = -1;
+        if (thread->interval_ns) {
+            // Budík má v epolle ukazovateľ NULL (spojenia majú vždy nenulový).
+            struct epoll_event event;
+            event.events = EPOLLIN;
+            event.data.ptr = NULL;
+            thread->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            if (thread->timer_fd < 0 || epoll_ctl(thread->epoll_fd, EPOLL_CTL_ADD, thread->timer_fd, &event) < 0) {
+                perror("timerfd");
+                return 1;
+            }
+        }
+        if (thread->epoll_fd < 0 || pthread_create(&thread->thread, NULL, load_thread_main, thread) != 0) {
+            perror("epoll/pthread_create");
+            return 1;
+        }
+    }
+
+    Histogram *latency = (Histogram *)calloc(1, sizeof(Histogram));
+    Histogram *service = (Histogram *)calloc(1, sizeof(Histogram));
+    Histogram *corrected = (Histogram *)calloc(1, sizeof(Histogram));
+    if (!latency || !service || !corrected) return 1;
+    uint64_t completed = 0, bytes = 0, errors_connect = 0, errors_io = 0, status_errors = 0;
+    uint64_t unfinished = 0, backlog_max = 0, entry_completed[LOAD_MAX_MIX] = {0};
+    for (int t = 0; t < load.threads; t++) {
+        LoadThread *thread = &threads[t];
+        pthread_join(thread->thread, NULL);
+        histogram_merge(latency, &thread->latency);
+        histogram_merge(service, &thread->service);
+        completed += thread->completed;
+        bytes += thread->bytes_received;
+        errors_connect += thread->errors_connect;
+        errors_io += thread->errors_io;
+        status_errors += thread->status_errors;
+        unfinished += thread->unfinished;
+        backlog_max += thread->backlog_max;
+        for (int i = 0; i < load.mix_count; i++) entry_completed[i] += thread->entry_completed[i];
+    }
+
+    if (load.rate > 0) {
+        *corrected = *latency;
+    } else {
+        uint64_t interval = load.expected_interval_ns ? load.expected_interval_ns : histogram_percentile(service, 50);
+        histogram_correct(latency, interval, corrected);
+    }
+
+    printf("Režim: %s, %s, %d spojení, %d vlákien, %.1f s (+%.1f s zahriatie)\n",
+           load.rate > 0 ? "otvorená slučka" : "uzavretá slučka",
+           load.keep_alive ? "keep-alive" : "nové spojenie na požiadavku",
+           load.connections, load.threads, load.duration, load.warmup);
+    if (load.rate > 0) printf("Cieľové tempo: %.0f pož./s\n", load.rate);
+    printf("Dokončené: %llu požiadaviek, %.1f pož./s, %.2f MB/s prijatých\n",
+           (unsigned long long)completed, (double)completed / load.duration,
+           (double)bytes / load.duration / 1e6);
+    printf("Chyby: pripojenie %llu, čítanie/zápis %llu, stav mimo 2xx/3xx %llu, nevybavené na konci %llu\n",
+           (unsigned long long)errors_connect, (unsigned long long)errors_io,
+           (unsigned long long)status_errors, (unsigned long long)unfinished);
+    if (load.rate > 0) {
+        printf("Najviac požiadaviek čakajúcich na voľné spojenie: %llu\n", (unsigned long long)backlog_max);
+    }
+    for (int i = 0; i < load.mix_count; i++) {
+        printf("  %-40s %10llu\n", load.mix[i].label, (unsigned long long)entry_completed[i]);
+    }
+
+    printf("\n%-24s %10s %10s %10s %10s %10s\n", "latencia", "p50", "p90", "p99", "p99.9", "max");
+    if (load.rate > 0) {
+        print_latency_row("od plánovaného času", corrected);
+        print_latency_row("čas obsluhy", service);
+    } else {
+        print_latency_row("korigovaná", corrected);
+        print_latency_row("nekorigovaná", latency);
+    }
+    return errors_connect + errors_io > 0 && completed == 0 ? 1 : 0;
+}
@@ -0,0 +1,488 @@
+/**
+ * @file password_bench.c
+ * @brief Benchmark funkcií Password.c (generovanie, hodnotenie, vylepšenie,
+ *        entropia a pomocné has_*) a generátora fráz Passphrase.c s výstupom
+ *        v JSON na porovnanie medzi commitmi.
+ *
+ * Každá funkcia beží nad reprodukovateľnými sadami vstupov (pevné semienko):
+ * krátke, dlhé, len malé písmená, zmiešané a „ľudské“ heslá. Po zahriatí sa
+ * meranie zopakuje niekoľkokrát; vypíše sa medián, minimum, priemer
+ * a smerodajná odchýlka ns na operáciu, operácie za sekundu a (na x86) takty
+ * počítadla TSC na operáciu.
+ *
+ * Použitie: ./Benchmarks/password_bench [-r opakovania] [-f filter] [-l značka]
+ *                                       [-o výsledky.json] [-c základ.json] [-t percent]
+ *
+ *   -o  zapíše výsledky ako JSON,
+ *   -c  porovná mediány s uloženými výsledkami a ak je niektorý pomalší
+ *       o viac ako -t percent (predvolene 10), skončí s kódom 2.
+ */
+#include "../Logic/Password.h"
+#include "../Logic/Passphrase.h"
+#include "../Logic/Policy.h"
+#include "../BackEnd/JsonParser.h"
+#include "../BackEnd/JsonWriter.h"
+#include <math.h>
+#include <stdint.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+// Počet rôznych hesiel v jednej sade (mocnina 2)
+#define BENCH_INPUTS 1024
+// Zahrievanie pred meraním každej funkcie
+#define BENCH_WARMUP_SEC 0.05
+// Cieľové trvanie jedného opakovania
+#define BENCH_REPETITION_SEC 0.02
+// Predvolený a najväčší počet opakovaní
+#define BENCH_DEFAULT_REPETITIONS 11
+#define BENCH_MAX_REPETITIONS 101
+// Predvolená hranica spomalenia (v percentách), ktorá sa hlási ako regresia
+#define BENCH_DEFAULT_THRESHOLD 10.0
+// Semienko generátora vstupov
+#define BENCH_SEED 0x5eed2024u
+
+static volatile int bench_sink;
+
+// Sada vstupov s menom, pod ktorým sa objaví vo výsledkoch.
+typedef struct {
+    const char *name;
+    char *inputs[BENCH_INPUTS];
+} InputSet;
+
+// Meraná operácia: jedno volanie funkcie nad jedným vstupom.
+typedef int (*BenchKernel)(const char *input);
+
+typedef struct {
+    const char *function;
+    const char *set;
+    BenchKernel kernel;
+} BenchCase;
+
+// Výsledok jedného merania.
+typedef struct {
+    char name[96];
+    uint64_t operations;         // Operácie v jednom opakovaní.
+    double min_ns, median_ns, mean_ns, stddev_ns, max_ns;
+    double cycles;               // Medián taktov TSC na operáciu (< 0 ak nie sú k dispozícii).
+} BenchResult;
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static uint64_t read_cycles(void) {
+#if BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// --- Vstupy ---
+
+static uint64_t seed_state = BENCH_SEED;
+
+/**
+ * @brief Deterministický generátor (xorshift64*): rovnaké vstupy v každom behu.
+ */
+static uint32_t seeded_uniform(uint32_t bound) {
+    seed_state ^= seed_state >> 12;
+    seed_state ^= seed_state << 25;
+    seed_state ^= seed_state >> 27;
+    return (uint32_t)((seed_state * 0x2545F4914F6CDD1Dull) >> 32) % bound;
+}
+
+static char *alloc_input(void) {
+    char *input = (char *)malloc(MAX_PASSWORD_LENGTH + 1);
+    if (!input) {
+        perror("malloc");
+        exit(1);
+    }
+    return input;
+}
+
+/**
+ * @brief Heslá danej dĺžky zo všetkých tlačiteľných ASCII znakov.
+ */
+static void make_mixed(InputSet *set, const char *name, size_t length) {
+    set->name = name;
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        char *p = set->inputs[i] = alloc_input();
+        for (size_t j = 0; j < length; j++) p[j] = (char)('!' + seeded_uniform(94));
+        p[length] = '\0';
+    }
+}
+
+/**
+ * @brief Heslá len z malých písmen (jedna trieda znakov).
+ */
+static void make_lower(InputSet *set, const char *name, size_t length) {
+    set->name = name;
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        char *p = set->inputs[i] = alloc_input();
+        for (size_t j = 0; j < length; j++) p[j] = (char)('a' + seeded_uniform(26));
+        p[length] = '\0';
+    }
+}
+
+/**
+ * @brief Heslá typu "Slovo" + číslo + znak, aké si ľudia vymýšľajú.
+ */
+static void make_human(InputSet *set, const char *name) {
+    static const char *const words[] = {
+        "Password", "dragon", "Monkey", "summer", "Zuzka", "bratislava", "qwerty", "iloveyou",
+        "p@ssw0rd", "Sunshine", "heslo", "football", "Michael", "asdfgh", "abc", "hockey",
+    };
+    static const char symbols[] = "!@#$.?";
+    set->name = name;
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        char *p = set->inputs[i] = alloc_input();
+        snprintf(p, MAX_PASSWORD_LENGTH + 1, "%s%u%c",
+                 words[seeded_uniform(sizeof(words) / sizeof(words[0]))],
+                 seeded_uniform(3000), symbols[seeded_uniform(sizeof(symbols) - 1)]);
+    }
+}
+
+// --- Merané funkcie ---
+
+static int kernel_generate_12(const char *input) {
+    char password[MAX_PASSWORD_LENGTH + 1];
+    (void)input;
+    return generate_password(password, 12, 1, 1, 1, 1) + password[0];
+}
+
+static int kernel_generate_64(const char *input) {
+    char password[MAX_PASSWORD_LENGTH + 1];
+    (void)input;
+    return generate_password(password, 64, 1, 1, 1, 1) + password[0];
+}
+
+static int kernel_generate_lower_16(const char *input) {
+    char password[MAX_PASSWORD_LENGTH + 1];
+    (void)input;
+    return generate_password(password, 16, 0, 0, 0, 1) + password[0];
+}
+
+// Vstavaná politika "readable" (vynechané podobné znaky, max_run=2).
+static const PasswordPolicy *readable_policy;
+
+static int kernel_policy_readable(const char *input) {
+    char password[MAX_PASSWORD_LENGTH + 1];
+    (void)input;
+    return policy_generate(readable_policy, 16, password) + password[0];
+}
+
+// Frázy zo vstavaného slovníka slabík (passphrase_init(NULL)).
+static const PassphraseOptions passphrase_plain = {0, 6, "-", 1, PASSPHRASE_CAPS_NONE, 0};
+static const PassphraseOptions passphrase_mixed = {0, 6, " ", 1, PASSPHRASE_CAPS_RANDOM, 3};
+
+static int kernel_passphrase_6(const char *input) {
+    char passphrase[PASSPHRASE_MAX_LENGTH];
+    (void)input;
+    return (int)passphrase_generate(&passphrase_plain, passphrase) + passphrase[0];
+}
+
+static int kernel_passphrase_6_mixed(const char *input) {
+    char passphrase[PASSPHRASE_MAX_LENGTH];
+    (void)input;
+    return (int)passphrase_generate(&passphrase_mixed, passphrase) + passphrase[0];
+}
+
+static int kernel_evaluate(const char *input) {
+    PasswordStrength result;
+    evaluate_password_strength(input, &result);
+    return result.score;
+}
+
+static int kernel_strengthen(const char *input) {
+    char password[MAX_PASSWORD_LENGTH + 1];
+    strengthen_password(input, password);
+    return password[0];
+}
+
+static int kernel_entropy(const char *input) {
+    return calculate_entropy(input);
+}
+
+static int kernel_has_all(const char *input) {
+    return has_lowercase(input) + has_uppercase(input) + has_numbers(input) + has_special_chars(input);
+}
+
+static int kernel_has_uppercase(const char *input) {
+    return has_uppercase(input);
+}
+
+static int kernel_has_special(const char *input) {
+    return has_special_chars(input);
+}
+
+static InputSet sets[6];
+
+static const BenchCase cases[] = {
+    {"generate_password", "len12",   kernel_generate_12},
+    {"generate_password", "len64",   kernel_generate_64},
+    {"generate_password", "lower16", kernel_generate_lower_16},
+    {"policy_generate", "readable16", kernel_policy_readable},
+    {"passphrase_generate", "words6",      kernel_passphrase_6},
+    {"passphrase_generate", "words6mixed", kernel_passphrase_6_mixed},
+    {"evaluate_password_strength", "short8",  kernel_evaluate},
+    {"evaluate_password_strength", "mixed16", kernel_evaluate},
+    {"evaluate_password_strength", "lower16", kernel_evaluate},
+    {"evaluate_password_strength", "human",   kernel_evaluate},
+    {"evaluate_password_strength", "long64",  kernel_evaluate},
+    {"evaluate_password_strength", "max128",  kernel_evaluate},
+    {"strengthen_password", "short8",  kernel_strengthen},
+    {"strengthen_password", "lower16", kernel_strengthen},
+    {"strengthen_password", "human",   kernel_strengthen},
+    {"calculate_entropy", "short8",  kernel_entropy},
+    {"calculate_entropy", "long64",  kernel_entropy},
+    {"calculate_entropy", "max128",  kernel_entropy},
+    {"has_all", "mixed16", kernel_has_all},
+    {"has_all", "human",   kernel_has_all},
+    // Bez hľadaného znaku sa prejde celé heslo (najhorší prípad).
+    {"has_uppercase", "lower16", kernel_has_uppercase},
+    {"has_special_chars", "lower16", kernel_has_special},
+    {"has_special_chars", "max128",  kernel_has_special},
+};
+
+static const InputSet *find_set(const char *name) {
+    for (size_t i = 0; i < sizeof(sets) / sizeof(sets[0]); i++) {
+        if (sets[i].name && strcmp(sets[i].name, name) == 0) return &sets[i];
+    }
+    return NULL;
+}
+
+// --- Meranie ---
+
+/**
+ * @brief Spustí `operations` operácií nad vstupmi sady (cyklicky).
+ */
+static void run_kernel(BenchKernel kernel, const InputSet *set, uint64_t operations) {
+    int sink = 0;
+    for (uint64_t i = 0; i < operations; i++) {
+        sink += kernel(set->inputs[i & (BENCH_INPUTS - 1)]);
+    }
+    bench_sink += sink;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *values, int count) {
+    qsort(values, (size_t)count, sizeof(double), compare_doubles);
+    return count % 2 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+/**
+ * @brief Zahreje funkciu, určí počet operácií na opakovanie a zmeria opakovania.
+ */
+static void bench_case(const BenchCase *bench, const InputSet *set, int repetitions, BenchResult *result) {
+    snprintf(result->name, sizeof(result->name), "%s/%s", bench->function, bench->set);
+
+    // Zahrievanie (cache, prediktor skokov, frekvencia jadra) a kalibrácia:
+    // počet operácií sa zdvojnásobuje, kým jedna dávka netrvá dosť dlho.
+    uint64_t operations = 64;
+    double start = now_seconds();
+    while (1) {
+        double batch_start = now_seconds();
+        run_kernel(bench->kernel, set, operations);
+        double elapsed = now_seconds() - batch_start;
+        if (elapsed >= BENCH_REPETITION_SEC && now_seconds() - start >= BENCH_WARMUP_SEC) break;
+        if (elapsed < BENCH_REPETITION_SEC) operations *= 2;
+    }
+    result->operations = operations;
+
+    double ns[BENCH_MAX_REPETITIONS];
+    double cycles[BENCH_MAX_REPETITIONS];
+    for (int r = 0; r < repetitions; r++) {
+        uint64_t cycles_start = read_cycles();
+        double time_start = now_seconds();
+        run_kernel(bench->kernel, set, operations);
+        double elapsed = now_seconds() - time_start;
+        cycles[r] = (double)(read_cycles() - cycles_start) / (double)operations;
+        ns[r] = elapsed * 1e9 / (double)operations;
+    }
+
+    double sum = 0, squares = 0;
+    for (int r = 0; r < repetitions; r++) sum += ns[r];
+    result->mean_ns = sum / repetitions;
+    for (int r = 0; r < repetitions; r++) squares += (ns[r] - result->mean_ns) * (ns[r] - result->mean_ns);
+    result->stddev_ns = repetitions > 1 ? sqrt(squares / (repetitions - 1)) : 0;
+    result->median_ns = median(ns, repetitions);
+    result->min_ns = ns[0];
+    result->max_ns = ns[repetitions - 1];
+    result->cycles = BENCH_HAVE_TSC ? median(cycles, repetitions) : -1;
+}
+
+// --- JSON ---
+
+static int write_results(const char *path, const char *label, int repetitions,
+                         const BenchResult *results, size_t count) {
+    Buffer out;
+    buffer_init(&out);
+    int ok = buffer_appendf(&out, "{\n  \"benchmark\": \"password_bench\",\n  \"label\": ") &&
+             json_append_string(&out, label, strlen(label)) &&
+             buffer_appendf(&out, ",\n  \"timestamp\": %ld,\n  \"repetitions\": %d,\n"
+                                  "  \"cycles_source\": %s,\n  \"results\": [",
+                            (long)time(NULL), repetitions, BENCH_HAVE_TSC ? "\"rdtsc\"" : "null");
+    for (size_t i = 0; ok && i < count; i++) {
+        const BenchResult *r = &results[i];
+        ok = buffer_appendf(&out, "%s\n    {\"name\": ", i ? "," : "") &&
+             json_append_string(&out, r->name, strlen(r->name)) &&
+             buffer_appendf(&out, ", \"operations\": %llu, \"median_ns\": %.3f, \"min_ns\": %.3f, "
+                                  "\"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"max_ns\": %.3f, "
+                                  "\"ops_per_sec\": %.0f, ",
+                            (unsigned long long)r->operations, r->median_ns, r->min_ns, r->mean_ns,
+                            r->stddev_ns, r->max_ns, 1e9 / r->median_ns) &&
+             (r->cycles >= 0 ? buffer_appendf(&out, "\"cycles_per_op\": %.1f}", r->cycles)
+                             : JSON_APPEND_LITERAL(&out, "\"cycles_per_op\": null}"));
+    }
+    ok = ok && JSON_APPEND_LITERAL(&out, "\n  ]\n}\n");
+
+    FILE *file = ok ? fopen(path, "w") : NULL;
+    if (!file || fwrite(out.data, 1, out.length, file) != out.length) {
+        fprintf(stderr, "Nepodarilo sa zapísať %s\n", path);
+        ok = 0;
+    }
+    if (file && fclose(file) != 0) ok = 0;
+    buffer_free(&out);
+    return ok;
+}
+
+/**
+ * @brief Porovná mediány s výsledkami uloženými cez -o.
+ *
+ * Zo súboru sa čítajú len dvojice "name" a "median_ns" (v tomto poradí)
+ * v objektoch poľa "results"; ostatné kľúče sa preskočia.
+ *
+ * @return Počet regresií, -1 ak sa súbor nedá načítať.
+ */
+static int compare_results(const char *path, double threshold, const BenchResult *results, size_t count) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return -1;
+    }
+    Buffer data;
+    buffer_init(&data);
+    char chunk[4096];
+    size_t read_bytes;
+    while ((read_bytes = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        if (!buffer_append(&data, chunk, read_bytes)) break;
+    }
+    fclose(file);
+
+    JsonTokenizer tokenizer;
+    JsonToken token;
+    JsonTokenType type;
+    char name[96] = "";
+    int expect = 0;              // 1 = hodnota kľúča "name", 2 = hodnota "median_ns".
+    int regressions = 0, matched = 0;
+    json_tokenizer_init(&tokenizer, data.data ? data.data : "", data.length);
+
+    printf("\n%-43s %13s %12s %9s\n", "porovnanie so základom", "základ ns", "teraz ns", "zmena");
+    while ((type = json_next(&tokenizer, &token)) > JSON_TOKEN_END) {
+        if (type == JSON_TOKEN_KEY) {
+            expect = token.length == 4 && memcmp(token.data, "name", 4) == 0 ? 1
+                   : token.length == 9 && memcmp(token.data, "median_ns", 9) == 0 ? 2 : 0;
+            continue;
+        }
+        if (expect == 1 && type == JSON_TOKEN_STRING && token.length < sizeof(name)) {
+            name[json_decode_string(&token, name)] = '\0';
+        } else if (expect == 2 && type == JSON_TOKEN_NUMBER && name[0]) {
+            double baseline = strtod(token.data, NULL);
+            for (size_t i = 0; i < count; i++) {
+                if (strcmp(results[i].name, name) != 0 || baseline <= 0) continue;
+                double change = (results[i].median_ns - baseline) / baseline * 100.0;
+                int regressed = change > threshold;
+                printf("%-42s %12.1f %12.1f %+8.1f%%%s\n", name, baseline, results[i].median_ns,
+                       change, regressed ? "  REGRESIA" : "");
+                regressions += regressed;
+                matched++;
+            }
+            name[0] = '\0';
+        }
+        expect = 0;
+    }
+    buffer_free(&data);
+    if (type == JSON_TOKEN_ERROR) {
+        fprintf(stderr, "%s nie je platný JSON\n", path);
+        return -1;
+    }
+    printf("%d porovnaných, %d regresií (hranica +%.1f %%)\n", matched, regressions, threshold);
+    return regressions;
+}
+
+int main(int argc, char **argv) {
+    int repetitions = BENCH_DEFAULT_REPETITIONS;
+    double threshold = BENCH_DEFAULT_THRESHOLD;
+    const char *filter = NULL, *output = NULL, *baseline = NULL, *label = "";
+    int option;
+    while ((option = getopt(argc, argv, "r:f:l:o:c:t:")) != -1) {
+        switch (option) {
+        case 'r': repetitions = atoi(optarg); break;
+        case 'f': filter = optarg; break;
+        case 'l': label = optarg; break;
+        case 'o': output = optarg; break;
+        case 'c': baseline = optarg; break;
+        case 't': threshold = atof(optarg); break;
+        default:
+            fprintf(stderr, "Použitie: %s [-r opakovania] [-f filter] [-l značka] "
+                            "[-o výsledky.json] [-c základ.json] [-t percent]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (repetitions < 1) repetitions = 1;
+    if (repetitions > BENCH_MAX_REPETITIONS) repetitions = BENCH_MAX_REPETITIONS;
+
+    make_mixed(&sets[0], "short8", 8);
+    make_mixed(&sets[1], "mixed16", 16);
+    make_mixed(&sets[2], "long64", 64);
+    make_mixed(&sets[3], "max128", MAX_PASSWORD_LENGTH);
+    make_lower(&sets[4], "lower16", 16);
+    make_human(&sets[5], "human");
+    if (!passphrase_init(NULL)) return 1;
+    readable_policy = policy_find("readable", 8);
+    // Generovanie vstup nečíta; sady "len*", "readable*" a "words*" len pomenúvajú parametre.
+    static const InputSet no_input = {"", {NULL}};
+
+    size_t case_count = sizeof(cases) / sizeof(cases[0]);
+    BenchResult *results = (BenchResult *)calloc(case_count, sizeof(BenchResult));
+    if (!results) return 1;
+    size_t count = 0;
+
+    printf("%-42s %11s %8s %9s %13s %10s\n", "funkcia/sada", "medián ns", "min ns", "± ns", "op/s", "takty/op");
+    for (size_t i = 0; i < case_count; i++) {
+        const InputSet *set = find_set(cases[i].set);
+        char name[96];
+        snprintf(name, sizeof(name), "%s/%s", cases[i].function, cases[i].set);
+        if (filter && !strstr(name, filter)) continue;
+
+        BenchResult *result = &results[count++];
+        bench_case(&cases[i], set ? set : &no_input, repetitions, result);
+        printf("%-42s %10.1f %8.1f %8.1f %13.0f", result->name, result->median_ns, result->min_ns,
+               result->stddev_ns, 1e9 / result->median_ns);
+        if (result->cycles >= 0) printf(" %10.1f\n", result->cycles);
+        else printf(" %10s\n", "-");
+        fflush(stdout);
+    }
+
+    int status = 0;
+    if (output && !write_results(output, label, repetitions, results, count)) status = 1;
+    if (baseline) {
+        int regressions = compare_results(baseline, threshold, results, count);
+        if (regressions < 0) status = 1;
+        else if (regressions > 0 && status == 0) status = 2;
+    }
+    free(results);
+    return status;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file pattern_bench.c
+ * @brief Benchmark odhadu počtu pokusov podľa vzorov (Patterns.c) a voliteľne
+ *        Markovovho modelu (Markov.c).
+ *
+ * Vypíše odhad pre niekoľko typických hesiel a potom ns na jeden odhad
+ * pre náhodné heslá rôznej dĺžky, heslá zložené zo slov a najhorší prípad
+ * (dlhé opakovanie jedného znaku). S modelom meria rovnaké sady aj pre
+ * `markov_guesses_log10()`.
+ *
+ * Použitie: ./Benchmarks/pattern_bench [MODEL]
+ */
+#include "../Logic/Patterns.h"
+#include "../Logic/Markov.h"
+#include "../Logic/Random.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Počet rôznych hesiel v jednej sade
+#define BENCH_INPUTS 1024
+// Ako dlho beží jedno meranie
+#define BENCH_DURATION_SEC 0.5
+// Najdlhšie heslo v sade
+#define BENCH_MAX_LENGTH 256
+
+static volatile double bench_sink;
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Náhodné heslá danej dĺžky zo všetkých tlačiteľných ASCII znakov.
+ */
+static void make_random(char **inputs, size_t length) {
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        for (size_t j = 0; j < length; j++) {
+            inputs[i][j] = (char)('!' + random_uniform(94));
+        }
+        inputs[i][length] = '\0';
+    }
+}
+
+/**
+ * @brief Heslá typu "Slovo" + číslo + znak, aké si ľudia vymýšľajú.
+ */
+static void make_human(char **inputs) {
+    static const char *const words[] = {
+        "Password", "dragon", "Monkey", "summer", "Zuzka", "bratislava", "qwerty", "iloveyou",
+        "p@ssw0rd", "Sunshine", "heslo", "football", "Michael", "asdfgh", "abc", "hockey",
+    };
+    static const char symbols[] = "!@#$.?";
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        snprintf(inputs[i], BENCH_MAX_LENGTH + 1, "%s%u%c",
+                 words[random_uniform(sizeof(words) / sizeof(words[0]))],
+                 random_uniform(3000), symbols[random_uniform(sizeof(symbols) - 1)]);
+    }
+}
+
+static double bench_estimate(char **inputs, int markov) {
+    PatternEstimate estimate;
+    uint64_t operations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        for (int i = 0; i < BENCH_INPUTS; i++) {
+            if (markov) {
+                bench_sink += markov_guesses_log10(inputs[i], strlen(inputs[i]));
+                continue;
+            }
+            estimate_password_guesses(inputs[i], strlen(inputs[i]), &estimate);
+            bench_sink += estimate.guesses_log10;
+        }
+        operations += BENCH_INPUTS;
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_DURATION_SEC);
+    return elapsed * 1e9 / (double)operations;
+}
+
+int main(int argc, char **argv) {
+    static const char *const examples[] = {
+        "Password1!", "p4ssw0rd", "qwertyuiop", "1qaz2wsx", "abcabcabc", "Zuzka1990",
+        "hesloheslo", "correcthorsebatterystaple", "Tr0ub4dor&3", "Kv7$pL2!nQ9@wX4#",
+    };
+    patterns_init();
+    int markov = argc > 1;
+    if (markov && !markov_open(argv[1])) return 1;
+
+    printf("%-28s %10s  %-6s %s\n", "heslo", "log10", "vzory", markov ? "Markov log10" : "");
+    for (size_t i = 0; i < sizeof(examples) / sizeof(examples[0]); i++) {
+        PatternEstimate estimate;
+        estimate_password_guesses(examples[i], strlen(examples[i]), &estimate);
+        printf("%-28s %10.2f  0x%02x  ", examples[i], estimate.guesses_log10, estimate.patterns);
+        if (markov) printf(" %10.2f", markov_guesses_log10(examples[i], strlen(examples[i])));
+        printf("\n");
+    }
+
+    char *inputs[BENCH_INPUTS];
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        inputs[i] = (char *)malloc(BENCH_MAX_LENGTH + 1);
+    }
+
+    printf("\n%-28s %10s %10s\n", "sada", "ns/op", markov ? "Markov" : "");
+    static const size_t lengths[] = {8, 12, 16, 32, 128};
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        make_random(inputs, lengths[l]);
+        char name[32];
+        snprintf(name, sizeof(name), "náhodné, dĺžka %zu", lengths[l]);
+        printf("%-29s %10.1f", name, bench_estimate(inputs, 0));
+        if (markov) printf(" %10.1f", bench_estimate(inputs, 1));
+        printf("\n");
+    }
+
+    make_human(inputs);
+    printf("%-28s %10.1f", "slovo + číslo + znak", bench_estimate(inputs, 0));
+    if (markov) printf(" %10.1f", bench_estimate(inputs, 1));
+    printf("\n");
+
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        memset(inputs[i], 'a', BENCH_MAX_LENGTH);
+        inputs[i][BENCH_MAX_LENGTH] = '\0';
+    }
+    printf("%-28s %10.1f", "\"aaa...\" (256 znakov)", bench_estimate(inputs, 0));
+    if (markov) printf(" %10.1f", bench_estimate(inputs, 1));
+    printf("\n");
+
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        free(inputs[i]);
+    }
+    return 0;
+}
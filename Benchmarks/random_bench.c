@@ -0,0 +1,133 @@
+/**
+ * @file random_bench.c
+ * @brief Mikro-benchmark generátora náhodných čísel a generovania hesiel.
+ *
+ * Meria priepustnosť `random_bytes()` (MB/s), `random_uniform()` (čísla/s)
+ * a `generate_password()` (heslá/s) v jednom vlákne aj vo všetkých jadrách.
+ * Pre porovnanie meria aj pôvodný prístup `rand_r() % n`.
+ *
+ * Použitie: ./Benchmarks/random_bench [počet_vlákien]
+ */
+#include "../Logic/Password.h"
+#include "../Logic/Random.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+// Ako dlho beží jedno meranie
+#define BENCH_DURATION_SEC 1.0
+// Počet operácií medzi kontrolami času
+#define BENCH_BATCH 4096
+
+// Zabráni kompilátoru vyhodiť výpočet, ktorého výsledok sa inak nepoužije.
+static volatile uint32_t bench_sink;
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Opakuje dávky operácie, kým neuplynie BENCH_DURATION_SEC.
+ *
+ * @return Počet operácií za sekundu.
+ */
+static double bench_run(uint64_t (*batch)(void)) {
+    // Zahriatie (inicializácia stavu vlákna, cache).
+    batch();
+
+    uint64_t operations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        operations += batch();
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_DURATION_SEC);
+    return (double)operations / elapsed;
+}
+
+static uint64_t batch_random_bytes(void) {
+    static __thread unsigned char block[64 * 1024];
+    for (int i = 0; i < 16; i++) {
+        random_bytes(block, sizeof(block));
+    }
+    bench_sink ^= block[0];
+    return 16 * sizeof(block);
+}
+
+static uint64_t batch_random_uniform(void) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < BENCH_BATCH; i++) {
+        sum += random_uniform(88);
+    }
+    bench_sink ^= sum;
+    return BENCH_BATCH;
+}
+
+static uint64_t batch_rand_r(void) {
+    static __thread unsigned int seed = 1;
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < BENCH_BATCH; i++) {
+        sum += (uint32_t)(rand_r(&seed) % 88);
+    }
+    bench_sink ^= sum;
+    return BENCH_BATCH;
+}
+
+static uint64_t batch_generate_password(void) {
+    char password[MAX_PASSWORD_LENGTH + 1];
+    for (int i = 0; i < BENCH_BATCH / 16; i++) {
+        generate_password(password, 16, 1, 1, 1, 1);
+        bench_sink ^= (uint32_t)password[0];
+    }
+    return BENCH_BATCH / 16;
+}
+
+typedef struct {
+    uint64_t (*batch)(void);
+    double rate;
+} BenchThread;
+
+static void *bench_thread_main(void *arg) {
+    BenchThread *thread = (BenchThread *)arg;
+    thread->rate = bench_run(thread->batch);
+    return NULL;
+}
+
+/**
+ * @brief Spustí meranie súčasne v `threads` vláknach a vráti súčet ich výkonov.
+ */
+static double bench_parallel(uint64_t (*batch)(void), int threads) {
+    pthread_t handles[256];
+    BenchThread states[256];
+    double total = 0;
+
+    for (int i = 0; i < threads; i++) {
+        states[i].batch = batch;
+        pthread_create(&handles[i], NULL, bench_thread_main, &states[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(handles[i], NULL);
+        total += states[i].rate;
+    }
+    return total;
+}
+
+int main(int argc, char *argv[]) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = argc > 1 ? atoi(argv[1]) : (int)cores;
+    if (threads < 1) threads = 1;
+    if (threads > 256) threads = 256;
+
+    printf("random_bytes:            %10.1f MB/s\n", bench_run(batch_random_bytes) / 1e6);
+    printf("random_uniform(88):      %10.1f M/s\n", bench_run(batch_random_uniform) / 1e6);
+    printf("rand_r() %% 88 (pôvodné): %10.1f M/s\n", bench_run(batch_rand_r) / 1e6);
+    printf("generate_password(16):   %10.3f M hesiel/s (1 vlákno)\n",
+           bench_run(batch_generate_password) / 1e6);
+    printf("generate_password(16):   %10.3f M hesiel/s (%d vlákien)\n",
+           bench_parallel(batch_generate_password, threads) / 1e6, threads);
+    printf("random_bytes:            %10.1f MB/s (%d vlákien)\n",
+           bench_parallel(batch_random_bytes, threads) / 1e6, threads);
+    return 0;
+}
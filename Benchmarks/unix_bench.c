@@ -0,0 +1,369 @@
+/**
+ * @file unix_bench.c
+ * @brief Porovnanie binárneho protokolu na Unix sockete s HTTP API bežiaceho servera.
+ *
+ * Server treba spustiť s UNIX_SOCKET, napr.
+ *
+ *     UNIX_SOCKET=/tmp/password.sock ./password_server
+ *
+ * Pre generate, evaluate a strengthen sa zmeria postupnosť požiadaviek s jednou
+ * položkou cez HTTP (keep-alive spojenie na TCP) a cez Unix socket, každá
+ * požiadavka čaká na odpoveď predchádzajúcej. Pre evaluate sa ešte zmerajú
+ * rámce s dávkou `--batch` hesiel a `--depth` rámcov poslaných naraz
+ * (pipelining s rozlíšením odpovedí podľa čísla požiadavky). Vypíše sa počet
+ * položiek za sekundu a percentily času jednej požiadavky.
+ *
+ * Heslá sa pri každej požiadavke menia, aby HTTP odpovede neprišli z cache
+ * vyhodnotení (EVAL_CACHE_MB).
+ *
+ * Použitie: ./Benchmarks/unix_bench [--socket CESTA] [--host H] [--port P]
+ *           [--requests N] [--batch B] [--depth D]
+ */
+#include "../Client/PasswordClient.h"
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+// Najväčšia odpoveď HTTP, ktorú benchmark prečíta
+#define BENCH_RESPONSE_SIZE 65536
+// Najdlhšie heslo benchmarku vrátane nuly
+#define BENCH_PASSWORD_SIZE 64
+// Priestor pre jedno heslo v odpovedi (MAX_PASSWORD_LENGTH + 1)
+#define BENCH_STRIDE 129
+
+// Výsledok jedného scenára.
+typedef struct {
+    const char *label;
+    size_t items;                // Položky spolu (heslá, nie požiadavky).
+    size_t count;                // Zmerané požiadavky.
+    uint64_t total_ns;
+    uint64_t *latencies;         // Čas každej požiadavky.
+} Scenario;
+
+static uint64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Vytvorí i-te heslo benchmarku (každé iné, aby sa neopakovali v cache).
+ */
+static size_t bench_password(char *out, size_t i) {
+    return (size_t)snprintf(out, BENCH_PASSWORD_SIZE, "Tr0ub4dor&3-%zu", i);
+}
+
+// --- HTTP ---
+
+// Adresa HTTP servera pre opätovné pripojenie.
+static const char *http_host;
+static const char *http_port;
+
+static int http_connect(const char *host, const char *port) {
+    struct addrinfo hints, *result;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    int error = getaddrinfo(host, port, &hints, &result);
+    if (error != 0) {
+        fprintf(stderr, "%s:%s: %s\n", host, port, gai_strerror(error));
+        return -1;
+    }
+    int fd = socket(result->ai_family, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, result->ai_addr, result->ai_addrlen) < 0) {
+        perror("connect");
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+    if (fd >= 0) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+/**
+ * @brief Pošle POST s JSON telom a prečíta celú odpoveď (podľa Content-Length).
+ *
+ * Ak server spojenie po odpovedi zavrie (KEEPALIVE_MAX_REQUESTS), pripojí sa
+ * znova ako bežný klient; čas pripojenia sa započíta do požiadavky.
+ *
+ * @return 1 pri odpovedi 200, inak 0.
+ */
+static int http_call(int *fd_out, const char *path, const char *body, size_t body_length) {
+    int fd = *fd_out;
+    char request[1024];
+    int length = snprintf(request, sizeof(request),
+                          "POST %s HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\n"
+                          "Content-Length: %zu\r\n\r\n%.*s",
+                          path, body_length, (int)body_length, body);
+    if (length < 0 || (size_t)length >= sizeof(request)) return 0;
+    if (send(fd, request, (size_t)length, MSG_NOSIGNAL) != length) return 0;
+
+    static char response[BENCH_RESPONSE_SIZE + 1];
+    size_t received = 0;
+    size_t needed = 0;
+    while (needed == 0 || received < needed) {
+        ssize_t n = recv(fd, response + received, BENCH_RESPONSE_SIZE - received, 0);
+        if (n <= 0) return 0;
+        received += (size_t)n;
+        response[received] = '\0';
+        if (needed == 0) {
+            char *end = strstr(response, "\r\n\r\n");
+            if (!end) continue;
+            char *content_length = strcasestr(response, "\r\nContent-Length:");
+            if (!content_length || content_length > end) return 0;
+            needed = (size_t)(end + 4 - response) + strtoul(content_length + 17, NULL, 10);
+            if (needed > BENCH_RESPONSE_SIZE) return 0;
+        }
+    }
+    if (strncmp(response, "HTTP/1.1 200", 12) != 0) return 0;
+    char *close_header = strcasestr(response, "\r\nConnection: close");
+    if (close_header && close_header < strstr(response, "\r\n\r\n")) {
+        close(fd);
+        *fd_out = http_connect(http_host, http_port);
+        if (*fd_out < 0) return 0;
+    }
+    return 1;
+}
+
+static int run_http(Scenario *scenario, int *fd, const char *path, int with_password, size_t requests) {
+    char password[BENCH_PASSWORD_SIZE];
+    char body[256];
+    uint64_t started = now_ns();
+    for (size_t i = 0; i < requests; i++) {
+        int length;
+        if (with_password) {
+            bench_password(password, i);
+            length = snprintf(body, sizeof(body), "{\"password\":\"%s\"}", password);
+        } else {
+            length = snprintf(body, sizeof(body), "{\"length\":16}");
+        }
+        uint64_t start = now_ns();
+        if (!http_call(fd, path, body, (size_t)length)) {
+            fprintf(stderr, "HTTP %s zlyhalo pri požiadavke %zu\n", path, i);
+            return 0;
+        }
+        scenario->latencies[scenario->count++] = now_ns() - start;
+    }
+    scenario->total_ns = now_ns() - started;
+    scenario->items = requests;
+    return 1;
+}
+
+// --- Unix socket ---
+
+/**
+ * @brief Po jednom rámci s `batch` položkami, každý čaká na odpoveď.
+ */
+static int run_unix(Scenario *scenario, PasswordClient *client, int opcode, size_t requests, size_t batch) {
+    static char passwords[PASSWORD_FRAME_MAX_COUNT][BENCH_PASSWORD_SIZE];
+    static const char *pointers[PASSWORD_FRAME_MAX_COUNT];
+    static char out[PASSWORD_FRAME_MAX_COUNT * BENCH_STRIDE];
+    static uint8_t scores[PASSWORD_FRAME_MAX_COUNT];
+    PasswordEvaluations results = {scores, NULL, NULL, NULL};
+
+    size_t next = 0;
+    uint64_t started = now_ns();
+    for (size_t i = 0; i < requests; i++) {
+        for (size_t j = 0; j < batch && opcode != PASSWORD_OP_GENERATE; j++) {
+            bench_password(passwords[j], next++);
+            pointers[j] = passwords[j];
+        }
+        uint64_t start = now_ns();
+        int ok;
+        switch (opcode) {
+        case PASSWORD_OP_GENERATE:
+            ok = password_client_generate(client, batch, 16, 0, 0, out, BENCH_STRIDE);
+            break;
+        case PASSWORD_OP_EVALUATE:
+            ok = password_client_evaluate(client, batch, pointers, NULL, &results);
+            break;
+        default:
+            ok = password_client_strengthen(client, batch, pointers, NULL, out, BENCH_STRIDE);
+            break;
+        }
+        if (!ok) {
+            fprintf(stderr, "Unix socket: požiadavka %zu zlyhala (stav %d)\n", i,
+                    password_client_status(client));
+            return 0;
+        }
+        scenario->latencies[scenario->count++] = now_ns() - start;
+    }
+    scenario->total_ns = now_ns() - started;
+    scenario->items = requests * batch;
+    return 1;
+}
+
+/**
+ * @brief EVALUATE s jedným heslom, `depth` rámcov naraz.
+ *
+ * Čas požiadavky je od zaradenia jej rámca po prijatie odpovede.
+ */
+static int run_pipelined(Scenario *scenario, PasswordClient *client, size_t requests, size_t depth) {
+    uint64_t *submitted = (uint64_t *)calloc(requests, sizeof(uint64_t));
+    if (!submitted) return 0;
+    uint32_t first_id = 0;
+    size_t sent = 0, done = 0;
+    char password[BENCH_PASSWORD_SIZE];
+    const char *pointer = password;
+
+    uint64_t started = now_ns();
+    while (done < requests) {
+        while (sent < requests && sent - done < depth) {
+            uint32_t request_id;
+            bench_password(password, sent);
+            if (!password_client_submit_passwords(client, PASSWORD_OP_EVALUATE, 1, &pointer, NULL, &request_id)) {
+                free(submitted);
+                return 0;
+            }
+            if (sent == 0) first_id = request_id;
+            submitted[sent++] = now_ns();
+        }
+        PasswordClientResponse response;
+        if (!password_client_receive(client, &response) || response.status != PASSWORD_STATUS_OK ||
+            response.request_id - first_id >= requests) {
+            fprintf(stderr, "Unix socket: pipelining zlyhal po %zu odpovediach\n", done);
+            free(submitted);
+            return 0;
+        }
+        scenario->latencies[scenario->count++] = now_ns() - submitted[response.request_id - first_id];
+        done++;
+    }
+    scenario->total_ns = now_ns() - started;
+    scenario->items = requests;
+    free(submitted);
+    return 1;
+}
+
+// --- Výstup ---
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * @brief Vypíše text doplnený medzerami na `width` znakov (nie bajtov, text je v UTF-8).
+ */
+static void print_padded(const char *text, int width) {
+    int characters = 0;
+    for (const char *p = text; *p; p++) characters += ((unsigned char)*p & 0xC0) != 0x80;
+    printf("%s%*s", text, width > characters ? width - characters : 0, "");
+}
+
+static void print_scenario(Scenario *scenario) {
+    if (scenario->count == 0) return;
+    qsort(scenario->latencies, scenario->count, sizeof(uint64_t), compare_u64);
+    double p50 = (double)scenario->latencies[scenario->count / 2] / 1e3;
+    double p99 = (double)scenario->latencies[scenario->count * 99 / 100] / 1e3;
+    double items_per_second = (double)scenario->items * 1e9 / (double)scenario->total_ns;
+    print_padded(scenario->label, 28);
+    printf(" %12.0f %10.1f %10.1f\n", items_per_second, p50, p99);
+}
+
+static void print_usage(const char *program) {
+    fprintf(stderr,
+            "Použitie: %s [voľby]\n"
+            "  --socket CESTA   Unix socket servera (predvolene /tmp/password.sock)\n"
+            "  --host H         adresa HTTP servera (predvolene 127.0.0.1)\n"
+            "  --port P         port HTTP servera (predvolene 8080)\n"
+            "  --requests N     požiadaviek na scenár (predvolene 20000)\n"
+            "  --batch B        hesiel v dávkovom rámci (predvolene 64, najviac %d)\n"
+            "  --depth D        rámcov naraz pri pipeliningu (predvolene 32)\n",
+            program, PASSWORD_FRAME_MAX_COUNT);
+}
+
+int main(int argc, char **argv) {
+    const char *socket_path = "/tmp/password.sock", *host = "127.0.0.1", *port = "8080";
+    long requests = 20000, batch = 64, depth = 32;
+
+    for (int i = 1; i < argc; i++) {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--socket") == 0 && has_value) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--host") == 0 && has_value) {
+            host = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && has_value) {
+            port = argv[++i];
+        } else if (strcmp(argv[i], "--requests") == 0 && has_value) {
+            requests = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--batch") == 0 && has_value) {
+            batch = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--depth") == 0 && has_value) {
+            depth = strtol(argv[++i], NULL, 10);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (requests < 1 || batch < 1 || batch > PASSWORD_FRAME_MAX_COUNT || depth < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    http_host = host;
+    http_port = port;
+    int http = http_connect(host, port);
+    PasswordClient *client = password_client_connect(socket_path);
+    if (http < 0) return 1;
+    if (!client) {
+        fprintf(stderr, "%s: %s\n", socket_path, strerror(errno));
+        return 1;
+    }
+
+    Scenario scenarios[] = {
+        {"HTTP /api/generate", 0, 0, 0, NULL},
+        {"Unix GENERATE", 0, 0, 0, NULL},
+        {"HTTP /api/evaluate", 0, 0, 0, NULL},
+        {"Unix EVALUATE", 0, 0, 0, NULL},
+        {"HTTP /api/strengthen", 0, 0, 0, NULL},
+        {"Unix STRENGTHEN", 0, 0, 0, NULL},
+        {"Unix EVALUATE dávka", 0, 0, 0, NULL},
+        {"Unix EVALUATE pipelining", 0, 0, 0, NULL},
+    };
+    size_t scenario_count = sizeof(scenarios) / sizeof(scenarios[0]);
+    for (size_t i = 0; i < scenario_count; i++) {
+        scenarios[i].latencies = (uint64_t *)malloc((size_t)requests * sizeof(uint64_t));
+        if (!scenarios[i].latencies) return 1;
+    }
+
+    // Zahriatie oboch spojení cez strengthen, aby sa heslá evaluate nedostali do cache.
+    Scenario warmup = {"", 0, 0, 0, scenarios[0].latencies};
+    size_t warmup_requests = (size_t)requests / 10 + 1;
+    int ok = run_http(&warmup, &http, "/api/strengthen", 1, warmup_requests);
+    warmup.count = 0;
+    ok = ok && run_unix(&warmup, client, PASSWORD_OP_STRENGTHEN, warmup_requests, 1);
+
+    size_t n = (size_t)requests;
+    ok = ok && run_http(&scenarios[0], &http, "/api/generate", 0, n) &&
+         run_unix(&scenarios[1], client, PASSWORD_OP_GENERATE, n, 1) &&
+         run_http(&scenarios[2], &http, "/api/evaluate", 1, n) &&
+         run_unix(&scenarios[3], client, PASSWORD_OP_EVALUATE, n, 1) &&
+         run_http(&scenarios[4], &http, "/api/strengthen", 1, n) &&
+         run_unix(&scenarios[5], client, PASSWORD_OP_STRENGTHEN, n, 1) &&
+         run_unix(&scenarios[6], client, PASSWORD_OP_EVALUATE, n / (size_t)batch + 1, (size_t)batch) &&
+         run_pipelined(&scenarios[7], client, n, (size_t)depth);
+
+    printf("%ld požiadaviek na scenár, dávka %ld hesiel, pipelining %ld rámcov\n\n", requests, batch, depth);
+    print_padded("scenár", 28);
+    printf("  položiek/s    p50 µs    p99 µs\n");
+    for (size_t i = 0; i < scenario_count; i++) {
+        print_scenario(&scenarios[i]);
+        free(scenarios[i].latencies);
+    }
+
+    close(http);
+    password_client_close(client);
+    return ok ? 0 : 1;
+}
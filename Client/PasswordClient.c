@@ -0,0 +1,367 @@
+#include "PasswordClient.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Počiatočná veľkosť vstupného aj výstupného buffera klienta
+#define CLIENT_BUFFER_SIZE 4096
+
+struct PasswordClient {
+    int fd;                      // Socket alebo -1 po chybe spojenia.
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    uint32_t next_id;            // Číslo ďalšej požiadavky.
+    unsigned int outstanding;    // Zaradené alebo odoslané požiadavky bez odpovede.
+    int status;                  // Stav poslednej odpovede, -1 po chybe spojenia.
+    unsigned char *out;          // Zaradené, ešte neodoslané rámce.
+    size_t out_length;
+    size_t out_capacity;
+    unsigned char *in;           // Prijaté dáta; od `in_start` ďalšie odpovede.
+    size_t in_start;
+    size_t in_length;
+    size_t in_capacity;
+};
+
+/**
+ * @brief Zväčší buffer tak, aby mal aspoň `needed` bajtov.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+static int client_reserve(unsigned char **data, size_t *capacity, size_t needed) {
+    if (needed <= *capacity) return 1;
+    size_t new_capacity = *capacity ? *capacity : CLIENT_BUFFER_SIZE;
+    while (new_capacity < needed) new_capacity *= 2;
+    unsigned char *grown = (unsigned char *)realloc(*data, new_capacity);
+    if (!grown) return 0;
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+/**
+ * @brief Otvorí spojenie na socket servera.
+ *
+ * @return 1 pri úspechu, 0 pri chybe (errno nastavené).
+ */
+static int client_open(PasswordClient *client) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, client->path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return 0;
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return 0;
+    }
+    client->fd = fd;
+    return 1;
+}
+
+/**
+ * @brief Zavrie pokazené spojenie a zahodí všetko rozpracované.
+ *
+ * @return Vždy 0, aby sa dalo písať `return client_fail(client);`.
+ */
+static int client_fail(PasswordClient *client) {
+    if (client->fd >= 0) {
+        close(client->fd);
+        client->fd = -1;
+    }
+    client->status = -1;
+    client->outstanding = 0;
+    client->out_length = 0;
+    client->in_start = client->in_length = 0;
+    return 0;
+}
+
+PasswordClient *password_client_connect(const char *path) {
+    PasswordClient *client = (PasswordClient *)calloc(1, sizeof(PasswordClient));
+    if (!client) return NULL;
+    if (strlen(path) >= sizeof(client->path)) {
+        free(client);
+        errno = ENAMETOOLONG;
+        return NULL;
+    }
+    strcpy(client->path, path);
+    client->next_id = 1;
+    if (!client_open(client)) {
+        int saved = errno;
+        free(client);
+        errno = saved;
+        return NULL;
+    }
+    return client;
+}
+
+void password_client_close(PasswordClient *client) {
+    if (!client) return;
+    if (client->fd >= 0) close(client->fd);
+    free(client->out);
+    free(client->in);
+    free(client);
+}
+
+int password_client_status(const PasswordClient *client) {
+    return client->status;
+}
+
+/**
+ * @brief Zaradí hlavičku rámca a vráti miesto pre jeho payload.
+ *
+ * @return 1 pri úspechu, 0 pri chybe alokácie.
+ */
+static int client_queue(PasswordClient *client, int opcode, unsigned int flags, size_t count,
+                        size_t payload_length, uint32_t *request_id, unsigned char **payload) {
+    if (!client_reserve(&client->out, &client->out_capacity,
+                        client->out_length + sizeof(PasswordFrameHeader) + payload_length)) {
+        return 0;
+    }
+    PasswordFrameHeader header;
+    header.length = (uint32_t)payload_length;
+    header.request_id = client->next_id++;
+    header.opcode = (uint8_t)opcode;
+    header.flags = (uint8_t)flags;
+    header.count = (uint16_t)count;
+    memcpy(client->out + client->out_length, &header, sizeof(header));
+    *payload = client->out + client->out_length + sizeof(header);
+    client->out_length += sizeof(header) + payload_length;
+    client->outstanding++;
+    if (request_id) *request_id = header.request_id;
+    return 1;
+}
+
+int password_client_submit_generate(PasswordClient *client, size_t count, int length, int policy_id,
+                                    unsigned int classes, unsigned int flags, uint32_t *request_id) {
+    if (count > PASSWORD_FRAME_MAX_COUNT || length < 0 || length > 255 || policy_id < 0 || policy_id > 255) {
+        return 0;
+    }
+    unsigned char *payload;
+    if (!client_queue(client, PASSWORD_OP_GENERATE, flags, count, 4, request_id, &payload)) return 0;
+    payload[0] = (unsigned char)length;
+    payload[1] = (unsigned char)policy_id;
+    payload[2] = (unsigned char)classes;
+    payload[3] = 0;
+    return 1;
+}
+
+int password_client_submit_passwords(PasswordClient *client, int opcode, size_t count,
+                                     const char *const *passwords, const size_t *lengths,
+                                     uint32_t *request_id) {
+    if ((opcode != PASSWORD_OP_EVALUATE && opcode != PASSWORD_OP_STRENGTHEN) ||
+        count > PASSWORD_FRAME_MAX_COUNT || (count > 0 && !passwords)) {
+        return 0;
+    }
+    size_t payload_length = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t length = lengths ? lengths[i] : strlen(passwords[i]);
+        if (length > UINT16_MAX) return 0;
+        payload_length += sizeof(uint16_t) + length;
+    }
+    if (payload_length > PASSWORD_FRAME_MAX_PAYLOAD) return 0;
+
+    unsigned char *payload;
+    if (!client_queue(client, opcode, 0, count, payload_length, request_id, &payload)) return 0;
+    for (size_t i = 0; i < count; i++) {
+        uint16_t length = (uint16_t)(lengths ? lengths[i] : strlen(passwords[i]));
+        memcpy(payload, &length, sizeof(length));
+        memcpy(payload + sizeof(length), passwords[i], length);
+        payload += sizeof(length) + length;
+    }
+    return 1;
+}
+
+/**
+ * @brief Odošle všetky zaradené rámce.
+ *
+ * @return 1 pri úspechu, 0 pri chybe spojenia.
+ */
+static int client_flush(PasswordClient *client) {
+    size_t sent = 0;
+    if (client->fd < 0) return 0;
+    while (sent < client->out_length) {
+        ssize_t written = send(client->fd, client->out + sent, client->out_length - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        sent += (size_t)written;
+    }
+    client->out_length = 0;
+    return 1;
+}
+
+int password_client_receive(PasswordClient *client, PasswordClientResponse *response) {
+    if (!client_flush(client)) return client_fail(client);
+
+    // Payload predchádzajúcej odpovede už nie je potrebný.
+    if (client->in_start > 0) {
+        memmove(client->in, client->in + client->in_start, client->in_length - client->in_start);
+        client->in_length -= client->in_start;
+        client->in_start = 0;
+    }
+
+    PasswordFrameHeader header;
+    size_t needed = sizeof(header);
+    while (1) {
+        if (client->in_length >= sizeof(header)) {
+            memcpy(&header, client->in, sizeof(header));
+            if (header.length > PASSWORD_FRAME_MAX_PAYLOAD) {
+                errno = EPROTO;
+                return client_fail(client);
+            }
+            needed = sizeof(header) + header.length;
+            if (client->in_length >= needed) break;
+        }
+        if (!client_reserve(&client->in, &client->in_capacity, needed > CLIENT_BUFFER_SIZE ? needed : CLIENT_BUFFER_SIZE)) {
+            return client_fail(client);
+        }
+        ssize_t received = recv(client->fd, client->in + client->in_length, client->in_capacity - client->in_length, 0);
+        if (received > 0) {
+            client->in_length += (size_t)received;
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        if (received == 0) errno = ECONNRESET;
+        return client_fail(client);
+    }
+
+    response->request_id = header.request_id;
+    response->opcode = header.opcode;
+    response->status = header.flags;
+    response->count = header.count;
+    response->payload = client->in + sizeof(header);
+    response->length = header.length;
+    client->in_start = needed;
+    client->status = header.flags;
+    if (client->outstanding > 0) client->outstanding--;
+    return 1;
+}
+
+int password_client_read_evaluations(const PasswordClientResponse *response, const PasswordEvaluations *results) {
+    if (response->status != PASSWORD_STATUS_OK || response->opcode != PASSWORD_OP_EVALUATE ||
+        response->length != (size_t)response->count * sizeof(PasswordFrameEvaluation)) {
+        return 0;
+    }
+    for (size_t i = 0; i < response->count; i++) {
+        PasswordFrameEvaluation evaluation;
+        memcpy(&evaluation, response->payload + i * sizeof(evaluation), sizeof(evaluation));
+        if (results->score) results->score[i] = evaluation.score;
+        if (results->strong) results->strong[i] = evaluation.strong;
+        if (results->reasons) results->reasons[i] = evaluation.reasons;
+        if (results->guesses_log10) results->guesses_log10[i] = evaluation.guesses_log10;
+    }
+    return 1;
+}
+
+int password_client_read_passwords(const PasswordClientResponse *response, char *passwords, size_t stride,
+                                   uint8_t *scores, uint8_t *strong) {
+    if (response->status != PASSWORD_STATUS_OK ||
+        (response->opcode != PASSWORD_OP_GENERATE && response->opcode != PASSWORD_OP_STRENGTHEN)) {
+        return 0;
+    }
+    // Skóre obsahuje len odpoveď na GENERATE s PASSWORD_FLAG_SCORE; volajúci
+    // o ňom vie, lebo si ho vyžiadal.
+    size_t extra = scores || strong ? 2 : 0;
+    const unsigned char *cursor = response->payload;
+    const unsigned char *end = cursor + response->length;
+    for (size_t i = 0; i < response->count; i++) {
+        if (cursor == end) return 0;
+        size_t length = *cursor++;
+        if ((size_t)(end - cursor) < length + extra || length >= stride) return 0;
+        memcpy(passwords + i * stride, cursor, length);
+        passwords[i * stride + length] = '\0';
+        cursor += length;
+        if (extra) {
+            if (scores) scores[i] = cursor[0];
+            if (strong) strong[i] = cursor[1];
+            cursor += extra;
+        }
+    }
+    return cursor == end;
+}
+
+/**
+ * @brief Počká na odpoveď na práve zaradenú požiadavku.
+ *
+ * @return 1 ak odpoveď prišla, 0 pri chybe spojenia.
+ */
+static int client_wait(PasswordClient *client, uint32_t request_id, PasswordClientResponse *response) {
+    if (!password_client_receive(client, response)) return 0;
+    if (response->request_id != request_id) {
+        errno = EPROTO;
+        return client_fail(client);
+    }
+    return 1;
+}
+
+/**
+ * @brief Pripraví spojenie pre synchrónne volanie.
+ *
+ * Po chybe spojenia (aj keď server zavrel nečinné spojenie po
+ * KEEPALIVE_TIMEOUT_MS) sa klient pripojí znova.
+ *
+ * @return 1 ak je spojenie pripravené, 0 ak ešte čakajú iné požiadavky
+ *         alebo sa nepodarilo pripojiť.
+ */
+static int client_ready(PasswordClient *client) {
+    if (client->outstanding > 0) return 0;
+    return client->fd >= 0 || client_open(client);
+}
+
+// Synchrónne volania: ak spojenie zlyhá skôr, ako príde odpoveď (typicky ho
+// server medzičasom zavrel pre nečinnosť), požiadavka sa raz zopakuje na
+// novom spojení. Všetky operácie sú bez vedľajších účinkov, opakovanie je bezpečné.
+
+int password_client_generate(PasswordClient *client, size_t count, int length, int policy_id,
+                             unsigned int classes, char *passwords, size_t stride) {
+    PasswordClientResponse response;
+    uint32_t request_id;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!client_ready(client)) return 0;
+        if (!password_client_submit_generate(client, count, length, policy_id, classes, 0, &request_id)) return 0;
+        if (client_wait(client, request_id, &response)) {
+            return password_client_read_passwords(&response, passwords, stride, NULL, NULL);
+        }
+    }
+    return 0;
+}
+
+int password_client_evaluate(PasswordClient *client, size_t count, const char *const *passwords,
+                             const size_t *lengths, const PasswordEvaluations *results) {
+    PasswordClientResponse response;
+    uint32_t request_id;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!client_ready(client)) return 0;
+        if (!password_client_submit_passwords(client, PASSWORD_OP_EVALUATE, count, passwords, lengths,
+                                              &request_id)) {
+            return 0;
+        }
+        if (client_wait(client, request_id, &response)) {
+            return password_client_read_evaluations(&response, results);
+        }
+    }
+    return 0;
+}
+
+int password_client_strengthen(PasswordClient *client, size_t count, const char *const *passwords,
+                               const size_t *lengths, char *out, size_t stride) {
+    PasswordClientResponse response;
+    uint32_t request_id;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!client_ready(client)) return 0;
+        if (!password_client_submit_passwords(client, PASSWORD_OP_STRENGTHEN, count, passwords, lengths,
+                                              &request_id)) {
+            return 0;
+        }
+        if (client_wait(client, request_id, &response)) {
+            return password_client_read_passwords(&response, out, stride, NULL, NULL);
+        }
+    }
+    return 0;
+}
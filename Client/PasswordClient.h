@@ -0,0 +1,128 @@
+#ifndef PASSWORDCLIENT_H
+#define PASSWORDCLIENT_H
+
+/*
+ * Klient binárneho protokolu servera (libpasswordclient.a).
+ *
+ * Jeden PasswordClient je jedno spojenie na Unix socket servera; nie je
+ * určený na súčasné používanie viacerými vláknami (každé vlákno si otvorí
+ * vlastné). Funkcie password_client_evaluate/generate/strengthen pošlú
+ * požiadavku a počkajú na odpoveď. Funkcie password_client_submit_* len
+ * zaradia rámec, takže sa dá poslať viac požiadaviek naraz a odpovede
+ * potom vyberať cez password_client_receive() podľa `request_id`.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "PasswordProtocol.h"
+#include "LibPassword.h"
+
+// Klient (nepriehľadný).
+typedef struct PasswordClient PasswordClient;
+
+// Odpoveď prijatá cez password_client_receive().
+typedef struct {
+    uint32_t request_id;
+    uint8_t opcode;             // PASSWORD_OP_* požiadavky.
+    uint8_t status;             // PASSWORD_STATUS_*.
+    uint16_t count;             // Počet položiek v payloade.
+    const unsigned char *payload; // Platný do ďalšieho volania funkcie klienta.
+    uint32_t length;
+} PasswordClientResponse;
+
+/**
+ * @brief Pripojí sa na Unix socket servera.
+ *
+ * @param path Cesta k socketu (UNIX_SOCKET servera).
+ * @return Klient alebo NULL pri chybe (errno nastavené).
+ */
+PasswordClient *password_client_connect(const char *path);
+
+/**
+ * @brief Zavrie spojenie a uvoľní klienta.
+ */
+void password_client_close(PasswordClient *client);
+
+/**
+ * @brief Stav poslednej odpovede (PASSWORD_STATUS_*), -1 po chybe spojenia.
+ */
+int password_client_status(const PasswordClient *client);
+
+/**
+ * @brief Zaradí požiadavku GENERATE.
+ *
+ * @param length Dĺžka hesiel (mimo 8-128 = predvolená dĺžka politiky).
+ * @param policy_id Číslo politiky (GET /api/policies), 0 = podľa `classes`.
+ * @param classes PASSWORD_CLASS_* pre heslá bez politiky.
+ * @param flags PASSWORD_FLAG_*.
+ * @param request_id Dostane číslo požiadavky (môže byť NULL).
+ * @return 1 pri úspechu, 0 pri neplatných parametroch alebo chybe alokácie.
+ */
+int password_client_submit_generate(PasswordClient *client, size_t count, int length, int policy_id,
+                                    unsigned int classes, unsigned int flags, uint32_t *request_id);
+
+/**
+ * @brief Zaradí požiadavku EVALUATE alebo STRENGTHEN s heslami.
+ *
+ * @param lengths Dĺžky hesiel alebo NULL pre reťazce ukončené nulou.
+ * @return 1 pri úspechu, 0 pri neplatných parametroch alebo chybe alokácie.
+ */
+int password_client_submit_passwords(PasswordClient *client, int opcode, size_t count,
+                                     const char *const *passwords, const size_t *lengths,
+                                     uint32_t *request_id);
+
+/**
+ * @brief Odošle zaradené požiadavky a počká na ďalšiu odpoveď.
+ *
+ * @return 1 pri úspechu, 0 pri chybe spojenia alebo chybnom rámci.
+ */
+int password_client_receive(PasswordClient *client, PasswordClientResponse *response);
+
+/**
+ * @brief Prečíta výsledky z odpovede EVALUATE do polí volajúceho.
+ *
+ * @return 1 pri úspechu, 0 ak odpoveď nie je úspešná odpoveď EVALUATE.
+ */
+int password_client_read_evaluations(const PasswordClientResponse *response, const PasswordEvaluations *results);
+
+/**
+ * @brief Prečíta heslá z odpovede GENERATE alebo STRENGTHEN.
+ *
+ * i-te heslo sa zapíše na `passwords + i * stride` a ukončí nulou.
+ *
+ * @param scores Skóre (len GENERATE s PASSWORD_FLAG_SCORE), inak NULL.
+ * @param strong Príznaky silného hesla (ako `scores`), inak NULL.
+ * @return 1 pri úspechu, 0 pri chybnej odpovedi alebo malom `stride`.
+ */
+int password_client_read_passwords(const PasswordClientResponse *response, char *passwords, size_t stride,
+                                   uint8_t *scores, uint8_t *strong);
+
+/**
+ * @brief Vygeneruje `count` hesiel (najviac PASSWORD_FRAME_MAX_COUNT).
+ *
+ * @param stride Vzdialenosť hesiel v `passwords`, aspoň dĺžka hesla + 1.
+ * @return 1 pri úspechu, inak 0 (príčinu vráti password_client_status()).
+ */
+int password_client_generate(PasswordClient *client, size_t count, int length, int policy_id,
+                             unsigned int classes, char *passwords, size_t stride);
+
+/**
+ * @brief Vyhodnotí `count` hesiel (najviac PASSWORD_FRAME_MAX_COUNT).
+ *
+ * @param lengths Dĺžky hesiel alebo NULL pre reťazce ukončené nulou.
+ * @param results Polia s aspoň `count` prvkami (nepotrebné môžu byť NULL).
+ * @return 1 pri úspechu, inak 0 (príčinu vráti password_client_status()).
+ */
+int password_client_evaluate(PasswordClient *client, size_t count, const char *const *passwords,
+                             const size_t *lengths, const PasswordEvaluations *results);
+
+/**
+ * @brief Vylepší `count` hesiel (najviac PASSWORD_FRAME_MAX_COUNT).
+ *
+ * @param stride Vzdialenosť výsledkov v `out`, aspoň 129 bajtov.
+ * @return 1 pri úspechu, inak 0 (príčinu vráti password_client_status()).
+ */
+int password_client_strengthen(PasswordClient *client, size_t count, const char *const *passwords,
+                               const size_t *lengths, char *out, size_t stride);
+
+#endif // PASSWORDCLIENT_H
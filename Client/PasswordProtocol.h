@@ -0,0 +1,80 @@
+#ifndef PASSWORDPROTOCOL_H
+#define PASSWORDPROTOCOL_H
+
+/*
+ * Binárny protokol pre klientov na tom istom stroji (Unix domain socket,
+ * premenná UNIX_SOCKET servera).
+ *
+ * Klient aj server bežia na jednom stroji, preto sú všetky čísla v poradí
+ * bajtov stroja. Požiadavka aj odpoveď je rámec:
+ *
+ *   PasswordFrameHeader                  12 bajtov
+ *   payload[length]
+ *
+ * Klient môže poslať viac rámcov bez čakania na odpovede. Server ich vybaví
+ * v poradí prijatia a odpoveď označí `request_id` a `opcode` požiadavky.
+ *
+ * Payload požiadaviek (`count` je počet položiek, najviac PASSWORD_FRAME_MAX_COUNT):
+ *   GENERATE    uint8_t length, policy_id, classes, reserved
+ *               (length mimo 8-128 = predvolená dĺžka politiky,
+ *                policy_id 0 = politika podľa `classes`, PASSWORD_CLASS_*)
+ *   EVALUATE    count × (uint16_t length, bajty hesla)
+ *   STRENGTHEN  count × (uint16_t length, bajty hesla)
+ *
+ * Payload odpovede so stavom PASSWORD_STATUS_OK (pri chybe je prázdny):
+ *   GENERATE    count × (uint8_t length, heslo), s PASSWORD_FLAG_SCORE
+ *               za každým heslom ešte uint8_t score, strong
+ *   EVALUATE    count × PasswordFrameEvaluation
+ *   STRENGTHEN  count × (uint8_t length, heslo)
+ */
+
+#include <stdint.h>
+
+// Veľkosť hlavičky rámca v bajtoch
+#define PASSWORD_FRAME_HEADER_SIZE 12
+// Najväčší payload jedného rámca (väčší server odmietne a spojenie zavrie)
+#define PASSWORD_FRAME_MAX_PAYLOAD (1024 * 1024)
+// Najviac položiek v jednom rámci
+#define PASSWORD_FRAME_MAX_COUNT 1024
+
+// Operácie.
+#define PASSWORD_OP_GENERATE   1
+#define PASSWORD_OP_EVALUATE   2
+#define PASSWORD_OP_STRENGTHEN 3
+
+// Príznaky požiadavky (pole `flags` hlavičky).
+#define PASSWORD_FLAG_SCORE 0x01   // GENERATE: ku každému heslu aj skóre.
+
+// Triedy znakov pre GENERATE bez politiky.
+#define PASSWORD_CLASS_LOWER   0x01
+#define PASSWORD_CLASS_UPPER   0x02
+#define PASSWORD_CLASS_DIGIT   0x04
+#define PASSWORD_CLASS_SPECIAL 0x08
+
+// Stav odpovede (pole `flags` hlavičky odpovede).
+#define PASSWORD_STATUS_OK                0
+#define PASSWORD_STATUS_BAD_REQUEST       1   // Chybný payload alebo parametre.
+#define PASSWORD_STATUS_UNKNOWN_OPERATION 2
+#define PASSWORD_STATUS_TOO_LARGE         3   // Priveľa položiek alebo priveľký rámec.
+#define PASSWORD_STATUS_OVERLOADED        4   // Server je preťažený (MAX_IN_FLIGHT).
+#define PASSWORD_STATUS_INTERNAL          5   // Napr. chyba alokácie.
+
+// Hlavička rámca požiadavky aj odpovede.
+typedef struct {
+    uint32_t length;            // Dĺžka payloadu za hlavičkou.
+    uint32_t request_id;        // Ľubovoľné číslo klienta; odpoveď ho zopakuje.
+    uint8_t opcode;             // PASSWORD_OP_*.
+    uint8_t flags;              // Požiadavka: PASSWORD_FLAG_*, odpoveď: PASSWORD_STATUS_*.
+    uint16_t count;             // Počet položiek payloadu.
+} PasswordFrameHeader;
+
+// Výsledok vyhodnotenia jedného hesla v odpovedi EVALUATE.
+typedef struct {
+    uint32_t reasons;           // PASSWORD_REASON_* (Logic/LibPassword.h).
+    float guesses_log10;        // log10 odhadu počtu pokusov.
+    uint8_t score;              // Skóre 0-100.
+    uint8_t strong;             // 1 ak je heslo silné.
+    uint16_t reserved;
+} PasswordFrameEvaluation;
+
+#endif // PASSWORDPROTOCOL_H
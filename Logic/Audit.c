@@ -0,0 +1,364 @@
+#include "Audit.h"
+#include "Password.h"
+#include "Breach.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Horná hranica počtu vlákien auditu
+#define AUDIT_MAX_THREADS 256
+
+// Časť vstupu spracovaná jedným vláknom.
+typedef struct {
+    const char *start;          // Prvý bajt (začiatok riadku).
+    const char *end;            // Za posledným bajtom.
+    AuditOutputFormat format;
+    FILE *output;               // Dočasný súbor s výsledkami riadkov (alebo NULL).
+    char *buffer;               // Buffer pre výsledky pred zápisom do `output`.
+    size_t buffered;
+    int failed;                 // Zlyhal zápis výsledkov.
+    AuditStats stats;
+} AuditChunk;
+
+static double audit_now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Zapíše obsah buffera vlákna do jeho dočasného súboru.
+ */
+static void audit_flush(AuditChunk *chunk) {
+    if (chunk->buffered > 0 && fwrite(chunk->buffer, 1, chunk->buffered, chunk->output) != chunk->buffered) {
+        chunk->failed = 1;
+    }
+    chunk->buffered = 0;
+}
+
+/**
+ * @brief Zapíše číslo bez znamienka v desiatkovej sústave.
+ *
+ * @return Ukazovateľ za posledným zapísaným znakom.
+ */
+static char *audit_format_uint(char *out, uint64_t value) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    return out;
+}
+
+/**
+ * @brief Pridá výsledok jedného riadku do výstupu vlákna.
+ */
+static void audit_emit(AuditChunk *chunk, const CharClassStats *classes, const PasswordStrength *result) {
+    // Najdlhší CSV riadok: "100,1,<20 číslic>,ludso\n"
+    if (AUDIT_OUTPUT_BUFFER_SIZE - chunk->buffered < 64) {
+        audit_flush(chunk);
+    }
+    char *out = chunk->buffer + chunk->buffered;
+
+    if (chunk->format == AUDIT_OUTPUT_BINARY) {
+        AuditRecord record;
+        record.score = (uint8_t)result->score;
+        record.is_strong = (uint8_t)result->is_strong;
+        record.classes = (uint8_t)classes->mask;
+        record.length = classes->length > 255 ? 255 : (uint8_t)classes->length;
+        memcpy(out, &record, sizeof(record));
+        chunk->buffered += sizeof(record);
+        return;
+    }
+
+    static const char class_letters[CHAR_CLASS_COUNT] = {'l', 'u', 'd', 's', 'o'};
+    char *start = out;
+    out = audit_format_uint(out, (uint64_t)result->score);
+    *out++ = ',';
+    *out++ = result->is_strong ? '1' : '0';
+    *out++ = ',';
+    out = audit_format_uint(out, classes->length);
+    *out++ = ',';
+    for (int k = 0; k < CHAR_CLASS_COUNT; k++) {
+        if (classes->mask & (1u << k)) *out++ = class_letters[k];
+    }
+    *out++ = '\n';
+    chunk->buffered += (size_t)(out - start);
+}
+
+/**
+ * @brief Vyhodnotí všetky neprázdne riadky svojej časti vstupu.
+ */
+static void *audit_worker(void *arg) {
+    AuditChunk *chunk = (AuditChunk *)arg;
+    AuditStats *stats = &chunk->stats;
+    const char *line = chunk->start;
+
+    while (line < chunk->end) {
+        const char *newline = memchr(line, '\n', (size_t)(chunk->end - line));
+        const char *line_end = newline ? newline : chunk->end;
+        size_t length = (size_t)(line_end - line);
+        if (length > 0 && line[length - 1] == '\r') length--;
+        if (length == 0) {
+            line = newline ? newline + 1 : chunk->end;
+            continue;
+        }
+
+        CharClassStats classes;
+        PasswordStrength result;
+        classify_bytes(line, length, &classes);
+        // Rovnaké kontroly ako /api/evaluate, aby audit dal rovnaké skóre ako server.
+        evaluate_classified_password(line, length, &classes, PASSWORD_CHECK_ALL, &result);
+        if (result.reasons & PASSWORD_REASON_BREACHED) stats->breached++;
+
+        stats->lines++;
+        stats->total_length += length;
+        if (!result.is_strong) stats->weak++;
+        stats->score_histogram[result.score > AUDIT_MAX_SCORE ? AUDIT_MAX_SCORE : result.score]++;
+        for (int k = 0; k < CHAR_CLASS_COUNT; k++) {
+            if (classes.mask & (1u << k)) stats->class_lines[k]++;
+        }
+        unsigned int required = CHAR_CLASS_LOWER | CHAR_CLASS_UPPER | CHAR_CLASS_DIGIT | CHAR_CLASS_SPECIAL;
+        if ((classes.mask & required) == required) stats->all_classes++;
+
+        if (chunk->output) {
+            audit_emit(chunk, &classes, &result);
+        }
+        line = newline ? newline + 1 : chunk->end;
+    }
+
+    if (chunk->output) {
+        audit_flush(chunk);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Otvorí dočasný súbor vedľa výstupného súboru (nie v /tmp, ktorý
+ *        môže byť v pamäti). Súbor sa hneď odstráni z adresára.
+ */
+static FILE *audit_temp_file(const char *output_path) {
+    size_t length = strlen(output_path);
+    char *template = (char *)malloc(length + 8);
+    if (!template) return NULL;
+    memcpy(template, output_path, length);
+    memcpy(template + length, ".XXXXXX", 8);
+
+    int fd = mkstemp(template);
+    if (fd < 0) {
+        perror(template);
+        free(template);
+        return NULL;
+    }
+    unlink(template);
+    free(template);
+
+    FILE *file = fdopen(fd, "w+b");
+    if (!file) close(fd);
+    return file;
+}
+
+/**
+ * @brief Spojí dočasné súbory vlákien do výstupného súboru v poradí vstupu.
+ */
+static int audit_merge_output(AuditChunk *chunks, int count, const char *output_path, AuditOutputFormat format) {
+    FILE *output = fopen(output_path, "wb");
+    if (!output) {
+        perror(output_path);
+        return 0;
+    }
+    if (format == AUDIT_OUTPUT_CSV) {
+        fputs("score,strong,length,classes\n", output);
+    }
+
+    char *buffer = chunks[0].buffer;
+    int ok = 1;
+    for (int i = 0; i < count && ok; i++) {
+        rewind(chunks[i].output);
+        size_t read_bytes;
+        while ((read_bytes = fread(buffer, 1, AUDIT_OUTPUT_BUFFER_SIZE, chunks[i].output)) > 0) {
+            if (fwrite(buffer, 1, read_bytes, output) != read_bytes) {
+                ok = 0;
+                break;
+            }
+        }
+    }
+    if (fclose(output) != 0) ok = 0;
+    if (!ok) perror(output_path);
+    return ok;
+}
+
+/**
+ * @brief Pripočíta štatistiku jedného vlákna k celkovej.
+ */
+static void audit_stats_add(AuditStats *total, const AuditStats *part) {
+    total->lines += part->lines;
+    total->weak += part->weak;
+    total->breached += part->breached;
+    total->all_classes += part->all_classes;
+    total->total_length += part->total_length;
+    for (int s = 0; s <= AUDIT_MAX_SCORE; s++) {
+        total->score_histogram[s] += part->score_histogram[s];
+    }
+    for (int k = 0; k < CHAR_CLASS_COUNT; k++) {
+        total->class_lines[k] += part->class_lines[k];
+    }
+}
+
+static double audit_percent(uint64_t part, uint64_t total) {
+    return total > 0 ? 100.0 * (double)part / (double)total : 0.0;
+}
+
+/**
+ * @brief Vypíše súhrnnú štatistiku auditu.
+ */
+static void audit_print_stats(const AuditStats *stats, const char *path, int threads, double seconds) {
+    static const char *class_names[CHAR_CLASS_COUNT] = {
+        "malé písmená", "veľké písmená", "číslice", "špeciálne znaky", "iné znaky"
+    };
+
+    printf("Audit súboru: %s\n", path);
+    printf("Riadkov: %llu, vlákien: %d, čas: %.3f s, priepustnosť: %.0f riadkov/s\n",
+           (unsigned long long)stats->lines, threads, seconds,
+           seconds > 0 ? (double)stats->lines / seconds : 0.0);
+    printf("Slabé heslá: %llu (%.2f %%)\n", (unsigned long long)stats->weak,
+           audit_percent(stats->weak, stats->lines));
+    if (breach_index_count() > 0) {
+        printf("Uniknuté heslá: %llu (%.2f %%)\n", (unsigned long long)stats->breached,
+               audit_percent(stats->breached, stats->lines));
+    }
+    printf("Priemerná dĺžka: %.2f\n",
+           stats->lines > 0 ? (double)stats->total_length / (double)stats->lines : 0.0);
+
+    printf("\nPokrytie tried znakov:\n");
+    for (int k = 0; k < CHAR_CLASS_COUNT; k++) {
+        printf("  %12llu  %6.2f %%  %s\n", (unsigned long long)stats->class_lines[k],
+               audit_percent(stats->class_lines[k], stats->lines), class_names[k]);
+    }
+    printf("  %12llu  %6.2f %%  %s\n", (unsigned long long)stats->all_classes,
+           audit_percent(stats->all_classes, stats->lines), "všetky štyri");
+
+    printf("\nHistogram skóre:\n");
+    for (int s = 0; s <= AUDIT_MAX_SCORE; s++) {
+        uint64_t count = stats->score_histogram[s];
+        if (count == 0) continue;
+        double percent = audit_percent(count, stats->lines);
+        char bar[51];
+        int width = (int)(percent / 2.0);
+        memset(bar, '#', (size_t)width);
+        bar[width] = '\0';
+        printf("  %3d %12llu  %6.2f %%  %s\n", s, (unsigned long long)count, percent, bar);
+    }
+}
+
+int audit_run(const AuditOptions *options) {
+    int fd = open(options->input_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(options->input_path);
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        perror("fstat");
+        close(fd);
+        return 0;
+    }
+
+    size_t size = (size_t)info.st_size;
+    const char *data = NULL;
+    if (size > 0) {
+        data = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            perror("mmap");
+            close(fd);
+            return 0;
+        }
+        madvise((void *)data, size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    int threads = options->threads > 0 ? options->threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > AUDIT_MAX_THREADS) threads = AUDIT_MAX_THREADS;
+    // Malé súbory nemá zmysel deliť na veľa častí.
+    if ((size_t)threads > size / 4096 + 1) threads = (int)(size / 4096 + 1);
+
+    AuditChunk *chunks = (AuditChunk *)calloc((size_t)threads, sizeof(AuditChunk));
+    pthread_t *handles = (pthread_t *)calloc((size_t)threads, sizeof(pthread_t));
+    if (!chunks || !handles) {
+        free(chunks);
+        free(handles);
+        if (data) munmap((void *)data, size);
+        return 0;
+    }
+
+    // Rozdelenie na časti s približne rovnakou veľkosťou; hranica sa posunie
+    // za najbližší koniec riadku, aby žiadny riadok nebol rozdelený.
+    size_t previous = 0;
+    for (int i = 0; i < threads; i++) {
+        size_t boundary = i + 1 == threads ? size : size / (size_t)threads * (size_t)(i + 1);
+        if (boundary < previous) boundary = previous;
+        if (boundary < size && boundary > 0 && data[boundary - 1] != '\n') {
+            const char *newline = memchr(data + boundary, '\n', size - boundary);
+            boundary = newline ? (size_t)(newline - data) + 1 : size;
+        }
+        chunks[i].start = data + previous;
+        chunks[i].end = data + boundary;
+        chunks[i].format = options->output_format;
+        previous = boundary;
+    }
+
+    int ok = 1;
+    if (options->output_format != AUDIT_OUTPUT_NONE) {
+        for (int i = 0; i < threads && ok; i++) {
+            chunks[i].output = audit_temp_file(options->output_path);
+            chunks[i].buffer = (char *)malloc(AUDIT_OUTPUT_BUFFER_SIZE);
+            if (!chunks[i].output || !chunks[i].buffer) ok = 0;
+        }
+    }
+
+    double started = audit_now_seconds();
+    int started_threads = 0;
+    for (int i = 0; i < threads && ok; i++) {
+        if (pthread_create(&handles[i], NULL, audit_worker, &chunks[i]) != 0) {
+            perror("pthread_create");
+            ok = 0;
+            break;
+        }
+        started_threads++;
+    }
+
+    AuditStats total;
+    memset(&total, 0, sizeof(total));
+    for (int i = 0; i < started_threads; i++) {
+        pthread_join(handles[i], NULL);
+        audit_stats_add(&total, &chunks[i].stats);
+        if (chunks[i].failed) ok = 0;
+    }
+    double elapsed = audit_now_seconds() - started;
+
+    if (ok && options->output_format != AUDIT_OUTPUT_NONE) {
+        ok = audit_merge_output(chunks, threads, options->output_path, options->output_format);
+    }
+    if (ok) {
+        audit_print_stats(&total, options->input_path, threads, elapsed);
+    } else {
+        fprintf(stderr, "Audit zlyhal.\n");
+    }
+
+    for (int i = 0; i < threads; i++) {
+        if (chunks[i].output) fclose(chunks[i].output);
+        free(chunks[i].buffer);
+    }
+    free(chunks);
+    free(handles);
+    if (data) munmap((void *)data, size);
+    return ok;
+}
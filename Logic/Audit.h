@@ -0,0 +1,60 @@
+#ifndef AUDIT_H
+#define AUDIT_H
+
+#include <stdint.h>
+#include "Classify.h"
+
+// Najvyššie možné skóre (veľkosť histogramu je AUDIT_MAX_SCORE + 1)
+#define AUDIT_MAX_SCORE 100
+// Veľkosť buffera pre zápis výsledkov jedného vlákna
+#define AUDIT_OUTPUT_BUFFER_SIZE (1024 * 1024)
+
+// Formát výsledkov pre jednotlivé riadky.
+typedef enum {
+    AUDIT_OUTPUT_NONE,      // Len súhrnná štatistika.
+    AUDIT_OUTPUT_CSV,       // Riadok "score,strong,length,classes" pre každé heslo.
+    AUDIT_OUTPUT_BINARY     // 4-bajtový záznam AuditRecord pre každé heslo.
+} AuditOutputFormat;
+
+// Binárny záznam výsledku jedného riadku. Záznamy sú v rovnakom poradí ako
+// neprázdne riadky vstupu (prázdne riadky záznam nemajú).
+typedef struct {
+    uint8_t score;          // Skóre 0-100.
+    uint8_t is_strong;      // 1 ak je heslo silné.
+    uint8_t classes;        // Maska tried znakov (CHAR_CLASS_*).
+    uint8_t length;         // Dĺžka v bajtoch (najviac 255).
+} AuditRecord;
+
+// Nastavenia auditu.
+typedef struct {
+    const char *input_path;         // Súbor s heslami, jedno na riadok.
+    const char *output_path;        // Súbor pre výsledky riadkov (ak format != NONE).
+    AuditOutputFormat output_format;
+    int threads;                    // Počet vlákien (0 = počet jadier).
+} AuditOptions;
+
+// Súhrnná štatistika auditu.
+typedef struct {
+    uint64_t lines;                                 // Počet vyhodnotených riadkov.
+    uint64_t weak;                                  // Počet hesiel, ktoré nie sú silné.
+    uint64_t breached;                              // Počet hesiel nájdených v indexe uniknutých hesiel.
+    uint64_t score_histogram[AUDIT_MAX_SCORE + 1];  // Počet hesiel s daným skóre.
+    uint64_t class_lines[CHAR_CLASS_COUNT];         // Počet hesiel obsahujúcich danú triedu.
+    uint64_t all_classes;                           // Počet hesiel so všetkými štyrmi triedami.
+    uint64_t total_length;                          // Súčet dĺžok (pre priemer).
+} AuditStats;
+
+/**
+ * @brief Vyhodnotí všetky heslá zo súboru a vypíše štatistiku na stdout.
+ *
+ * Súbor sa namapuje do pamäte a rozdelí na časti podľa počtu vlákien;
+ * každé vlákno hodnotí svoje riadky priamo v namapovanej pamäti bez
+ * alokácie na riadok. Koncové `\r` sa ignoruje a prázdne riadky sa
+ * preskočia, rovnako ako pri zostavovaní indexu a Markovovho modelu.
+ *
+ * @param options Nastavenia auditu.
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int audit_run(const AuditOptions *options);
+
+#endif // AUDIT_H
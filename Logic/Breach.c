@@ -0,0 +1,486 @@
+#include "Breach.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Horná hranica počtu vlákien pri zostavovaní indexu
+#define BREACH_MAX_THREADS 256
+// Vedierka do tejto veľkosti sa triedia vkladaním
+#define BREACH_INSERTION_SORT_LIMIT 32
+
+// Namapovaný index. Nastaví sa raz pri štarte a potom sa len číta.
+typedef struct {
+    const BreachIndexHeader *header;
+    const uint32_t *offsets;
+    const uint32_t *suffixes;
+    size_t size;
+} BreachIndex;
+
+static BreachIndex breach_index;
+
+// Časť vstupu hašovaná jedným vláknom pri zostavovaní indexu.
+typedef struct {
+    const char *start;          // Prvý bajt (začiatok riadku).
+    const char *end;            // Za posledným bajtom.
+    uint64_t *keys;             // Miesto pre kľúče (aspoň toľko, koľko má časť riadkov).
+    size_t count;               // Počet zapísaných kľúčov.
+} BreachChunk;
+
+// --- SHA-1 ---
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/**
+ * @brief Spracuje jeden 64-bajtový blok SHA-1.
+ */
+static void sha1_block(uint32_t state[5], const unsigned char *block) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16 |
+               (uint32_t)block[4 * i + 2] << 8 | (uint32_t)block[4 * i + 3];
+    }
+    for (int i = 16; i < 80; i++) {
+        w[i] = ROTL32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    // Štyri fázy po 20 krokov; oddelené cykly nemajú vetvenie v každom kroku.
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+#define SHA1_STEP(f, k, i) do {                                 \
+        uint32_t temp = ROTL32(a, 5) + (f) + e + (k) + w[i];    \
+        e = d;                                                  \
+        d = c;                                                  \
+        c = ROTL32(b, 30);                                      \
+        b = a;                                                  \
+        a = temp;                                               \
+    } while (0)
+    for (int i = 0; i < 20; i++) SHA1_STEP(d ^ (b & (c ^ d)), 0x5A827999, i);
+    for (int i = 20; i < 40; i++) SHA1_STEP(b ^ c ^ d, 0x6ED9EBA1, i);
+    for (int i = 40; i < 60; i++) SHA1_STEP((b & c) | (d & (b | c)), 0x8F1BBCDC, i);
+    for (int i = 60; i < 80; i++) SHA1_STEP(b ^ c ^ d, 0xCA62C1D6, i);
+#undef SHA1_STEP
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+}
+
+/**
+ * @brief Vypočíta kľúč hesla: prvých 64 bitov jeho SHA-1 (big-endian).
+ */
+static uint64_t breach_key(const char *data, size_t length) {
+    uint32_t state[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    const unsigned char *p = (const unsigned char *)data;
+    size_t remaining = length;
+    while (remaining >= 64) {
+        sha1_block(state, p);
+        p += 64;
+        remaining -= 64;
+    }
+
+    // Posledný blok s doplnením: 0x80, nuly a dĺžka v bitoch (jeden alebo dva bloky).
+    unsigned char block[128];
+    size_t padded = remaining + 9 <= 64 ? 64 : 128;
+    memcpy(block, p, remaining);
+    block[remaining] = 0x80;
+    memset(block + remaining + 1, 0, padded - remaining - 1);
+    uint64_t bits = (uint64_t)length * 8;
+    for (int i = 0; i < 8; i++) {
+        block[padded - 1 - i] = (unsigned char)(bits >> (8 * i));
+    }
+    sha1_block(state, block);
+    if (padded == 128) sha1_block(state, block + 64);
+
+    return (uint64_t)state[0] << 32 | state[1];
+}
+
+// --- Vyhľadávanie ---
+
+int breach_index_open(const char *path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(path);
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0 || (size_t)info.st_size < sizeof(BreachIndexHeader)) {
+        fprintf(stderr, "%s: neplatný index uniknutých hesiel\n", path);
+        close(fd);
+        return 0;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("mmap");
+        return 0;
+    }
+
+    // Kontrola hlavičky a veľkosti súboru, aby vyhľadávanie nesiahlo mimo mapy.
+    const BreachIndexHeader *header = (const BreachIndexHeader *)data;
+    uint64_t buckets = header->prefix_bits >= BREACH_MIN_PREFIX_BITS &&
+                       header->prefix_bits <= BREACH_MAX_PREFIX_BITS
+                       ? (uint64_t)1 << header->prefix_bits : 0;
+    uint64_t expected = sizeof(BreachIndexHeader) + (buckets + 1) * sizeof(uint32_t) +
+                        header->count * sizeof(uint32_t);
+    const uint32_t *offsets = (const uint32_t *)(header + 1);
+    if (memcmp(header->magic, BREACH_INDEX_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != BREACH_INDEX_VERSION || buckets == 0 ||
+        header->count > UINT32_MAX || expected != size || offsets[buckets] != header->count) {
+        fprintf(stderr, "%s: neplatný index uniknutých hesiel\n", path);
+        munmap(data, size);
+        return 0;
+    }
+
+    // Vedierka musia byť neklesajúce, inak by vyhľadávanie mohlo čítať mimo poľa.
+    for (uint64_t b = 0; b < buckets; b++) {
+        if (offsets[b] > offsets[b + 1]) {
+            fprintf(stderr, "%s: neplatný index uniknutých hesiel\n", path);
+            munmap(data, size);
+            return 0;
+        }
+    }
+
+    // Prístupy sú náhodné; jadro nech index načíta vopred na pozadí.
+    madvise(data, size, MADV_RANDOM);
+    madvise(data, size, MADV_WILLNEED);
+
+    breach_index.header = header;
+    breach_index.offsets = offsets;
+    breach_index.suffixes = offsets + buckets + 1;
+    breach_index.size = size;
+    return 1;
+}
+
+int breach_index_contains(const char *password, size_t length) {
+    if (!breach_index.header) return 0;
+
+    uint64_t key = breach_key(password, length);
+    unsigned int bits = breach_index.header->prefix_bits;
+    uint64_t bucket = key >> (64 - bits);
+    uint32_t suffix = (uint32_t)(key >> (32 - bits));
+
+    // Binárne vyhľadávanie v rámci vedierka (v priemere BREACH_BUCKET_TARGET záznamov).
+    size_t low = breach_index.offsets[bucket];
+    size_t end = breach_index.offsets[bucket + 1];
+    size_t high = end;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (breach_index.suffixes[middle] < suffix) low = middle + 1;
+        else high = middle;
+    }
+    return low < end && breach_index.suffixes[low] == suffix;
+}
+
+uint64_t breach_index_count(void) {
+    return breach_index.header ? breach_index.header->count : 0;
+}
+
+// --- Zostavenie indexu ---
+
+static int hex_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Rozpozná riadok vo formáte "SHA1HEX" alebo "SHA1HEX:počet".
+ *
+ * @return 1 a kľúč v `key`, ak riadok je haš; 0 ak ide o heslo.
+ */
+static int breach_parse_hash(const char *line, size_t length, uint64_t *key) {
+    if (length < 40 || (length > 40 && line[40] != ':')) return 0;
+    uint64_t value = 0;
+    for (int i = 0; i < 40; i++) {
+        int digit = hex_digit(line[i]);
+        if (digit < 0) return 0;
+        if (i < 16) value = value << 4 | (uint64_t)digit;
+    }
+    *key = value;
+    return 1;
+}
+
+/**
+ * @brief Vypočíta kľúče všetkých neprázdnych riadkov svojej časti vstupu.
+ */
+static void *breach_build_worker(void *arg) {
+    BreachChunk *chunk = (BreachChunk *)arg;
+    const char *line = chunk->start;
+
+    while (line < chunk->end) {
+        const char *newline = memchr(line, '\n', (size_t)(chunk->end - line));
+        const char *line_end = newline ? newline : chunk->end;
+        size_t length = (size_t)(line_end - line);
+        if (length > 0 && line[length - 1] == '\r') length--;
+
+        if (length > 0) {
+            uint64_t key;
+            if (!breach_parse_hash(line, length, &key)) {
+                key = breach_key(line, length);
+            }
+            chunk->keys[chunk->count++] = key;
+        }
+        line = newline ? newline + 1 : chunk->end;
+    }
+    return NULL;
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Zoradí jedno vedierko (väčšinou pár desiatok hodnôt).
+ */
+static void breach_sort_bucket(uint32_t *values, size_t count) {
+    if (count > BREACH_INSERTION_SORT_LIMIT) {
+        qsort(values, count, sizeof(uint32_t), compare_u32);
+        return;
+    }
+    for (size_t i = 1; i < count; i++) {
+        uint32_t value = values[i];
+        size_t j = i;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+/**
+ * @brief Vypočíta kľúče všetkých riadkov súboru paralelne.
+ *
+ * @param count Výstup: počet kľúčov.
+ * @return Pole kľúčov (uvoľní volajúci) alebo NULL pri chybe.
+ */
+static uint64_t *breach_hash_lines(const char *data, size_t size, int threads, size_t *count) {
+    if ((size_t)threads > size / 4096 + 1) threads = (int)(size / 4096 + 1);
+
+    BreachChunk chunks[BREACH_MAX_THREADS];
+    pthread_t handles[BREACH_MAX_THREADS];
+    memset(chunks, 0, sizeof(chunks));
+
+    // Rovnaké delenie ako pri audite: hranica sa posunie za koniec riadku.
+    // Každá časť dostane miesto pre toľko kľúčov, koľko má riadkov.
+    size_t previous = 0;
+    size_t capacity = 0;
+    for (int i = 0; i < threads; i++) {
+        size_t boundary = i + 1 == threads ? size : size / (size_t)threads * (size_t)(i + 1);
+        if (boundary < previous) boundary = previous;
+        if (boundary < size && boundary > 0 && data[boundary - 1] != '\n') {
+            const char *newline = memchr(data + boundary, '\n', size - boundary);
+            boundary = newline ? (size_t)(newline - data) + 1 : size;
+        }
+        chunks[i].start = data + previous;
+        chunks[i].end = data + boundary;
+        previous = boundary;
+
+        size_t lines = 1;
+        const char *p = chunks[i].start;
+        while ((p = memchr(p, '\n', (size_t)(chunks[i].end - p))) != NULL) {
+            lines++;
+            p++;
+        }
+        chunks[i].count = capacity;     // Dočasne: poloha časti v poli kľúčov.
+        capacity += lines;
+    }
+
+    uint64_t *keys = (uint64_t *)malloc(capacity * sizeof(uint64_t));
+    if (!keys) {
+        fprintf(stderr, "Nedostatok pamäte pre %zu kľúčov\n", capacity);
+        return NULL;
+    }
+
+    int started = 0;
+    int ok = 1;
+    for (int i = 0; i < threads; i++) {
+        chunks[i].keys = keys + chunks[i].count;
+        chunks[i].count = 0;
+        if (pthread_create(&handles[i], NULL, breach_build_worker, &chunks[i]) != 0) {
+            perror("pthread_create");
+            ok = 0;
+            break;
+        }
+        started++;
+    }
+
+    // Spojenie kľúčov jednotlivých častí do súvislého poľa.
+    size_t total = 0;
+    for (int i = 0; i < started; i++) {
+        pthread_join(handles[i], NULL);
+        memmove(keys + total, chunks[i].keys, chunks[i].count * sizeof(uint64_t));
+        total += chunks[i].count;
+    }
+    if (!ok) {
+        free(keys);
+        return NULL;
+    }
+    *count = total;
+    return keys;
+}
+
+/**
+ * @brief Zapíše index do dočasného súboru a premenuje ho na `output_path`.
+ *
+ * Bežiaci server môže mať starý index namapovaný; premenovanie ho nezmení,
+ * kým prepísanie na mieste by mu pod rukami zmenilo (alebo skrátilo) dáta.
+ */
+static int breach_write_index(const char *output_path, const BreachIndexHeader *header,
+                              const uint32_t *offsets, size_t buckets, const uint32_t *suffixes) {
+    size_t path_length = strlen(output_path);
+    char *temp_path = (char *)malloc(path_length + 8);
+    if (!temp_path) return 0;
+    memcpy(temp_path, output_path, path_length);
+    memcpy(temp_path + path_length, ".XXXXXX", 8);
+
+    int fd = mkstemp(temp_path);
+    FILE *output = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if (!output) {
+        perror(temp_path);
+        if (fd >= 0) {
+            close(fd);
+            unlink(temp_path);
+        }
+        free(temp_path);
+        return 0;
+    }
+
+    int ok = fwrite(header, sizeof(*header), 1, output) == 1 &&
+             fwrite(offsets, sizeof(uint32_t), buckets + 1, output) == buckets + 1 &&
+             fwrite(suffixes, sizeof(uint32_t), header->count, output) == header->count;
+    if (fclose(output) != 0) ok = 0;
+    // mkstemp vytvára súbor s právami 0600; index má byť čitateľný ako bežný súbor.
+    if (ok && chmod(temp_path, 0644) != 0) ok = 0;
+    if (ok && rename(temp_path, output_path) != 0) ok = 0;
+    if (!ok) {
+        perror(output_path);
+        unlink(temp_path);
+    }
+    free(temp_path);
+    return ok;
+}
+
+int breach_index_build(const char *input_path, const char *output_path, int threads) {
+    struct timespec started, finished;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+
+    int fd = open(input_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(input_path);
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        perror("fstat");
+        close(fd);
+        return 0;
+    }
+    size_t size = (size_t)info.st_size;
+    const char *data = "";
+    if (size > 0) {
+        data = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            perror("mmap");
+            close(fd);
+            return 0;
+        }
+        madvise((void *)data, size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > BREACH_MAX_THREADS) threads = BREACH_MAX_THREADS;
+
+    size_t lines = 0;
+    uint64_t *keys = breach_hash_lines(data, size, threads, &lines);
+    if (size > 0) munmap((void *)data, size);
+    if (!keys) return 0;
+    if (lines >= UINT32_MAX) {
+        fprintf(stderr, "Index môže mať najviac %u hesiel\n", UINT32_MAX - 1);
+        free(keys);
+        return 0;
+    }
+
+    // Počet bitov prefixu tak, aby vedierko malo v priemere BREACH_BUCKET_TARGET kľúčov.
+    unsigned int bits = BREACH_MIN_PREFIX_BITS;
+    while (bits < BREACH_MAX_PREFIX_BITS && ((uint64_t)BREACH_BUCKET_TARGET << bits) < lines) {
+        bits++;
+    }
+    size_t buckets = (size_t)1 << bits;
+
+    uint32_t *offsets = (uint32_t *)calloc(buckets + 1, sizeof(uint32_t));
+    uint32_t *suffixes = (uint32_t *)malloc((lines > 0 ? lines : 1) * sizeof(uint32_t));
+    if (!offsets || !suffixes) {
+        fprintf(stderr, "Nedostatok pamäte pre index\n");
+        free(keys);
+        free(offsets);
+        free(suffixes);
+        return 0;
+    }
+
+    // Triedenie počítaním podľa prefixu: offsets[b] je najprv začiatok vedierka
+    // a počas rozdeľovania sa posúva, až skončí na začiatku vedierka b + 1.
+    for (size_t i = 0; i < lines; i++) {
+        offsets[(keys[i] >> (64 - bits)) + 1]++;
+    }
+    for (size_t b = 0; b < buckets; b++) {
+        offsets[b + 1] += offsets[b];
+    }
+    for (size_t i = 0; i < lines; i++) {
+        uint64_t bucket = keys[i] >> (64 - bits);
+        suffixes[offsets[bucket]++] = (uint32_t)(keys[i] >> (32 - bits));
+    }
+    free(keys);
+    memmove(offsets + 1, offsets, buckets * sizeof(uint32_t));
+    offsets[0] = 0;
+
+    // Zoradenie vedierok a odstránenie duplicít (pole sa pritom zhusťuje).
+    size_t read = 0;
+    size_t write = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        size_t end = offsets[b + 1];
+        breach_sort_bucket(suffixes + read, end - read);
+        offsets[b] = (uint32_t)write;
+        for (size_t i = read; i < end; i++) {
+            if (i == read || suffixes[i] != suffixes[i - 1]) {
+                suffixes[write++] = suffixes[i];
+            }
+        }
+        read = end;
+    }
+    offsets[buckets] = (uint32_t)write;
+
+    BreachIndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BREACH_INDEX_MAGIC, sizeof(header.magic));
+    header.version = BREACH_INDEX_VERSION;
+    header.prefix_bits = bits;
+    header.count = write;
+
+    int ok = breach_write_index(output_path, &header, offsets, buckets, suffixes);
+    free(offsets);
+    free(suffixes);
+
+    if (ok) {
+        clock_gettime(CLOCK_MONOTONIC, &finished);
+        double seconds = (double)(finished.tv_sec - started.tv_sec) +
+                         (double)(finished.tv_nsec - started.tv_nsec) / 1e9;
+        double megabytes = (double)(sizeof(header) + (buckets + 1 + write) * sizeof(uint32_t)) / (1024.0 * 1024.0);
+        printf("Index %s: %zu hesiel (%zu riadkov), %u bitov prefixu, %.1f MB, čas: %.3f s\n",
+               output_path, write, lines, bits, megabytes, seconds);
+    }
+    return ok;
+}
@@ -0,0 +1,81 @@
+#ifndef BREACH_H
+#define BREACH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Identifikátor formátu súboru s indexom uniknutých hesiel
+#define BREACH_INDEX_MAGIC "PWBREACH"
+#define BREACH_INDEX_VERSION 1
+// Priemerný počet záznamov v jednom vedierku (určuje počet bitov prefixu)
+#define BREACH_BUCKET_TARGET 16
+// Rozsah počtu bitov prefixu, podľa ktorých sa kľúče delia do vedierok
+#define BREACH_MIN_PREFIX_BITS 8
+#define BREACH_MAX_PREFIX_BITS 32
+// Najvyššie skóre, ktoré môže dostať heslo nájdené v indexe
+#define BREACH_MAX_SCORE 10
+
+/*
+ * Formát súboru (všetky čísla v poradí bajtov stroja, ktorý index vytvoril):
+ *
+ *   BreachIndexHeader
+ *   uint32_t offsets[2^prefix_bits + 1]   začiatok vedierka v poli suffixes
+ *   uint32_t suffixes[count]              zoradené v rámci vedierka
+ *
+ * Kľúčom hesla je prvých 64 bitov jeho SHA-1. Horných `prefix_bits` bitov
+ * určuje vedierko, ďalších 32 bitov sa uloží do `suffixes`. Index tak zaberá
+ * približne 4 bajty na heslo a falošná zhoda nastane s pravdepodobnosťou
+ * približne count / 2^(prefix_bits + 32).
+ */
+typedef struct {
+    char magic[8];              // BREACH_INDEX_MAGIC (bez ukončovacej nuly).
+    uint32_t version;           // BREACH_INDEX_VERSION.
+    uint32_t prefix_bits;       // Počet bitov prefixu (BREACH_MIN/MAX_PREFIX_BITS).
+    uint64_t count;             // Počet (rôznych) kľúčov.
+    uint64_t reserved[5];       // Zarovnanie hlavičky na 64 bajtov.
+} BreachIndexHeader;
+
+/**
+ * @brief Zostaví index uniknutých hesiel zo súboru (jedna položka na riadok).
+ *
+ * Riadok je buď heslo v čitateľnej podobe, alebo jeho SHA-1 ako 40
+ * hexadecimálnych znakov, voliteľne s ":počet" (formát zoznamov Have I Been
+ * Pwned). Prázdne riadky sa preskočia, duplicity sa odstránia. Počas
+ * zostavovania treba približne 12 bajtov pamäte na riadok.
+ *
+ * @param input_path Vstupný súbor.
+ * @param output_path Výstupný súbor s indexom.
+ * @param threads Počet vlákien pre hašovanie (0 = počet jadier).
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int breach_index_build(const char *input_path, const char *output_path, int threads);
+
+/**
+ * @brief Namapuje index do pamäte a odvtedy ho použije `breach_index_contains()`.
+ *
+ * Volá sa raz pri štarte, pred spustením vlákien.
+ *
+ * @param path Súbor vytvorený `breach_index_build()`.
+ * @return 1 pri úspechu, 0 pri chybe (chýbajúci alebo poškodený súbor).
+ */
+int breach_index_open(const char *path);
+
+/**
+ * @brief Zistí, či je heslo v namapovanom indexe.
+ *
+ * Nealokuje pamäť; cena je jeden SHA-1 a binárne vyhľadávanie v jednom
+ * vedierku.
+ *
+ * @param password Heslo (nemusí byť ukončené nulou).
+ * @param length Dĺžka hesla v bajtoch.
+ * @return 1 ak sa heslo (pravdepodobne) nachádza v indexe, 0 ak nie alebo
+ *         ak nie je načítaný žiadny index.
+ */
+int breach_index_contains(const char *password, size_t length);
+
+/**
+ * @brief Počet hesiel v načítanom indexe (0 ak nie je načítaný).
+ */
+uint64_t breach_index_count(void);
+
+#endif // BREACH_H
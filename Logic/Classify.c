@@ -0,0 +1,250 @@
+#include "Classify.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CLASSIFY_X86 1
+#endif
+
+// Skratky indexov tried pre prehľadnosť tabuľky.
+#define L 0
+#define U 1
+#define D 2
+#define S 3
+#define O 4
+
+const unsigned char char_class_table[256] = {
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0x00
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0x10
+    O, S, O, S, S, S, S, O, S, S, S, S, S, S, S, O,   // 0x20
+    D, D, D, D, D, D, D, D, D, D, S, S, S, S, S, S,   // 0x30
+    S, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,   // 0x40
+    U, U, U, U, U, U, U, U, U, U, U, S, O, S, S, S,   // 0x50
+    O, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L,   // 0x60
+    L, L, L, L, L, L, L, L, L, L, L, S, S, S, O, O,   // 0x70
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0x80
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0x90
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0xa0
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0xb0
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0xc0
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0xd0
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0xe0
+    O, O, O, O, O, O, O, O, O, O, O, O, O, O, O, O,   // 0xf0
+};
+
+#undef L
+#undef U
+#undef D
+#undef S
+#undef O
+
+// SIMD jadro: pripočíta k `counts` počty malých, veľkých písmen, číslic
+// a špeciálnych znakov v `length` bajtoch (ostatné sa dopočítajú z dĺžky).
+typedef size_t (*ClassifyKernel)(const unsigned char *data, size_t length, size_t counts[4]);
+
+static ClassifyKernel classify_kernel = NULL;
+static const char *classify_kernel_name = "scalar";
+static pthread_once_t classify_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Pripočíta triedy bajtov podľa tabuľky (bez SIMD).
+ */
+static void classify_scalar(const unsigned char *data, size_t length, size_t counts[CHAR_CLASS_COUNT]) {
+    for (size_t i = 0; i < length; i++) {
+        counts[char_class_table[data[i]]]++;
+    }
+}
+
+#ifdef CLASSIFY_X86
+
+/*
+ * Vektorová klasifikácia po 16 (SSE2) alebo 32 (AVX2) bajtoch:
+ *   - rozsahy a-z, A-Z, 0-9 a tlačiteľné ASCII (0x21-0x7e) cez min/max bez znamienka,
+ *   - špeciálne znaky = tlačiteľné, ktoré nie sú písmená ani číslice, okrem
+ *     šiestich, ktoré v `special_chars` nie sú: " ' / \ ` ~
+ * Porovnania vracajú 0xff, takže odčítanie masky pripočíta 1 k bajtovým
+ * počítadlám; tie sa pred pretečením (255 krokov) zosumujú cez SAD.
+ */
+
+// x je v [lo, hi] (bez znamienka) <=> max(x, lo) == x && min(x, hi) == x
+#define SSE_IN_RANGE(v, lo, hi) \
+    _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, lo), v), _mm_cmpeq_epi8(_mm_min_epu8(v, hi), v))
+
+static size_t classify_sse2(const unsigned char *data, size_t length, size_t counts[4]) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lower_lo = _mm_set1_epi8('a'), lower_hi = _mm_set1_epi8('z');
+    const __m128i upper_lo = _mm_set1_epi8('A'), upper_hi = _mm_set1_epi8('Z');
+    const __m128i digit_lo = _mm_set1_epi8('0'), digit_hi = _mm_set1_epi8('9');
+    const __m128i print_lo = _mm_set1_epi8(0x21), print_hi = _mm_set1_epi8(0x7e);
+    const __m128i quote = _mm_set1_epi8('"'), apostrophe = _mm_set1_epi8('\'');
+    const __m128i slash = _mm_set1_epi8('/'), backslash = _mm_set1_epi8('\\');
+    const __m128i backtick = _mm_set1_epi8('`'), tilde = _mm_set1_epi8('~');
+    size_t done = 0;
+
+    while (length - done >= 16) {
+        __m128i acc_lower = zero, acc_upper = zero, acc_digit = zero, acc_special = zero;
+        size_t blocks = (length - done) / 16;
+        if (blocks > 255) blocks = 255;
+
+        for (size_t b = 0; b < blocks; b++, done += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(data + done));
+            __m128i lower = SSE_IN_RANGE(v, lower_lo, lower_hi);
+            __m128i upper = SSE_IN_RANGE(v, upper_lo, upper_hi);
+            __m128i digit = SSE_IN_RANGE(v, digit_lo, digit_hi);
+            __m128i excluded = _mm_or_si128(
+                _mm_or_si128(_mm_or_si128(lower, upper), digit),
+                _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, apostrophe)),
+                             _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, slash), _mm_cmpeq_epi8(v, backslash)),
+                                          _mm_or_si128(_mm_cmpeq_epi8(v, backtick), _mm_cmpeq_epi8(v, tilde)))));
+            __m128i special = _mm_andnot_si128(excluded, SSE_IN_RANGE(v, print_lo, print_hi));
+
+            acc_lower = _mm_sub_epi8(acc_lower, lower);
+            acc_upper = _mm_sub_epi8(acc_upper, upper);
+            acc_digit = _mm_sub_epi8(acc_digit, digit);
+            acc_special = _mm_sub_epi8(acc_special, special);
+        }
+
+        __m128i sums[4] = {
+            _mm_sad_epu8(acc_lower, zero), _mm_sad_epu8(acc_upper, zero),
+            _mm_sad_epu8(acc_digit, zero), _mm_sad_epu8(acc_special, zero)
+        };
+        for (int k = 0; k < 4; k++) {
+            counts[k] += (size_t)_mm_cvtsi128_si32(sums[k]) +
+                         (size_t)_mm_cvtsi128_si32(_mm_unpackhi_epi64(sums[k], sums[k]));
+        }
+    }
+    return done;
+}
+
+#define AVX_IN_RANGE(v, lo, hi) \
+    _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, lo), v), _mm256_cmpeq_epi8(_mm256_min_epu8(v, hi), v))
+
+__attribute__((target("avx2")))
+static size_t classify_avx2(const unsigned char *data, size_t length, size_t counts[4]) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lower_lo = _mm256_set1_epi8('a'), lower_hi = _mm256_set1_epi8('z');
+    const __m256i upper_lo = _mm256_set1_epi8('A'), upper_hi = _mm256_set1_epi8('Z');
+    const __m256i digit_lo = _mm256_set1_epi8('0'), digit_hi = _mm256_set1_epi8('9');
+    const __m256i print_lo = _mm256_set1_epi8(0x21), print_hi = _mm256_set1_epi8(0x7e);
+    const __m256i quote = _mm256_set1_epi8('"'), apostrophe = _mm256_set1_epi8('\'');
+    const __m256i slash = _mm256_set1_epi8('/'), backslash = _mm256_set1_epi8('\\');
+    const __m256i backtick = _mm256_set1_epi8('`'), tilde = _mm256_set1_epi8('~');
+    size_t done = 0;
+
+    while (length - done >= 32) {
+        __m256i acc_lower = zero, acc_upper = zero, acc_digit = zero, acc_special = zero;
+        size_t blocks = (length - done) / 32;
+        if (blocks > 255) blocks = 255;
+
+        for (size_t b = 0; b < blocks; b++, done += 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(data + done));
+            __m256i lower = AVX_IN_RANGE(v, lower_lo, lower_hi);
+            __m256i upper = AVX_IN_RANGE(v, upper_lo, upper_hi);
+            __m256i digit = AVX_IN_RANGE(v, digit_lo, digit_hi);
+            __m256i excluded = _mm256_or_si256(
+                _mm256_or_si256(_mm256_or_si256(lower, upper), digit),
+                _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, apostrophe)),
+                                _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, slash), _mm256_cmpeq_epi8(v, backslash)),
+                                                _mm256_or_si256(_mm256_cmpeq_epi8(v, backtick), _mm256_cmpeq_epi8(v, tilde)))));
+            __m256i special = _mm256_andnot_si256(excluded, AVX_IN_RANGE(v, print_lo, print_hi));
+
+            acc_lower = _mm256_sub_epi8(acc_lower, lower);
+            acc_upper = _mm256_sub_epi8(acc_upper, upper);
+            acc_digit = _mm256_sub_epi8(acc_digit, digit);
+            acc_special = _mm256_sub_epi8(acc_special, special);
+        }
+
+        __m256i sums[4] = {
+            _mm256_sad_epu8(acc_lower, zero), _mm256_sad_epu8(acc_upper, zero),
+            _mm256_sad_epu8(acc_digit, zero), _mm256_sad_epu8(acc_special, zero)
+        };
+        for (int k = 0; k < 4; k++) {
+            uint64_t lanes[4];
+            _mm256_storeu_si256((__m256i *)lanes, sums[k]);
+            counts[k] += (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+        }
+    }
+    return done;
+}
+
+#endif // CLASSIFY_X86
+
+/**
+ * @brief Vyberie SIMD jadro podľa schopností procesora.
+ */
+static void classify_select_kernel(void) {
+#ifdef CLASSIFY_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        classify_kernel = classify_avx2;
+        classify_kernel_name = "avx2";
+    } else if (__builtin_cpu_supports("sse2")) {
+        classify_kernel = classify_sse2;
+        classify_kernel_name = "sse2";
+    }
+#endif
+}
+
+/**
+ * @brief Pripočíta triedy `length` bajtov k `counts`, pri dlhých vstupoch cez SIMD.
+ */
+static void classify_accumulate(const unsigned char *data, size_t length, size_t counts[CHAR_CLASS_COUNT]) {
+    if (length >= CLASSIFY_SIMD_THRESHOLD) {
+        pthread_once(&classify_once, classify_select_kernel);
+        if (classify_kernel) {
+            size_t before = counts[0] + counts[1] + counts[2] + counts[3];
+            size_t done = classify_kernel(data, length, counts);
+            // Čo nie je písmeno, číslica ani špeciálny znak, patrí do OTHER.
+            counts[4] += done - (counts[0] + counts[1] + counts[2] + counts[3] - before);
+            data += done;
+            length -= done;
+        }
+    }
+    classify_scalar(data, length, counts);
+}
+
+/**
+ * @brief Doplní masku tried podľa nenulových počítadiel.
+ */
+static void classify_finish(CharClassStats *stats) {
+    stats->mask = 0;
+    for (int k = 0; k < CHAR_CLASS_COUNT; k++) {
+        if (stats->counts[k] > 0) stats->mask |= 1u << k;
+    }
+}
+
+void classify_bytes(const char *data, size_t length, CharClassStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    classify_accumulate((const unsigned char *)data, length, stats->counts);
+    stats->length = length;
+    classify_finish(stats);
+}
+
+void classify_password(const char *password, CharClassStats *stats) {
+    const unsigned char *data = (const unsigned char *)password;
+    memset(stats, 0, sizeof(*stats));
+
+    // Bežné heslá sú krátke: dĺžka aj triedy sa zistia v jednom prechode tabuľkou.
+    size_t length = 0;
+    while (length < CLASSIFY_SIMD_THRESHOLD && data[length]) {
+        stats->counts[char_class_table[data[length]]]++;
+        length++;
+    }
+
+    // Dlhý vstup: zvyšok sa spracuje po blokoch cez SIMD.
+    if (data[length]) {
+        size_t rest = strlen(password + length);
+        classify_accumulate(data + length, rest, stats->counts);
+        length += rest;
+    }
+
+    stats->length = length;
+    classify_finish(stats);
+}
+
+const char *classify_implementation(void) {
+    pthread_once(&classify_once, classify_select_kernel);
+    return classify_kernel_name;
+}
@@ -0,0 +1,51 @@
+#ifndef CLASSIFY_H
+#define CLASSIFY_H
+
+#include <stddef.h>
+
+// Triedy znakov hesla (bitová maska).
+#define CHAR_CLASS_LOWER   0x01   // a-z
+#define CHAR_CLASS_UPPER   0x02   // A-Z
+#define CHAR_CLASS_DIGIT   0x04   // 0-9
+#define CHAR_CLASS_SPECIAL 0x08   // Znaky zo sady `special_chars` v Password.c.
+#define CHAR_CLASS_OTHER   0x10   // Všetko ostatné (medzera, ~, \, UTF-8, ...).
+
+// Počet tried (indexy do `counts`).
+#define CHAR_CLASS_COUNT 5
+
+// Od tejto dĺžky sa použije SIMD verzia (pri kratších vstupoch je rýchlejšia tabuľka).
+#define CLASSIFY_SIMD_THRESHOLD 32
+
+// Výsledok klasifikácie reťazca jedným prechodom.
+typedef struct {
+    size_t length;                     // Dĺžka v bajtoch.
+    unsigned int mask;                 // Zjednotenie tried všetkých znakov (CHAR_CLASS_*).
+    size_t counts[CHAR_CLASS_COUNT];   // Počty znakov: lower, upper, digit, special, other.
+} CharClassStats;
+
+// Index triedy (0 až CHAR_CLASS_COUNT - 1) každého bajtu; bit triedy v maske
+// je `1 << index`.
+extern const unsigned char char_class_table[256];
+
+/**
+ * @brief Klasifikuje reťazec ukončený nulou jedným prechodom.
+ *
+ * @param password Vstupný reťazec.
+ * @param stats Výstup: dĺžka, maska tried a počty znakov jednotlivých tried.
+ */
+void classify_password(const char *password, CharClassStats *stats);
+
+/**
+ * @brief Klasifikuje `length` bajtov (vstup nemusí byť ukončený nulou).
+ *
+ * Pre dlhé vstupy sa použije SSE2 alebo AVX2 verzia podľa toho, čo
+ * podporuje procesor (zistí sa raz pri prvom volaní).
+ */
+void classify_bytes(const char *data, size_t length, CharClassStats *stats);
+
+/**
+ * @brief Vráti názov použitej SIMD implementácie ("avx2", "sse2" alebo "scalar").
+ */
+const char *classify_implementation(void);
+
+#endif // CLASSIFY_H
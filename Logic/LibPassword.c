@@ -0,0 +1,108 @@
+#include "LibPassword.h"
+#include "Password.h"
+#include "Policy.h"
+#include "Breach.h"
+#include "Markov.h"
+
+// Nastavenie kontextu; funkcie ho len čítajú, takže kontext bez zmien
+// môže zdieľať viac vlákien.
+struct PasswordContext {
+    const PasswordPolicy *policy;
+    int length;
+    unsigned int checks;
+};
+
+// Strojové názvy dôvodov v poradí bitov PASSWORD_REASON_*.
+static const char *const reason_names[PASSWORD_REASON_COUNT] = {
+    "too_short", "no_lowercase", "no_uppercase", "no_digits", "no_symbols",
+    "dictionary", "leet", "keyboard", "repeat", "sequence", "year",
+    "predictable", "breached",
+};
+
+unsigned int password_library_version(void) {
+    return LIBPASSWORD_VERSION;
+}
+
+int password_library_init(const PasswordLibraryConfig *config) {
+    if (!policy_load(config ? config->policies : NULL)) return 0;
+    if (!config) return 1;
+    if (config->markov_model && !markov_open(config->markov_model)) return 0;
+    if (config->breach_index && !breach_index_open(config->breach_index)) return 0;
+    return 1;
+}
+
+PasswordContext *password_context_create(unsigned int version) {
+    if (version >> 16 != LIBPASSWORD_VERSION_MAJOR) return NULL;
+    PasswordContext *context = (PasswordContext *)malloc(sizeof(PasswordContext));
+    if (!context) return NULL;
+    context->policy = policy_by_id(1);
+    context->length = context->policy->default_length;
+    context->checks = PASSWORD_CHECK_ALL;
+    return context;
+}
+
+void password_context_destroy(PasswordContext *context) {
+    free(context);
+}
+
+int password_context_set_policy(PasswordContext *context, const char *name) {
+    const PasswordPolicy *policy = name ? policy_find(name, strlen(name)) : NULL;
+    if (!policy) return 0;
+    context->policy = policy;
+    context->length = policy->default_length;
+    return 1;
+}
+
+void password_context_set_classes(PasswordContext *context, int special, int numbers,
+                                  int uppercase, int lowercase) {
+    context->policy = policy_for_classes(special, numbers, uppercase, lowercase);
+    context->length = context->policy->default_length;
+}
+
+int password_context_set_length(PasswordContext *context, int length) {
+    if (length < context->policy->min_length || length < 1 || length > MAX_PASSWORD_LENGTH) return 0;
+    context->length = length;
+    return 1;
+}
+
+int password_context_length(const PasswordContext *context) {
+    return context->length;
+}
+
+void password_context_set_checks(PasswordContext *context, unsigned int checks) {
+    context->checks = checks & PASSWORD_CHECK_ALL;
+}
+
+int password_generate_batch(const PasswordContext *context, size_t count, char *passwords, size_t stride) {
+    if (!context || (count > 0 && !passwords) || stride <= (size_t)context->length) return 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!policy_generate(context->policy, context->length, passwords + i * stride)) return 0;
+    }
+    return 1;
+}
+
+int password_evaluate_batch(const PasswordContext *context, size_t count, const char *const *passwords,
+                            const size_t *lengths, const PasswordEvaluations *results) {
+    if (!context || !results || (count > 0 && !passwords)) return 0;
+    for (size_t i = 0; i < count; i++) {
+        PasswordStrength result;
+        size_t length = lengths ? lengths[i] : strlen(passwords[i]);
+        evaluate_password_bytes(passwords[i], length, context->checks, &result);
+        if (results->score) results->score[i] = (uint8_t)result.score;
+        if (results->strong) results->strong[i] = (uint8_t)result.is_strong;
+        if (results->reasons) results->reasons[i] = result.reasons;
+        if (results->guesses_log10) results->guesses_log10[i] = (float)result.guesses_log10;
+    }
+    return 1;
+}
+
+size_t password_feedback(uint32_t reasons, int strong, char *out, size_t size) {
+    return format_password_feedback(reasons, strong, out, size);
+}
+
+const char *password_reason_name(uint32_t reason) {
+    for (int i = 0; i < PASSWORD_REASON_COUNT; i++) {
+        if (reason == 1u << i) return reason_names[i];
+    }
+    return NULL;
+}
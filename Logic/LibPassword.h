@@ -0,0 +1,161 @@
+#ifndef LIBPASSWORD_H
+#define LIBPASSWORD_H
+
+/*
+ * Verejné rozhranie knižnice libpassword (libpassword.a, libpassword.so).
+ *
+ * Všetky funkcie okrem password_library_init() sú reentrantné: stav nesú
+ * explicitné kontexty a náhodné čísla pochádzajú z generátora ChaCha20
+ * vlastného pre každé vlákno. Kontext, ktorý sa po nastavení už nemení,
+ * môžu naraz používať viaceré vlákna.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Verzia rozhrania. Hlavná verzia sa mení pri nekompatibilnej zmene,
+// vedľajšia pri pridaní funkcií; zdieľaná knižnica má soname libpassword.so.MAJOR.
+#define LIBPASSWORD_VERSION_MAJOR 1
+#define LIBPASSWORD_VERSION_MINOR 0
+#define LIBPASSWORD_VERSION ((LIBPASSWORD_VERSION_MAJOR << 16) | LIBPASSWORD_VERSION_MINOR)
+
+// Dôvody nižšieho hodnotenia (bitová maska). Poradie bitov je poradie,
+// v akom sa odporúčania vypisujú v textovej spätnej väzbe.
+#define PASSWORD_REASON_TOO_SHORT    0x0001u   // Kratšie ako 8 znakov.
+#define PASSWORD_REASON_NO_LOWER     0x0002u   // Chýbajú malé písmená.
+#define PASSWORD_REASON_NO_UPPER     0x0004u   // Chýbajú veľké písmená.
+#define PASSWORD_REASON_NO_DIGIT     0x0008u   // Chýbajú číslice.
+#define PASSWORD_REASON_NO_SPECIAL   0x0010u   // Chýbajú špeciálne znaky.
+#define PASSWORD_REASON_DICTIONARY   0x0020u   // Bežné heslo, slovo alebo meno.
+#define PASSWORD_REASON_LEET         0x0040u   // Slovo s náhradami znakov (p@ssw0rd).
+#define PASSWORD_REASON_KEYBOARD     0x0080u   // Rad susedných klávesov.
+#define PASSWORD_REASON_REPEAT       0x0100u   // Opakovanie.
+#define PASSWORD_REASON_SEQUENCE     0x0200u   // Postupnosť (1234, abcd).
+#define PASSWORD_REASON_YEAR         0x0400u   // Letopočet.
+#define PASSWORD_REASON_PREDICTABLE  0x0800u   // Pravdepodobné podľa Markovovho modelu.
+#define PASSWORD_REASON_BREACHED     0x1000u   // V zozname uniknutých hesiel.
+#define PASSWORD_REASON_COUNT 13
+
+// Kontroly vyhodnotenia nad rámec pravidiel o dĺžke a triedach znakov.
+#define PASSWORD_CHECK_PATTERNS 0x01u   // Vzory (slová, klávesnica, opakovania...).
+#define PASSWORD_CHECK_MARKOV   0x02u   // Markovov model (ak je načítaný).
+#define PASSWORD_CHECK_BREACH   0x04u   // Index uniknutých hesiel (ak je načítaný).
+#define PASSWORD_CHECK_ALL      0x07u
+
+// Dĺžka buffera, do ktorého sa vždy zmestí textová spätná väzba
+#define PASSWORD_FEEDBACK_SIZE 512
+
+// Zdroje zdieľané všetkými kontextmi procesu (NULL = nepoužije sa).
+typedef struct {
+    const char *breach_index;   // Index uniknutých hesiel (Breach.h).
+    const char *markov_model;   // Markovov model (Markov.h).
+    const char *policies;       // Súbor s ďalšími politikami generovania (Policy.h).
+} PasswordLibraryConfig;
+
+// Kontext: nastavenie generovania a vyhodnocovania (nepriehľadný).
+typedef struct PasswordContext PasswordContext;
+
+// Výsledky vyhodnotenia dávky ako štruktúra polí: i-ty prvok každého poľa
+// patrí i-temu heslu. Pole, ktoré volajúci nepotrebuje, môže byť NULL.
+typedef struct {
+    uint8_t *score;             // Skóre 0-100.
+    uint8_t *strong;            // 1 ak je heslo silné.
+    uint32_t *reasons;          // PASSWORD_REASON_*.
+    float *guesses_log10;       // log10 odhadu počtu pokusov na uhádnutie.
+} PasswordEvaluations;
+
+/**
+ * @brief Verzia knižnice, s ktorou je program zlinkovaný (LIBPASSWORD_VERSION).
+ */
+unsigned int password_library_version(void);
+
+/**
+ * @brief Načíta zdroje zdieľané všetkými kontextmi.
+ *
+ * Jediná funkcia, ktorá nie je reentrantná: volá sa raz, pred vytvorením
+ * kontextov a spustením vlákien. Bez nej sa heslá hodnotia bez indexu
+ * a modelu a generujú len vstavanými politikami.
+ *
+ * @return 1 pri úspechu, 0 ak sa niektorý súbor nepodarilo načítať.
+ */
+int password_library_init(const PasswordLibraryConfig *config);
+
+/**
+ * @brief Vytvorí kontext s predvolenými nastaveniami (politika "default",
+ *        jej predvolená dĺžka, všetky kontroly).
+ *
+ * @param version LIBPASSWORD_VERSION, s ktorou bol volajúci skompilovaný.
+ * @return Kontext alebo NULL pri inej hlavnej verzii či chybe alokácie.
+ */
+PasswordContext *password_context_create(unsigned int version);
+
+/**
+ * @brief Uvoľní kontext.
+ */
+void password_context_destroy(PasswordContext *context);
+
+/**
+ * @brief Nastaví pomenovanú politiku generovania (a jej predvolenú dĺžku).
+ *
+ * @return 1 pri úspechu, 0 ak politika neexistuje.
+ */
+int password_context_set_policy(PasswordContext *context, const char *name);
+
+/**
+ * @brief Nastaví politiku podľa tried znakov ako voľby include* v /api/generate.
+ */
+void password_context_set_classes(PasswordContext *context, int special, int numbers,
+                                  int uppercase, int lowercase);
+
+/**
+ * @brief Nastaví dĺžku generovaných hesiel.
+ *
+ * @return 1 pri úspechu, 0 ak je dĺžka mimo rozsahu politiky.
+ */
+int password_context_set_length(PasswordContext *context, int length);
+
+/**
+ * @brief Dĺžka hesiel, ktoré kontext generuje.
+ */
+int password_context_length(const PasswordContext *context);
+
+/**
+ * @brief Nastaví kontroly vyhodnotenia (PASSWORD_CHECK_*).
+ */
+void password_context_set_checks(PasswordContext *context, unsigned int checks);
+
+/**
+ * @brief Vygeneruje `count` hesiel podľa politiky kontextu.
+ *
+ * i-te heslo sa zapíše na `passwords + i * stride` a ukončí nulou.
+ *
+ * @param stride Vzdialenosť hesiel v bajtoch, aspoň password_context_length() + 1.
+ * @return 1 pri úspechu, 0 pri neplatných parametroch.
+ */
+int password_generate_batch(const PasswordContext *context, size_t count, char *passwords, size_t stride);
+
+/**
+ * @brief Vyhodnotí `count` hesiel.
+ *
+ * @param passwords Heslá (nemusia byť ukončené nulou, ak je zadané `lengths`).
+ * @param lengths Dĺžky hesiel v bajtoch alebo NULL pre reťazce ukončené nulou.
+ * @param results Polia s aspoň `count` prvkami.
+ * @return 1 pri úspechu, 0 pri neplatných parametroch.
+ */
+int password_evaluate_batch(const PasswordContext *context, size_t count, const char *const *passwords,
+                            const size_t *lengths, const PasswordEvaluations *results);
+
+/**
+ * @brief Zostaví textovú spätnú väzbu (slovensky) z dôvodov hodnotenia.
+ *
+ * @param out Buffer; s PASSWORD_FEEDBACK_SIZE bajtmi sa text zmestí vždy.
+ * @return Dĺžka textu bez ukončovacej nuly.
+ */
+size_t password_feedback(uint32_t reasons, int strong, char *out, size_t size);
+
+/**
+ * @brief Strojový názov jedného dôvodu (napr. "too_short") alebo NULL.
+ */
+const char *password_reason_name(uint32_t reason);
+
+#endif // LIBPASSWORD_H
@@ -0,0 +1,255 @@
+#include "Markov.h"
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Počet záznamov tabuľky (S^3) a riadkov kontextu (S^2)
+#define MARKOV_CELLS ((size_t)MARKOV_SYMBOLS * MARKOV_SYMBOLS * MARKOV_SYMBOLS)
+#define MARKOV_CONTEXTS ((size_t)MARKOV_SYMBOLS * MARKOV_SYMBOLS)
+// Symbol hranice hesla a symbol pre bajty mimo tlačiteľného ASCII
+#define MARKOV_BOUNDARY 0
+#define MARKOV_OTHER (MARKOV_SYMBOLS - 1)
+
+// Namapovaný model. Nastaví sa raz pri štarte a potom sa len číta.
+typedef struct {
+    const MarkovHeader *header;
+    const uint8_t *costs;
+    size_t size;
+} MarkovModel;
+
+static MarkovModel markov_model;
+
+/**
+ * @brief Prevedie bajt na symbol modelu.
+ */
+static inline unsigned int markov_symbol(unsigned char c) {
+    return c >= 0x20 && c <= 0x7e ? (unsigned int)(c - 0x20 + 1) : MARKOV_OTHER;
+}
+
+int markov_open(const char *path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(path);
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0 || (size_t)info.st_size != sizeof(MarkovHeader) + MARKOV_CELLS) {
+        fprintf(stderr, "%s: neplatný Markovov model\n", path);
+        close(fd);
+        return 0;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("mmap");
+        return 0;
+    }
+
+    const MarkovHeader *header = (const MarkovHeader *)data;
+    if (memcmp(header->magic, MARKOV_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != MARKOV_VERSION || header->symbols != MARKOV_SYMBOLS ||
+        header->scale != MARKOV_SCALE) {
+        fprintf(stderr, "%s: neplatný Markovov model\n", path);
+        munmap(data, size);
+        return 0;
+    }
+    // Tabuľka má necelý 1 MB; načíta sa celá vopred.
+    madvise(data, size, MADV_WILLNEED);
+
+    markov_model.header = header;
+    markov_model.costs = (const uint8_t *)(header + 1);
+    markov_model.size = size;
+    return 1;
+}
+
+uint64_t markov_passwords(void) {
+    return markov_model.header ? markov_model.header->passwords : 0;
+}
+
+double markov_guesses_log10(const char *password, size_t length) {
+    const uint8_t *costs = markov_model.costs;
+    if (!costs) return -1.0;
+
+    // Kontext (a, b) je vždy uložený ako (a * S + b) * S, takže posun
+    // o znak je jedno násobenie a sčítanie.
+    size_t context = 0;
+    unsigned int previous = MARKOV_BOUNDARY;
+    uint32_t total = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned int symbol = markov_symbol((unsigned char)password[i]);
+        total += costs[context + symbol];
+        context = ((size_t)previous * MARKOV_SYMBOLS + symbol) * MARKOV_SYMBOLS;
+        previous = symbol;
+    }
+    total += costs[context + MARKOV_BOUNDARY];
+    return (double)total / MARKOV_SCALE * 0.30102999566398120; // log10(2)
+}
+
+/**
+ * @brief Zapíše model do dočasného súboru a premenuje ho na `output_path`
+ *        (bežiaci server so starým modelom to neovplyvní).
+ */
+static int markov_write(const char *output_path, const MarkovHeader *header, const uint8_t *costs) {
+    size_t path_length = strlen(output_path);
+    char *temp_path = (char *)malloc(path_length + 8);
+    if (!temp_path) return 0;
+    memcpy(temp_path, output_path, path_length);
+    memcpy(temp_path + path_length, ".XXXXXX", 8);
+
+    int fd = mkstemp(temp_path);
+    FILE *output = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if (!output) {
+        perror(temp_path);
+        if (fd >= 0) {
+            close(fd);
+            unlink(temp_path);
+        }
+        free(temp_path);
+        return 0;
+    }
+
+    int ok = fwrite(header, sizeof(*header), 1, output) == 1 &&
+             fwrite(costs, 1, MARKOV_CELLS, output) == MARKOV_CELLS;
+    if (fclose(output) != 0) ok = 0;
+    if (ok && chmod(temp_path, 0644) != 0) ok = 0;
+    if (ok && rename(temp_path, output_path) != 0) ok = 0;
+    if (!ok) {
+        perror(output_path);
+        unlink(temp_path);
+    }
+    free(temp_path);
+    return ok;
+}
+
+/**
+ * @brief Prevedie pravdepodobnosť na kvantovanú cenu (1/MARKOV_SCALE bitu, najviac 255).
+ */
+static uint8_t markov_quantize(double probability) {
+    double cost = -log2(probability) * MARKOV_SCALE + 0.5;
+    return cost >= 255.0 ? 255 : (uint8_t)cost;
+}
+
+int markov_build(const char *input_path, const char *output_path) {
+    struct timespec started, finished;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+
+    FILE *input = fopen(input_path, "r");
+    if (!input) {
+        perror(input_path);
+        return 0;
+    }
+
+    // Počty trigramov; počty bigramov a unigramov sú ich súčty.
+    uint64_t *trigrams = (uint64_t *)calloc(MARKOV_CELLS, sizeof(uint64_t));
+    uint8_t *costs = (uint8_t *)malloc(MARKOV_CELLS);
+    if (!trigrams || !costs) {
+        fprintf(stderr, "Nedostatok pamäte pre model\n");
+        free(trigrams);
+        free(costs);
+        fclose(input);
+        return 0;
+    }
+
+    char *line = NULL;
+    size_t capacity = 0;
+    ssize_t read;
+    uint64_t passwords = 0;
+    while ((read = getline(&line, &capacity, input)) != -1) {
+        size_t length = (size_t)read;
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) length--;
+        if (length == 0) continue;
+        passwords++;
+        unsigned int a = MARKOV_BOUNDARY, b = MARKOV_BOUNDARY;
+        for (size_t i = 0; i <= length; i++) {
+            unsigned int c = i < length ? markov_symbol((unsigned char)line[i]) : MARKOV_BOUNDARY;
+            trigrams[((size_t)a * MARKOV_SYMBOLS + b) * MARKOV_SYMBOLS + c]++;
+            a = b;
+            b = c;
+        }
+    }
+    free(line);
+    int read_error = ferror(input);
+    fclose(input);
+    if (read_error || passwords == 0) {
+        fprintf(stderr, "%s: %s\n", input_path, read_error ? "chyba pri čítaní" : "žiadne heslá");
+        free(trigrams);
+        free(costs);
+        return 0;
+    }
+
+    // Bigramy (b, c) a unigramy c ako súčty cez starší kontext.
+    static uint64_t bigrams[MARKOV_CONTEXTS];
+    static uint64_t unigrams[MARKOV_SYMBOLS];
+    memset(bigrams, 0, sizeof(bigrams));
+    memset(unigrams, 0, sizeof(unigrams));
+    for (size_t cell = 0; cell < MARKOV_CELLS; cell++) {
+        bigrams[cell % MARKOV_CONTEXTS] += trigrams[cell];
+        unigrams[cell % MARKOV_SYMBOLS] += trigrams[cell];
+    }
+    uint64_t total = 0;
+    for (size_t c = 0; c < MARKOV_SYMBOLS; c++) total += unigrams[c];
+
+    // Witten-Bell: P(c | kontext) = (n(kontext, c) + T * P_nižší(c)) / (n(kontext) + T),
+    // kde T je počet rôznych symbolov, ktoré po kontexte nasledovali.
+    double unigram_p[MARKOV_SYMBOLS];
+    for (size_t c = 0; c < MARKOV_SYMBOLS; c++) {
+        unigram_p[c] = (double)(unigrams[c] + 1) / (double)(total + MARKOV_SYMBOLS);
+    }
+    double bigram_p[MARKOV_SYMBOLS];
+    for (size_t b = 0; b < MARKOV_SYMBOLS; b++) {
+        const uint64_t *row = bigrams + b * MARKOV_SYMBOLS;
+        uint64_t seen = 0, types = 0;
+        for (size_t c = 0; c < MARKOV_SYMBOLS; c++) {
+            seen += row[c];
+            types += row[c] > 0;
+        }
+        for (size_t c = 0; c < MARKOV_SYMBOLS; c++) {
+            bigram_p[c] = seen ? ((double)row[c] + (double)types * unigram_p[c]) / (double)(seen + types)
+                               : unigram_p[c];
+        }
+        for (size_t a = 0; a < MARKOV_SYMBOLS; a++) {
+            size_t context = (a * MARKOV_SYMBOLS + b) * MARKOV_SYMBOLS;
+            const uint64_t *counts = trigrams + context;
+            uint64_t context_seen = 0, context_types = 0;
+            for (size_t c = 0; c < MARKOV_SYMBOLS; c++) {
+                context_seen += counts[c];
+                context_types += counts[c] > 0;
+            }
+            for (size_t c = 0; c < MARKOV_SYMBOLS; c++) {
+                double p = context_seen
+                    ? ((double)counts[c] + (double)context_types * bigram_p[c]) / (double)(context_seen + context_types)
+                    : bigram_p[c];
+                costs[context + c] = markov_quantize(p);
+            }
+        }
+    }
+    free(trigrams);
+
+    MarkovHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MARKOV_MAGIC, sizeof(header.magic));
+    header.version = MARKOV_VERSION;
+    header.symbols = MARKOV_SYMBOLS;
+    header.scale = MARKOV_SCALE;
+    header.passwords = passwords;
+
+    int ok = markov_write(output_path, &header, costs);
+    free(costs);
+    if (ok) {
+        clock_gettime(CLOCK_MONOTONIC, &finished);
+        double seconds = (double)(finished.tv_sec - started.tv_sec) +
+                         (double)(finished.tv_nsec - started.tv_nsec) / 1e9;
+        printf("Model %s: %llu hesiel, %.1f MB, čas: %.3f s\n", output_path,
+               (unsigned long long)passwords, (double)(sizeof(header) + MARKOV_CELLS) / (1024.0 * 1024.0),
+               seconds);
+    }
+    return ok;
+}
@@ -0,0 +1,78 @@
+#ifndef MARKOV_H
+#define MARKOV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Identifikátor formátu súboru s modelom
+#define MARKOV_MAGIC "PWMARKOV"
+#define MARKOV_VERSION 1
+// Počet symbolov: hranica hesla, 95 tlačiteľných ASCII znakov a "iný bajt"
+#define MARKOV_SYMBOLS 97
+// Cena prechodu je v jednotkách 1/MARKOV_SCALE bitu (najviac 255 / MARKOV_SCALE bitov)
+#define MARKOV_SCALE 8
+// Pod touto hranicou (log10 pokusov) dostane predvídateľné heslo obmedzené skóre
+#define MARKOV_SAFE_GUESSES_LOG10 10.0
+
+/*
+ * Formát súboru (čísla v poradí bajtov stroja, ktorý model vytvoril):
+ *
+ *   MarkovHeader
+ *   uint8_t costs[MARKOV_SYMBOLS][MARKOV_SYMBOLS][MARKOV_SYMBOLS]
+ *
+ * Model je trigramový: costs[a][b][c] je -log2 P(c | a, b) v jednotkách
+ * 1/MARKOV_SCALE bitu, kde a, b sú dva predchádzajúce symboly (na začiatku
+ * hranica) a c nasledujúci symbol (na konci hranica). Riadok pre jeden
+ * kontext má MARKOV_SYMBOLS bajtov, takže cena znaku je jeden prístup
+ * na index (a * S + b) * S + c.
+ */
+typedef struct {
+    char magic[8];              // MARKOV_MAGIC (bez ukončovacej nuly).
+    uint32_t version;           // MARKOV_VERSION.
+    uint32_t symbols;           // MARKOV_SYMBOLS.
+    uint32_t scale;             // MARKOV_SCALE.
+    uint32_t reserved32;
+    uint64_t passwords;         // Počet hesiel, z ktorých sa model naučil.
+    uint64_t reserved[4];       // Zarovnanie hlavičky na 64 bajtov.
+} MarkovHeader;
+
+/**
+ * @brief Naučí model zo zoznamu hesiel (jedno na riadok) a zapíše ho do súboru.
+ *
+ * Pravdepodobnosti sa vyhladzujú metódou Witten-Bell (trigram → bigram →
+ * unigram), takže aj nevidené prechody majú konečnú cenu. Počas učenia treba
+ * približne 8 MB pamäte bez ohľadu na veľkosť vstupu.
+ *
+ * @param input_path Vstupný súbor.
+ * @param output_path Výstupný súbor s modelom.
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int markov_build(const char *input_path, const char *output_path);
+
+/**
+ * @brief Namapuje model do pamäte a odvtedy ho použije `markov_guesses_log10()`.
+ *
+ * Volá sa raz pri štarte, pred spustením vlákien.
+ *
+ * @param path Súbor vytvorený `markov_build()`.
+ * @return 1 pri úspechu, 0 pri chybe (chýbajúci alebo poškodený súbor).
+ */
+int markov_open(const char *path);
+
+/**
+ * @brief Počet hesiel, z ktorých sa načítaný model naučil (0 ak nie je načítaný).
+ */
+uint64_t markov_passwords(void);
+
+/**
+ * @brief Odhadne počet pokusov ako 1 / P(heslo) podľa modelu.
+ *
+ * Nealokuje pamäť; cena je jeden prístup do tabuľky na znak.
+ *
+ * @param password Heslo (nemusí byť ukončené nulou).
+ * @param length Dĺžka hesla v bajtoch.
+ * @return log10 odhadovaného počtu pokusov alebo -1, ak nie je načítaný model.
+ */
+double markov_guesses_log10(const char *password, size_t length);
+
+#endif // MARKOV_H
@@ -0,0 +1,332 @@
+#include "Passphrase.h"
+#include "Random.h"
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Vstavaný slovník: slová tvaru spoluhláska-samohláska-spoluhláska-samohláska
+// (16 * 5 * 16 * 5 = 6400 slov, 12,6 bitu na slovo, napr. "kobe", "tiru").
+static const char builtin_consonants[] = "bdfghjklmnprstvz";
+static const char builtin_vowels[] = "aeiou";
+#define BUILTIN_WORD_COUNT 6400
+#define BUILTIN_WORD_LENGTH 4
+
+// Slovník je súvislý úsek indexu slov.
+typedef struct {
+    char name[PASSPHRASE_LIST_NAME_SIZE];
+    uint32_t first;              // Index prvého slova v `word_offsets`.
+    uint32_t count;
+    double bits_per_word;        // log2(count).
+} PassphraseList;
+
+static PassphraseList lists[PASSPHRASE_MAX_LISTS];
+static int list_count;
+
+// Jeden namapovaný blok: index `word_offsets[word_count + 1]` a za ním slová
+// bez oddeľovačov. Slovo i je word_data[word_offsets[i] .. word_offsets[i + 1]).
+static void *blob;
+static size_t blob_size;
+static const uint32_t *word_offsets;
+static const char *word_data;
+
+// Stav počas zostavovania.
+typedef struct {
+    char *data;
+    size_t data_length;
+    uint32_t *offsets;           // offsets[i] = začiatok slova i.
+    uint32_t count;
+} WordBuilder;
+
+static uint32_t hash_word(const char *word, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)word[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Prevedie slovo na malé písmená; odmietne slová s inými znakmi ako a-z.
+ *
+ * @return 1 ak je slovo použiteľné.
+ */
+static int normalize_word(const char *word, size_t length, char *out) {
+    if (length == 0 || length > PASSPHRASE_MAX_WORD_LENGTH) return 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = word[i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        if (c < 'a' || c > 'z') return 0;
+        out[i] = c;
+    }
+    return 1;
+}
+
+/**
+ * @brief Pridá slová zo súboru do builderu ako nový slovník (bez duplicít).
+ */
+static int load_list(WordBuilder *builder, const char *path, size_t path_length) {
+    char file_name[4096];
+    if (path_length >= sizeof(file_name)) path_length = sizeof(file_name) - 1;
+    memcpy(file_name, path, path_length);
+    file_name[path_length] = '\0';
+
+    int fd = open(file_name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(file_name);
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0 || info.st_size == 0) {
+        fprintf(stderr, "%s: prázdny slovník\n", file_name);
+        close(fd);
+        return 0;
+    }
+    size_t size = (size_t)info.st_size;
+    const char *text = (const char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (text == MAP_FAILED) {
+        perror("mmap");
+        return 0;
+    }
+
+    // Hašovacia tabuľka indexov slov na odstránenie duplicít.
+    size_t slots = 64;
+    while (slots < size) slots <<= 1;
+    uint32_t *table = (uint32_t *)malloc(slots * sizeof(uint32_t));
+    if (!table) {
+        munmap((void *)text, size);
+        return 0;
+    }
+    memset(table, 0xff, slots * sizeof(uint32_t));
+
+    uint32_t first = builder->count;
+    const char *p = text, *end = text + size;
+    while (p < end) {
+        const char *line_end = memchr(p, '\n', (size_t)(end - p));
+        if (!line_end) line_end = end;
+        // Slovo je posledné pole riadku (pred ním môže byť číslo kociek).
+        const char *word_end = line_end;
+        while (word_end > p && (word_end[-1] == '\r' || word_end[-1] == ' ' || word_end[-1] == '\t')) word_end--;
+        const char *word = word_end;
+        while (word > p && word[-1] != ' ' && word[-1] != '\t') word--;
+        p = line_end + 1;
+
+        char *out = builder->data + builder->data_length;
+        size_t length = (size_t)(word_end - word);
+        if (!normalize_word(word, length, out)) continue;
+
+        size_t slot = hash_word(out, length) & (slots - 1);
+        int duplicate = 0;
+        while (table[slot] != UINT32_MAX) {
+            uint32_t other = table[slot];
+            size_t other_length = builder->offsets[other + 1] - builder->offsets[other];
+            if (other_length == length && memcmp(builder->data + builder->offsets[other], out, length) == 0) {
+                duplicate = 1;
+                break;
+            }
+            slot = (slot + 1) & (slots - 1);
+        }
+        if (duplicate) continue;
+
+        table[slot] = builder->count;
+        builder->data_length += length;
+        builder->offsets[++builder->count] = (uint32_t)builder->data_length;
+    }
+    free(table);
+    munmap((void *)text, size);
+
+    uint32_t count = builder->count - first;
+    if (count < PASSPHRASE_MIN_LIST_SIZE) {
+        fprintf(stderr, "%s: slovník má len %u použiteľných slov (treba aspoň %d)\n",
+                file_name, count, PASSPHRASE_MIN_LIST_SIZE);
+        builder->count = first;
+        builder->data_length = builder->offsets[first];
+        return 0;
+    }
+
+    // Názov slovníka: názov súboru bez adresára a prípony.
+    const char *name = strrchr(file_name, '/');
+    name = name ? name + 1 : file_name;
+    size_t name_length = strcspn(name, ".");
+    if (name_length >= PASSPHRASE_LIST_NAME_SIZE) name_length = PASSPHRASE_LIST_NAME_SIZE - 1;
+    PassphraseList *list = &lists[list_count++];
+    memcpy(list->name, name, name_length);
+    list->name[name_length] = '\0';
+    list->first = first;
+    list->count = count;
+    list->bits_per_word = log2((double)count);
+    return 1;
+}
+
+/**
+ * @brief Pridá vstavaný slovník slabík.
+ */
+static void add_builtin_list(WordBuilder *builder) {
+    uint32_t first = builder->count;
+    for (int a = 0; a < 16; a++) {
+        for (int b = 0; b < 5; b++) {
+            for (int c = 0; c < 16; c++) {
+                for (int d = 0; d < 5; d++) {
+                    char *out = builder->data + builder->data_length;
+                    out[0] = builtin_consonants[a];
+                    out[1] = builtin_vowels[b];
+                    out[2] = builtin_consonants[c];
+                    out[3] = builtin_vowels[d];
+                    builder->data_length += BUILTIN_WORD_LENGTH;
+                    builder->offsets[++builder->count] = (uint32_t)builder->data_length;
+                }
+            }
+        }
+    }
+    PassphraseList *list = &lists[list_count++];
+    strcpy(list->name, PASSPHRASE_BUILTIN_LIST);
+    list->first = first;
+    list->count = BUILTIN_WORD_COUNT;
+    list->bits_per_word = log2((double)BUILTIN_WORD_COUNT);
+}
+
+int passphrase_init(const char *paths) {
+    // Horný odhad veľkosti: slov nie je viac ako bajtov.
+    size_t capacity = BUILTIN_WORD_COUNT * BUILTIN_WORD_LENGTH;
+    for (const char *p = paths; p && *p;) {
+        size_t length = strcspn(p, ":");
+        char file_name[4096];
+        if (length > 0 && length < sizeof(file_name)) {
+            memcpy(file_name, p, length);
+            file_name[length] = '\0';
+            struct stat info;
+            if (stat(file_name, &info) == 0) capacity += (size_t)info.st_size;
+        }
+        p += length + (p[length] == ':');
+    }
+    if (capacity > UINT32_MAX) {
+        fprintf(stderr, "Slovníky sú príliš veľké\n");
+        return 0;
+    }
+
+    WordBuilder builder;
+    builder.data = (char *)malloc(capacity + PASSPHRASE_MAX_WORD_LENGTH);
+    builder.offsets = (uint32_t *)malloc((capacity + 1) * sizeof(uint32_t));
+    builder.data_length = 0;
+    builder.count = 0;
+    if (!builder.data || !builder.offsets) {
+        free(builder.data);
+        free(builder.offsets);
+        return 0;
+    }
+    builder.offsets[0] = 0;
+
+    int ok = 1;
+    for (const char *p = paths; ok && p && *p;) {
+        size_t length = strcspn(p, ":");
+        if (length > 0) {
+            if (list_count == PASSPHRASE_MAX_LISTS - 1) {
+                fprintf(stderr, "Najviac %d slovníkov\n", PASSPHRASE_MAX_LISTS - 1);
+                ok = 0;
+            } else {
+                ok = load_list(&builder, p, length);
+            }
+        }
+        p += length + (p[length] == ':');
+    }
+    if (ok) add_builtin_list(&builder);
+
+    // Index a slová sa presunú do jedného bloku len na čítanie.
+    size_t index_size = ((size_t)builder.count + 1) * sizeof(uint32_t);
+    if (ok) {
+        blob_size = index_size + builder.data_length;
+        blob = mmap(NULL, blob_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (blob == MAP_FAILED) {
+            perror("mmap");
+            blob = NULL;
+            ok = 0;
+        }
+    }
+    if (ok) {
+        memcpy(blob, builder.offsets, index_size);
+        memcpy((char *)blob + index_size, builder.data, builder.data_length);
+        mprotect(blob, blob_size, PROT_READ);
+        word_offsets = (const uint32_t *)blob;
+        word_data = (const char *)blob + index_size;
+    } else {
+        list_count = 0;
+    }
+    free(builder.data);
+    free(builder.offsets);
+    return ok;
+}
+
+int passphrase_find_list(const char *name, size_t length) {
+    if (list_count == 0) return -1;
+    if (!name) return 0;
+    for (int i = 0; i < list_count; i++) {
+        if (strlen(lists[i].name) == length && memcmp(lists[i].name, name, length) == 0) return i;
+    }
+    return -1;
+}
+
+const char *passphrase_list_name(int list) {
+    return list >= 0 && list < list_count ? lists[list].name : NULL;
+}
+
+uint32_t passphrase_list_size(int list) {
+    return lists[list].count;
+}
+
+int passphrase_options_valid(const PassphraseOptions *options) {
+    if (options->list < 0 || options->list >= list_count) return 0;
+    if (options->words < 1 || options->words > PASSPHRASE_MAX_WORDS) return 0;
+    if (options->digits < 0 || options->digits > PASSPHRASE_MAX_DIGITS) return 0;
+    if (options->separator_length > PASSPHRASE_MAX_SEPARATOR) return 0;
+    // Písmeno alebo číslica v oddeľovači by hranice slov a číslic zahmlili
+    // a rôzne voľby by mohli dať rovnakú frázu.
+    for (size_t i = 0; i < options->separator_length; i++) {
+        char c = options->separator[i];
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return 0;
+    }
+    return options->separator_length > 0 || options->caps == PASSPHRASE_CAPS_FIRST;
+}
+
+double passphrase_entropy(const PassphraseOptions *options) {
+    double bits = options->words * lists[options->list].bits_per_word;
+    if (options->caps == PASSPHRASE_CAPS_RANDOM) bits += options->words;
+    if (options->digits > 0) {
+        bits += options->digits * log2(10.0) + log2((double)options->words);
+    }
+    return bits;
+}
+
+size_t passphrase_generate(const PassphraseOptions *options, char *output) {
+    const PassphraseList *list = &lists[options->list];
+    int digit_word = options->digits > 0 ? (int)random_uniform((uint32_t)options->words) : -1;
+    uint32_t caps_bits = options->caps == PASSPHRASE_CAPS_RANDOM ? random_u32() : 0;
+    size_t length = 0;
+
+    for (int i = 0; i < options->words; i++) {
+        if (i > 0) {
+            memcpy(output + length, options->separator, options->separator_length);
+            length += options->separator_length;
+        }
+        uint32_t word = list->first + random_uniform(list->count);
+        uint32_t start = word_offsets[word];
+        uint32_t word_length = word_offsets[word + 1] - start;
+        memcpy(output + length, word_data + start, word_length);
+        if (options->caps == PASSPHRASE_CAPS_FIRST || ((caps_bits >> i) & 1)) {
+            output[length] = (char)(output[length] - 'a' + 'A');
+        }
+        length += word_length;
+
+        if (i == digit_word) {
+            for (int d = 0; d < options->digits; d++) {
+                output[length++] = (char)('0' + random_uniform(10));
+            }
+        }
+    }
+    output[length] = '\0';
+    return length;
+}
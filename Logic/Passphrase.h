@@ -0,0 +1,98 @@
+#ifndef PASSPHRASE_H
+#define PASSPHRASE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Najviac slovníkov (súborov) a dĺžka ich názvu
+#define PASSPHRASE_MAX_LISTS 16
+#define PASSPHRASE_LIST_NAME_SIZE 32
+// Najdlhšie slovo, ktoré sa zo slovníka načíta (dlhšie sa preskočia)
+#define PASSPHRASE_MAX_WORD_LENGTH 24
+// Najmenší počet rôznych slov, s ktorým sa slovník použije
+#define PASSPHRASE_MIN_LIST_SIZE 16
+// Rozsahy volieb
+#define PASSPHRASE_MAX_WORDS 32
+#define PASSPHRASE_DEFAULT_WORDS 6
+#define PASSPHRASE_MAX_DIGITS 8
+#define PASSPHRASE_MAX_SEPARATOR 8
+// Najdlhšia vygenerovaná fráza vrátane ukončovacej nuly
+#define PASSPHRASE_MAX_LENGTH (PASSPHRASE_MAX_WORDS * (PASSPHRASE_MAX_WORD_LENGTH + PASSPHRASE_MAX_SEPARATOR) + \
+                               PASSPHRASE_MAX_DIGITS + 1)
+// Názov vstavaného slovníka slabík, ktorý je k dispozícii vždy
+#define PASSPHRASE_BUILTIN_LIST "syllables"
+
+// Veľké písmená v slovách frázy.
+typedef enum {
+    PASSPHRASE_CAPS_NONE,        // všetko malými písmenami (0 bitov)
+    PASSPHRASE_CAPS_FIRST,       // Prvé Písmeno Každého Slova (0 bitov)
+    PASSPHRASE_CAPS_RANDOM       // každé slovo náhodne s veľkým začiatkom (1 bit na slovo)
+} PassphraseCaps;
+
+// Voľby generovania frázy.
+typedef struct {
+    int list;                    // Index slovníka (passphrase_find_list()).
+    int words;                   // Počet slov (1 až PASSPHRASE_MAX_WORDS).
+    const char *separator;       // Oddeľovač slov (bez písmen a číslic).
+    size_t separator_length;
+    PassphraseCaps caps;
+    int digits;                  // Počet náhodných číslic vložených za náhodné slovo.
+} PassphraseOptions;
+
+/**
+ * @brief Načíta slovníky a zostaví z nich jeden blok pamäte s indexom.
+ *
+ * `paths` sú súbory oddelené dvojbodkou; riadok je slovo, prípadne s
+ * číslom pred ním (formát diceware "11111 slovo"). Slová sa prevedú na
+ * malé písmená; slová s inými znakmi ako a-z a duplicity sa vynechajú,
+ * aby bola každá fráza jednoznačná a entropia presná. Názov slovníka je
+ * názov súboru bez prípony. Vstavaný slovník PASSPHRASE_BUILTIN_LIST sa
+ * pridá vždy ako posledný. Volá sa raz pri štarte, pred spustením vlákien.
+ *
+ * @param paths Zoznam súborov alebo NULL (len vstavaný slovník).
+ * @return 1 pri úspechu, 0 ak niektorý súbor nejde načítať.
+ */
+int passphrase_init(const char *paths);
+
+/**
+ * @brief Nájde slovník podľa názvu.
+ *
+ * @param name Názov (nemusí byť ukončený nulou) alebo NULL pre predvolený (prvý).
+ * @return Index slovníka alebo -1.
+ */
+int passphrase_find_list(const char *name, size_t length);
+
+/**
+ * @brief Vráti názov (NULL za posledným slovníkom) a počet slov slovníka.
+ */
+const char *passphrase_list_name(int list);
+uint32_t passphrase_list_size(int list);
+
+/**
+ * @brief Skontroluje voľby (rozsahy a oddeľovač, ktorý zachová jednoznačnosť).
+ *
+ * Prázdny oddeľovač je dovolený len s PASSPHRASE_CAPS_FIRST, kde hranice
+ * slov určujú veľké písmená.
+ *
+ * @return 1 ak sú voľby platné, inak 0.
+ */
+int passphrase_options_valid(const PassphraseOptions *options);
+
+/**
+ * @brief Presná entropia frázy v bitoch pre dané voľby.
+ *
+ * words * log2(veľkosť slovníka), plus 1 bit na slovo pri náhodných
+ * veľkých písmenách, plus digits * log2(10) a log2(words) za pozíciu číslic.
+ */
+double passphrase_entropy(const PassphraseOptions *options);
+
+/**
+ * @brief Vygeneruje frázu; nealokuje pamäť, výber slova je O(1).
+ *
+ * @param options Platné voľby (passphrase_options_valid()).
+ * @param output Buffer s aspoň PASSPHRASE_MAX_LENGTH bajtmi.
+ * @return Dĺžka frázy (bez ukončovacej nuly).
+ */
+size_t passphrase_generate(const PassphraseOptions *options, char *output);
+
+#endif // PASSPHRASE_H
@@ -1,4 +1,11 @@
 #include "Password.h"
+#include "Random.h"
+#include "Classify.h"
+#include "Breach.h"
+#include "Patterns.h"
+#include "Policy.h"
+#include "Markov.h"
+#include <math.h>
 
 // Definície konštantných znakových sád pre generovanie hesiel.
 static const char lowercase_chars[] = "abcdefghijklmnopqrstuvwxyz";
@@ -6,12 +13,16 @@ static const char uppercase_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 static const char number_chars[] = "0123456789";
 static const char special_chars[] = "!@#$%^&*()_+-=[]{}|;:,.<>?";
 
+static int entropy_from_stats(const CharClassStats *stats);
+
 /**
  * @brief Generuje náhodné heslo na základe špecifikovaných kritérií.
  *
  * Funkcia vytvára heslo požadovanej dĺžky, pričom zaručuje, že bude obsahovať
  * aspoň jeden znak z každej zvolenej kategórie (malé/veľké písmená, čísla, špeciálne znaky).
  * Zvyšok hesla je doplnený náhodnými znakmi a celé heslo je nakoniec premiešané.
+ * Sady znakov pre každú kombináciu kategórií sú predpočítané (Policy.h), takže
+ * sa pri volaní nič neskladá.
  */
 int generate_password(char *password, int length, int include_special, 
                      int include_numbers, int include_uppercase, int include_lowercase) {
@@ -19,67 +30,10 @@ int generate_password(char *password, int length, int include_special,
     if (!password || length < MIN_PASSWORD_LENGTH || length > MAX_PASSWORD_LENGTH) {
         return 0;
     }
-    
-    // Ak nie je vybraná žiadna sada znakov, použijú sa všetky ako predvolené.
-    if (!include_lowercase && !include_uppercase && !include_numbers && !include_special) {
-        include_lowercase = include_uppercase = include_numbers = include_special = 1;
-    }
-    
-    // Vytvorenie kompletnej sady povolených znakov (charset).
-    char charset[256] = "";
-    int charset_len = 0;
-    
-    if (include_lowercase) {
-        strcat(charset, lowercase_chars);
-        charset_len += strlen(lowercase_chars);
-    }
-    if (include_uppercase) {
-        strcat(charset, uppercase_chars);
-        charset_len += strlen(uppercase_chars);
-    }
-    if (include_numbers) {
-        strcat(charset, number_chars);
-        charset_len += strlen(number_chars);
-    }
-    if (include_special) {
-        strcat(charset, special_chars);
-        charset_len += strlen(special_chars);
-    }
-    
-    // Inicializácia generátora náhodných čísel.
-    srand(time(NULL));
-    
-    // Zabezpečenie, že heslo obsahuje aspoň jeden znak z každej požadovanej kategórie.
-    int pos = 0;
-    
-    if (include_lowercase && pos < length) {
-        password[pos++] = lowercase_chars[rand() % strlen(lowercase_chars)];
-    }
-    if (include_uppercase && pos < length) {
-        password[pos++] = uppercase_chars[rand() % strlen(uppercase_chars)];
-    }
-    if (include_numbers && pos < length) {
-        password[pos++] = number_chars[rand() % strlen(number_chars)];
-    }
-    if (include_special && pos < length) {
-        password[pos++] = special_chars[rand() % strlen(special_chars)];
-    }
-    
-    // Doplnenie zvyšku hesla náhodnými znakmi z vytvorenej sady.
-    while (pos < length) {
-        password[pos++] = charset[rand() % charset_len];
-    }
-    
-    // Premiešanie znakov v hesle (Fisher-Yates shuffle) pre zvýšenie náhodnosti.
-    for (int i = length - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        char temp = password[i];
-        password[i] = password[j];
-        password[j] = temp;
-    }
-    
-    password[length] = '\0'; // Ukončenie reťazca.
-    return 1;
+    // Ak nie je vybraná žiadna sada znakov, politika použije všetky.
+    const PasswordPolicy *policy = policy_for_classes(include_special, include_numbers,
+                                                      include_uppercase, include_lowercase);
+    return policy_generate(policy, length, password);
 }
 
 /**
@@ -94,8 +48,10 @@ int strengthen_password(const char *weak_password, char *strong_password) {
         return 0;
     }
     
-    // Skopírovanie pôvodného hesla.
-    strcpy(strong_password, weak_password);
+    // Skopírovanie pôvodného hesla (najviac MAX_PASSWORD_LENGTH znakov, aby
+    // príliš dlhý vstup neprepísal buffer volajúceho).
+    strncpy(strong_password, weak_password, MAX_PASSWORD_LENGTH);
+    strong_password[MAX_PASSWORD_LENGTH] = '\0';
     int current_length = strlen(strong_password);
     
     // Pridanie chýbajúcich typov znakov.
@@ -108,12 +64,9 @@ int strengthen_password(const char *weak_password, char *strong_password) {
         strcat(charset, uppercase_chars);
         strcat(charset, number_chars);
         strcat(charset, special_chars);
-        
-        // Inicializácia generátora náhodných čísel.
-        srand(time(NULL));
 
         while (current_length < STRONG_PASSWORD_LENGTH) {
-            strong_password[current_length++] = charset[rand() % strlen(charset)];
+            strong_password[current_length++] = charset[random_uniform(strlen(charset))];
         }
         strong_password[current_length] = '\0';
     }
@@ -133,26 +86,69 @@ int strengthen_password(const char *weak_password, char *strong_password) {
  * @brief Vyhodnocuje silu hesla na základe viacerých kritérií.
  *
  * Funkcia analyzuje dĺžku, prítomnosť rôznych typov znakov a vypočítanú entropiu.
- * Na základe toho priradí skóre (0-100) a vygeneruje textovú spätnú väzbu
- * s odporúčaniami na zlepšenie.
+ * Na základe toho priradí skóre (0-100) a dôvody, z ktorých sa zostaví
+ * spätná väzba s odporúčaniami na zlepšenie.
  */
 int evaluate_password_strength(const char *password, PasswordStrength *result) {
     if (!password || !result) {
         return 0;
     }
     
+    // Dĺžka aj prítomnosť jednotlivých typov znakov jedným prechodom.
+    CharClassStats stats;
+    classify_password(password, &stats);
+    return evaluate_classified_password(password, stats.length, &stats, PASSWORD_CHECK_ALL, result);
+}
+
+/**
+ * @brief Vyhodnotí heslo zadané dĺžkou len vybranými kontrolami.
+ *
+ * Dávkové vyhodnocovanie (libpassword, /api/evaluate/batch) tak nemusí
+ * heslá kopírovať, aby ich ukončilo nulou.
+ */
+int evaluate_password_bytes(const char *password, size_t length, unsigned int checks,
+                            PasswordStrength *result) {
+    if (!password || !result) {
+        return 0;
+    }
+
+    CharClassStats stats;
+    classify_bytes(password, length, &stats);
+    return evaluate_classified_password(password, length, &stats, checks, result);
+}
+
+int evaluate_classified_password(const char *password, size_t length, const CharClassStats *stats,
+                                 unsigned int checks, PasswordStrength *result) {
+    if (!evaluate_password_classes(stats, result)) {
+        return 0;
+    }
+    if (checks & PASSWORD_CHECK_PATTERNS) apply_pattern_penalty(password, length, result);
+    if (checks & PASSWORD_CHECK_MARKOV) apply_markov_penalty(password, length, result);
+    if (checks & PASSWORD_CHECK_BREACH) apply_breach_penalty(password, length, result);
+    return 1;
+}
+
+/**
+ * @brief Vyhodnotí silu hesla z výsledku jeho klasifikácie.
+ *
+ * Obsahuje samotné pravidlá hodnotenia; `evaluate_password_strength()`
+ * aj offline audit ich tak zdieľajú.
+ */
+int evaluate_password_classes(const CharClassStats *stats, PasswordStrength *result) {
+    if (!stats || !result) {
+        return 0;
+    }
+    
     // Inicializácia výslednej štruktúry.
     result->is_strong = 0;
     result->score = 0;
-    strcpy(result->feedback, "");
+    result->reasons = 0;
     
-    int length = strlen(password);
-    
-    // Zistenie prítomnosti jednotlivých typov znakov.
-    int has_lower = has_lowercase(password);
-    int has_upper = has_uppercase(password);
-    int has_nums = has_numbers(password);
-    int has_special = has_special_chars(password);
+    int length = (int)stats->length;
+    int has_lower = (stats->mask & CHAR_CLASS_LOWER) != 0;
+    int has_upper = (stats->mask & CHAR_CLASS_UPPER) != 0;
+    int has_nums = (stats->mask & CHAR_CLASS_DIGIT) != 0;
+    int has_special = (stats->mask & CHAR_CLASS_SPECIAL) != 0;
     
     // Výpočet skóre na základe dĺžky.
     int score = 0;
@@ -168,7 +164,8 @@ int evaluate_password_strength(const char *password, PasswordStrength *result) {
     if (has_special) score += 10;
     
     // Pridelenie bodov za (zjednodušenú) entropiu.
-    int entropy = calculate_entropy(password);
+    int entropy = entropy_from_stats(stats);
+    result->guesses_log10 = entropy * 0.30102999566398120; // log10(2^entropia)
     if (entropy >= 60) score += 20;
     else if (entropy >= 40) score += 15;
     else if (entropy >= 30) score += 10;
@@ -181,91 +178,199 @@ int evaluate_password_strength(const char *password, PasswordStrength *result) {
     result->is_strong = (score >= 80 && length >= MIN_PASSWORD_LENGTH && 
                         has_lower && has_upper && has_nums && has_special);
     
-    // Vytvorenie textovej spätnej väzby pre používateľa.
-    char feedback[256] = "";
-    
-    if (result->is_strong) {
-        strcat(feedback, "Heslo je silné!");
-    } else {
-        // Zostavenie reťazca s odporúčaniami bez úvodnej vety "Heslo je slabé."
-        char recommendations[200] = "";
-        
-        if (length < MIN_PASSWORD_LENGTH) {
-            strcat(recommendations, "Použite aspoň 8 znakov. ");
-        }
-        if (!has_lower) {
-            strcat(recommendations, "Pridajte malé písmená. ");
-        }
-        if (!has_upper) {
-            strcat(recommendations, "Pridajte veľké písmená. ");
-        }
-        if (!has_nums) {
-            strcat(recommendations, "Pridajte čísla. ");
-        }
-        if (!has_special) {
-            strcat(recommendations, "Pridajte špeciálne znaky. ");
-        }
+    // Odporúčania (len pre heslo, ktoré nie je silné).
+    if (!result->is_strong) {
+        if (length < MIN_PASSWORD_LENGTH) result->reasons |= PASSWORD_REASON_TOO_SHORT;
+        if (!has_lower) result->reasons |= PASSWORD_REASON_NO_LOWER;
+        if (!has_upper) result->reasons |= PASSWORD_REASON_NO_UPPER;
+        if (!has_nums) result->reasons |= PASSWORD_REASON_NO_DIGIT;
+        if (!has_special) result->reasons |= PASSWORD_REASON_NO_SPECIAL;
+    }
+    return 1;
+}
 
-        // Ak existujú nejaké odporúčania, pridá sa k nim úvodný text.
-        if (strlen(recommendations) > 0) {
-            sprintf(feedback, "Odporúčania: %s", recommendations);
-        }
+// Texty odporúčaní v poradí bitov PASSWORD_REASON_* (okrem BREACHED).
+static const char *const reason_texts[PASSWORD_REASON_COUNT - 1] = {
+    "Použite aspoň 8 znakov. ",
+    "Pridajte malé písmená. ",
+    "Pridajte veľké písmená. ",
+    "Pridajte čísla. ",
+    "Pridajte špeciálne znaky. ",
+    "Nepoužívajte bežné slová, mená a heslá. ",
+    "Náhrady ako @ za a heslo nezosilnia. ",
+    "Vyhnite sa radom klávesov (qwerty). ",
+    "Vyhnite sa opakovaniam. ",
+    "Vyhnite sa postupnostiam (1234, abcd). ",
+    "Vyhnite sa letopočtom. ",
+    "Heslo je predvídateľné, podobá sa bežným heslám. ",
+};
+
+/**
+ * @brief Pripojí text k spätnej väzbe, ak sa do buffera zmestí celý.
+ */
+static size_t append_feedback(char *out, size_t size, size_t used, const char *text) {
+    size_t length = strlen(text);
+    if (used + length >= size) return used;
+    memcpy(out + used, text, length + 1);
+    return used + length;
+}
+
+/**
+ * @brief Zostaví spätnú väzbu: dôvod úniku, potom "Odporúčania: " a texty
+ *        dôvodov v poradí bitov; silné heslo dostane "Heslo je silné!".
+ */
+size_t format_password_feedback(unsigned int reasons, int is_strong, char *out, size_t size) {
+    if (size == 0) return 0;
+    out[0] = '\0';
+    size_t used = 0;
+    unsigned int advice = reasons & ~PASSWORD_REASON_BREACHED;
+    if (reasons & PASSWORD_REASON_BREACHED) {
+        used = append_feedback(out, size, used, "Heslo sa nachádza v zozname uniknutých hesiel. ");
+        if (!advice) return append_feedback(out, size, used, "Zvoľte iné heslo.");
+    } else if (!advice) {
+        return is_strong ? append_feedback(out, size, used, "Heslo je silné!") : 0;
     }
-    
-    strcpy(result->feedback, feedback);
+    used = append_feedback(out, size, used, "Odporúčania: ");
+    for (int i = 0; i < PASSWORD_REASON_COUNT - 1; i++) {
+        if (advice & (1u << i)) used = append_feedback(out, size, used, reason_texts[i]);
+    }
+    return used;
+}
+
+/**
+ * @brief Obmedzí skóre ľahko uhádnuteľného hesla.
+ *
+ * Hranice počtu pokusov zodpovedajú stupňom 0-3 v zxcvbn.
+ */
+static void limit_guessable_score(PasswordStrength *result, double guesses_log10) {
+    int cap;
+    if (guesses_log10 < 3.0) cap = 10;
+    else if (guesses_log10 < 6.0) cap = 30;
+    else if (guesses_log10 < 8.0) cap = 50;
+    else cap = 70;
+    if (result->score > cap) result->score = cap;
+    result->is_strong = 0;
+}
+
+/**
+ * @brief Obmedzí skóre hesla, ktoré sa dá uhádnuť podľa vzorov.
+ *
+ * Heslo, ktoré potrebuje aspoň 10^10 pokusov, sa hodnotí len podľa
+ * pôvodných pravidiel.
+ */
+int apply_pattern_penalty(const char *password, size_t length, PasswordStrength *result) {
+    if (!password || !result) {
+        return 0;
+    }
+
+    PatternEstimate estimate;
+    estimate_password_guesses(password, length, &estimate);
+    if (estimate.guesses_log10 < result->guesses_log10) result->guesses_log10 = estimate.guesses_log10;
+    if (!estimate.patterns || estimate.guesses_log10 >= PATTERN_SAFE_GUESSES_LOG10) {
+        return 0;
+    }
+
+    limit_guessable_score(result, estimate.guesses_log10);
+    if (estimate.patterns & PATTERN_DICTIONARY) result->reasons |= PASSWORD_REASON_DICTIONARY;
+    if (estimate.patterns & PATTERN_LEET) result->reasons |= PASSWORD_REASON_LEET;
+    if (estimate.patterns & PATTERN_KEYBOARD) result->reasons |= PASSWORD_REASON_KEYBOARD;
+    if (estimate.patterns & PATTERN_REPEAT) result->reasons |= PASSWORD_REASON_REPEAT;
+    if (estimate.patterns & PATTERN_SEQUENCE) result->reasons |= PASSWORD_REASON_SEQUENCE;
+    if (estimate.patterns & PATTERN_YEAR) result->reasons |= PASSWORD_REASON_YEAR;
+    return 1;
+}
+
+/**
+ * @brief Obmedzí skóre hesla, ktoré Markovov model považuje za pravdepodobné.
+ *
+ * Model zachytí aj ľudské heslá bez známych slov (napr. vymyslené slová
+ * s bežnými koncovkami), ktoré pravidlá o triedach znakov preceňujú.
+ */
+int apply_markov_penalty(const char *password, size_t length, PasswordStrength *result) {
+    if (!password || !result) {
+        return 0;
+    }
+
+    double guesses_log10 = markov_guesses_log10(password, length);
+    if (guesses_log10 < 0) return 0;
+    if (guesses_log10 < result->guesses_log10) result->guesses_log10 = guesses_log10;
+    if (guesses_log10 >= MARKOV_SAFE_GUESSES_LOG10) return 0;
+
+    limit_guessable_score(result, guesses_log10);
+    result->reasons |= PASSWORD_REASON_PREDICTABLE;
+    return 1;
+}
+
+/**
+ * @brief Zníži hodnotenie hesla nájdeného v indexe uniknutých hesiel.
+ *
+ * Také heslo je slabé bez ohľadu na dĺžku a typy znakov, lebo ho útočníci
+ * skúšajú medzi prvými. Ostatné dôvody zostanú.
+ */
+int apply_breach_penalty(const char *password, size_t length, PasswordStrength *result) {
+    if (!password || !result || !breach_index_contains(password, length)) {
+        return 0;
+    }
+
+    result->reasons |= PASSWORD_REASON_BREACHED;
+    result->is_strong = 0;
+    if (result->score > BREACH_MAX_SCORE) result->score = BREACH_MAX_SCORE;
+    // Útočník skúša celý zoznam; heslo z neho nepotrebuje viac pokusov, ako má zoznam.
+    double list_log10 = log10((double)breach_index_count());
+    if (list_log10 < result->guesses_log10) result->guesses_log10 = list_log10;
     return 1;
 }
 
 // --- Pomocné funkcie na kontrolu znakov ---
 
-// Kontroluje, či reťazec obsahuje aspoň jedno malé písmeno.
-int has_lowercase(const char *password) {
-    for (int i = 0; password[i]; i++) {
-        if (islower(password[i])) return 1;
+/**
+ * @brief Zistí, či reťazec obsahuje znak z danej triedy.
+ *
+ * Prechádza len po prvý výskyt, tabuľka nahrádza volania islower()/strchr().
+ */
+static int has_char_class(const char *password, unsigned int char_class) {
+    const unsigned char *data = (const unsigned char *)password;
+    for (size_t i = 0; data[i]; i++) {
+        if ((1u << char_class_table[data[i]]) & char_class) return 1;
     }
     return 0;
 }
 
+// Kontroluje, či reťazec obsahuje aspoň jedno malé písmeno.
+int has_lowercase(const char *password) {
+    return has_char_class(password, CHAR_CLASS_LOWER);
+}
+
 // Kontroluje, či reťazec obsahuje aspoň jedno veľké písmeno.
 int has_uppercase(const char *password) {
-    for (int i = 0; password[i]; i++) {
-        if (isupper(password[i])) return 1;
-    }
-    return 0;
+    return has_char_class(password, CHAR_CLASS_UPPER);
 }
 
 // Kontroluje, či reťazec obsahuje aspoň jedno číslo.
 int has_numbers(const char *password) {
-    for (int i = 0; password[i]; i++) {
-        if (isdigit(password[i])) return 1;
-    }
-    return 0;
+    return has_char_class(password, CHAR_CLASS_DIGIT);
 }
 
 // Kontroluje, či reťazec obsahuje aspoň jeden špeciálny znak.
 int has_special_chars(const char *password) {
-    for (int i = 0; password[i]; i++) {
-        if (strchr(special_chars, password[i])) return 1;
-    }
-    return 0;
+    return has_char_class(password, CHAR_CLASS_SPECIAL);
 }
 
 /**
- * @brief Vypočíta zjednodušenú entropiu hesla.
+ * @brief Vypočíta zjednodušenú entropiu z výsledku klasifikácie.
  *
- * Entropia je miera nepredvídateľnosti. Táto funkcia ju aproximuje na základe
+ * Entropia je miera nepredvídateľnosti. Aproximuje sa na základe
  * veľkosti použitej znakovej sady a dĺžky hesla.
  */
-int calculate_entropy(const char *password) {
+static int entropy_from_stats(const CharClassStats *stats) {
     int charset_size = 0;
     
-    if (has_lowercase(password)) charset_size += 26;
-    if (has_uppercase(password)) charset_size += 26;
-    if (has_numbers(password)) charset_size += 10;
-    if (has_special_chars(password)) charset_size += strlen(special_chars);
+    if (stats->mask & CHAR_CLASS_LOWER) charset_size += 26;
+    if (stats->mask & CHAR_CLASS_UPPER) charset_size += 26;
+    if (stats->mask & CHAR_CLASS_DIGIT) charset_size += 10;
+    if (stats->mask & CHAR_CLASS_SPECIAL) charset_size += sizeof(special_chars) - 1;
     
     // Zjednodušený výpočet entropie: log2(veľkosť_sady) * dĺžka
-    int length = strlen(password);
     double entropy_per_char = 0;
     
     if (charset_size > 0) {
@@ -277,7 +382,18 @@ int calculate_entropy(const char *password) {
         else entropy_per_char = 3.3;                         // Len čísla (10)
     }
     
-    return (int)(entropy_per_char * length);
+    return (int)(entropy_per_char * (double)stats->length);
+}
+
+/**
+ * @brief Vypočíta zjednodušenú entropiu hesla.
+ *
+ * Heslo sa klasifikuje jedným prechodom (pozri `classify_password()`).
+ */
+int calculate_entropy(const char *password) {
+    CharClassStats stats;
+    classify_password(password, &stats);
+    return entropy_from_stats(&stats);
 }
 
 /**
@@ -287,19 +403,17 @@ int calculate_entropy(const char *password) {
  * Ak niektorý typ chýba, pridá na koniec hesla jeden náhodný znak daného typu.
  */
 void add_missing_characters(char *password, int *length) {
-    srand(time(NULL));
-    
     if (!has_lowercase(password) && *length < MAX_PASSWORD_LENGTH - 1) {
-        password[(*length)++] = lowercase_chars[rand() % strlen(lowercase_chars)];
+        password[(*length)++] = lowercase_chars[random_uniform(strlen(lowercase_chars))];
     }
     if (!has_uppercase(password) && *length < MAX_PASSWORD_LENGTH - 1) {
-        password[(*length)++] = uppercase_chars[rand() % strlen(uppercase_chars)];
+        password[(*length)++] = uppercase_chars[random_uniform(strlen(uppercase_chars))];
     }
     if (!has_numbers(password) && *length < MAX_PASSWORD_LENGTH - 1) {
-        password[(*length)++] = number_chars[rand() % strlen(number_chars)];
+        password[(*length)++] = number_chars[random_uniform(strlen(number_chars))];
     }
     if (!has_special_chars(password) && *length < MAX_PASSWORD_LENGTH - 1) {
-        password[(*length)++] = special_chars[rand() % strlen(special_chars)];
+        password[(*length)++] = special_chars[random_uniform(strlen(special_chars))];
     }
     
     password[*length] = '\0';
@@ -316,7 +430,7 @@ void shuffle_password(char *password) {
     if (length <= 1) return;
 
     for (int i = length - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
+        int j = random_uniform(i + 1);
         char temp = password[i];
         password[i] = password[j];
         password[j] = temp;
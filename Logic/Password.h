@@ -6,17 +6,28 @@
 #include <string.h>
 #include <time.h>
 #include <ctype.h>
+#include "Classify.h"
+#include "LibPassword.h"
 
 // Konštanty pre prácu s heslami
 #define MIN_PASSWORD_LENGTH 8
 #define MAX_PASSWORD_LENGTH 128
 #define STRONG_PASSWORD_LENGTH 12
 
+// Rýchlosti útokov (pokusy za sekundu) pre odhad času prelomenia hesla:
+// obmedzené online prihlasovanie, online bez obmedzenia, offline útok
+// na pomalý haš (bcrypt) a offline útok na rýchly haš (SHA-1) s GPU.
+#define CRACK_RATE_ONLINE_THROTTLED (100.0 / 3600.0)
+#define CRACK_RATE_ONLINE 10.0
+#define CRACK_RATE_OFFLINE_SLOW 1e4
+#define CRACK_RATE_OFFLINE_FAST 1e10
+
 // Štruktúra pre výsledok vyhodnotenia sily hesla
 typedef struct {
     int is_strong;          // 1, ak je heslo silné, inak 0.
     int score;             // Celkové skóre sily hesla (0-100).
-    char feedback[256];    // Textová spätná väzba s odporúčaniami na zlepšenie.
+    unsigned int reasons;  // Dôvody nižšieho hodnotenia (PASSWORD_REASON_*); text zostaví format_password_feedback().
+    double guesses_log10;  // log10 odhadu počtu pokusov (najmenší z hrubej sily, vzorov, modelu a indexu).
 } PasswordStrength;
 
 /**
@@ -48,6 +59,76 @@ int strengthen_password(const char *weak_password, char *strong_password);
  */
 int evaluate_password_strength(const char *password, PasswordStrength *result);
 
+/**
+ * Vyhodnocuje silu hesla z už vypočítanej klasifikácie jeho znakov
+ * (napr. pre vstup, ktorý nie je ukončený nulou).
+ * @param stats Výsledok `classify_password()` alebo `classify_bytes()`.
+ * @param result Ukazovateľ na štruktúru, kde sa uložia výsledky hodnotenia.
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int evaluate_password_classes(const CharClassStats *stats, PasswordStrength *result);
+
+/**
+ * Vyhodnocuje silu hesla, ktoré nemusí byť ukončené nulou, len vybranými kontrolami.
+ * @param password Heslo.
+ * @param length Dĺžka hesla v bajtoch.
+ * @param checks Kontroly nad rámec pravidiel o triedach znakov (PASSWORD_CHECK_*).
+ * @param result Ukazovateľ na štruktúru, kde sa uložia výsledky hodnotenia.
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int evaluate_password_bytes(const char *password, size_t length, unsigned int checks,
+                            PasswordStrength *result);
+
+/**
+ * Ako `evaluate_password_bytes()`, ale s už vypočítanou klasifikáciou znakov
+ * (offline audit ju potrebuje aj pre vlastné štatistiky).
+ * @param stats Výsledok `classify_bytes()` pre to isté heslo.
+ * @return 1 pri úspechu, 0 pri chybe.
+ */
+int evaluate_classified_password(const char *password, size_t length, const CharClassStats *stats,
+                                 unsigned int checks, PasswordStrength *result);
+
+/**
+ * Zostaví textovú spätnú väzbu s odporúčaniami z dôvodov hodnotenia.
+ * @param reasons Dôvody (PASSWORD_REASON_*).
+ * @param is_strong 1 ak je heslo silné ("Heslo je silné!").
+ * @param out Buffer s aspoň PASSWORD_FEEDBACK_SIZE bajtmi (kratší text oreže).
+ * @param size Veľkosť buffera.
+ * @return Dĺžka textu bez ukončovacej nuly.
+ */
+size_t format_password_feedback(unsigned int reasons, int is_strong, char *out, size_t size);
+
+/**
+ * Odhadne počet pokusov na uhádnutie hesla podľa vzorov (slová, klávesové
+ * postupnosti, opakovania...; pozri Patterns.h). Ak heslo obsahuje vzor a je
+ * ľahko uhádnuteľné, obmedzí skóre a doplní dôvody.
+ * @param password Heslo (nemusí byť ukončené nulou).
+ * @param length Dĺžka hesla v bajtoch.
+ * @param result Výsledok z `evaluate_password_classes()`, ktorý sa upraví.
+ * @return 1 ak sa hodnotenie zmenilo, inak 0.
+ */
+int apply_pattern_penalty(const char *password, size_t length, PasswordStrength *result);
+
+/**
+ * Odhadne počet pokusov Markovovým modelom (pozri Markov.h), ak je načítaný.
+ * Ak je heslo podľa modelu predvídateľné, obmedzí skóre a doplní dôvod.
+ * @param password Heslo (nemusí byť ukončené nulou).
+ * @param length Dĺžka hesla v bajtoch.
+ * @param result Výsledok z `evaluate_password_classes()`, ktorý sa upraví.
+ * @return 1 ak sa hodnotenie zmenilo, inak 0.
+ */
+int apply_markov_penalty(const char *password, size_t length, PasswordStrength *result);
+
+/**
+ * Skontroluje heslo v indexe uniknutých hesiel (pozri Breach.h) a ak sa v ňom
+ * nachádza, zníži skóre na najviac BREACH_MAX_SCORE a doplní dôvod.
+ * @param password Heslo (nemusí byť ukončené nulou).
+ * @param length Dĺžka hesla v bajtoch.
+ * @param result Výsledok z `evaluate_password_classes()`, ktorý sa upraví.
+ * @return 1 ak sa heslo v indexe našlo, inak 0.
+ */
+int apply_breach_penalty(const char *password, size_t length, PasswordStrength *result);
+
 // --- Pomocné (interné) funkcie ---
 
 int has_lowercase(const char *password); // Kontroluje prítomnosť malých písmen.
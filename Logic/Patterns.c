@@ -0,0 +1,616 @@
+#include "Patterns.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Počet pokusov na jeden znak, ktorý nepatrí do žiadneho vzoru (ako v zxcvbn)
+#define PATTERN_BRUTEFORCE_CARDINALITY 10
+// Najmenší počet pokusov pre vzor dlhší ako jeden znak
+#define PATTERN_MIN_SUBMATCH_GUESSES 50
+// Klávesové postupnosti: počet klávesov, z ktorých môže začať, a priemerný počet susedov
+#define KEYBOARD_STARTING_KEYS 94
+#define KEYBOARD_AVERAGE_DEGREE 4
+// Letopočty od-do, ktoré sa považujú za vzor
+#define PATTERN_MIN_YEAR 1900
+#define PATTERN_MAX_YEAR 2049
+// Najmenší počet pokusov pre letopočet (roky blízko súčasnosti)
+#define PATTERN_MIN_YEAR_SPACE 20
+// Počiatočná kapacita automatu (počet stavov)
+#define PATTERN_INITIAL_STATES 4096
+// Stavy sa indexujú 16-bitovo
+#define PATTERN_MAX_STATES 65535
+
+/*
+ * Slovníky. Poradie v zozname je poradie podľa častosti, takže index + 1
+ * je počet pokusov, po ktorých útočník skúšajúci slová v tomto poradí
+ * na slovo narazí.
+ */
+static const char *const common_passwords[] = {
+    "123456", "password", "12345678", "qwerty", "123456789", "12345", "1234", "111111",
+    "1234567", "dragon", "123123", "baseball", "abc123", "football", "monkey", "letmein",
+    "696969", "shadow", "master", "666666", "qwertyuiop", "123321", "mustang", "1234567890",
+    "michael", "654321", "superman", "1qaz2wsx", "7777777", "121212", "000000", "qazwsx",
+    "123qwe", "killer", "trustno1", "jordan", "jennifer", "zxcvbnm", "asdfgh", "hunter",
+    "buster", "soccer", "harley", "batman", "andrew", "tigger", "sunshine", "iloveyou",
+    "2000", "charlie", "robert", "thomas", "hockey", "ranger", "daniel", "starwars",
+    "klaster", "112233", "george", "computer", "michelle", "jessica", "pepper", "1111",
+    "zxcvbn", "555555", "11111111", "131313", "freedom", "777777", "pass", "maggie",
+    "159753", "aaaaaa", "ginger", "princess", "joshua", "cheese", "amanda", "summer",
+    "love", "ashley", "nicole", "chelsea", "biteme", "matthew", "access", "yankees",
+    "987654321", "dallas", "austin", "thunder", "taylor", "matrix", "welcome", "admin",
+    "login", "passw0rd", "qwerty123", "1q2w3e4r", "1q2w3e", "123abc", "secret", "whatever",
+    "hello", "hello123", "changeme", "default", "test", "test123", "guest", "root",
+    "administrator", "letmein1", "welcome1", "password1", "password123", "p@ssw0rd", "qwe123", "zaq12wsx",
+    "asdf1234", "monkey123", "dragon123", "football1", "baseball1", "sunshine1", "princess1", "iloveyou1",
+    "flower", "hottie", "lovely", "loveme", "angel", "babygirl", "qwer1234", "1qazxsw2",
+    "asdfghjkl", "qazwsxedc", "abcd1234", "abcdef", "abcdefg", "football123", "samsung", "internet",
+    "google", "killer123", "master123", "shadow123", "superman1", "batman123", "pokemon", "minecraft",
+    "starwars1", "whatever1", "trustno1!", "q1w2e3r4", "q1w2e3r4t5", "1q2w3e4r5t", "zxcvbnm123", "asdfasdf",
+    "heslo", "heslo123", "slovensko", "bratislava", "laska", "mojeheslo", "tajne", "tajneheslo",
+};
+
+static const char *const english_words[] = {
+    "love", "god", "money", "life", "house", "family", "friend", "summer", "winter", "spring",
+    "autumn", "happy", "lucky", "star", "blue", "red", "green", "black", "white", "orange",
+    "apple", "banana", "cherry", "chocolate", "coffee", "cookie", "dog", "cat", "puppy", "kitty",
+    "tiger", "lion", "eagle", "falcon", "wolf", "bear", "horse", "dragon", "phoenix", "angel",
+    "devil", "heaven", "hell", "magic", "music", "guitar", "piano", "rock", "metal", "soccer",
+    "hockey", "tennis", "golf", "football", "baseball", "basketball", "computer", "internet",
+    "secret", "private", "security", "access", "master", "admin", "super", "power", "energy",
+    "hero", "ninja", "pirate", "knight", "king", "queen", "prince", "princess", "lady", "baby",
+    "sweet", "honey", "sugar", "candy", "pretty", "beautiful", "flower", "rose", "garden",
+    "forest", "river", "ocean", "sea", "beach", "sun", "moon", "sky", "rain", "snow", "storm",
+    "thunder", "light", "dark", "shadow", "fire", "water", "earth", "wind", "silver", "gold",
+    "diamond", "crystal", "dream", "hope", "faith", "peace", "freedom", "world", "america",
+    "london", "paris", "city", "home", "school", "college", "january", "february", "march",
+    "april", "june", "july", "august", "september", "october", "november", "december",
+    "monday", "friday", "sunday", "purple", "yellow", "brown", "pink", "one", "two", "three",
+    "hello", "welcome", "please", "thanks", "good", "bad", "best", "cool", "crazy", "funny",
+    "smile", "kiss", "heart", "soul", "mother", "father", "sister", "brother", "daddy",
+    "mommy", "forever", "always", "never", "together", "pass", "word", "user", "login",
+    "guest", "test", "letme", "monkey", "qwerty", "killer", "hunter", "player", "gamer",
+    "winner", "champion", "victory", "alpha", "omega", "delta", "matrix", "system", "server",
+    "network", "office", "company", "manager", "student", "teacher", "doctor", "spider",
+};
+
+static const char *const first_names[] = {
+    "michael", "jennifer", "jessica", "ashley", "amanda", "daniel", "david", "james", "john",
+    "robert", "william", "richard", "joseph", "thomas", "charles", "christopher", "matthew",
+    "anthony", "mark", "donald", "steven", "paul", "andrew", "joshua", "kevin", "brian",
+    "george", "edward", "ronald", "timothy", "jason", "jeffrey", "ryan", "jacob", "gary",
+    "nicholas", "eric", "jonathan", "stephen", "larry", "justin", "scott", "brandon",
+    "benjamin", "samuel", "frank", "gregory", "raymond", "alexander", "patrick", "jack",
+    "dennis", "jerry", "tyler", "aaron", "jose", "henry", "adam", "douglas", "nathan",
+    "peter", "zachary", "kyle", "walter", "harold", "jeremy", "ethan", "carl", "keith",
+    "roger", "gerald", "christian", "terry", "sean", "arthur", "austin", "noah", "jesse",
+    "bryan", "billy", "jordan", "albert", "dylan", "bruce", "gabriel", "alan", "logan",
+    "mary", "patricia", "linda", "barbara", "elizabeth", "susan", "margaret", "sarah",
+    "karen", "nancy", "lisa", "betty", "dorothy", "sandra", "kimberly", "donna", "emily",
+    "michelle", "carol", "melissa", "deborah", "stephanie", "rebecca", "laura", "sharon",
+    "cynthia", "kathleen", "amy", "shirley", "angela", "helen", "anna", "brenda", "pamela",
+    "nicole", "samantha", "katherine", "emma", "ruth", "christine", "catherine", "rachel",
+    "janet", "virginia", "maria", "heather", "diane", "julie", "joyce", "victoria", "kelly",
+    "christina", "lauren", "evelyn", "olivia", "megan", "martha", "andrea", "hannah",
+    "alice", "teresa", "sara", "madison", "julia", "grace", "abigail", "marie", "amber",
+    "danielle", "diana", "brittany", "natalie", "sophia", "isabella", "alexis", "charlotte",
+};
+
+static const char *const slovak_words[] = {
+    "heslo", "slovensko", "bratislava", "kosice", "zilina", "nitra", "presov", "laska",
+    "mama", "tato", "babka", "dedko", "macka", "psik", "jahoda", "slnko", "mesiac",
+    "hviezda", "kvet", "ruza", "zlato", "srdce", "domov", "rodina", "priatel", "kamarat",
+    "skola", "futbal", "hokej", "leto", "zima", "jesen", "pondelok", "piatok", "nedela",
+    "ahoj", "dobre", "miska", "jozef", "janko", "anicka", "zuzka", "katka", "lucia",
+    "martin", "tomas", "michal", "lukas", "marek", "jana", "eva", "petra", "peter",
+    "miroslav", "ivana", "zuzana", "veronika", "tajne", "pocitac", "internet", "sloboda",
+};
+
+// Rady klávesov (QWERTY, QWERTZ, AZERTY, stĺpce a typické "cikcak" postupnosti).
+// Ako vzor sa berie každý súvislý úsek aspoň PATTERN_MIN_WALK_LENGTH znakov
+// v oboch smeroch.
+static const char *const keyboard_rows[] = {
+    "`1234567890-=", "qwertyuiop[]\\", "asdfghjkl;'", "zxcvbnm,./", "~!@#$%^&*()_+",
+    "qwertzuiop", "yxcvbnm", "azertyuiop", "qsdfghjklm", "wxcvbn",
+    "1qaz", "2wsx", "3edc", "4rfv", "5tgb", "6yhn", "7ujm", "8ik,", "9ol.", "0p;/",
+    "1q2w3e4r5t6y7u8i9o0p", "q1w2e3r4t5y6u7i8o9p0", "1qaz2wsx3edc4rfv5tgb6yhn",
+    "qazwsxedcrfvtgbyhnujm", "zaq1xsw2cde3vfr4bgt5", "7894561230", "1472583690",
+};
+
+// Znaky, medzi ktorými automat prechádza; ostatné bajty ho vrátia do koreňa.
+static const char pattern_alphabet[] =
+    "abcdefghijklmnopqrstuvwxyz0123456789!@#$%^&*()-_=+[]{};:'\",.<>/?\\|`~";
+// Symbol 0 je vyhradený pre bajty mimo abecedy.
+#define PATTERN_SYMBOLS (sizeof(pattern_alphabet))
+
+// Stav automatu. Reťazec stavu je cesta z koreňa, takže slovo končiace
+// v stave je určené jeho hĺbkou.
+typedef struct {
+    uint32_t guesses;       // Počet pokusov pre slovo končiace v stave (0 = žiadne slovo).
+    uint16_t output;        // Najbližší stav na reťazi zlyhaní, v ktorom končí slovo (0 = žiadny).
+    uint8_t depth;          // Dĺžka reťazca stavu.
+    uint8_t kind;           // PATTERN_DICTIONARY alebo PATTERN_KEYBOARD.
+} PatternState;
+
+// Automat Aho-Corasick ako úplná tabuľka prechodov [stav * PATTERN_SYMBOLS + symbol].
+// Po zostavení sa už nemení.
+static uint16_t *pattern_next;
+static PatternState *pattern_states;
+static size_t pattern_state_count;
+static size_t pattern_state_capacity;
+static int patterns_ready;
+
+static uint8_t pattern_symbol[256];     // Bajt -> symbol abecedy (0 = mimo abecedy).
+static char pattern_leet[256];          // Náhrady znakov (l33t) -> písmeno, 0 = bez náhrady.
+static int pattern_reference_year;
+static pthread_once_t patterns_once = PTHREAD_ONCE_INIT;
+
+// Nájdený vzor: úsek [start, end) a log10 počtu pokusov.
+typedef struct {
+    uint8_t start;
+    uint8_t end;
+    uint8_t type;
+    double guesses_log10;
+} PatternMatch;
+
+typedef struct {
+    PatternMatch items[PATTERN_MAX_MATCHES];
+    int count;
+} PatternMatches;
+
+// --- Zostavenie automatu ---
+
+/**
+ * @brief Vytvorí nový stav (pri zaplnení zdvojnásobí kapacitu).
+ *
+ * @return Index stavu alebo 0, ak sa stav nepodarilo vytvoriť.
+ */
+static size_t pattern_new_state(uint8_t depth) {
+    if (pattern_state_count == pattern_state_capacity) {
+        size_t capacity = pattern_state_capacity ? pattern_state_capacity * 2 : PATTERN_INITIAL_STATES;
+        if (capacity > PATTERN_MAX_STATES + 1) capacity = PATTERN_MAX_STATES + 1;
+        if (capacity == pattern_state_capacity) return 0;
+
+        uint16_t *next = (uint16_t *)realloc(pattern_next, capacity * PATTERN_SYMBOLS * sizeof(uint16_t));
+        if (!next) return 0;
+        pattern_next = next;
+        PatternState *states = (PatternState *)realloc(pattern_states, capacity * sizeof(PatternState));
+        if (!states) return 0;
+        pattern_states = states;
+        pattern_state_capacity = capacity;
+    }
+
+    size_t state = pattern_state_count++;
+    memset(&pattern_next[state * PATTERN_SYMBOLS], 0, PATTERN_SYMBOLS * sizeof(uint16_t));
+    memset(&pattern_states[state], 0, sizeof(PatternState));
+    pattern_states[state].depth = depth;
+    return state;
+}
+
+/**
+ * @brief Prejde z `state` znakom `c`, podľa potreby vytvorí nový stav.
+ *
+ * @return Nasledujúci stav alebo 0 pri chybe (znak mimo abecedy, plný automat).
+ */
+static size_t pattern_child(size_t state, unsigned char c) {
+    uint8_t symbol = pattern_symbol[c];
+    if (!symbol || pattern_states[state].depth == UINT8_MAX) return 0;
+    uint16_t *slot = &pattern_next[state * PATTERN_SYMBOLS + symbol];
+    if (*slot) return *slot;
+
+    size_t child = pattern_new_state((uint8_t)(pattern_states[state].depth + 1));
+    if (!child) return 0;
+    // realloc v pattern_new_state() mohol tabuľku presunúť.
+    pattern_next[state * PATTERN_SYMBOLS + symbol] = (uint16_t)child;
+    return child;
+}
+
+/**
+ * @brief Označí stav ako koniec slova (pri viacerých zdrojoch platí menší počet pokusov).
+ */
+static void pattern_mark(size_t state, uint8_t kind, uint32_t guesses) {
+    PatternState *entry = &pattern_states[state];
+    if (entry->guesses == 0 || guesses < entry->guesses) {
+        entry->guesses = guesses;
+        entry->kind = kind;
+    }
+}
+
+/**
+ * @brief Vloží slovník; počet pokusov je poradie slova v zozname.
+ */
+static int pattern_add_words(const char *const *words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        size_t state = 0;
+        for (const char *c = words[i]; *c; c++) {
+            state = pattern_child(state, (unsigned char)*c);
+            if (!state) return 0;
+        }
+        if (state) pattern_mark(state, PATTERN_DICTIONARY, (uint32_t)(i + 1));
+    }
+    return 1;
+}
+
+/**
+ * @brief Vloží všetky úseky radu klávesov dlhé aspoň PATTERN_MIN_WALK_LENGTH.
+ */
+static int pattern_add_walks(const char *row, size_t length) {
+    for (size_t start = 0; start + PATTERN_MIN_WALK_LENGTH <= length; start++) {
+        size_t state = 0;
+        for (size_t i = start; i < length; i++) {
+            state = pattern_child(state, (unsigned char)row[i]);
+            if (!state) return 0;
+            size_t walk = i - start + 1;
+            if (walk >= PATTERN_MIN_WALK_LENGTH) {
+                pattern_mark(state, PATTERN_KEYBOARD,
+                             (uint32_t)(KEYBOARD_STARTING_KEYS * KEYBOARD_AVERAGE_DEGREE * (walk - 1)));
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Doplní prechody cez zlyhania (BFS), takže z každého stavu vedie
+ *        prechod pre každý symbol, a reťaz výstupov pre slová, ktoré sú
+ *        príponou dlhšieho reťazca.
+ */
+static int pattern_link(void) {
+    uint16_t *fail = (uint16_t *)calloc(pattern_state_count, sizeof(uint16_t));
+    uint16_t *queue = (uint16_t *)malloc(pattern_state_count * sizeof(uint16_t));
+    if (!fail || !queue) {
+        free(fail);
+        free(queue);
+        return 0;
+    }
+
+    size_t head = 0;
+    size_t tail = 0;
+    for (size_t symbol = 1; symbol < PATTERN_SYMBOLS; symbol++) {
+        uint16_t child = pattern_next[symbol];
+        if (child) queue[tail++] = child;
+    }
+    while (head < tail) {
+        size_t state = queue[head++];
+        uint16_t *row = &pattern_next[state * PATTERN_SYMBOLS];
+        const uint16_t *fail_row = &pattern_next[fail[state] * PATTERN_SYMBOLS];
+        for (size_t symbol = 1; symbol < PATTERN_SYMBOLS; symbol++) {
+            uint16_t child = row[symbol];
+            if (child) {
+                uint16_t target = fail_row[symbol];
+                fail[child] = target;
+                pattern_states[child].output = pattern_states[target].guesses
+                                               ? target : pattern_states[target].output;
+                queue[tail++] = child;
+            } else {
+                row[symbol] = fail_row[symbol];
+            }
+        }
+    }
+
+    free(fail);
+    free(queue);
+    return 1;
+}
+
+#define ARRAY_COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+static void patterns_build(void) {
+    for (size_t i = 0; pattern_alphabet[i]; i++) {
+        pattern_symbol[(unsigned char)pattern_alphabet[i]] = (uint8_t)(i + 1);
+    }
+    for (int c = 'A'; c <= 'Z'; c++) {
+        pattern_symbol[c] = pattern_symbol[c - 'A' + 'a'];
+    }
+
+    // Dvojice "znak, písmeno", ktoré nahrádza.
+    static const char leet_pairs[] = "4a@a8b(c3e6g9g1i!i|l0o$s5s7t+t2z";
+    for (size_t i = 0; leet_pairs[i]; i += 2) {
+        pattern_leet[(unsigned char)leet_pairs[i]] = leet_pairs[i + 1];
+    }
+
+    time_t now = time(NULL);
+    struct tm local;
+    localtime_r(&now, &local);
+    pattern_reference_year = local.tm_year + 1900;
+
+    pattern_new_state(0);                   // Koreň je stav 0.
+    int ok = pattern_state_count == 1;
+    ok = ok && pattern_add_words(common_passwords, ARRAY_COUNT(common_passwords));
+    ok = ok && pattern_add_words(english_words, ARRAY_COUNT(english_words));
+    ok = ok && pattern_add_words(first_names, ARRAY_COUNT(first_names));
+    ok = ok && pattern_add_words(slovak_words, ARRAY_COUNT(slovak_words));
+
+    char reversed[64];
+    for (size_t r = 0; ok && r < ARRAY_COUNT(keyboard_rows); r++) {
+        size_t length = strlen(keyboard_rows[r]);
+        for (size_t i = 0; i < length; i++) {
+            reversed[i] = keyboard_rows[r][length - 1 - i];
+        }
+        ok = pattern_add_walks(keyboard_rows[r], length) && pattern_add_walks(reversed, length);
+    }
+    ok = ok && pattern_link();
+
+    if (!ok) {
+        fprintf(stderr, "Nepodarilo sa zostaviť automat vzorov, heslá sa hodnotia bez neho\n");
+        return;
+    }
+    patterns_ready = 1;
+}
+
+void patterns_init(void) {
+    pthread_once(&patterns_once, patterns_build);
+}
+
+// --- Hľadanie vzorov ---
+
+static void pattern_add_match(PatternMatches *matches, size_t start, size_t end,
+                              unsigned int type, double guesses_log10) {
+    if (matches->count == PATTERN_MAX_MATCHES) return;
+    double minimum = log10(PATTERN_MIN_SUBMATCH_GUESSES);
+    PatternMatch *match = &matches->items[matches->count++];
+    match->start = (uint8_t)start;
+    match->end = (uint8_t)end;
+    match->type = (uint8_t)type;
+    match->guesses_log10 = guesses_log10 > minimum ? guesses_log10 : minimum;
+}
+
+static int is_upper(char c) {
+    return c >= 'A' && c <= 'Z';
+}
+
+static int is_lower(char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+/**
+ * @brief log10 počtu variantov veľkých písmen slova (ako v zxcvbn).
+ *
+ * Všetko malé: 1; všetko veľké alebo len prvé/posledné veľké: 2;
+ * inak súčet C(n, i) pre i = 1..min(veľké, malé).
+ */
+static double uppercase_variations_log10(const char *raw, size_t start, size_t end) {
+    size_t upper = 0;
+    size_t lower = 0;
+    for (size_t i = start; i < end; i++) {
+        if (is_upper(raw[i])) upper++;
+        else if (is_lower(raw[i])) lower++;
+    }
+    if (upper == 0) return 0.0;
+    if (lower == 0 || (upper == 1 && (is_upper(raw[start]) || is_upper(raw[end - 1])))) {
+        return log10(2.0);
+    }
+
+    size_t letters = upper + lower;
+    size_t limit = upper < lower ? upper : lower;
+    double variations = 0.0;
+    double binomial = 1.0;
+    for (size_t i = 1; i <= limit; i++) {
+        binomial = binomial * (double)(letters - i + 1) / (double)i;
+        variations += binomial;
+    }
+    return log10(variations);
+}
+
+/**
+ * @brief Prejde text automatom a zapíše všetky slová zo slovníkov a klávesové postupnosti.
+ *
+ * @param view Text pre automat (`raw` s prípadnými náhradami l33t).
+ * @param substituted Prefixové súčty nahradených znakov alebo NULL pre text bez náhrad.
+ *        Pri náhradách sa berú len slovníkové slová, ktoré aspoň jednu obsahujú.
+ */
+static void match_automaton(const char *raw, const char *view, const uint8_t *substituted,
+                            size_t length, PatternMatches *matches) {
+    size_t state = 0;
+    for (size_t i = 0; i < length; i++) {
+        state = pattern_next[state * PATTERN_SYMBOLS + pattern_symbol[(unsigned char)view[i]]];
+        size_t found = pattern_states[state].guesses ? state : pattern_states[state].output;
+        while (found) {
+            const PatternState *word = &pattern_states[found];
+            size_t start = i + 1 - word->depth;
+            double guesses = log10((double)word->guesses) + uppercase_variations_log10(raw, start, i + 1);
+
+            if (!substituted) {
+                pattern_add_match(matches, start, i + 1, word->kind, guesses);
+            } else if (word->kind == PATTERN_DICTIONARY) {
+                // Každý nahradený znak zhruba zdvojnásobí počet variantov.
+                unsigned int count = substituted[i + 1] - substituted[start];
+                if (count > 0) {
+                    pattern_add_match(matches, start, i + 1, PATTERN_DICTIONARY | PATTERN_LEET,
+                                      guesses + count * log10(2.0));
+                }
+            }
+            found = word->output;
+        }
+    }
+}
+
+/**
+ * @brief Trieda znaku pre postupnosti: 1 malé, 2 veľké písmeno, 3 číslica, 0 iné.
+ */
+static int sequence_class(char c) {
+    if (is_lower(c)) return 1;
+    if (is_upper(c)) return 2;
+    if (c >= '0' && c <= '9') return 3;
+    return 0;
+}
+
+/**
+ * @brief Nájde postupnosti s krokom +1 alebo -1 (abcd, 4321) dlhé aspoň 3 znaky.
+ */
+static void match_sequences(const char *raw, size_t length, PatternMatches *matches) {
+    size_t i = 0;
+    while (i + 2 < length) {
+        int delta = raw[i + 1] - raw[i];
+        int class = sequence_class(raw[i]);
+        if ((delta != 1 && delta != -1) || !class || sequence_class(raw[i + 1]) != class) {
+            i++;
+            continue;
+        }
+
+        size_t j = i + 1;
+        while (j + 1 < length && raw[j + 1] - raw[j] == delta && sequence_class(raw[j + 1]) == class) {
+            j++;
+        }
+        size_t run = j - i + 1;
+        if (run >= 3) {
+            // Postupnosti od "zjavných" znakov sa skúšajú ako prvé.
+            double base = strchr("aAzZ019", raw[i]) ? 4.0 : (class == 3 ? 10.0 : 26.0);
+            double guesses = base * (double)run * (delta < 0 ? 2.0 : 1.0);
+            pattern_add_match(matches, i, j + 1, PATTERN_SEQUENCE, log10(guesses));
+        }
+        i = j;
+    }
+}
+
+/**
+ * @brief Nájde štvorice číslic, ktoré vyzerajú ako letopočet.
+ */
+static void match_years(const char *raw, size_t length, PatternMatches *matches) {
+    for (size_t i = 0; i + 4 <= length; i++) {
+        int year = 0;
+        size_t k = 0;
+        for (; k < 4 && raw[i + k] >= '0' && raw[i + k] <= '9'; k++) {
+            year = year * 10 + (raw[i + k] - '0');
+        }
+        if (k < 4 || year < PATTERN_MIN_YEAR || year > PATTERN_MAX_YEAR) continue;
+
+        int distance = abs(year - pattern_reference_year);
+        if (distance < PATTERN_MIN_YEAR_SPACE) distance = PATTERN_MIN_YEAR_SPACE;
+        pattern_add_match(matches, i, i + 4, PATTERN_YEAR, log10((double)distance));
+    }
+}
+
+static double pattern_analyze(const char *raw, size_t length, int allow_repeats, unsigned int *patterns);
+
+/**
+ * @brief Nájde opakovania úseku (aaaa, abab, hesloheslo).
+ *
+ * Pre každú dĺžku úseku u sa hľadajú pozície, kde sa znak zhoduje so znakom
+ * o u ďalej a zhoda sa nedá posunúť doľava; od nich sa zhoda predĺži.
+ * Porovnania sú nezávislé, takže náhodné heslo (skoro žiadne zhody) sa
+ * prejde rýchlo. Počet pokusov je odhad pre úsek krát počet opakovaní.
+ * Dlhší úsek, ktorý nepokryje viac ako kratší z rovnakej pozície (napr. "aa"
+ * v "aaaaaa"), sa preskočí.
+ */
+static void match_repeats(const char *raw, size_t length, PatternMatches *matches) {
+    uint8_t covered[PATTERN_MAX_LENGTH];        // Najdlhšie opakovanie začínajúce na pozícii.
+    size_t max_unit = length / 2 < PATTERN_MAX_REPEAT_UNIT ? length / 2 : PATTERN_MAX_REPEAT_UNIT;
+    memset(covered, 0, length);
+
+    for (size_t unit = 1; unit <= max_unit; unit++) {
+        size_t limit = length - unit;
+        for (size_t i = 0; i < limit; i++) {
+            if (raw[i] != raw[i + unit] || (i > 0 && raw[i - 1] == raw[i - 1 + unit])) continue;
+
+            size_t run = 1;
+            while (i + run < limit && raw[i + run] == raw[i + run + unit]) run++;
+            // Aspoň dve celé opakovania úseku.
+            if (run < unit) continue;
+            size_t span = (unit + run) / unit * unit;
+            if (span < 3 || span <= covered[i]) continue;
+            covered[i] = (uint8_t)span;
+
+            double unit_guesses = pattern_analyze(raw + i, unit, 0, NULL);
+            pattern_add_match(matches, i, i + span, PATTERN_REPEAT,
+                              unit_guesses + log10((double)(span / unit)));
+        }
+    }
+}
+
+/**
+ * @brief Vyberie rozklad hesla na vzory a úseky hrubej sily s najmenším
+ *        počtom pokusov (dynamické programovanie cez pozície hesla).
+ */
+static double pattern_minimum_guesses(const PatternMatches *matches, size_t length, unsigned int *patterns) {
+    double best[PATTERN_MAX_LENGTH + 1];
+    int16_t choice[PATTERN_MAX_LENGTH + 1];
+    int16_t ending[PATTERN_MAX_LENGTH + 1];     // Prvý vzor končiaci na danej pozícii.
+    int16_t next[PATTERN_MAX_MATCHES];          // Ďalší vzor s rovnakým koncom.
+
+    for (size_t k = 0; k <= length; k++) {
+        ending[k] = -1;
+    }
+    for (int m = 0; m < matches->count; m++) {
+        next[m] = ending[matches->items[m].end];
+        ending[matches->items[m].end] = (int16_t)m;
+    }
+
+    double per_char = log10(PATTERN_BRUTEFORCE_CARDINALITY);
+    best[0] = 0.0;
+    for (size_t k = 1; k <= length; k++) {
+        best[k] = best[k - 1] + per_char;
+        choice[k] = -1;
+        for (int m = ending[k]; m >= 0; m = next[m]) {
+            const PatternMatch *match = &matches->items[m];
+            double candidate = best[match->start] + match->guesses_log10;
+            if (candidate < best[k]) {
+                best[k] = candidate;
+                choice[k] = (int16_t)m;
+            }
+        }
+    }
+
+    if (patterns) {
+        *patterns = 0;
+        for (size_t k = length; k > 0;) {
+            if (choice[k] < 0) {
+                k--;
+            } else {
+                *patterns |= matches->items[choice[k]].type;
+                k = matches->items[choice[k]].start;
+            }
+        }
+    }
+    return best[length];
+}
+
+/**
+ * @brief Nájde všetky vzory v hesle a vráti log10 počtu pokusov najlepšieho rozkladu.
+ *
+ * @param allow_repeats 0 pri odhade opakovaného úseku (opakovanie v opakovaní sa nehľadá).
+ */
+static double pattern_analyze(const char *raw, size_t length, int allow_repeats, unsigned int *patterns) {
+    PatternMatches matches;
+    matches.count = 0;
+
+    // Automat pracuje s malými písmenami (veľké mapuje tabuľka symbolov na rovnaké);
+    // druhý prechod je cez text s nahradenými l33t znakmi.
+    char leet_view[PATTERN_MAX_LENGTH];
+    uint8_t substituted[PATTERN_MAX_LENGTH + 1];
+    substituted[0] = 0;
+    for (size_t i = 0; i < length; i++) {
+        char replacement = pattern_leet[(unsigned char)raw[i]];
+        leet_view[i] = replacement ? replacement : raw[i];
+        substituted[i + 1] = (uint8_t)(substituted[i] + (replacement != 0));
+    }
+
+    match_automaton(raw, raw, NULL, length, &matches);
+    if (substituted[length] > 0) {
+        match_automaton(raw, leet_view, substituted, length, &matches);
+    }
+    match_sequences(raw, length, &matches);
+    match_years(raw, length, &matches);
+    if (allow_repeats) {
+        match_repeats(raw, length, &matches);
+    }
+    return pattern_minimum_guesses(&matches, length, patterns);
+}
+
+void estimate_password_guesses(const char *password, size_t length, PatternEstimate *estimate) {
+    pthread_once(&patterns_once, patterns_build);
+
+    // Za analyzovaným začiatkom sa každý ďalší znak počíta ako hrubá sila.
+    size_t analyzed = length < PATTERN_MAX_LENGTH ? length : PATTERN_MAX_LENGTH;
+    double rest = (double)(length - analyzed) * log10(PATTERN_BRUTEFORCE_CARDINALITY);
+
+    if (!patterns_ready) {
+        estimate->guesses_log10 = (double)length * log10(PATTERN_BRUTEFORCE_CARDINALITY);
+        estimate->patterns = 0;
+        return;
+    }
+    estimate->guesses_log10 = pattern_analyze(password, analyzed, 1, &estimate->patterns) + rest;
+}
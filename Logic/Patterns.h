@@ -0,0 +1,51 @@
+#ifndef PATTERNS_H
+#define PATTERNS_H
+
+#include <stddef.h>
+
+// Analyzuje sa najviac toľko bajtov hesla (dlhšie heslá sú silné už dĺžkou)
+#define PATTERN_MAX_LENGTH 128
+// Najviac nájdených vzorov v jednom hesle
+#define PATTERN_MAX_MATCHES 512
+// Najkratšia klávesová postupnosť (kratšie pokrýva hrubá sila alebo postupnosť)
+#define PATTERN_MIN_WALK_LENGTH 4
+// Najdlhší opakovaný úsek (napr. "heslo" v "hesloheslo")
+#define PATTERN_MAX_REPEAT_UNIT 32
+// Pod touto hranicou (log10 pokusov) dostane heslo so vzorom obmedzené skóre
+#define PATTERN_SAFE_GUESSES_LOG10 10.0
+
+// Druhy vzorov nájdených v hesle (bitová maska).
+#define PATTERN_DICTIONARY 0x01     // Bežné heslo, slovo alebo meno.
+#define PATTERN_KEYBOARD   0x02     // Postupnosť susedných klávesov (qwerty, 1qaz).
+#define PATTERN_REPEAT     0x04     // Opakovanie (aaaa, abcabc).
+#define PATTERN_SEQUENCE   0x08     // Postupnosť (1234, abcd, 9876).
+#define PATTERN_YEAR       0x10     // Letopočet (1990, 2024).
+#define PATTERN_LEET       0x20     // Slovo s náhradami znakov (p@ssw0rd).
+
+// Odhad počtu pokusov potrebných na uhádnutie hesla.
+typedef struct {
+    double guesses_log10;   // log10 odhadovaného počtu pokusov.
+    unsigned int patterns;  // Vzory v najlepšom rozklade (PATTERN_*), 0 = len hrubá sila.
+} PatternEstimate;
+
+/**
+ * @brief Odhadne, koľko pokusov treba na uhádnutie hesla (v štýle zxcvbn).
+ *
+ * Heslo sa rozloží na slová zo slovníkov, klávesové postupnosti (všetky
+ * v jednom automate Aho-Corasick), opakovania, postupnosti a letopočty;
+ * zvyšok sa odhaduje hrubou silou. Dynamické programovanie vyberie rozklad
+ * s najmenším počtom pokusov. Automat sa zostaví pri prvom volaní a potom
+ * ho vlákna zdieľajú len na čítanie; funkcia nealokuje pamäť.
+ *
+ * @param password Heslo (nemusí byť ukončené nulou).
+ * @param length Dĺžka hesla v bajtoch.
+ * @param estimate Výsledok odhadu.
+ */
+void estimate_password_guesses(const char *password, size_t length, PatternEstimate *estimate);
+
+/**
+ * @brief Zostaví automat vopred (inak sa zostaví pri prvom odhade).
+ */
+void patterns_init(void);
+
+#endif // PATTERNS_H
@@ -0,0 +1,356 @@
+#include "Policy.h"
+#include "Password.h"
+#include "Random.h"
+#include <pthread.h>
+
+// Základné abecedy tried (rovnaké ako pri generate_password()).
+static const char *const default_alphabets[POLICY_CLASS_COUNT] = {
+    "abcdefghijklmnopqrstuvwxyz",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+    "0123456789",
+    "!@#$%^&*()_+-=[]{}|;:,.<>?",
+};
+// Písmená v `classes=` a prípony kľúčov `min_*` pre jednotlivé triedy.
+static const char class_letters[POLICY_CLASS_COUNT] = {'l', 'u', 'd', 's'};
+static const char *const class_keys[POLICY_CLASS_COUNT] = {"lower", "upper", "digits", "symbols"};
+
+// Vstavané politiky v rovnakom formáte ako súbor z policy_load().
+static const char *const builtin_policies[] = {
+    "default classes=luds min_lower=1 min_upper=1 min_digits=1 min_symbols=1 length=12",
+    "readable classes=luds exclude=0O1lI|`'.,;: min_lower=1 min_upper=1 min_digits=1 min_symbols=1 "
+        "max_run=2 length=16",
+    "alphanumeric classes=lud min_lower=1 min_upper=1 min_digits=1 length=16",
+    "pin classes=d max_run=2 length=8",
+};
+
+static PasswordPolicy policies[POLICY_MAX_POLICIES];
+static int named_count;
+// Vnútorné politiky generate_password() podľa masky tried (bit = PolicyClass).
+static PasswordPolicy class_policies[1 << POLICY_CLASS_COUNT];
+static pthread_once_t policy_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Nastaví abecedu triedy (duplicity sa vynechajú).
+ *
+ * @return 1 pri úspechu, 0 ak obsahuje nepovolený znak.
+ */
+static int set_alphabet(PolicyAlphabet *alphabet, const char *chars, size_t length) {
+    unsigned char seen[256] = {0};
+    alphabet->size = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)chars[i];
+        // Úvodzovky a spätné lomky by sa v JSON odpovediach museli escapovať.
+        if (c < 0x21 || c > 0x7e || c == '"' || c == '\\') return 0;
+        if (seen[c]) continue;
+        seen[c] = 1;
+        alphabet->chars[alphabet->size++] = (char)c;
+    }
+    return 1;
+}
+
+/**
+ * @brief Vynechá z abecedy znaky označené v `excluded` a predpočíta hranicu zamietnutia.
+ */
+static void finish_alphabet(PolicyAlphabet *alphabet, const unsigned char *excluded) {
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < alphabet->size; i++) {
+        if (!excluded[(unsigned char)alphabet->chars[i]]) alphabet->chars[size++] = alphabet->chars[i];
+    }
+    alphabet->size = size;
+    alphabet->threshold = size ? (uint32_t)-size % size : 0;
+}
+
+/**
+ * @brief Dokončí politiku: vynechá znaky, zostaví zjednotenie abecied a skontroluje limity.
+ *
+ * @param exclude Vynechané znaky (môže byť NULL).
+ * @return NULL pri úspechu, inak popis chyby.
+ */
+static const char *compile_policy(PasswordPolicy *policy, const char *exclude, size_t exclude_length) {
+    unsigned char excluded[256] = {0};
+    for (size_t i = 0; i < exclude_length; i++) excluded[(unsigned char)exclude[i]] = 1;
+
+    unsigned char in_union[256] = {0};
+    int min_total = 0;
+    policy->all.size = 0;
+    for (int c = 0; c < POLICY_CLASS_COUNT; c++) {
+        PolicyAlphabet *alphabet = &policy->classes[c];
+        int used = alphabet->size > 0;
+        finish_alphabet(alphabet, excluded);
+        if (used && alphabet->size == 0) return "trieda nemá po vynechaní žiadny znak";
+        if (policy->min_count[c] > 0 && alphabet->size == 0) return "minimum pre triedu, ktorá sa nepoužíva";
+        if (policy->max_run > 0 && alphabet->size == 1) return "max_run potrebuje aspoň 2 znaky v každej triede";
+        min_total += policy->min_count[c];
+        for (uint32_t i = 0; i < alphabet->size; i++) {
+            unsigned char ch = (unsigned char)alphabet->chars[i];
+            if (in_union[ch]) continue;
+            in_union[ch] = 1;
+            policy->all.chars[policy->all.size++] = (char)ch;
+        }
+    }
+    finish_alphabet(&policy->all, excluded);
+    if (policy->all.size == 0) return "politika nemá žiadne znaky";
+    if (policy->max_run > 0 && policy->all.size < 2) return "max_run potrebuje aspoň 2 znaky";
+
+    policy->min_length = policy->prefix_length + min_total;
+    if (policy->min_length > MAX_PASSWORD_LENGTH) return "predpona a minimá sú dlhšie ako najdlhšie heslo";
+    if (policy->default_length == 0) {
+        policy->default_length = policy->min_length > MIN_PASSWORD_LENGTH ? policy->min_length : MIN_PASSWORD_LENGTH;
+    }
+    if (policy->default_length < policy->min_length || policy->default_length > MAX_PASSWORD_LENGTH) {
+        return "neplatná dĺžka";
+    }
+    return NULL;
+}
+
+/**
+ * @brief Načíta nezáporné číslo hodnoty kľúča.
+ *
+ * @return Číslo alebo -1.
+ */
+static int parse_count(const char *value, size_t length) {
+    if (length == 0 || length > 3) return -1;
+    int result = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (value[i] < '0' || value[i] > '9') return -1;
+        result = result * 10 + (value[i] - '0');
+    }
+    return result;
+}
+
+/**
+ * @brief Skompiluje jeden riadok `názov kľúč=hodnota ...` do `policy`.
+ *
+ * @return NULL pri úspechu, inak popis chyby.
+ */
+static const char *parse_policy(const char *line, PasswordPolicy *policy) {
+    memset(policy, 0, sizeof(*policy));
+    const char *p = line;
+    size_t name_length = strcspn(p, " \t");
+    if (name_length == 0 || name_length >= POLICY_NAME_SIZE) return "chýba alebo je príliš dlhý názov";
+    for (size_t i = 0; i < name_length; i++) {
+        char c = p[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-')) {
+            return "názov smie obsahovať len a-z, 0-9, '_' a '-'";
+        }
+    }
+    memcpy(policy->name, p, name_length);
+    p += name_length;
+
+    const char *exclude = NULL;
+    size_t exclude_length = 0;
+    while (*p) {
+        p += strspn(p, " \t");
+        if (!*p) break;
+        size_t token_length = strcspn(p, " \t");
+        const char *equals = memchr(p, '=', token_length);
+        if (!equals) return "očakávam kľúč=hodnota";
+        size_t key_length = (size_t)(equals - p);
+        const char *value = equals + 1;
+        size_t value_length = token_length - key_length - 1;
+
+        int matched = 0;
+        if (key_length == 7 && memcmp(p, "classes", 7) == 0) {
+            for (size_t i = 0; i < value_length; i++) {
+                const char *letter = memchr(class_letters, value[i], POLICY_CLASS_COUNT);
+                if (!letter) return "classes pozná len písmená l, u, d, s";
+                int c = (int)(letter - class_letters);
+                set_alphabet(&policy->classes[c], default_alphabets[c], strlen(default_alphabets[c]));
+            }
+            matched = 1;
+        } else if (key_length == 7 && memcmp(p, "exclude", 7) == 0) {
+            exclude = value;
+            exclude_length = value_length;
+            matched = 1;
+        } else if (key_length == 6 && memcmp(p, "prefix", 6) == 0) {
+            PolicyAlphabet check;
+            if (value_length > POLICY_MAX_PREFIX || !set_alphabet(&check, value, value_length)) {
+                return "neplatná predpona";
+            }
+            memcpy(policy->prefix, value, value_length);
+            policy->prefix_length = (int)value_length;
+            matched = 1;
+        } else if (key_length == 7 && memcmp(p, "max_run", 7) == 0) {
+            policy->max_run = parse_count(value, value_length);
+            if (policy->max_run < 0) return "neplatné max_run";
+            matched = 1;
+        } else if (key_length == 6 && memcmp(p, "length", 6) == 0) {
+            policy->default_length = parse_count(value, value_length);
+            if (policy->default_length <= 0) return "neplatná dĺžka";
+            matched = 1;
+        }
+        for (int c = 0; !matched && c < POLICY_CLASS_COUNT; c++) {
+            size_t class_length = strlen(class_keys[c]);
+            if (key_length == class_length && memcmp(p, class_keys[c], class_length) == 0) {
+                if (!set_alphabet(&policy->classes[c], value, value_length)) return "nepovolený znak v abecede";
+                matched = 1;
+            } else if (key_length == class_length + 4 && memcmp(p, "min_", 4) == 0 &&
+                       memcmp(p + 4, class_keys[c], class_length) == 0) {
+                policy->min_count[c] = parse_count(value, value_length);
+                if (policy->min_count[c] < 0) return "neplatné minimum";
+                matched = 1;
+            }
+        }
+        if (!matched) return "neznámy kľúč";
+        p += token_length;
+    }
+    return compile_policy(policy, exclude, exclude_length);
+}
+
+static const PasswordPolicy *find_named(const char *name, size_t length) {
+    for (int i = 0; i < named_count; i++) {
+        if (strlen(policies[i].name) == length && memcmp(policies[i].name, name, length) == 0) {
+            return &policies[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Pridá pomenovanú politiku, ak je názov voľný.
+ *
+ * @return NULL pri úspechu, inak popis chyby.
+ */
+static const char *add_policy(const char *line) {
+    if (named_count == POLICY_MAX_POLICIES) return "príliš veľa politík";
+    PasswordPolicy *policy = &policies[named_count];
+    const char *error = parse_policy(line, policy);
+    if (error) return error;
+    if (find_named(policy->name, strlen(policy->name))) return "politika s týmto názvom už existuje";
+    policy->id = ++named_count;
+    return NULL;
+}
+
+/**
+ * @brief Skompiluje vstavané politiky (raz, pri prvom použití).
+ */
+static void policy_build(void) {
+    for (size_t i = 0; i < sizeof(builtin_policies) / sizeof(builtin_policies[0]); i++) {
+        const char *error = add_policy(builtin_policies[i]);
+        if (error) {
+            fprintf(stderr, "Vstavaná politika %zu: %s\n", i, error);
+            abort();
+        }
+    }
+    for (int mask = 0; mask < (1 << POLICY_CLASS_COUNT); mask++) {
+        PasswordPolicy *policy = &class_policies[mask];
+        int classes = mask ? mask : (1 << POLICY_CLASS_COUNT) - 1;
+        for (int c = 0; c < POLICY_CLASS_COUNT; c++) {
+            if (!(classes & (1 << c))) continue;
+            set_alphabet(&policy->classes[c], default_alphabets[c], strlen(default_alphabets[c]));
+            policy->min_count[c] = 1;
+        }
+        policy->default_length = 12;
+        compile_policy(policy, NULL, 0);
+    }
+}
+
+int policy_load(const char *path) {
+    pthread_once(&policy_once, policy_build);
+    if (!path || !*path) return 1;
+
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return 0;
+    }
+    char line[POLICY_MAX_LINE];
+    int line_number = 0;
+    int ok = 1;
+    while (ok && fgets(line, sizeof(line), file)) {
+        line_number++;
+        line[strcspn(line, "#\r\n")] = '\0';
+        const char *start = line + strspn(line, " \t");
+        if (!*start) continue;
+        const char *error = add_policy(start);
+        if (error) {
+            fprintf(stderr, "%s:%d: %s\n", path, line_number, error);
+            ok = 0;
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+const PasswordPolicy *policy_find(const char *name, size_t length) {
+    pthread_once(&policy_once, policy_build);
+    return find_named(name, length);
+}
+
+const PasswordPolicy *policy_by_id(int id) {
+    pthread_once(&policy_once, policy_build);
+    return id >= 1 && id <= named_count ? &policies[id - 1] : NULL;
+}
+
+int policy_count(void) {
+    pthread_once(&policy_once, policy_build);
+    return named_count;
+}
+
+const PasswordPolicy *policy_for_classes(int include_special, int include_numbers,
+                                         int include_uppercase, int include_lowercase) {
+    pthread_once(&policy_once, policy_build);
+    int mask = (include_lowercase ? 1 << POLICY_LOWER : 0) | (include_uppercase ? 1 << POLICY_UPPER : 0) |
+               (include_numbers ? 1 << POLICY_DIGIT : 0) | (include_special ? 1 << POLICY_SYMBOL : 0);
+    return &class_policies[mask];
+}
+
+/**
+ * @brief Rovnomerne vyberie znak z abecedy.
+ */
+static inline char pick(const PolicyAlphabet *alphabet) {
+    uint64_t product = (uint64_t)random_u32() * alphabet->size;
+    while ((uint32_t)product < alphabet->threshold) {
+        product = (uint64_t)random_u32() * alphabet->size;
+    }
+    return alphabet->chars[product >> 32];
+}
+
+int policy_generate(const PasswordPolicy *policy, int length, char *password) {
+    if (length < policy->min_length || length > MAX_PASSWORD_LENGTH) return 0;
+
+    memcpy(password, policy->prefix, (size_t)policy->prefix_length);
+    char *body = password + policy->prefix_length;
+    int body_length = length - policy->prefix_length;
+
+    // Zdroj každej pozície: zjednotenie abecied, alebo trieda s minimom na
+    // náhodnej pozícii. Pozície miním vyberá čiastočné Fisher-Yates miešanie,
+    // takže náhodných čísel treba len toľko, koľko je miním, nie celá dĺžka.
+    const PolicyAlphabet *source[MAX_PASSWORD_LENGTH];
+    uint8_t slots[MAX_PASSWORD_LENGTH];
+    for (int i = 0; i < body_length; i++) {
+        source[i] = &policy->all;
+        slots[i] = (uint8_t)i;
+    }
+    int placed = 0;
+    for (int c = 0; c < POLICY_CLASS_COUNT; c++) {
+        for (int k = 0; k < policy->min_count[c]; k++) {
+            int j = placed + (int)random_uniform((uint32_t)(body_length - placed));
+            uint8_t slot = slots[j];
+            slots[j] = slots[placed];
+            slots[placed++] = slot;
+            source[slot] = &policy->classes[c];
+        }
+    }
+
+    // Beh rovnakých znakov pokračuje aj z konca predpony.
+    char previous = 0;
+    int run = 0;
+    for (int i = policy->prefix_length - 1; i >= 0 && policy->prefix[i] == policy->prefix[policy->prefix_length - 1]; i--) {
+        previous = policy->prefix[i];
+        run++;
+    }
+    for (int i = 0; i < body_length; i++) {
+        char c = pick(source[i]);
+        if (policy->max_run > 0 && c == previous && run >= policy->max_run) {
+            do {
+                c = pick(source[i]);
+            } while (c == previous);
+        }
+        run = c == previous ? run + 1 : 1;
+        previous = c;
+        body[i] = c;
+    }
+    password[length] = '\0';
+    return 1;
+}
@@ -0,0 +1,103 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Najviac pomenovaných politík (vstavané aj zo súboru)
+#define POLICY_MAX_POLICIES 64
+// Dĺžka názvu politiky vrátane ukončovacej nuly
+#define POLICY_NAME_SIZE 32
+// Najdlhšia povinná predpona hesla
+#define POLICY_MAX_PREFIX 32
+// Najdlhší riadok súboru s politikami
+#define POLICY_MAX_LINE 1024
+
+// Triedy znakov, pre ktoré sa dá predpísať abeceda a minimálny počet.
+typedef enum {
+    POLICY_LOWER,
+    POLICY_UPPER,
+    POLICY_DIGIT,
+    POLICY_SYMBOL,
+    POLICY_CLASS_COUNT
+} PolicyClass;
+
+// Plochá abeceda s predpočítanou hranicou zamietnutia pre rovnomerný výber
+// (Lemireho metóda, pozri random_uniform()); výber znaku je jedno násobenie.
+typedef struct {
+    char chars[96];              // Znaky bez duplicít (tlačiteľné ASCII okrem '"' a '\').
+    uint32_t size;
+    uint32_t threshold;          // 2^32 mod size: nižšie dolné polovice súčinu sa zamietnu.
+} PolicyAlphabet;
+
+// Skompilovaná politika generovania; po štarte sa už nemení.
+typedef struct {
+    char name[POLICY_NAME_SIZE]; // Prázdny pre vnútorné politiky generate_password().
+    int id;                      // Číslo pomenovanej politiky (od 1), inak 0.
+    int default_length;          // Dĺžka, ak ju požiadavka neurčí.
+    int min_length;              // Predpona + súčet minimálnych počtov.
+    PolicyAlphabet classes[POLICY_CLASS_COUNT]; // Abecedy tried (size 0 = trieda sa nepoužíva).
+    PolicyAlphabet all;          // Zjednotenie abecied tried pre zvyšok hesla.
+    int min_count[POLICY_CLASS_COUNT];
+    int max_run;                 // Najdlhší beh rovnakého znaku (0 = bez obmedzenia).
+    char prefix[POLICY_MAX_PREFIX + 1];
+    int prefix_length;
+} PasswordPolicy;
+
+/**
+ * @brief Načíta pomenované politiky zo súboru (okrem vstavaných).
+ *
+ * Riadok je `názov kľúč=hodnota ...`, `#` začína komentár. Kľúče:
+ * `classes=luds` (triedy so základnými abecedami), `lower=`, `upper=`,
+ * `digits=`, `symbols=` (vlastná abeceda triedy), `exclude=` (vynechané
+ * znaky, napr. `0O1lI|`), `min_lower=`, `min_upper=`, `min_digits=`,
+ * `min_symbols=`, `max_run=`, `prefix=` a `length=`. Volá sa raz pri štarte,
+ * pred spustením vlákien.
+ *
+ * @param path Súbor alebo NULL (len vstavané politiky).
+ * @return 1 pri úspechu, 0 pri chybe (vypíše riadok a dôvod).
+ */
+int policy_load(const char *path);
+
+/**
+ * @brief Nájde pomenovanú politiku podľa názvu.
+ *
+ * @param name Názov (nemusí byť ukončený nulou).
+ * @return Politika alebo NULL.
+ */
+const PasswordPolicy *policy_find(const char *name, size_t length);
+
+/**
+ * @brief Nájde pomenovanú politiku podľa čísla (1 až policy_count()).
+ *
+ * @return Politika alebo NULL.
+ */
+const PasswordPolicy *policy_by_id(int id);
+
+/**
+ * @brief Počet pomenovaných politík.
+ */
+int policy_count(void);
+
+/**
+ * @brief Vnútorná politika pre voľby generate_password() (aspoň jeden znak
+ *        z každej zvolenej triedy; žiadna zvolená = všetky).
+ */
+const PasswordPolicy *policy_for_classes(int include_special, int include_numbers,
+                                         int include_uppercase, int include_lowercase);
+
+/**
+ * @brief Vygeneruje heslo podľa politiky.
+ *
+ * Heslo začína predponou; zvyšok obsahuje minimálne počty znakov tried na
+ * náhodných pozíciách, ostatné znaky sú zo zjednotenia abecied a žiadny
+ * znak sa neopakuje viac ako `max_run`-krát za sebou. Nič sa neskladá ani
+ * nealokuje.
+ *
+ * @param length Dĺžka hesla (min_length až MAX_PASSWORD_LENGTH).
+ * @param password Buffer s aspoň length + 1 bajtmi.
+ * @return 1 pri úspechu, 0 pri neplatnej dĺžke.
+ */
+int policy_generate(const PasswordPolicy *policy, int length, char *password);
+
+#endif // POLICY_H
@@ -0,0 +1,211 @@
+#include "Random.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/random.h>
+
+// Stav generátora jedného vlákna.
+typedef struct {
+    uint32_t key[8];                        // Aktuálny kľúč ChaCha20.
+    uint32_t buffer[RANDOM_BUFFER_WORDS];   // Predgenerovaný výstup.
+    size_t position;                        // Index prvého nepoužitého slova v `buffer`.
+    unsigned int generation;                // Hodnota `fork_generation` pri poslednom kľúčovaní.
+    int seeded;
+} RandomState;
+
+static __thread RandomState random_state;
+
+// Zvyšuje sa v potomkovi po každom fork(), aby si vlákno vygenerovalo nový kľúč
+// a nepokračovalo v rovnakej postupnosti ako rodič.
+static volatile unsigned int fork_generation = 0;
+static pthread_once_t atfork_once = PTHREAD_ONCE_INIT;
+
+static void random_on_fork(void) {
+    fork_generation++;
+}
+
+static void random_register_atfork(void) {
+    pthread_atfork(NULL, NULL, random_on_fork);
+}
+
+// Počet blokov ChaCha20 počítaných súčasne. Bloky sú nezávislé, takže
+// kompilátor môže jednotlivé "pruhy" spracovať SIMD inštrukciami.
+#define CHACHA_LANES 4
+
+#define ROTATE(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+#define QUARTER_ROUND(a, b, c, d)                                         \
+    for (int lane = 0; lane < CHACHA_LANES; lane++) {                     \
+        x[a][lane] += x[b][lane]; x[d][lane] ^= x[a][lane]; x[d][lane] = ROTATE(x[d][lane], 16); \
+        x[c][lane] += x[d][lane]; x[b][lane] ^= x[c][lane]; x[b][lane] = ROTATE(x[b][lane], 12); \
+        x[a][lane] += x[b][lane]; x[d][lane] ^= x[a][lane]; x[d][lane] = ROTATE(x[d][lane], 8);  \
+        x[c][lane] += x[d][lane]; x[b][lane] ^= x[c][lane]; x[b][lane] = ROTATE(x[b][lane], 7);  \
+    }
+
+/**
+ * @brief Vypočíta CHACHA_LANES po sebe idúcich 64-bajtových blokov ChaCha20 (20 kôl).
+ *
+ * @param counter Počítadlo prvého bloku; ďalšie bloky majú counter+1, ...
+ * @param output Výstup, bloky za sebou (16 slov na blok).
+ */
+static void chacha20_blocks(const uint32_t key[8], uint64_t counter, uint32_t output[16 * CHACHA_LANES]) {
+    uint32_t input[16][CHACHA_LANES];
+    uint32_t x[16][CHACHA_LANES];
+
+    for (int lane = 0; lane < CHACHA_LANES; lane++) {
+        uint64_t block = counter + (uint64_t)lane;
+        input[0][lane] = 0x61707865;    // "expand 32-byte k"
+        input[1][lane] = 0x3320646e;
+        input[2][lane] = 0x79622d32;
+        input[3][lane] = 0x6b206574;
+        for (int i = 0; i < 8; i++) {
+            input[4 + i][lane] = key[i];
+        }
+        input[12][lane] = (uint32_t)block;
+        input[13][lane] = (uint32_t)(block >> 32);
+        input[14][lane] = 0;
+        input[15][lane] = 0;
+    }
+    memcpy(x, input, sizeof(x));
+
+    for (int round = 0; round < 10; round++) {
+        QUARTER_ROUND(0, 4, 8,  12)
+        QUARTER_ROUND(1, 5, 9,  13)
+        QUARTER_ROUND(2, 6, 10, 14)
+        QUARTER_ROUND(3, 7, 11, 15)
+        QUARTER_ROUND(0, 5, 10, 15)
+        QUARTER_ROUND(1, 6, 11, 12)
+        QUARTER_ROUND(2, 7, 8,  13)
+        QUARTER_ROUND(3, 4, 9,  14)
+    }
+
+    for (int lane = 0; lane < CHACHA_LANES; lane++) {
+        for (int i = 0; i < 16; i++) {
+            output[lane * 16 + i] = x[i][lane] + input[i][lane];
+        }
+    }
+}
+
+/**
+ * @brief Načíta 32 bajtov entropie z jadra.
+ *
+ * Bez kvalitného zdroja entropie nemá zmysel generovať heslá, preto je
+ * zlyhanie fatálne.
+ */
+static void random_seed_key(uint32_t key[8]) {
+    unsigned char *output = (unsigned char *)key;
+    size_t filled = 0;
+
+    while (filled < 32) {
+        ssize_t result = getrandom(output + filled, 32 - filled, 0);
+        if (result > 0) {
+            filled += (size_t)result;
+            continue;
+        }
+        if (result < 0 && errno == EINTR) continue;
+        if (result < 0 && errno == ENOSYS) break;
+        perror("getrandom");
+        exit(EXIT_FAILURE);
+    }
+    if (filled == 32) return;
+
+    // Staršie jadrá bez getrandom(): rovnaký zdroj cez /dev/urandom.
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    while (fd >= 0 && filled < 32) {
+        ssize_t result = read(fd, output + filled, 32 - filled);
+        if (result > 0) {
+            filled += (size_t)result;
+        } else if (result < 0 && errno == EINTR) {
+            continue;
+        } else {
+            break;
+        }
+    }
+    if (fd >= 0) close(fd);
+    if (filled < 32) {
+        perror("/dev/urandom");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Vygeneruje nový obsah buffera a nahradí kľúč.
+ *
+ * Prvých 8 slov výstupu sa stane novým kľúčom a volajúcemu sa nikdy
+ * nevydajú (tzv. fast key erasure), takže únik stavu vlákna neprezradí
+ * už použité náhodné čísla.
+ */
+static void random_refill(RandomState *state) {
+    if (!state->seeded || state->generation != fork_generation) {
+        pthread_once(&atfork_once, random_register_atfork);
+        state->generation = fork_generation;
+        random_seed_key(state->key);
+        state->seeded = 1;
+    }
+
+    for (size_t block = 0; block < RANDOM_BUFFER_WORDS / 16; block += CHACHA_LANES) {
+        chacha20_blocks(state->key, block, state->buffer + block * 16);
+    }
+    memcpy(state->key, state->buffer, sizeof(state->key));
+    memset(state->buffer, 0, sizeof(state->key));
+    state->position = sizeof(state->key) / sizeof(uint32_t);
+}
+
+/**
+ * @brief Vráti stav generátora vlákna s aspoň jedným nepoužitým slovom.
+ */
+static inline RandomState *random_ready_state(void) {
+    RandomState *state = &random_state;
+    if (state->position >= RANDOM_BUFFER_WORDS || !state->seeded ||
+        state->generation != fork_generation) {
+        random_refill(state);
+    }
+    return state;
+}
+
+uint32_t random_u32(void) {
+    RandomState *state = random_ready_state();
+    uint32_t value = state->buffer[state->position];
+    // Vydaný výstup sa z buffera maže, aby nezostal v pamäti.
+    state->buffer[state->position++] = 0;
+    return value;
+}
+
+void random_bytes(void *output, size_t length) {
+    unsigned char *target = (unsigned char *)output;
+
+    while (length > 0) {
+        RandomState *state = random_ready_state();
+        size_t available = (RANDOM_BUFFER_WORDS - state->position) * sizeof(uint32_t);
+        size_t count = length < available ? length : available;
+        unsigned char *source = (unsigned char *)(state->buffer + state->position);
+
+        memcpy(target, source, count);
+        // Posun po celých slovách; zvyšok načatého slova sa zahodí.
+        size_t words = (count + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+        memset(source, 0, words * sizeof(uint32_t));
+        state->position += words;
+        target += count;
+        length -= count;
+    }
+}
+
+uint32_t random_uniform(uint32_t bound) {
+    if (bound == 0) return 0;
+
+    // Horných 32 bitov súčinu je rovnomerne v [0, bound), okrem malého
+    // počtu hodnôt dolnej polovice, ktoré treba zamietnuť.
+    uint64_t product = (uint64_t)random_u32() * bound;
+    uint32_t low = (uint32_t)product;
+    if (low < bound) {
+        uint32_t threshold = (uint32_t)-bound % bound;
+        while (low < threshold) {
+            product = (uint64_t)random_u32() * bound;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
@@ -0,0 +1,38 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet 32-bitových slov, ktoré generátor vyrobí naraz (64 blokov ChaCha20 = 4 KB).
+#define RANDOM_BUFFER_WORDS 1024
+
+/**
+ * @brief Naplní buffer kryptograficky bezpečnými náhodnými bajtmi.
+ *
+ * Každé vlákno má vlastný generátor ChaCha20 s kľúčom z `getrandom()`,
+ * takže volania sa medzi vláknami nezamykajú. Po každom naplnení interného
+ * buffera sa kľúč nahradí novým (starší výstup sa z neho nedá zrekonštruovať)
+ * a po `fork()` si potomok vygeneruje úplne nový kľúč.
+ *
+ * @param output Cieľový buffer.
+ * @param length Počet bajtov.
+ */
+void random_bytes(void *output, size_t length);
+
+/**
+ * @brief Vráti náhodné 32-bitové číslo s rovnomerným rozdelením.
+ */
+uint32_t random_u32(void);
+
+/**
+ * @brief Vráti náhodné číslo z intervalu [0, bound) bez skreslenia modulom.
+ *
+ * Používa Lemireho metódu (násobenie namiesto delenia, zamietnutie
+ * len v zriedkavých prípadoch).
+ *
+ * @param bound Horná hranica (exkluzívna); pre 0 vráti 0.
+ */
+uint32_t random_uniform(uint32_t bound);
+
+#endif // RANDOM_H
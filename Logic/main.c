@@ -1,16 +1,129 @@
 #include "../BackEnd/HTTPserver.h"
+#include "Audit.h"
+#include "Breach.h"
+#include "Markov.h"
+
+/**
+ * @brief Vypíše návod na použitie programu.
+ */
+static void print_usage(const char *program) {
+    fprintf(stderr,
+            "Použitie:\n"
+            "  %s [--port P] [--backlog N] [--workers N]\n"
+            "                         spustí HTTP server (--workers > 1: supervisor\n"
+            "                         s N procesmi pripnutými na CPU, SIGHUP = reštart)\n"
+            "  %s --audit SÚBOR [--threads N] [--csv VÝSTUP | --binary VÝSTUP]\n"
+            "     [--breach-index INDEX] [--markov-model MODEL]\n"
+            "                         vyhodnotí heslá zo súboru (jedno na riadok)\n"
+            "  %s --build-breach-index VSTUP INDEX [--threads N]\n"
+            "                         zostaví index uniknutých hesiel zo zoznamu\n"
+            "                         hesiel alebo SHA-1 hašov (jedno na riadok)\n"
+            "  %s --build-markov-model VSTUP MODEL\n"
+            "                         naučí Markovov model odhadu pokusov zo\n"
+            "                         zoznamu hesiel (jedno na riadok)\n",
+            program, program, program, program);
+}
+
+/**
+ * @brief Načíta voľby servera (`--port`, `--backlog`, `--workers`) do server_config.
+ *
+ * @return 1 ak sú všetky argumenty platné voľby servera, inak 0.
+ */
+static int parse_server_options(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        int value = i + 1 < argc ? atoi(argv[i + 1]) : 0;
+        if (value <= 0) return 0;
+        if (strcmp(argv[i], "--port") == 0 && value <= 65535) {
+            server_config.port = value;
+        } else if (strcmp(argv[i], "--backlog") == 0) {
+            server_config.listen_backlog = value;
+        } else if (strcmp(argv[i], "--workers") == 0) {
+            server_config.worker_processes = value;
+        } else {
+            return 0;
+        }
+        i++;
+    }
+    server_config.argv = argv;
+    return 1;
+}
 
 /**
  * @brief Hlavný vstupný bod programu.
  *
- * Funkcia main je zodpovedná za spustenie celej aplikácie.
- * Jej jedinou úlohou je zavolať funkciu `start_server()`, ktorá
- * inicializuje a spustí HTTP server v nekonečnej slučke.
+ * Bez argumentov alebo s voľbami servera spustí HTTP server (`start_server()`),
+ * ktorý beží, kým nedostane SIGTERM/SIGINT. S prepínačom `--audit` namiesto toho offline
+ * vyhodnotí heslá zo súboru rovnakými pravidlami, aké používa server,
+ * s `--build-breach-index` zostaví index uniknutých hesiel pre server
+ * a s `--build-markov-model` naučí Markovov model odhadu počtu pokusov.
  *
- * @return 0 po úspešnom ukončení (hoci v tomto prípade sa slučka servera nikdy neukončí).
+ * @return 0 po úspešnom ukončení, 1 pri chybe alebo nesprávnych argumentoch.
  */
-int main() {
-    // Spustí HTTP server, ktorý začne počúvať na prichádzajúce spojenia.
-    start_server();
-    return 0;
+int main(int argc, char *argv[]) {
+    if (argc == 1 || strcmp(argv[1], "--port") == 0 || strcmp(argv[1], "--backlog") == 0 ||
+        strcmp(argv[1], "--workers") == 0) {
+        if (!parse_server_options(argc, argv)) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        // Spustí HTTP server, ktorý začne počúvať na prichádzajúce spojenia.
+        start_server();
+        return 0;
+    }
+
+    AuditOptions options;
+    memset(&options, 0, sizeof(options));
+    options.output_format = AUDIT_OUTPUT_NONE;
+    const char *breach_path = NULL;
+    const char *build_input = NULL;
+    const char *build_output = NULL;
+    const char *markov_path = NULL;
+    const char *markov_input = NULL;
+    const char *markov_output = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--audit") == 0 && has_value) {
+            options.input_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && has_value) {
+            options.output_format = AUDIT_OUTPUT_CSV;
+            options.output_path = argv[++i];
+        } else if (strcmp(argv[i], "--binary") == 0 && has_value) {
+            options.output_format = AUDIT_OUTPUT_BINARY;
+            options.output_path = argv[++i];
+        } else if (strcmp(argv[i], "--breach-index") == 0 && has_value) {
+            breach_path = argv[++i];
+        } else if (strcmp(argv[i], "--build-breach-index") == 0 && i + 2 < argc) {
+            build_input = argv[++i];
+            build_output = argv[++i];
+        } else if (strcmp(argv[i], "--markov-model") == 0 && has_value) {
+            markov_path = argv[++i];
+        } else if (strcmp(argv[i], "--build-markov-model") == 0 && i + 2 < argc) {
+            markov_input = argv[++i];
+            markov_output = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (build_input) {
+        return breach_index_build(build_input, build_output, options.threads) ? 0 : 1;
+    }
+    if (markov_input) {
+        return markov_build(markov_input, markov_output) ? 0 : 1;
+    }
+    if (breach_path && !breach_index_open(breach_path)) {
+        return 1;
+    }
+    if (markov_path && !markov_open(markov_path)) {
+        return 1;
+    }
+    if (!options.input_path) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    return audit_run(&options) ? 0 : 1;
 }
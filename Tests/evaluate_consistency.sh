@@ -0,0 +1,54 @@
+#!/bin/bash
+
+# Overí, že /api/evaluate a /api/evaluate/batch dajú rovnaké skóre a spätnú
+# väzbu aj s načítaným Markovovým modelom. Spúšťa sa cez 'make check'.
+
+PORT=${TEST_PORT:-18080}
+DIR=$(mktemp -d)
+SERVER_PID=
+
+cleanup() {
+    [ -n "$SERVER_PID" ] && kill "$SERVER_PID" 2>/dev/null && wait "$SERVER_PID" 2>/dev/null
+    rm -rf "$DIR"
+}
+trap cleanup EXIT
+
+# Model naučený na jednom hesle, ktoré potom musí byť "predvídateľné".
+MODEL_PASSWORD='Xq7!mPz2#Lr9'
+for i in $(seq 300); do echo "$MODEL_PASSWORD"; done > "$DIR/corpus.txt"
+./password_server --build-markov-model "$DIR/corpus.txt" "$DIR/markov.bin" > /dev/null || exit 1
+
+MARKOV_MODEL="$DIR/markov.bin" SERVER_PORT=$PORT ./password_server > "$DIR/server.log" 2>&1 &
+SERVER_PID=$!
+for i in $(seq 50); do
+    curl -s -o /dev/null "http://127.0.0.1:$PORT/" && break
+    sleep 0.1
+done
+
+# Vytiahne "skóre|spätná väzba" z odpovede (jedno aj dávkové vyhodnotenie).
+extract() {
+    sed -n 's/.*"score": *\([0-9]*\).*"feedback": *"\([^"]*\)".*/\1|\2/p'
+}
+
+failed=0
+for password in "$MODEL_PASSWORD" 'password' 'Tr0ub4dor&3' 'correcthorsebatterystaple' 'xK9#mQ2$vL8!pR4z' 'abc'; do
+    single=$(curl -s -X POST "http://127.0.0.1:$PORT/api/evaluate" -d "{\"password\":\"$password\"}" | extract)
+    batch=$(curl -s -X POST "http://127.0.0.1:$PORT/api/evaluate/batch" -H 'Content-Type: application/x-ndjson' \
+            --data-binary "\"$password\"" | extract)
+    if [ -z "$single" ] || [ "$single" != "$batch" ]; then
+        echo "CHYBA $password: evaluate '$single', evaluate/batch '$batch'"
+        failed=1
+    fi
+done
+
+# Bez načítaného modelu by test nič neoveril.
+if ! curl -s -X POST "http://127.0.0.1:$PORT/api/evaluate" -d "{\"password\":\"$MODEL_PASSWORD\"}" |
+        grep -q "predvídateľné"; then
+    echo "CHYBA: Markovov model sa neprejavil na $MODEL_PASSWORD"
+    failed=1
+fi
+
+if [ $failed -eq 0 ]; then
+    echo "evaluate_consistency: OK"
+fi
+exit $failed